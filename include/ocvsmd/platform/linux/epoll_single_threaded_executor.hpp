@@ -29,7 +29,9 @@
 #include <sys/epoll.h>
 #include <thread>
 #include <unistd.h>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace ocvsmd
 {
@@ -107,13 +109,25 @@ public:
         }
         const auto epoll_nfds = static_cast<std::size_t>(epoll_result);
 
+        // Several awaitable nodes (f.e. readable and writable ones) could share the same file descriptor,
+        // so dispatch to the nodes which are interested in the reported events.
+        // Errors and hang-ups are reported to all nodes of the descriptor.
+        //
         const auto now_time = now();
         for (std::size_t index = 0; index < epoll_nfds; ++index)
         {
-            const epoll_event& ev = evs[index];
-            if (auto* const cb_interface = static_cast<AwaitableNode*>(ev.data.ptr))
+            const epoll_event& ev      = evs[index];
+            const auto         fd_node = fd_to_nodes_.find(ev.data.fd);
+            if (fd_node == fd_to_nodes_.end())
+            {
+                continue;
+            }
+            for (auto* const cb_interface : fd_node->second)
             {
-                cb_interface->schedule(Callback::Schedule::Once{now_time});
+                if ((ev.events & (cb_interface->events() | EPOLLERR | EPOLLHUP)) != 0)
+                {
+                    cb_interface->schedule(Callback::Schedule::Once{now_time});
+                }
             }
         }
 
@@ -183,7 +197,7 @@ private:
         {
             if (fd_ >= 0)
             {
-                ::epoll_ctl(getExecutor().epollfd_, EPOLL_CTL_DEL, fd_, nullptr);
+                getExecutor().detachNode(*this);
                 getExecutor().total_awaitables_--;
             }
         }
@@ -195,8 +209,7 @@ private:
         {
             if (fd_ >= 0)
             {
-                ::epoll_event ev{events_, {this}};
-                ::epoll_ctl(getExecutor().epollfd_, EPOLL_CTL_MOD, fd_, &ev);
+                getExecutor().replaceNode(other, *this);
             }
         }
 
@@ -223,8 +236,7 @@ private:
             events_ = events;
 
             getExecutor().total_awaitables_++;
-            ::epoll_event ev{events_, {this}};
-            ::epoll_ctl(getExecutor().epollfd_, EPOLL_CTL_ADD, fd_, &ev);
+            getExecutor().attachNode(*this);
         }
 
     private:
@@ -242,12 +254,69 @@ private:
 
     };  // AwaitableNode
 
+    using FdNodes = std::vector<AwaitableNode*>;
+
+    /// Registers the node at its file descriptor.
+    ///
+    /// There is only one `epoll` registration per file descriptor - with combined events of all its nodes.
+    /// This allows to have both readable and writable callbacks on the same file descriptor
+    /// (otherwise the second `EPOLL_CTL_ADD` of the same descriptor would fail with `EEXIST`).
+    ///
+    void attachNode(AwaitableNode& node)
+    {
+        auto&      fd_nodes = fd_to_nodes_[node.fd()];
+        const bool is_new   = fd_nodes.empty();
+        fd_nodes.push_back(&node);
+        updateEpollFor(node.fd(), fd_nodes, is_new ? EPOLL_CTL_ADD : EPOLL_CTL_MOD);
+    }
+
+    void detachNode(AwaitableNode& node)
+    {
+        const auto fd_node = fd_to_nodes_.find(node.fd());
+        if (fd_node == fd_to_nodes_.end())
+        {
+            return;
+        }
+        auto& fd_nodes = fd_node->second;
+        fd_nodes.erase(std::remove(fd_nodes.begin(), fd_nodes.end(), &node), fd_nodes.end());
+        if (fd_nodes.empty())
+        {
+            ::epoll_ctl(epollfd_, EPOLL_CTL_DEL, node.fd(), nullptr);
+            fd_to_nodes_.erase(fd_node);
+            return;
+        }
+        updateEpollFor(node.fd(), fd_nodes, EPOLL_CTL_MOD);
+    }
+
+    void replaceNode(AwaitableNode& old_node, AwaitableNode& new_node)
+    {
+        const auto fd_node = fd_to_nodes_.find(new_node.fd());
+        if (fd_node != fd_to_nodes_.end())
+        {
+            std::replace(fd_node->second.begin(), fd_node->second.end(), &old_node, &new_node);
+        }
+    }
+
+    void updateEpollFor(const int fd, const FdNodes& fd_nodes, const int op) const
+    {
+        std::uint32_t events = 0;
+        for (const auto* const node : fd_nodes)
+        {
+            events |= node->events();
+        }
+
+        ::epoll_event ev{events, {}};
+        ev.data.fd = fd;
+        ::epoll_ctl(epollfd_, op, fd, &ev);
+    }
+
     // MARK: - Data members:
 
     static constexpr int MaxEpollEvents = 16;
 
-    int         epollfd_;
-    std::size_t total_awaitables_;
+    int                              epollfd_;
+    std::size_t                      total_awaitables_;
+    std::unordered_map<int, FdNodes> fd_to_nodes_;
 
 };  // EpollSingleThreadedExecutor
 
@@ -0,0 +1,488 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_SDK_COROUTINE_HPP_INCLUDED
+#define OCVSMD_SDK_COROUTINE_HPP_INCLUDED
+
+// This header is optional - the rest of the SDK requires C++14 only.
+#if (__cplusplus < 202002L) || !defined(__cpp_impl_coroutine)
+#    error "The `ocvsmd/sdk/coroutine.hpp` header requires C++20 (with coroutines support)."
+#endif
+
+#include "execution.hpp"
+#include "ocvsmd/platform/defines.hpp"
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+#include <cetl/pmr/interface_ptr.hpp>
+#include <libcyphal/executor.hpp>
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+namespace ocvsmd
+{
+namespace sdk
+{
+
+template <typename T>
+class Task;
+
+/// Internal implementation details.
+/// Not supposed to be used directly by the users of the SDK.
+///
+namespace detail
+{
+
+/// Defines base of awaiters which resume their coroutine via the executor.
+///
+/// Senders call their receivers from within their own (IPC) callbacks. Resuming the awaiting coroutine right there
+/// might destroy the sender (owned by the coroutine frame) while it's still in use, so instead the resumption
+/// is scheduled as an executor callback.
+///
+class ExecutorResumer
+{
+public:
+    void bindExecutor(libcyphal::IExecutor& executor) noexcept
+    {
+        executor_ = &executor;
+    }
+
+protected:
+    explicit ExecutorResumer(libcyphal::IExecutor* const executor = nullptr) noexcept
+        : executor_{executor}
+    {
+    }
+
+    void resumeLater(const std::coroutine_handle<> handle)
+    {
+        CETL_DEBUG_ASSERT(executor_ != nullptr, "Should be awaited from within `sdk::Task` coroutine.");
+
+        callback_ = executor_->registerCallback([handle](const auto&) {
+            //
+            handle.resume();
+        });
+        callback_.schedule(libcyphal::IExecutor::Callback::Schedule::Once{executor_->now()});
+    }
+
+private:
+    libcyphal::IExecutor*               executor_{nullptr};
+    libcyphal::IExecutor::Callback::Any callback_;
+
+};  // ExecutorResumer
+
+/// Defines awaiter of a single sender.
+///
+/// The result is stored right in the awaiter (i.e. in the coroutine frame),
+/// and the receiver captures just a pointer to it (plus the coroutine handle).
+///
+template <typename Result>
+class SenderAwaiter final : public ExecutorResumer
+{
+public:
+    SenderAwaiter(typename SenderOf<Result>::Ptr sender, libcyphal::IExecutor& executor)
+        : ExecutorResumer{&executor}
+        , sender_{std::move(sender)}
+    {
+        CETL_DEBUG_ASSERT(sender_, "");
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(const std::coroutine_handle<> handle)
+    {
+        sender_->submit([this, handle](Result&& result) {
+            //
+            maybe_result_.emplace(std::move(result));
+            resumeLater(handle);
+        });
+    }
+
+    Result await_resume()
+    {
+        CETL_DEBUG_ASSERT(maybe_result_, "");
+        return std::move(*maybe_result_);
+    }
+
+private:
+    typename SenderOf<Result>::Ptr sender_;
+    cetl::optional<Result>         maybe_result_;
+
+};  // SenderAwaiter
+
+/// Defines awaiter of all given senders - they are submitted concurrently.
+///
+template <typename... Results>
+class WhenAllAwaiter final : public ExecutorResumer
+{
+public:
+    explicit WhenAllAwaiter(typename SenderOf<Results>::Ptr... senders)
+        : senders_{std::move(senders)...}
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return sizeof...(Results) == 0;
+    }
+
+    void await_suspend(const std::coroutine_handle<> handle)
+    {
+        handle_ = handle;
+        submitAll(std::index_sequence_for<Results...>{});
+    }
+
+    std::tuple<Results...> await_resume()
+    {
+        return std::apply(
+            [](auto&... maybe_results) {
+                //
+                return std::tuple<Results...>{std::move(*maybe_results)...};
+            },
+            maybe_results_);
+    }
+
+private:
+    template <std::size_t... Is>
+    void submitAll(std::index_sequence<Is...>)
+    {
+        (submitOne<Is>(), ...);
+    }
+
+    template <std::size_t I>
+    void submitOne()
+    {
+        using Result = std::tuple_element_t<I, std::tuple<Results...>>;
+
+        std::get<I>(senders_)->submit([this](Result&& result) {
+            //
+            std::get<I>(maybe_results_).emplace(std::move(result));
+            if (++completed_ == sizeof...(Results))
+            {
+                resumeLater(handle_);
+            }
+        });
+    }
+
+    std::tuple<typename SenderOf<Results>::Ptr...> senders_;
+    std::tuple<cetl::optional<Results>...>         maybe_results_;
+    std::size_t                                    completed_{0};
+    std::coroutine_handle<>                        handle_;
+
+};  // WhenAllAwaiter
+
+/// Defines awaiter of the first completed sender out of the given ones - they are submitted concurrently.
+///
+template <typename... Results>
+class WhenAnyAwaiter final : public ExecutorResumer
+{
+    static_assert(sizeof...(Results) > 0, "At least one sender is required.");
+
+public:
+    using Variant = cetl::variant<Results...>;
+
+    explicit WhenAnyAwaiter(typename SenderOf<Results>::Ptr... senders)
+        : senders_{std::move(senders)...}
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(const std::coroutine_handle<> handle)
+    {
+        handle_ = handle;
+        submitAll(std::index_sequence_for<Results...>{});
+    }
+
+    Variant await_resume()
+    {
+        CETL_DEBUG_ASSERT(maybe_result_, "");
+        return std::move(*maybe_result_);
+    }
+
+private:
+    template <std::size_t... Is>
+    void submitAll(std::index_sequence<Is...>)
+    {
+        (submitOne<Is>(), ...);
+    }
+
+    template <std::size_t I>
+    void submitOne()
+    {
+        using Result = std::tuple_element_t<I, std::tuple<Results...>>;
+
+        std::get<I>(senders_)->submit([this](Result&& result) {
+            //
+            if (!maybe_result_)
+            {
+                maybe_result_.emplace(cetl::in_place_index<I>, std::move(result));
+                resumeLater(handle_);
+            }
+        });
+    }
+
+    std::tuple<typename SenderOf<Results>::Ptr...> senders_;
+    cetl::optional<Variant>                        maybe_result_;
+    std::coroutine_handle<>                        handle_;
+
+};  // WhenAnyAwaiter
+
+/// Defines common part of the `Task` coroutine promise.
+///
+class TaskPromiseBase
+{
+public:
+    struct FinalAwaiter final
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(const std::coroutine_handle<Promise> handle) const noexcept
+        {
+            // Symmetric transfer to the awaiting coroutine (if any).
+            const auto continuation = handle.promise().continuation_;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+
+    };  // FinalAwaiter
+
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    [[noreturn]] void unhandled_exception() const noexcept
+    {
+        // There is no support of async failures via C++ exceptions in the SDK.
+        std::terminate();
+    }
+
+    /// Makes a sender awaitable.
+    ///
+    template <typename Result>
+    SenderAwaiter<Result> await_transform(cetl::pmr::InterfacePtr<SenderOf<Result>>&& sender)
+    {
+        return SenderAwaiter<Result>{std::move(sender), *executor_};
+    }
+
+    /// Passes the executor of this coroutine to the awaitable (f.e. a nested task, or `when_all` awaiter).
+    ///
+    template <typename Awaitable>
+        requires requires(Awaitable& awaitable, libcyphal::IExecutor& executor) { awaitable.bindExecutor(executor); }
+    Awaitable&& await_transform(Awaitable&& awaitable) const noexcept
+    {
+        awaitable.bindExecutor(*executor_);
+        return std::forward<Awaitable>(awaitable);
+    }
+
+protected:
+    TaskPromiseBase() = default;
+
+private:
+    template <typename T>
+    friend class sdk::Task;
+
+    libcyphal::IExecutor*   executor_{nullptr};
+    std::coroutine_handle<> continuation_;
+
+};  // TaskPromiseBase
+
+template <typename T>
+class TaskPromise final : public TaskPromiseBase
+{
+public:
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& value)
+    {
+        maybe_result_.emplace(std::forward<U>(value));
+    }
+
+    T takeResult()
+    {
+        CETL_DEBUG_ASSERT(maybe_result_, "");
+        return std::move(*maybe_result_);
+    }
+
+private:
+    cetl::optional<T> maybe_result_;
+
+};  // TaskPromise
+
+template <>
+class TaskPromise<void> final : public TaskPromiseBase
+{
+public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void takeResult() const noexcept {}
+
+};  // TaskPromise<void>
+
+}  // namespace detail
+
+/// Defines a lazy coroutine of the SDK operations.
+///
+/// Within the coroutine, any `SenderOf<T>::Ptr` (f.e. a result of `NodeCommandClient::restart`) could be `co_await`-ed
+/// directly, as well as other tasks and `when_all`/`when_any` combinators. Awaited senders are consumed, their results
+/// are stored in the coroutine frame (no `shared_ptr` states), and the coroutine is resumed via the executor.
+///
+/// A task starts only when it's awaited (by another task) or synchronously waited (see `sync_wait`).
+/// The whole chain of tasks runs on the executor of the root one, so it should be spun by the same thread
+/// (as it's the case for other SDK functionality).
+///
+template <typename T>
+class Task final
+{
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+    Task(Task&& other) noexcept
+        : handle_{std::exchange(other.handle_, {})}
+    {
+    }
+
+    Task& operator=(Task&& other) noexcept
+    {
+        Task old{std::move(*this)};
+        handle_ = std::exchange(other.handle_, {});
+        return *this;
+    }
+
+    Task(const Task&)            = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task()
+    {
+        if (handle_)
+        {
+            handle_.destroy();
+        }
+    }
+
+    /// Starts this task as a root one (not awaited by another task).
+    ///
+    void start(libcyphal::IExecutor& executor)
+    {
+        bindExecutor(executor);
+        handle_.resume();
+    }
+
+    bool isDone() const noexcept
+    {
+        return handle_.done();
+    }
+
+    // MARK: Awaitable
+
+    void bindExecutor(libcyphal::IExecutor& executor) noexcept
+    {
+        handle_.promise().executor_ = &executor;
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    std::coroutine_handle<> await_suspend(const std::coroutine_handle<> continuation) noexcept
+    {
+        handle_.promise().continuation_ = continuation;
+        return handle_;  // Symmetric transfer - start the task.
+    }
+
+    T await_resume()
+    {
+        return handle_.promise().takeResult();
+    }
+
+private:
+    friend class detail::TaskPromise<T>;
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    explicit Task(const Handle handle)
+        : handle_{handle}
+    {
+    }
+
+    Handle handle_;
+
+};  // Task
+
+template <typename T>
+Task<T> detail::TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+}
+
+inline Task<void> detail::TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+}
+
+/// Makes an awaitable which submits all given senders concurrently, and completes when all of them are completed.
+///
+/// The awaitable result is a tuple of the senders' results (in the order of the senders).
+///
+template <typename... Results>
+detail::WhenAllAwaiter<Results...> when_all(cetl::pmr::InterfacePtr<SenderOf<Results>>... senders)
+{
+    return detail::WhenAllAwaiter<Results...>{std::move(senders)...};
+}
+
+/// Makes an awaitable which submits all given senders concurrently, and completes when any of them is completed.
+///
+/// The awaitable result is a variant whose index is the index of the first completed sender.
+/// The rest of the senders are destroyed (and so canceled) together with the awaitable.
+///
+template <typename... Results>
+detail::WhenAnyAwaiter<Results...> when_any(cetl::pmr::InterfacePtr<SenderOf<Results>>... senders)
+{
+    return detail::WhenAnyAwaiter<Results...>{std::move(senders)...};
+}
+
+/// Algorithm that synchronously waits for the task to complete.
+///
+/// Starts the task on the given executor, and spins the executor until the task is done.
+///
+template <typename T, typename Executor>
+T sync_wait(Executor& executor, Task<T>&& task)
+{
+    task.start(executor);
+
+    platform::waitPollingUntil(executor, [&task] { return task.isDone(); });
+
+    return task.await_resume();
+}
+
+}  // namespace sdk
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_SDK_COROUTINE_HPP_INCLUDED
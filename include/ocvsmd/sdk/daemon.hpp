@@ -37,6 +37,11 @@ public:
     /// @param executor The executor to use for the factory and its subcomponents.
     ///                 Instance of the executor must outlive the factory.
     ///                 Should support `IPosixExecutorExtension` interface (via `cetl::rtti`).
+    /// @param connection The IPC connection string to the daemon (f.e. "unix-abstract:org.opencyphal.ocvsmd.ipc").
+    ///                   All factories of the process made with the same memory resource, executor and connection
+    ///                   share one IPC connection (one socket), and multiplex their channels over it.
+    ///                   A lost connection is automatically restored (with a jittered exponential backoff);
+    ///                   requests in progress at the moment of the loss fail with a "disconnected" error.
     /// @return Shared pointer to the successfully created factory.
     ///         `nullptr` on failure (see logs for the reason of failure).
     ///
@@ -59,6 +64,18 @@ public:
     ///
     virtual NodeCommandClient::Ptr getNodeCommandClient() const = 0;
 
+    /// Makes a new entity which represents the Node Exec Command component of the given Cyphal network.
+    ///
+    /// The daemon might run several Cyphal networks at once (f.e. "udp" and "can" ones) - the parameterless
+    /// `getNodeCommandClient` above works with the primary one (the first configured), while this method
+    /// allows to reach any of them by name.
+    /// A client of a network which the daemon doesn't run fails its commands (on the daemon side).
+    ///
+    /// @param network The name of the network (f.e. "can").
+    /// @return Shared pointer to the client side of the Node Exec Command component. Never `nullptr`.
+    ///
+    virtual NodeCommandClient::Ptr getNodeCommandClient(const std::string& network) const = 0;
+
 protected:
     Daemon() = default;
 
@@ -9,75 +9,18 @@
 #include "ocvsmd/platform/defines.hpp"
 
 #include <cetl/pf17/cetlpf.hpp>
+#include <cetl/pmr/function.hpp>
+#include <cetl/pmr/interface_ptr.hpp>
 
-#include <functional>
+#include <cstddef>
 #include <memory>
+#include <utility>
 
 namespace ocvsmd
 {
 namespace sdk
 {
 
-/// Internal implementation details.
-/// Not supposed to be used directly by the users of the SDK.
-///
-namespace detail
-{
-
-// Defines various internal types for `sync_wait` implementation.
-//
-template <typename Result>
-class StateOf;
-//
-template <typename Result>
-class ReceiverOf final
-{
-public:
-    explicit ReceiverOf(std::shared_ptr<StateOf<Result>> state)
-        : state_{std::move(state)}
-    {
-    }
-
-    template <typename... Args>
-    void operator()(Args&&... args)
-    {
-        state_->maybe_result_.emplace(std::forward<Args>(args)...);
-    }
-
-private:
-    std::shared_ptr<StateOf<Result>> state_;
-
-};  // ReceiverOf
-//
-template <typename Result>
-class StateOf final : public std::enable_shared_from_this<StateOf<Result>>
-{
-public:
-    bool completed() const
-    {
-        return maybe_result_.has_value();
-    }
-
-    Result get()
-    {
-        CETL_DEBUG_ASSERT(maybe_result_, "");
-        return std::move(*maybe_result_);
-    }
-
-    ReceiverOf<Result> makeReceiver()
-    {
-        return ReceiverOf<Result>{this->shared_from_this()};
-    }
-
-private:
-    friend class ReceiverOf<Result>;
-
-    cetl::optional<Result> maybe_result_;
-
-};  // StateOf
-
-}  // namespace detail
-
 /// Abstract interface of a result sender.
 ///
 /// There is no (at least for now) support of async failures via C++ exceptions in the SDK.
@@ -88,14 +31,29 @@ template <typename Result_>
 class SenderOf
 {
 public:
-    /// Defines the shared pointer type for the interface.
+    /// Defines the unique pointer type for the interface.
+    ///
+    /// Senders are allocated from a memory resource (see `cetl::pmr::InterfaceFactory`) rather than the heap,
+    /// so the pointer carries its own deleter.
     ///
-    using Ptr = std::unique_ptr<SenderOf>;
+    using Ptr = cetl::pmr::InterfacePtr<SenderOf>;
 
     /// Defines the result type of the sender.
     ///
     using Result = Result_;
 
+    /// Defines max size of a receiver which could be submitted to the sender.
+    ///
+    static constexpr std::size_t ReceiverFootprint = sizeof(void*) * 8;
+
+    /// Defines the type-erased receiver of the sender's result.
+    ///
+    /// A receiver is stored in place (no heap allocation), so it should not be bigger than `ReceiverFootprint`
+    /// (it's checked at compile time). Typical receiver lambdas capture a few pointers or references;
+    /// if a bigger state is needed then it should be captured by pointer.
+    ///
+    using Receiver = cetl::pmr::function<void(Result&&), ReceiverFootprint>;
+
     // No copy/move semantics.
     SenderOf(SenderOf&&)                 = delete;
     SenderOf(const SenderOf&)            = delete;
@@ -106,17 +64,14 @@ public:
 
     /// Initiates an operation execution by submitting a given receiver to this sender.
     ///
-    /// @tparam Receiver The type of the receiver functor. Should be callable with the result of the sender.
+    /// @tparam Receiver_ The type of the receiver functor. Should be callable with the result of the sender.
     /// @param receiver The receiver of the sender's result.
     ///                 Method "consumes" the receiver (no longer usable after this call).
     ///
-    template <typename Receiver>
-    void submit(Receiver&& receiver)
+    template <typename Receiver_>
+    void submit(Receiver_&& receiver)
     {
-        submitImpl([receive = std::forward<Receiver>(receiver)](Result&& result) mutable {
-            //
-            receive(std::move(result));
-        });
+        submitImpl(Receiver{std::forward<Receiver_>(receiver)});
     }
 
 protected:
@@ -124,7 +79,7 @@ protected:
 
     /// Implementation extension point for the derived classes.
     ///
-    virtual void submitImpl(std::function<void(Result&&)>&& receiver) = 0;
+    virtual void submitImpl(Receiver&& receiver) = 0;
 
 };  // SenderOf
 
@@ -142,8 +97,8 @@ void submit(Sender& sender, Receiver&& receiver)
 ///
 /// The submit "consumes" the receiver (no longer usable after this call).
 ///
-template <typename Sender, typename Receiver>
-void submit(std::unique_ptr<Sender>& sender_ptr, Receiver&& receiver)
+template <typename Sender, typename Deleter, typename Receiver>
+void submit(std::unique_ptr<Sender, Deleter>& sender_ptr, Receiver&& receiver)
 {
     sender_ptr->submit(std::forward<Receiver>(receiver));
 }
@@ -151,17 +106,21 @@ void submit(std::unique_ptr<Sender>& sender_ptr, Receiver&& receiver)
 /// Algorithm that synchronously waits for the sender to emit result.
 ///
 /// This algorithm "consumes" the sender, meaning that the sender is no longer usable after this call.
+/// The sender is alive (owned by the caller) while waiting, so the result is received directly on the stack.
 ///
 template <typename Result, typename Executor, typename Sender>
 Result sync_wait(Executor& executor, Sender&& sender)
 {
-    auto state = std::make_shared<detail::StateOf<Result>>();
+    cetl::optional<Result> maybe_result;
 
-    submit(sender, state->makeReceiver());
+    submit(sender, [&maybe_result](Result&& result) {
+        //
+        maybe_result.emplace(std::move(result));
+    });
 
-    platform::waitPollingUntil(executor, [state] { return state->completed(); });
+    platform::waitPollingUntil(executor, [&maybe_result] { return maybe_result.has_value(); });
 
-    return state->get();
+    return std::move(*maybe_result);
 }
 
 }  // namespace sdk
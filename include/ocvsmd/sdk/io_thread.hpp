@@ -0,0 +1,145 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_SDK_IO_THREAD_HPP_INCLUDED
+#define OCVSMD_SDK_IO_THREAD_HPP_INCLUDED
+
+#include "daemon.hpp"
+#include "execution.hpp"
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace ocvsmd
+{
+namespace sdk
+{
+
+/// Defines a background I/O thread which drives the SDK on behalf of multithreaded applications.
+///
+/// Normally, the user of the SDK owns the executor, and has to make all SDK calls (and spin the executor)
+/// on one thread. Instead, the I/O thread owns its own executor and `Daemon` (made with this executor),
+/// and runs them on a dedicated thread. Work is posted to the I/O thread from any thread via a lock-free
+/// queue; results are delivered either right on the I/O thread, or via a caller-chosen result executor.
+///
+/// The `Daemon` (and all its clients and senders) must be used only on the I/O thread - i.e. from within
+/// posted tasks, sender factories of `submit` calls, and receivers invoked without a result executor.
+///
+class IoThread
+{
+public:
+    /// Defines the unique pointer type for the I/O thread.
+    ///
+    using Ptr = std::unique_ptr<IoThread>;
+
+    /// Defines a task which is executed on the I/O thread.
+    ///
+    using Task = std::function<void(Daemon& daemon)>;
+
+    /// Defines a caller-chosen executor of result deliveries.
+    ///
+    /// F.e. a function which posts the given action to the caller's own event loop or thread pool.
+    /// It's called on the I/O thread, so it must be thread-safe, and it should not block.
+    ///
+    using ResultExecutor = std::function<void(std::function<void()>&& action)>;
+
+    /// Creates a new I/O thread, and establishes a connection to the daemon.
+    ///
+    /// @param memory The memory resource to use for the daemon factory and its subcomponents.
+    ///               The memory resource must outlive the I/O thread, and must be thread-safe
+    ///               if it's also used by other threads.
+    /// @param connection The IPC connection string to the daemon (see `Daemon::make`).
+    /// @return Unique pointer to the successfully created (and already running) I/O thread.
+    ///         `nullptr` on failure (see logs for the reason of failure).
+    ///
+    CETL_NODISCARD static Ptr make(cetl::pmr::memory_resource& memory, const std::string& connection);
+
+    // No copy/move semantics.
+    IoThread(IoThread&&)                 = delete;
+    IoThread(const IoThread&)            = delete;
+    IoThread& operator=(IoThread&&)      = delete;
+    IoThread& operator=(const IoThread&) = delete;
+
+    /// Stops and joins the thread.
+    ///
+    /// Tasks which are still queued are dropped (not executed), and operations in progress are canceled
+    /// (their receivers are never called).
+    ///
+    virtual ~IoThread() = default;
+
+    /// Posts a task to be executed on the I/O thread. Safe to call from any thread.
+    ///
+    /// Tasks are executed in the order of posting (per posting thread).
+    ///
+    virtual void post(Task&& task) = 0;
+
+    /// Initiates an operation on the I/O thread, and delivers its result. Safe to call from any thread.
+    ///
+    /// @tparam Result The result type of the operation's sender.
+    /// @param make_sender Factory of the operation's sender - called on the I/O thread with the `Daemon`,
+    ///                    should return `typename SenderOf<Result>::Ptr` (f.e. `NodeCommandClient::restart`).
+    /// @param receiver The receiver of the operation's result. Should be copyable.
+    /// @param result_executor Optional executor of the result delivery. If empty, the receiver is called
+    ///                        right on the I/O thread.
+    ///
+    template <typename Result, typename MakeSender, typename Receiver>
+    void submit(MakeSender&& make_sender, Receiver&& receiver, ResultExecutor result_executor = {})
+    {
+        struct Delivery final
+        {
+            std::decay_t<Receiver> receiver;         // NOLINT
+            ResultExecutor         result_executor;  // NOLINT
+        };
+        auto delivery =
+            std::make_shared<Delivery>(Delivery{std::forward<Receiver>(receiver), std::move(result_executor)});
+
+        post([this, make_sender = std::forward<MakeSender>(make_sender), delivery](Daemon& daemon) mutable {
+            //
+            std::shared_ptr<SenderOf<Result>> sender{make_sender(daemon)};
+            const auto                        sender_id = retainSender(sender);
+
+            // Captures are kept small enough to fit the sender's in-place receiver storage.
+            sender->submit([this, sender_id, delivery](Result&& result) {
+                //
+                // The sender is calling us, so it can't be released right here - only on the next task.
+                post([this, sender_id](Daemon&) { releaseSender(sender_id); });
+
+                if (!delivery->result_executor)
+                {
+                    delivery->receiver(std::move(result));
+                    return;
+                }
+                auto result_ptr = std::make_shared<Result>(std::move(result));
+                delivery->result_executor([delivery, result_ptr] {
+                    //
+                    delivery->receiver(std::move(*result_ptr));
+                });
+            });
+        });
+    }
+
+protected:
+    IoThread() = default;
+
+    /// Keeps the given sender alive until it's released - at most until the I/O thread is destroyed.
+    ///
+    /// Called on the I/O thread only.
+    ///
+    virtual std::uint64_t retainSender(std::shared_ptr<void> sender)   = 0;
+    virtual void          releaseSender(const std::uint64_t sender_id) = 0;
+
+};  // IoThread
+
+}  // namespace sdk
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_SDK_IO_THREAD_HPP_INCLUDED
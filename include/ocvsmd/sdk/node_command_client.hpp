@@ -12,11 +12,15 @@
 
 #include <cetl/pf17/cetlpf.hpp>
 #include <cetl/pf20/cetlpf.hpp>
+#include <cetl/pmr/function.hpp>
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <unordered_map>
+#include <utility>
 
 namespace ocvsmd
 {
@@ -49,12 +53,93 @@ public:
         using NodeRequest  = uavcan::node::ExecuteCommand_1_3::Request;
         using NodeResponse = uavcan::node::ExecuteCommand_1_3::Response;
 
-        using Success = std::unordered_map<std::uint16_t, NodeResponse>;
+        /// Node responses are allocated from the memory resource of the client (and so is the map itself).
+        ///
+        using Success = std::unordered_map<  //
+            std::uint16_t,
+            NodeResponse,
+            std::hash<std::uint16_t>,
+            std::equal_to<std::uint16_t>,
+            cetl::pmr::polymorphic_allocator<std::pair<const std::uint16_t, NodeResponse>>>;
         using Failure = int;  // `errno`-like error code.
         using Result  = cetl::variant<Success, Failure>;
 
+        /// Defines max size of an observer which could be passed to `sendCommandStreaming` or `sendCommandBatch`.
+        ///
+        static constexpr std::size_t ObserverFootprint = sizeof(void*) * 4;
+
+        /// Defines observer of individual node responses of a streaming command (see `sendCommandStreaming`).
+        ///
+        /// Like a receiver, an observer is stored in place (no heap allocation), so it should not be bigger
+        /// than `ObserverFootprint` (it's checked at compile time).
+        ///
+        using NodeObserver =
+            cetl::pmr::function<void(const std::uint16_t node_id, NodeResponse&& node_response), ObserverFootprint>;
+
+        /// Defines the final result type of a streaming command execution.
+        ///
+        /// On success, the result is the number of node responses which were passed to the observer.
+        ///
+        using StreamSuccess = std::size_t;
+        using StreamResult  = cetl::variant<StreamSuccess, Failure>;
+
+        /// Defines a single item of a command batch (see `sendCommandBatch`).
+        ///
+        struct BatchItem final
+        {
+            /// The list of Cyphal node IDs to send the command to (up to 128). Duplicates are ignored.
+            cetl::span<const std::uint16_t> node_ids;
+            /// The Cyphal command request to send to the `node_ids`.
+            const NodeRequest& node_request;
+        };
+
+        /// Defines observer of individual node responses of a command batch (see `sendCommandBatch`).
+        ///
+        /// The `item_index` is the index of the corresponding item in the batch.
+        /// Same as `NodeObserver`, it's stored in place (so should not be bigger than `ObserverFootprint`).
+        ///
+        using BatchObserver = cetl::pmr::function<
+            void(const std::size_t item_index, const std::uint16_t node_id, NodeResponse&& node_response),
+            ObserverFootprint>;
+
+        /// Defines retry policy for nodes which didn't respond in time (see `setRetryPolicy`).
+        ///
+        /// Retries are done by the OCVSMD engine, only to the missing nodes, and within the overall timeout.
+        ///
+        struct RetryPolicy final
+        {
+            /// Total number of attempts per node (including the first one). Zero is the same as one.
+            std::uint8_t max_attempts{1};
+            /// Timeout of a single attempt. Zero means "till the overall timeout".
+            std::chrono::microseconds attempt_timeout{0};
+            /// Delay before each next attempt (counting from the failure of the previous one).
+            std::chrono::microseconds backoff{0};
+        };
+
     };  // Command
 
+    /// Sends a batch of Cyphal commands (each to its own subset of nodes), and streams node responses.
+    ///
+    /// All items of the batch are executed by the OCVSMD engine as a single request (over a single IPC channel)
+    /// under the one common `timeout`, so it's cheaper than sending the same commands one by one.
+    /// Each node response is passed to the `batch_observer` as soon as it has arrived.
+    ///
+    /// @param items The batch items (up to 16). Each item is a command and a list of nodes to send it to.
+    /// @param timeout The maximum time to wait for all Cyphal node responses to arrive.
+    /// @param batch_observer The observer of individual node responses.
+    /// @return An execution sender which emits the async overall completion of the operation.
+    ///
+    virtual SenderOf<Command::StreamResult>::Ptr sendCommandBatch(
+        const cetl::span<const Command::BatchItem> items,
+        const std::chrono::microseconds            timeout,
+        Command::BatchObserver                     batch_observer) = 0;
+
+    /// Sets retry policy for all subsequent commands of this client.
+    ///
+    /// By default, there are no retries - each node gets a single attempt which lasts till the overall timeout.
+    ///
+    virtual void setRetryPolicy(const Command::RetryPolicy& retry_policy) = 0;
+
     /// Sends a Cyphal command to the specified Cyphal network nodes.
     ///
     /// On the OCVSMD engine side, the `node_request` is sent concurrently to all specified Cyphal nodes.
@@ -70,6 +155,25 @@ public:
                                                        const Command::NodeRequest&           node_request,
                                                        const std::chrono::microseconds       timeout) = 0;
 
+    /// Sends a Cyphal command to the specified Cyphal network nodes, and streams their responses.
+    ///
+    /// Same as `sendCommand`, but instead of accumulating all responses into the final result,
+    /// each node response is passed to the `node_observer` as soon as it has arrived.
+    /// So the caller can act on early responders immediately, without waiting for the slowest node (or timeout).
+    /// The observer is called only after the sender has been submitted, and never after the final result.
+    ///
+    /// @param node_ids The list of Cyphal node IDs to send the command to. Duplicates are ignored.
+    /// @param node_request The Cyphal command request to send (aka broadcast) to the `node_ids`.
+    /// @param timeout The maximum time to wait for all Cyphal node responses to arrive.
+    /// @param node_observer The observer of individual node responses.
+    /// @return An execution sender which emits the async overall completion of the operation.
+    ///
+    virtual SenderOf<Command::StreamResult>::Ptr sendCommandStreaming(
+        const cetl::span<const std::uint16_t> node_ids,
+        const Command::NodeRequest&           node_request,
+        const std::chrono::microseconds       timeout,
+        Command::NodeObserver                 node_observer) = 0;
+
     /// A convenience method for invoking `sendCommand` with COMMAND_RESTART.
     ///
     /// @param node_ids The list of Cyphal node IDs to send the command to. Duplicates are ignored.
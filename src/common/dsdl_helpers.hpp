@@ -7,6 +7,7 @@
 #define OCVSMD_COMMON_DSDL_HELPERS_HPP_INCLUDED
 
 #include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
 #include <cetl/pf20/cetlpf.hpp>
 
 #include <array>
@@ -47,9 +48,12 @@ CETL_NODISCARD static int tryPerformOnSerialized(const Message& message, Action&
 }
 
 template <typename Message, std::size_t BufferSize, bool IsOnStack, typename Action>
-CETL_NODISCARD static auto tryPerformOnSerialized(const Message& message,
-                                                  Action&&       action) -> std::enable_if_t<IsOnStack, int>
+CETL_NODISCARD static auto tryPerformOnSerialized(const Message&              message,
+                                                  cetl::pmr::memory_resource& memory,
+                                                  Action&& action) -> std::enable_if_t<IsOnStack, int>
 {
+    (void) memory;
+
     // Try to serialize the message to raw payload buffer.
     //
     // Next nolint b/c we use a buffer to serialize the message, so no need to zero it (and performance better).
@@ -67,21 +71,29 @@ CETL_NODISCARD static auto tryPerformOnSerialized(const Message& message,
 }
 
 template <typename Message, std::size_t BufferSize, bool IsOnStack, typename Action>
-CETL_NODISCARD static auto tryPerformOnSerialized(const Message& message,
-                                                  Action&&       action) -> std::enable_if_t<!IsOnStack, int>
+CETL_NODISCARD static auto tryPerformOnSerialized(const Message&              message,
+                                                  cetl::pmr::memory_resource& memory,
+                                                  Action&& action) -> std::enable_if_t<!IsOnStack, int>
 {
     // Try to serialize the message to raw payload buffer.
     //
-    using ArrayOfBytes = std::array<std::uint8_t, BufferSize>;
-    const std::unique_ptr<ArrayOfBytes> buffer{new ArrayOfBytes};
+    // The buffer is too big for the stack, so it's taken from the memory resource (rather than the heap).
+    const auto deleter = [&memory](std::uint8_t* const ptr) { memory.deallocate(ptr, BufferSize); };
+    const std::unique_ptr<std::uint8_t, decltype(deleter)> buffer{  //
+        static_cast<std::uint8_t*>(memory.allocate(BufferSize)),
+        deleter};
+    if (!buffer)
+    {
+        return ENOMEM;
+    }
     //
-    const auto result_size = serialize(message, {buffer->data(), buffer->size()});
+    const auto result_size = serialize(message, {buffer.get(), BufferSize});
     if (!result_size)
     {
         return EINVAL;
     }
 
-    const cetl::span<const std::uint8_t> bytes{buffer->data(), result_size.value()};
+    const cetl::span<const std::uint8_t> bytes{buffer.get(), result_size.value()};
     return std::forward<Action>(action)(bytes);
 }
 
@@ -41,6 +41,14 @@ public:
         ErrorCode error_code;
     };
 
+    /// Delivered (instead of `Connected`) to a resumable channel which has survived a reconnection.
+    ///
+    /// The server side of the channel is gone together with the previous connection, so the channel owner
+    /// has to re-establish its state at the server (f.e. by re-sending its initial request).
+    ///
+    struct Resumed final
+    {};
+
     /// Builds a service ID from either the service name (if not empty), or message type name.
     ///
     template <typename Message>
@@ -70,6 +78,9 @@ protected:
 /// but client could also complete the channel. Any unexpected IPC communication error (like f.e. sudden death of
 /// either client or server process) also leads to channel completion (with `ipc::ErrorCode::Disconnected` error).
 ///
+/// A client-side channel could opt in to survive reconnections of the IPC pipe (see `enableResumption`).
+/// A server-side channel could opt in to handle back-pressure of the IPC pipe on its own (see `enableBackPressure`).
+///
 /// Channel could be moved, but not copied.
 /// Channel lifetime is managed by its owner - an IPC service client or server.
 ///
@@ -80,7 +91,7 @@ public:
     using Input  = Input_;
     using Output = Output_;
 
-    using EventVar     = cetl::variant<Connected, Input, Completed>;
+    using EventVar     = cetl::variant<Connected, Input, Completed, Resumed>;
     using EventHandler = std::function<void(const EventVar&)>;
 
     // Move-only.
@@ -99,12 +110,23 @@ public:
 
         return tryPerformOnSerialized<Output, BufferSize, IsOnStack>(  //
             output,
+            memory_,
             [this](const auto payload) {
                 //
                 return gateway_->send(service_id_, payload);
             });
     }
 
+    /// Sends an already serialized `Output` message.
+    ///
+    /// Useful when the same message is sent to many channels (f.e. a fan-out of a subscription) -
+    /// it could be serialized only once, and then shared between all of them.
+    ///
+    CETL_NODISCARD int sendSerialized(const Payload payload)
+    {
+        return gateway_->send(service_id_, payload);
+    }
+
     void complete(const int error_code = 0)
     {
         return gateway_->complete(error_code);
@@ -122,10 +144,35 @@ public:
         }
         else
         {
-            gateway_->subscribe(nullptr);
+            gateway_->subscribe(detail::Gateway::EventHandler{});
         }
     }
 
+    /// Makes this channel resumable - it won't be completed on a loss of the IPC connection.
+    ///
+    /// Instead, the channel waits for the connection to be restored, and then gets either `Connected` event
+    /// (if nothing has been sent via the channel yet, so the server never knew about it),
+    /// or `Resumed` event (if the channel has to re-establish its state at the server).
+    /// Should be enabled only for channels whose requests are safe to repeat (f.e. subscriptions).
+    /// Has no effect for server-side channels.
+    ///
+    void enableResumption()
+    {
+        gateway_->enableResumption();
+    }
+
+    /// Makes this channel aware of back-pressure of the IPC pipe.
+    ///
+    /// By default, messages sent while the pipe's connection is busy are queued by the pipe (up to its limit).
+    /// With back-pressure enabled, such messages are refused instead (`send` fails with `EAGAIN`), and it's up to
+    /// the channel owner to retry later (f.e. a subscription which keeps its own bounded queue of messages).
+    /// Has no effect for client-side channels.
+    ///
+    void enableBackPressure()
+    {
+        gateway_->enableBackPressure();
+    }
+
 private:
     friend class ClientRouter;
     friend class ServerRouter;
@@ -162,6 +209,12 @@ private:
             return 0;
         }
 
+        CETL_NODISCARD int operator()(const GatewayEvent::Resumed&) const
+        {
+            ch_event_handler(Resumed{});
+            return 0;
+        }
+
     };  // Adapter
 
     Channel(cetl::pmr::memory_resource& memory, detail::Gateway::Ptr gateway, const detail::ServiceDesc::Id service_id)
@@ -196,6 +249,15 @@ struct fmt::formatter<ocvsmd::common::ipc::AnyChannel::Connected> : formatter<st
     }
 };
 
+template <>
+struct fmt::formatter<ocvsmd::common::ipc::AnyChannel::Resumed> : formatter<string_view>
+{
+    auto format(ocvsmd::common::ipc::AnyChannel::Resumed, format_context& ctx) const
+    {
+        return formatter<string_view>::format("Resumed", ctx);
+    }
+};
+
 template <>
 struct fmt::formatter<ocvsmd::common::ipc::AnyChannel::Completed> : formatter<std::string>
 {
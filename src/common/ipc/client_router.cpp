@@ -24,6 +24,7 @@
 
 #include <cerrno>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <utility>
@@ -41,7 +42,8 @@ namespace
 /// Defines implementation of the IPC client-side router.
 ///
 /// It subscribes to the client pipe events and dispatches them to corresponding target gateway (by matching tags).
-/// In case of the pipe disconnection, it is broadcast-ed to all currently existing gateways (aka channels).
+/// In case of the pipe disconnection, it is broadcast-ed to all currently existing gateways (aka channels),
+/// except resumable ones - these stay registered (with their tags), and get notified when the pipe is reconnected.
 ///
 class ClientRouterImpl final : public ClientRouter
 {
@@ -52,6 +54,7 @@ public:
         , logger_{getLogger("ipc")}
         , next_tag_{0}
         , is_connected_{false}
+        , map_of_gateways_{MapOfWeakGateways::allocator_type{&memory_}}
     {
         CETL_DEBUG_ASSERT(client_pipe_, "");
     }
@@ -108,7 +111,11 @@ private:
     public:
         CETL_NODISCARD static std::shared_ptr<GatewayImpl> create(ClientRouterImpl& router, const Endpoint& endpoint)
         {
-            return std::make_shared<GatewayImpl>(Private(), router, endpoint);
+            // A gateway is made per each new channel, so it's allocated from the memory resource (not the heap).
+            return std::allocate_shared<GatewayImpl>(cetl::pmr::polymorphic_allocator<GatewayImpl>{&router.memory_},
+                                                     Private(),
+                                                     router,
+                                                     endpoint);
         }
 
         GatewayImpl(Private, ClientRouterImpl& router, const Endpoint& endpoint)
@@ -181,17 +188,58 @@ private:
             router_.onGatewaySubscription(endpoint_);
         }
 
+        void enableResumption() override
+        {
+            is_resumable_ = true;
+        }
+
+        void enableBackPressure() override
+        {
+            // Nothing to do here - client requests are always queued by the pipe.
+        }
+
+        CETL_NODISCARD bool isResumable() const noexcept
+        {
+            return is_resumable_;
+        }
+
+        /// Prepares the gateway to survive the pipe disconnection.
+        ///
+        /// The server side counterpart (if any) is gone, so the next sequence starts from scratch,
+        /// and the gateway should be notified with `Resumed` event (instead of `Connected`) on reconnection.
+        /// `next_sequence_ == 0` means that the server never knew about this gateway - nothing to resume.
+        ///
+        void suspend() noexcept
+        {
+            is_resuming_   = next_sequence_ > 0;
+            next_sequence_ = 0;
+        }
+
+        CETL_NODISCARD Event::Var makeConnectedEvent() noexcept
+        {
+            const bool was_resuming = is_resuming_;
+            is_resuming_            = false;
+            return was_resuming ? Event::Var{Event::Resumed{}} : Event::Var{Event::Connected{}};
+        }
+
     private:
         ClientRouterImpl& router_;
         const Endpoint    endpoint_;
         std::uint64_t     next_sequence_;
         EventHandler      event_handler_;
         int               completion_error_code_;
+        bool              is_resumable_{false};
+        bool              is_resuming_{false};
 
     };  // GatewayImpl
 
     // Lifetime of a gateway is strictly managed by its channel. But router needs to "weakly" keep track of them.
-    using MapOfWeakGateways = std::unordered_map<Endpoint::Tag, detail::Gateway::WeakPtr>;
+    using MapOfWeakGateways = std::unordered_map<  //
+        Endpoint::Tag,
+        std::weak_ptr<GatewayImpl>,
+        std::hash<Endpoint::Tag>,
+        std::equal_to<Endpoint::Tag>,
+        cetl::pmr::polymorphic_allocator<std::pair<const Endpoint::Tag, std::weak_ptr<GatewayImpl>>>>;
 
     CETL_NODISCARD bool isConnected(const Endpoint&) const noexcept
     {
@@ -225,7 +273,7 @@ private:
         // Calling an action might indirectly modify the map, so we first
         // collect strong pointers to gateways into a local collection.
         //
-        std::vector<detail::Gateway::Ptr> gateway_ptrs;
+        std::vector<std::shared_ptr<GatewayImpl>> gateway_ptrs;
         gateway_ptrs.reserve(map_of_gateways_.size());
         for (const auto& tag_to_gw : map_of_gateways_)
         {
@@ -247,7 +295,7 @@ private:
         {
             const int err = findAndActOnRegisteredGateway(endpoint, [](auto& gateway, auto) {
                 //
-                return gateway.event(detail::Gateway::Event::Connected{});
+                return gateway.event(gateway.makeConnectedEvent());
             });
             (void) err;  // Best efforts strategy.
         }
@@ -341,18 +389,32 @@ private:
         {
             is_connected_ = false;
 
-            // The whole router is disconnected, so we need to unregister and notify all gateways.
+            // The whole router is disconnected, so we need to unregister and notify all gateways,
+            // except resumable ones - they are kept registered until the pipe is reconnected.
             //
-            MapOfWeakGateways local_map_of_gateways;
+            MapOfWeakGateways local_map_of_gateways{MapOfWeakGateways::allocator_type{&memory_}};
             std::swap(local_map_of_gateways, map_of_gateways_);
+            std::vector<std::shared_ptr<GatewayImpl>> completed_gateways;
             for (const auto& tag_to_gw : local_map_of_gateways)
             {
                 if (const auto gateway = tag_to_gw.second.lock())
                 {
-                    const int err = gateway->event(detail::Gateway::Event::Completed{ErrorCode::Disconnected});
-                    (void) err;  // Best efforts strategy.
+                    if (gateway->isResumable())
+                    {
+                        gateway->suspend();
+                        map_of_gateways_.emplace(tag_to_gw);
+                    }
+                    else
+                    {
+                        completed_gateways.push_back(gateway);
+                    }
                 }
             }
+            for (const auto& gateway : completed_gateways)
+            {
+                const int err = gateway->event(detail::Gateway::Event::Completed{ErrorCode::Disconnected});
+                (void) err;  // Best efforts strategy.
+            }
         }
 
         // It's fine to be already disconnected.
@@ -371,10 +433,11 @@ private:
             is_connected_ = true;
 
             // We've got connection response from the server, so we need to notify all local gateways.
+            // Resumable gateways which have survived a reconnection might be notified as resumed.
             //
             forEachRegisteredGateway([](auto& gateway) {
                 //
-                const int err = gateway.event(detail::Gateway::Event::Connected{});
+                const int err = gateway.event(gateway.makeConnectedEvent());
                 (void) err;  // Best efforts strategy.
             });
         }
@@ -11,6 +11,7 @@
 #include <cetl/cetl.hpp>
 #include <cetl/pf17/cetlpf.hpp>
 #include <cetl/pf20/cetlpf.hpp>
+#include <cetl/pmr/function.hpp>
 
 #include <cstdint>
 #include <functional>
@@ -59,12 +60,20 @@ public:
             std::uint64_t sequence;
             Payload       payload;
         };
+        struct Resumed final
+        {};
 
-        using Var = cetl::variant<Connected, Message, Completed>;
+        using Var = cetl::variant<Connected, Message, Completed, Resumed>;
 
     };  // Event
 
-    using EventHandler = std::function<int(const Event::Var&)>;
+    /// Defines the type-erased handler of the gateway events.
+    ///
+    /// A channel adapts its own event handler into this one (see `Channel::subscribe`), so it's stored in place
+    /// (no heap allocation), and it's big enough for one `std::function` plus a couple of pointers.
+    ///
+    using EventHandler =
+        cetl::pmr::function<int(const Event::Var&), sizeof(std::function<void()>) + (sizeof(void*) * 2)>;
 
     // No copying or moving.
     Gateway(const Gateway&)                = delete;
@@ -76,6 +85,8 @@ public:
     virtual void               complete(int error_code)                                      = 0;
     CETL_NODISCARD virtual int event(const Event::Var& event)                                = 0;
     virtual void               subscribe(EventHandler event_handler)                         = 0;
+    virtual void               enableResumption()                                            = 0;
+    virtual void               enableBackPressure()                                          = 0;
 
 protected:
     Gateway()  = default;
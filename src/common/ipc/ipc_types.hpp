@@ -24,10 +24,11 @@ namespace ipc
 ///
 enum class ErrorCode : int  // NOLINT
 {
-    Success      = 0,
-    NotConnected = ENOTCONN,
-    Disconnected = ECONNRESET,
-    Shutdown     = ESHUTDOWN,
+    Success        = 0,
+    NotConnected   = ENOTCONN,
+    Disconnected   = ECONNRESET,
+    Shutdown       = ESHUTDOWN,
+    UnknownService = ENOSYS,
 
 };  // ErrorCode
 
@@ -63,11 +63,24 @@ public:
         fd_callback_ = std::move(fd_callback);
     }
 
+    /// Sets (or resets) the callback which flushes rest of the partially sent message when the socket is writable.
+    ///
+    void setWriteCallback(libcyphal::IExecutor::Callback::Any&& write_callback)
+    {
+        write_callback_ = std::move(write_callback);
+    }
+
+    bool isAwaitingWritable() const noexcept
+    {
+        return static_cast<bool>(write_callback_);
+    }
+
 private:
     const ServerPipe::ClientId          id_;
     Logger&                             logger_;
     SocketBase::State                   state_;
     libcyphal::IExecutor::Callback::Any fd_callback_;
+    libcyphal::IExecutor::Callback::Any write_callback_;
 
 };  // ClientContext
 
@@ -63,9 +63,21 @@ public:
 
     virtual ~ServerPipe() = default;
 
-    CETL_NODISCARD virtual int start(EventHandler event_handler)                       = 0;
+    CETL_NODISCARD virtual int start(EventHandler event_handler) = 0;
+
+    /// Sends the message (all its payload fragments) to the client as a single frame.
+    ///
+    /// A busy connection doesn't refuse the message - instead, it's queued (up to a per connection limit)
+    /// behind the not yet written ones. So, one busy channel doesn't block others of the same client.
+    ///
     CETL_NODISCARD virtual int send(const ClientId client_id, const Payloads payloads) = 0;
 
+    /// Same as `send`, but the message is refused (with `EAGAIN`) if the connection is busy.
+    ///
+    /// Used by channels which have opted in to handle back-pressure on their own (see `Channel::enableBackPressure`).
+    ///
+    CETL_NODISCARD virtual int trySend(const ClientId client_id, const Payloads payloads) = 0;
+
 protected:
     ServerPipe() = default;
 
@@ -16,12 +16,13 @@
 #include <cstdint>
 #include <cstring>
 #include <functional>
-#include <memory>
 #include <numeric>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <utility>
+#include <vector>
 
 namespace ocvsmd
 {
@@ -39,16 +40,40 @@ struct MsgHeader final
     std::uint32_t signature;
     std::uint32_t size;
 };
+static_assert(sizeof(MsgHeader) == SocketBase::State::MsgHeaderSize, "");
 
 constexpr std::size_t   MsgSmallPayloadSize = 256;
-constexpr std::uint32_t MsgSignature        = 0x5356434F;     // 'OCVS'
-constexpr std::size_t   MsgMaxSize          = 1ULL << 20ULL;  // 1 MB
+constexpr std::size_t   MsgMaxFragments     = 4;
+constexpr std::uint32_t MsgSignature        = 0x5356434F;      // 'OCVS'
+constexpr std::size_t   MsgMaxSize          = 1ULL << 20ULL;   // 1 MB
+constexpr std::size_t   MsgMaxPendingSize   = 2 * MsgMaxSize;  // 2 MB (per connection)
+
+bool isWouldBlock(const int err)
+{
+    return (err == EAGAIN) || (err == EWOULDBLOCK);
+}
 
 }  // namespace
 
-int SocketBase::send(const State& state, const Payloads payloads)
+int SocketBase::send(State& state, const Payloads payloads)
+{
+    return sendFrame(state, payloads, true);
+}
+
+int SocketBase::trySend(State& state, const Payloads payloads)
 {
-    // 1. Write the message header (signature and total size of the following fragments).
+    return sendFrame(state, payloads, false);
+}
+
+int SocketBase::sendFrame(State& state, const Payloads payloads, const bool can_queue)
+{
+    if (payloads.size() >= MsgMaxFragments)
+    {
+        return EINVAL;
+    }
+
+    // 1. Make the message header (signature and total size of the following fragments),
+    //    and the message payload fragments - to be written all at once.
     //
     const std::size_t total_size = std::accumulate(  // NOLINT
         payloads.begin(),
@@ -58,63 +83,173 @@ int SocketBase::send(const State& state, const Payloads payloads)
             //
             return acc + payload.size();
         });
-    if (const int err = platform::posixSyscallError([total_size, &state] {
+    const MsgHeader msg_header{MsgSignature, static_cast<std::uint32_t>(total_size)};
+
+    std::array<iovec, MsgMaxFragments> iovecs{};
+    std::size_t                        iov_count = 1;
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-const-cast, *-constant-array-index)
+    iovecs[0] = {const_cast<MsgHeader*>(&msg_header), sizeof(msg_header)};
+    for (const auto payload : payloads)
+    {
+        iovecs[iov_count++] = {const_cast<std::uint8_t*>(payload.data()), payload.size()};
+    }
+    // NOLINTEND(cppcoreguidelines-pro-type-const-cast, *-constant-array-index)
+
+    // Appends the rest of the frame (past the first `skip_bytes`) to the pending bytes.
+    const auto append_pending = [&state, &iovecs, iov_count](std::size_t skip_bytes) {
+        //
+        for (std::size_t i = 0; i < iov_count; ++i)
+        {
+            const auto& iov = iovecs[i];  // NOLINT(*-constant-array-index)
+            if (skip_bytes >= iov.iov_len)
+            {
+                skip_bytes -= iov.iov_len;
+                continue;
+            }
+            const auto* const base = static_cast<const std::uint8_t*>(iov.iov_base);
+            state.write_pending.insert(state.write_pending.end(), base + skip_bytes, base + iov.iov_len);
+            skip_bytes = 0;
+        }
+    };
+
+    // Queues the whole frame behind the pending bytes (if allowed, and there is still room for it).
+    const auto queue_frame = [&state, &append_pending, can_queue, total_size](const int would_block_err) {
+        //
+        if (!can_queue)
+        {
+            return would_block_err;
+        }
+        if ((state.pendingWriteSize() + sizeof(MsgHeader) + total_size) > MsgMaxPendingSize)
+        {
+            return ENOBUFS;
+        }
+
+        // Already written bytes are dropped first - so that the pending buffer doesn't grow forever.
+        state.write_pending.erase(state.write_pending.begin(),
+                                  state.write_pending.begin() + static_cast<std::ptrdiff_t>(state.write_offset));
+        state.write_offset = 0;
+
+        append_pending(0);
+        return 0;
+    };
+
+    // 2. Nothing new is written until all pending bytes are flushed - otherwise frames would interleave.
+    //
+    if (const int err = flushPending(state))
+    {
+        return isWouldBlock(err) ? queue_frame(err) : err;
+    }
+
+    msghdr msg{};
+    msg.msg_iov    = iovecs.data();
+    msg.msg_iovlen = iov_count;
+
+    ssize_t bytes_sent = 0;
+    if (const int err = platform::posixSyscallError([&state, &msg, &bytes_sent] {
             //
-            const MsgHeader msg_header{MsgSignature, static_cast<std::uint32_t>(total_size)};
-            return ::send(state.fd.get(), &msg_header, sizeof(msg_header), MSG_DONTWAIT);
+            return bytes_sent = ::sendmsg(state.fd.get(), &msg, MSG_DONTWAIT);
         }))
     {
-        return err;
+        // Nothing has been written, so the stream is still in sync.
+        return isWouldBlock(err) ? queue_frame(err) : err;
     }
 
-    // 2. Write the message payload fragments.
+    // 3. The socket might have accepted only a part of the frame - its rest is kept to be flushed later.
     //
-    for (const auto payload : payloads)
+    append_pending(static_cast<std::size_t>(bytes_sent));
+    return 0;
+}
+
+int SocketBase::flushPending(State& state)
+{
+    while (state.hasPendingWrite())
     {
-        if (const int err = platform::posixSyscallError([payload, &state] {
+        ssize_t bytes_sent = 0;
+        if (const int err = platform::posixSyscallError([&state, &bytes_sent] {
                 //
-                return ::send(state.fd.get(), payload.data(), payload.size(), MSG_DONTWAIT);
+                return bytes_sent = ::send(state.fd.get(),
+                                           state.write_pending.data() + state.write_offset,
+                                           state.write_pending.size() - state.write_offset,
+                                           MSG_DONTWAIT);
             }))
         {
             return err;
         }
+        state.write_offset += static_cast<std::size_t>(bytes_sent);
     }
+
+    state.write_offset = 0;
+    std::vector<std::uint8_t>{}.swap(state.write_pending);
     return 0;
 }
 
+int SocketBase::receiveSome(const State& state, const cetl::span<std::uint8_t> buffer, std::size_t& received)
+{
+    ssize_t bytes_read = 0;
+    if (const auto err = platform::posixSyscallError([&state, buffer, &bytes_read] {
+            //
+            return bytes_read = ::recv(state.fd.get(), buffer.data(), buffer.size(), MSG_DONTWAIT);
+        }))
+    {
+        received = 0;
+        if ((err == EAGAIN) || (err == EWOULDBLOCK))
+        {
+            return 0;  // no data available yet
+        }
+        return err;
+    }
+    if (bytes_read == 0)
+    {
+        return -1;  // EOF
+    }
+
+    received = static_cast<std::size_t>(bytes_read);
+    return 0;
+}
+
+void SocketBase::logPayloadError(const State& state, const int err) const
+{
+    if (err != -1)  // not EOF?
+    {
+        logger_->error("Failed to read message payload (fd={}): {}.", state.fd.get(), std::strerror(err));
+    }
+}
+
 int SocketBase::receiveMessage(State& state, std::function<int(Payload)>&& action) const
 {
     // 1. Receive and validate the message header.
+    //    It might arrive in several parts (as well as the payload) - received so far bytes are kept in the state.
     //
     if (state.read_phase == State::ReadPhase::Header)
     {
-        MsgHeader msg_header{};
-        ssize_t   bytes_read = 0;
-        if (const auto err = platform::posixSyscallError([&state, &msg_header, &bytes_read] {
-                //
-                return bytes_read = ::recv(state.fd.get(), &msg_header, sizeof(msg_header), MSG_DONTWAIT);
-            }))
+        std::size_t received = 0;
+        if (const auto err = receiveSome(  //
+                state,
+                {state.read_header.data() + state.read_offset, state.read_header.size() - state.read_offset},
+                received))
         {
-            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            if (err != -1)  // not EOF?
             {
-                return 0;  // no data available yet
+                logger_->error("Failed to read message header (fd={}): {}.", state.fd.get(), std::strerror(err));
             }
-            logger_->error("Failed to read message header (fd={}): {}.", state.fd.get(), std::strerror(err));
             return err;
         }
-
-        if (bytes_read == 0)
+        state.read_offset += received;
+        if (state.read_offset < state.read_header.size())
         {
-            return -1;  // EOF
+            return 0;  // the rest of the header is not available yet
         }
 
-        if ((bytes_read != sizeof(msg_header)) || (msg_header.signature != MsgSignature)  //
-            || (msg_header.size == 0) || (msg_header.size > MsgMaxSize))
+        MsgHeader msg_header{};
+        std::memcpy(&msg_header, state.read_header.data(), sizeof(msg_header));
+        if ((msg_header.signature != MsgSignature) || (msg_header.size == 0) || (msg_header.size > MsgMaxSize))
         {
             return EINVAL;
         }
 
         state.read_msg_size = msg_header.size;
+        state.read_offset   = 0;
         state.read_phase    = State::ReadPhase::Payload;
     }
 
@@ -122,41 +257,52 @@ int SocketBase::receiveMessage(State& state, std::function<int(Payload)>&& actio
     //
     if (state.read_phase == State::ReadPhase::Payload)
     {
-        auto read_and_act = [this, &state, act = std::move(action)](  //
-                                const cetl::span<std::uint8_t> buf_span) {
-            //
-            ssize_t read = 0;
-            if (const auto err = platform::posixSyscallError([this, &state, buf_span, &read] {
-                    //
-                    return read = ::recv(state.fd.get(), buf_span.data(), buf_span.size(), MSG_DONTWAIT);
-                }))
+        // Small payload, which is available as a whole, is received right into the stack buffer.
+        //
+        if ((state.read_offset == 0) && (state.read_msg_size <= MsgSmallPayloadSize))
+        {
+            std::array<std::uint8_t, MsgSmallPayloadSize> buffer;  // NOLINT(*-member-init)
+            std::size_t                                   received = 0;
+            if (const auto err = receiveSome(state, {buffer.data(), state.read_msg_size}, received))
             {
-                if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
-                {
-                    return 0;  // no data available
-                }
-                logger_->error("Failed to read message payload (fd={}): {}.", state.fd.get(), std::strerror(err));
+                logPayloadError(state, err);
                 return err;
             }
-            if (read != buf_span.size())
+            if (received == state.read_msg_size)
             {
-                return EINVAL;
+                state.read_phase = State::ReadPhase::Header;
+                return action({buffer.data(), received});
             }
+            state.read_payload.assign(buffer.data(), buffer.data() + received);
+            state.read_offset = received;
+            return 0;
+        }
 
-            state.read_phase = State::ReadPhase::Header;
-
-            const cetl::span<const std::uint8_t> const_buf_span{buf_span};
-            return act(const_buf_span);
-        };
-        if (state.read_msg_size <= MsgSmallPayloadSize)  // on stack buffer?
+        // Otherwise, the payload is accumulated in the state (until all of it is received).
+        //
+        state.read_payload.resize(state.read_msg_size);
+        std::size_t received = 0;
+        if (const auto err = receiveSome(  //
+                state,
+                {state.read_payload.data() + state.read_offset, state.read_payload.size() - state.read_offset},
+                received))
         {
-            std::array<std::uint8_t, MsgSmallPayloadSize> buffer;  // NOLINT(*-member-init)
-            return read_and_act({buffer.data(), state.read_msg_size});
+            logPayloadError(state, err);
+            return err;
+        }
+        state.read_offset += received;
+        if (state.read_offset < state.read_msg_size)
+        {
+            return 0;  // the rest of the payload is not available yet
         }
 
-        // NOLINTNEXTLINE(*-avoid-c-arrays)
-        const std::unique_ptr<std::uint8_t[]> buffer{new std::uint8_t[state.read_msg_size]};
-        return read_and_act({buffer.get(), state.read_msg_size});
+        state.read_offset = 0;
+        state.read_phase  = State::ReadPhase::Header;
+
+        // The action might reset the state (f.e. on disconnection), hence the payload is moved out of it.
+        const std::vector<std::uint8_t> payload{std::move(state.read_payload)};
+        state.read_payload.clear();
+        return action({payload.data(), payload.size()});
     }
 
     return 0;
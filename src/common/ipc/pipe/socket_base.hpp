@@ -12,10 +12,12 @@
 
 #include <cetl/cetl.hpp>
 
+#include <array>
 #include <cerrno>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <vector>
 
 namespace ocvsmd
 {
@@ -29,6 +31,13 @@ namespace pipe
 class SocketBase
 {
 public:
+    /// Holds state of a socket stream.
+    ///
+    /// Both reads and writes of a non-blocking stream socket might be partial - so the state keeps what
+    /// was received so far of the current message (header or payload), and the not yet written rest
+    /// of the latest sent message. Otherwise, the stream of message frames would get out of sync.
+    /// Whole frames sent while the socket is busy are queued right behind that rest (see `SocketBase::send`).
+    ///
     struct State final
     {
         enum class ReadPhase : std::uint8_t
@@ -37,9 +46,39 @@ public:
             Payload
         };
 
-        io::OwnFd   fd{};
-        std::size_t read_msg_size{0};
-        ReadPhase   read_phase{ReadPhase::Header};
+        /// Size of the message header (signature and size of the payload).
+        static constexpr std::size_t MsgHeaderSize = 8;
+
+        io::OwnFd                               fd{};
+        std::size_t                             read_msg_size{0};
+        ReadPhase                               read_phase{ReadPhase::Header};
+        std::size_t                             read_offset{0};
+        std::array<std::uint8_t, MsgHeaderSize> read_header{};
+        std::vector<std::uint8_t>               read_payload;
+        std::size_t                             write_offset{0};
+        std::vector<std::uint8_t>               write_pending;
+
+        bool hasPendingWrite() const noexcept
+        {
+            return write_offset < write_pending.size();
+        }
+
+        std::size_t pendingWriteSize() const noexcept
+        {
+            return write_pending.size() - write_offset;
+        }
+
+        /// Resets the stream state (f.e. on reconnection) - the file descriptor is left intact.
+        ///
+        void resetStream()
+        {
+            read_msg_size = 0;
+            read_phase    = ReadPhase::Header;
+            read_offset   = 0;
+            write_offset  = 0;
+            std::vector<std::uint8_t>{}.swap(read_payload);
+            std::vector<std::uint8_t>{}.swap(write_pending);
+        }
 
     };  // State
 
@@ -57,11 +96,33 @@ protected:
         return *logger_;
     }
 
-    CETL_NODISCARD static int send(const State& state, const Payloads payloads);
+    /// Sends the message (all its payload fragments) as a single frame.
+    ///
+    /// The frame is either accepted as a whole, or not at all. If the socket has accepted only a part of the frame,
+    /// its rest is kept in the state (and flushed later). If the socket would block (or something is still pending),
+    /// the whole frame is queued behind the pending bytes - so one busy channel never blocks the others
+    /// multiplexed over the same connection. The queue is bounded - `ENOBUFS` is returned on its overflow.
+    ///
+    CETL_NODISCARD static int send(State& state, const Payloads payloads);
+
+    /// Same as `send`, but never queues - the frame is refused (with `EAGAIN`) if the socket would block,
+    /// or something is still pending. For senders which handle back-pressure on their own.
+    ///
+    CETL_NODISCARD static int trySend(State& state, const Payloads payloads);
+
+    /// Tries to write the rest of the partially sent message (if any).
+    ///
+    /// @return Zero if nothing is pending anymore, `EAGAIN` if the socket would still block, or other error.
+    ///
+    CETL_NODISCARD static int flushPending(State& state);
 
     CETL_NODISCARD int receiveMessage(State& state, std::function<int(Payload)>&& action) const;
 
 private:
+    CETL_NODISCARD static int sendFrame(State& state, const Payloads payloads, const bool can_queue);
+    CETL_NODISCARD static int receiveSome(const State& state, cetl::span<std::uint8_t> buffer, std::size_t& received);
+    void                      logPayloadError(const State& state, const int err) const;
+
     LoggerPtr logger_{getLogger("ipc")};
 
 };  // SocketBase
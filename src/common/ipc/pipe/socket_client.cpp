@@ -14,9 +14,13 @@
 #include <cetl/rtti.hpp>
 #include <libcyphal/executor.hpp>
 
+#include <algorithm>
 #include <cerrno>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <random>
 #include <sys/socket.h>
 #include <unistd.h>
 #include <utility>
@@ -30,9 +34,17 @@ namespace ipc
 namespace pipe
 {
 
-SocketClient::SocketClient(libcyphal::IExecutor& executor, const io::SocketAddress& address)
-    : socket_address_{address}
+constexpr std::uint32_t SocketClient::MaxBackoffShift;
+
+SocketClient::SocketClient(libcyphal::IExecutor&    executor,
+                           const io::SocketAddress& address,
+                           const ReconnectPolicy&   reconnect_policy)
+    : executor_{executor}
+    , socket_address_{address}
     , posix_executor_ext_{cetl::rtti_cast<platform::IPosixExecutorExtension*>(&executor)}
+    , reconnect_policy_{reconnect_policy}
+    , reconnect_attempts_{0}
+    , jitter_random_{std::random_device{}()}
 {
     CETL_DEBUG_ASSERT(posix_executor_ext_ != nullptr, "");
 }
@@ -50,14 +62,23 @@ int SocketClient::start(EventHandler event_handler)
         return err;
     }
 
+    reconnect_callback_ = executor_.registerCallback([this](const auto&) {
+        //
+        handle_reconnect();
+    });
+
+    awaitConnect();
+    return 0;
+}
+
+void SocketClient::awaitConnect()
+{
     socket_callback_ = posix_executor_ext_->registerAwaitableCallback(  //
         [this](const auto&) {
             //
             handle_connect();
         },
         platform::IPosixExecutorExtension::Trigger::Writable{state_.fd.get()});
-
-    return 0;
 }
 
 int SocketClient::makeSocketHandle()
@@ -89,7 +110,17 @@ int SocketClient::makeSocketHandle()
 
 int SocketClient::send(const Payloads payloads)
 {
-    return SocketBase::send(state_, payloads);
+    const int err = SocketBase::send(state_, payloads);
+    if (state_.hasPendingWrite() && !write_callback_)
+    {
+        write_callback_ = posix_executor_ext_->registerAwaitableCallback(  //
+            [this](const auto&) {
+                //
+                handle_writable();
+            },
+            platform::IPosixExecutorExtension::Trigger::Writable{state_.fd.get()});
+    }
+    return err;
 }
 
 int SocketClient::connectSocket(const int fd, const void* const addr_ptr, const std::size_t addr_size) const
@@ -136,7 +167,8 @@ void SocketClient::handle_connect()
         },
         platform::IPosixExecutorExtension::Trigger::Readable{state_.fd.get()});
 
-    state_.read_phase = State::ReadPhase::Header;
+    reconnect_attempts_ = 0;
+    state_.resetStream();
     event_handler_(Event::Connected{});
 }
 
@@ -160,14 +192,74 @@ void SocketClient::handle_receive()
     }
 }
 
+void SocketClient::handle_writable()
+{
+    const int err = flushPending(state_);
+    if ((err == EAGAIN) || (err == EWOULDBLOCK))
+    {
+        return;  // still pending - wait for the next writable event
+    }
+    if (err != 0)
+    {
+        logger().warn("Failed to flush client request - closing connection: {}.", std::strerror(err));
+        handle_disconnect();
+        return;
+    }
+
+    write_callback_.reset();
+}
+
 void SocketClient::handle_disconnect()
 {
     socket_callback_.reset();
+    write_callback_.reset();
 
     state_.fd.reset();
-    state_.read_phase = State::ReadPhase::Header;
+    state_.resetStream();
 
     event_handler_(Event::Disconnected{});
+
+    scheduleReconnect();
+}
+
+void SocketClient::scheduleReconnect()
+{
+    using Schedule = libcyphal::IExecutor::Callback::Schedule;
+
+    if (reconnect_policy_.initial_backoff <= libcyphal::Duration::zero())
+    {
+        return;
+    }
+
+    // Exponential backoff (capped), with "equal jitter" - a random delay in the upper half of the backoff.
+    // The jitter spreads reconnections of many clients (f.e. after the daemon restart) over time.
+    //
+    using Rep = libcyphal::Duration::rep;
+
+    const auto shift   = std::min<std::uint32_t>(reconnect_attempts_, MaxBackoffShift);
+    const auto backoff = std::min(reconnect_policy_.initial_backoff * (Rep{1} << shift), reconnect_policy_.max_backoff);
+
+    std::uniform_int_distribution<Rep> jitter{0, backoff.count() / 2};
+    const libcyphal::Duration          delay = backoff - libcyphal::Duration{jitter(jitter_random_)};
+    ++reconnect_attempts_;
+
+    logger().debug("Reconnecting in {} ms (attempt={}).",
+                   std::chrono::duration_cast<std::chrono::milliseconds>(delay).count(),
+                   reconnect_attempts_);
+
+    reconnect_callback_.schedule(Schedule::Once{executor_.now() + delay});
+}
+
+void SocketClient::handle_reconnect()
+{
+    if (const auto err = makeSocketHandle())
+    {
+        logger().warn("Failed to make client socket handle: {}.", std::strerror(err));
+        scheduleReconnect();
+        return;
+    }
+
+    awaitConnect();
 }
 
 }  // namespace pipe
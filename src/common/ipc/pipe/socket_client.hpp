@@ -14,8 +14,12 @@
 
 #include <cetl/cetl.hpp>
 #include <libcyphal/executor.hpp>
+#include <libcyphal/types.hpp>
 
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <random>
 
 namespace ocvsmd
 {
@@ -26,10 +30,28 @@ namespace ipc
 namespace pipe
 {
 
+/// Defines client pipe over a stream socket.
+///
+/// Once started, the pipe keeps (re)connecting to the server: a failed connection attempt or a lost
+/// connection schedules the next attempt after a jittered exponential backoff, so that many clients
+/// don't reconnect all at once after a restart of the server. Every (re)connection is reported as
+/// `Event::Connected`, and every loss of the connection as `Event::Disconnected`.
+///
 class SocketClient final : public SocketBase, public ClientPipe
 {
 public:
-    SocketClient(libcyphal::IExecutor& executor, const io::SocketAddress& address);
+    struct ReconnectPolicy final
+    {
+        /// Backoff before the first reconnection attempt. Zero disables reconnection.
+        libcyphal::Duration initial_backoff{std::chrono::milliseconds{100}};
+        /// Upper limit of the backoff - it doubles with each failed attempt up to this value.
+        libcyphal::Duration max_backoff{std::chrono::seconds{10}};
+
+    };  // ReconnectPolicy
+
+    SocketClient(libcyphal::IExecutor&    executor,
+                 const io::SocketAddress& address,
+                 const ReconnectPolicy&   reconnect_policy = {});
 
     SocketClient(const SocketClient&)                = delete;
     SocketClient(SocketClient&&) noexcept            = delete;
@@ -39,21 +61,33 @@ public:
     ~SocketClient() override = default;
 
 private:
+    static constexpr std::uint32_t MaxBackoffShift = 16;
+
     int  makeSocketHandle();
     int  connectSocket(const int fd, const void* const addr_ptr, const std::size_t addr_size) const;
     void handle_connect();
     void handle_receive();
+    void handle_writable();
     void handle_disconnect();
+    void scheduleReconnect();
+    void handle_reconnect();
+    void awaitConnect();
 
     // ClientPipe
     //
     CETL_NODISCARD int start(EventHandler event_handler) override;
     CETL_NODISCARD int send(const Payloads payloads) override;
 
+    libcyphal::IExecutor&                    executor_;
     io::SocketAddress                        socket_address_;
     platform::IPosixExecutorExtension* const posix_executor_ext_;
+    const ReconnectPolicy                    reconnect_policy_;
     State                                    state_;
     libcyphal::IExecutor::Callback::Any      socket_callback_;
+    libcyphal::IExecutor::Callback::Any      write_callback_;
+    libcyphal::IExecutor::Callback::Any      reconnect_callback_;
+    std::uint32_t                            reconnect_attempts_;
+    std::minstd_rand                         jitter_random_;
     EventHandler                             event_handler_;
 
 };  // SocketClient
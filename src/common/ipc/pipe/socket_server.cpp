@@ -117,10 +117,26 @@ int SocketServer::makeSocketHandle()
 }
 
 int SocketServer::send(const ClientId client_id, const Payloads payloads)
+{
+    return sendToClient(client_id, payloads, true);
+}
+
+int SocketServer::trySend(const ClientId client_id, const Payloads payloads)
+{
+    return sendToClient(client_id, payloads, false);
+}
+
+int SocketServer::sendToClient(const ClientId client_id, const Payloads payloads, const bool can_queue)
 {
     if (auto* const client_context = tryFindClientContext(client_id))
     {
-        return SocketBase::send(client_context->state(), payloads);
+        auto&     state = client_context->state();
+        const int err   = can_queue ? SocketBase::send(state, payloads) : SocketBase::trySend(state, payloads);
+        if (state.hasPendingWrite() && !client_context->isAwaitingWritable())
+        {
+            awaitClientWritable(*client_context, client_id);
+        }
+        return err;
     }
 
     logger().warn("Client context is not found (id={}).", client_id);
@@ -185,6 +201,42 @@ void SocketServer::handleClientRequest(const ClientId client_id)
     }
 }
 
+void SocketServer::awaitClientWritable(ClientContext& client_context, const ClientId client_id)
+{
+    client_context.setWriteCallback(posix_executor_ext_->registerAwaitableCallback(
+        [this, client_id](const auto&) {
+            //
+            handleClientWritable(client_id);
+        },
+        platform::IPosixExecutorExtension::Trigger::Writable{client_context.state().fd.get()}));
+}
+
+void SocketServer::handleClientWritable(const ClientId client_id)
+{
+    auto* const client_context = tryFindClientContext(client_id);
+    CETL_DEBUG_ASSERT(client_context, "");
+    auto& state = client_context->state();
+
+    const int err = flushPending(state);
+    if ((err == EAGAIN) || (err == EWOULDBLOCK))
+    {
+        return;  // still pending - wait for the next writable event
+    }
+    if (err != 0)
+    {
+        logger().warn("Failed to flush client response - closing connection (id={}, fd={}): {}.",
+                      client_id,
+                      state.fd.get(),
+                      std::strerror(err));
+
+        client_id_to_context_.erase(client_id);
+        event_handler_(Event::Disconnected{client_id});
+        return;
+    }
+
+    client_context->setWriteCallback({});
+}
+
 ClientContext* SocketServer::tryFindClientContext(const ClientId client_id)
 {
     const auto id_and_context = client_id_to_context_.find(client_id);
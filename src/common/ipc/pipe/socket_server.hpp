@@ -42,14 +42,18 @@ public:
 
 private:
     int            makeSocketHandle();
+    int            sendToClient(const ClientId client_id, const Payloads payloads, const bool can_queue);
     void           handleAccept();
     void           handleClientRequest(const ClientId client_id);
+    void           awaitClientWritable(ClientContext& client_context, const ClientId client_id);
+    void           handleClientWritable(const ClientId client_id);
     ClientContext* tryFindClientContext(const ClientId client_id);
 
     // ServerPipe
     //
     CETL_NODISCARD int start(EventHandler event_handler) override;
     CETL_NODISCARD int send(const ClientId client_id, const Payloads payloads) override;
+    CETL_NODISCARD int trySend(const ClientId client_id, const Payloads payloads) override;
 
     io::OwnFd                                        server_fd_;
     io::SocketAddress                                socket_address_;
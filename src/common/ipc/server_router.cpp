@@ -151,14 +151,22 @@ private:
 
             auto& channel_msg        = route.set_channel_msg();
             channel_msg.tag          = endpoint_.tag;
-            channel_msg.sequence     = next_sequence_++;
+            channel_msg.sequence     = next_sequence_;
             channel_msg.service_id   = service_id;
             channel_msg.payload_size = payload.size();
 
-            return tryPerformOnSerialized(route, [this, payload](const auto prefix) {
+            const int err = tryPerformOnSerialized(route, [this, payload](const auto prefix) {
                 //
-                return router_.server_pipe_->send(endpoint_.client_id, {{prefix, payload}});
+                auto& server_pipe = *router_.server_pipe_;
+                return is_back_pressured_ ? server_pipe.trySend(endpoint_.client_id, {{prefix, payload}})
+                                          : server_pipe.send(endpoint_.client_id, {{prefix, payload}});
             });
+            if (0 == err)
+            {
+                // A refused (f.e. back-pressured) message doesn't take its sequence number - it's going to be retried.
+                ++next_sequence_;
+            }
+            return err;
         }
 
         void complete(const int error_code) override
@@ -178,12 +186,23 @@ private:
             router_.onGatewaySubscription(endpoint_);
         }
 
+        void enableResumption() override
+        {
+            // Nothing to do here - it's up to clients to resume their channels on reconnection.
+        }
+
+        void enableBackPressure() override
+        {
+            is_back_pressured_ = true;
+        }
+
     private:
         ServerRouterImpl& router_;
         const Endpoint    endpoint_;
         std::uint64_t     next_sequence_;
         EventHandler      event_handler_;
         int               completion_error_code_;
+        bool              is_back_pressured_{false};
 
     };  // GatewayImpl
 
@@ -262,21 +281,26 @@ private:
             //
             if (was_registered && isConnected(endpoint))
             {
-                Route_0_1 route{&memory_};
-                auto&     channel_end  = route.set_channel_end();
-                channel_end.tag        = endpoint.tag;
-                channel_end.error_code = completion_err;
-
-                const int error = tryPerformOnSerialized(route, [this, &endpoint](const auto payload) {
-                    //
-                    return server_pipe_->send(endpoint.client_id, {{payload}});
-                });
-                // Best efforts strategy - gateway anyway is gone, so nowhere to report.
-                (void) error;
+                sendRouteChannelEnd(endpoint, completion_err);
             }
         }
     }
 
+    void sendRouteChannelEnd(const Endpoint& endpoint, const int error_code)
+    {
+        Route_0_1 route{&memory_};
+        auto&     channel_end  = route.set_channel_end();
+        channel_end.tag        = endpoint.tag;
+        channel_end.error_code = error_code;
+
+        const int error = tryPerformOnSerialized(route, [this, &endpoint](const auto payload) {
+            //
+            return server_pipe_->send(endpoint.client_id, {{payload}});
+        });
+        // Best efforts strategy - there is no gateway (anymore), so nowhere to report.
+        (void) error;
+    }
+
     CETL_NODISCARD int handlePipeEvent(const pipe::ServerPipe::Event::Connected& pipe_conn) const
     {
         logger_->debug("Pipe is connected (cl={}).", pipe_conn.client_id);
@@ -419,6 +443,15 @@ private:
                     si_to_ch_factory->second(gateway, msg_real_payload);
                     return 0;
                 }
+
+                // The client will wait forever for a service which is not (and won't be) there,
+                // so let it know (f.e. the service of a network which the daemon doesn't run).
+                logger_->warn("Route Ch Msg to unknown service (cl={}, tag={}, srv=0x{:X}).",
+                              client_id,
+                              route_ch_msg.tag,
+                              route_ch_msg.service_id);
+                sendRouteChannelEnd({route_ch_msg.tag, client_id}, static_cast<int>(ErrorCode::UnknownService));
+                return 0;
             }
         }
 
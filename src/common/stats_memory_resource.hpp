@@ -0,0 +1,154 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_COMMON_STATS_MEMORY_RESOURCE_HPP_INCLUDED
+#define OCVSMD_COMMON_STATS_MEMORY_RESOURCE_HPP_INCLUDED
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace ocvsmd
+{
+namespace common
+{
+
+/// Defines a snapshot of memory usage counters of a single subsystem.
+///
+struct MemoryStats
+{
+    /// Number of bytes currently allocated (not yet deallocated).
+    std::size_t allocated_bytes{0};
+
+    /// High-water mark of `allocated_bytes`.
+    std::size_t peak_allocated_bytes{0};
+
+    /// Total number of successful allocations (including reallocations).
+    std::uint64_t allocations{0};
+
+    /// Total number of deallocations.
+    std::uint64_t deallocations{0};
+
+    /// Total number of allocations which failed at the upstream resource.
+    std::uint64_t failed_allocations{0};
+
+};  // MemoryStats
+
+/// Defines a low-overhead memory resource wrapper which accounts usage of an upstream resource.
+///
+/// Unlike the test-only tracking resource, it doesn't keep a list of individual allocations -
+/// it just maintains a few counters, so it's cheap enough to be used in production
+/// (f.e. one instance per daemon subsystem). Not thread-safe - the daemon is single-threaded.
+///
+class StatsMemoryResource final : public cetl::pmr::memory_resource
+{
+public:
+    explicit StatsMemoryResource(std::string                 name,
+                                 cetl::pmr::memory_resource& upstream = *cetl::pmr::get_default_resource())
+        : name_{std::move(name)}
+        , upstream_{upstream}
+    {
+    }
+
+    StatsMemoryResource(const StatsMemoryResource&)                = delete;
+    StatsMemoryResource(StatsMemoryResource&&) noexcept            = delete;
+    StatsMemoryResource& operator=(const StatsMemoryResource&)     = delete;
+    StatsMemoryResource& operator=(StatsMemoryResource&&) noexcept = delete;
+
+    ~StatsMemoryResource() override = default;
+
+    CETL_NODISCARD const std::string& name() const noexcept
+    {
+        return name_;
+    }
+
+    CETL_NODISCARD const MemoryStats& stats() const noexcept
+    {
+        return stats_;
+    }
+
+private:
+    void account_allocation(const void* const ptr, const std::size_t size_bytes) noexcept
+    {
+        if (nullptr == ptr)
+        {
+            ++stats_.failed_allocations;
+            return;
+        }
+        ++stats_.allocations;
+        stats_.allocated_bytes += size_bytes;
+        stats_.peak_allocated_bytes = std::max(stats_.peak_allocated_bytes, stats_.allocated_bytes);
+    }
+
+    // MARK: cetl::pmr::memory_resource
+
+    void* do_allocate(std::size_t size_bytes, std::size_t alignment) override
+    {
+        void* const ptr = upstream_.allocate(size_bytes, alignment);
+        account_allocation(ptr, size_bytes);
+        return ptr;
+    }
+
+    void do_deallocate(void* ptr, std::size_t size_bytes, std::size_t alignment) override
+    {
+        CETL_DEBUG_ASSERT((nullptr != ptr) || (0 == size_bytes), "");
+
+        upstream_.deallocate(ptr, size_bytes, alignment);
+
+        if (nullptr != ptr)
+        {
+            ++stats_.deallocations;
+            stats_.allocated_bytes -= std::min(stats_.allocated_bytes, size_bytes);
+        }
+    }
+
+#if (__cplusplus < CETL_CPP_STANDARD_17)
+
+    void* do_reallocate(void*       ptr,
+                        std::size_t old_size_bytes,
+                        std::size_t new_size_bytes,
+                        std::size_t alignment) override
+    {
+        CETL_DEBUG_ASSERT((nullptr != ptr) || (0 == old_size_bytes), "");
+
+        void* const new_ptr = upstream_.reallocate(ptr, old_size_bytes, new_size_bytes, alignment);
+        if (nullptr == new_ptr)
+        {
+            ++stats_.failed_allocations;
+            return nullptr;
+        }
+
+        // Reallocation is accounted as a deallocation of the old block, followed by allocation of the new one.
+        if (nullptr != ptr)
+        {
+            ++stats_.deallocations;
+            stats_.allocated_bytes -= std::min(stats_.allocated_bytes, old_size_bytes);
+        }
+        account_allocation(new_ptr, new_size_bytes);
+        return new_ptr;
+    }
+
+#endif
+
+    bool do_is_equal(const cetl::pmr::memory_resource& rhs) const noexcept override
+    {
+        return (&rhs == this);
+    }
+
+    const std::string           name_;
+    cetl::pmr::memory_resource& upstream_;
+    MemoryStats                 stats_;
+
+};  // StatsMemoryResource
+
+}  // namespace common
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_COMMON_STATS_MEMORY_RESOURCE_HPP_INCLUDED
@@ -0,0 +1,39 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_COMMON_SVC_DIAG_MEMORY_STATS_SPEC_HPP_INCLUDED
+#define OCVSMD_COMMON_SVC_DIAG_MEMORY_STATS_SPEC_HPP_INCLUDED
+
+#include "ocvsmd/common/svc/diag/MemoryStatsSvcRequest_0_1.hpp"
+#include "ocvsmd/common/svc/diag/MemoryStatsSvcResponse_0_1.hpp"
+
+namespace ocvsmd
+{
+namespace common
+{
+namespace svc
+{
+namespace diag
+{
+
+struct MemoryStatsSpec
+{
+    using Request  = MemoryStatsSvcRequest_0_1;
+    using Response = MemoryStatsSvcResponse_0_1;
+
+    constexpr auto static svc_full_name()
+    {
+        return "ocvsmd.svc.diag.memory_stats";
+    }
+
+    MemoryStatsSpec() = delete;
+};
+
+}  // namespace diag
+}  // namespace svc
+}  // namespace common
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_COMMON_SVC_DIAG_MEMORY_STATS_SPEC_HPP_INCLUDED
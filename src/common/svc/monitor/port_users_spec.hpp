@@ -0,0 +1,39 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_COMMON_SVC_MONITOR_PORT_USERS_SPEC_HPP_INCLUDED
+#define OCVSMD_COMMON_SVC_MONITOR_PORT_USERS_SPEC_HPP_INCLUDED
+
+#include "ocvsmd/common/svc/monitor/PortUsersSvcRequest_0_1.hpp"
+#include "ocvsmd/common/svc/monitor/PortUsersSvcResponse_0_1.hpp"
+
+namespace ocvsmd
+{
+namespace common
+{
+namespace svc
+{
+namespace monitor
+{
+
+struct PortUsersSpec
+{
+    using Request  = PortUsersSvcRequest_0_1;
+    using Response = PortUsersSvcResponse_0_1;
+
+    constexpr auto static svc_full_name()
+    {
+        return "ocvsmd.svc.monitor.port_users";
+    }
+
+    PortUsersSpec() = delete;
+};
+
+}  // namespace monitor
+}  // namespace svc
+}  // namespace common
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_COMMON_SVC_MONITOR_PORT_USERS_SPEC_HPP_INCLUDED
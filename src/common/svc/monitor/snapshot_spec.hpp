@@ -0,0 +1,39 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_COMMON_SVC_MONITOR_SNAPSHOT_SPEC_HPP_INCLUDED
+#define OCVSMD_COMMON_SVC_MONITOR_SNAPSHOT_SPEC_HPP_INCLUDED
+
+#include "ocvsmd/common/svc/monitor/SnapshotSvcRequest_0_1.hpp"
+#include "ocvsmd/common/svc/monitor/SnapshotSvcResponse_0_1.hpp"
+
+namespace ocvsmd
+{
+namespace common
+{
+namespace svc
+{
+namespace monitor
+{
+
+struct SnapshotSpec
+{
+    using Request  = SnapshotSvcRequest_0_1;
+    using Response = SnapshotSvcResponse_0_1;
+
+    constexpr auto static svc_full_name()
+    {
+        return "ocvsmd.svc.monitor.snapshot";
+    }
+
+    SnapshotSpec() = delete;
+};
+
+}  // namespace monitor
+}  // namespace svc
+}  // namespace common
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_COMMON_SVC_MONITOR_SNAPSHOT_SPEC_HPP_INCLUDED
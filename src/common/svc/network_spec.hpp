@@ -0,0 +1,50 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_COMMON_SVC_NETWORK_SPEC_HPP_INCLUDED
+#define OCVSMD_COMMON_SVC_NETWORK_SPEC_HPP_INCLUDED
+
+#include <cetl/pf17/cetlpf.hpp>
+
+#include <string>
+
+namespace ocvsmd
+{
+namespace common
+{
+namespace svc
+{
+
+/// Defines how IPC services are bound to the Cyphal networks of the daemon.
+///
+/// The daemon might run several Cyphal networks at once (f.e. "udp" and "can" ones). Services which talk
+/// to a network are served once per each network - by their names qualified with the network name
+/// (f.e. "ocvsmd.svc.node.exec_cmd@can"). The primary network (the first one) is also served by the plain names.
+///
+struct NetworkSpec
+{
+    static constexpr char Separator = '@';
+
+    /// Makes the service name for the given network. Empty network name means the primary network.
+    ///
+    static std::string svc_full_name(const cetl::string_view svc_full_name, const cetl::string_view network)
+    {
+        std::string name{svc_full_name.data(), svc_full_name.size()};
+        if (!network.empty())
+        {
+            name += Separator;
+            name.append(network.data(), network.size());
+        }
+        return name;
+    }
+
+    NetworkSpec() = delete;
+};
+
+}  // namespace svc
+}  // namespace common
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_COMMON_SVC_NETWORK_SPEC_HPP_INCLUDED
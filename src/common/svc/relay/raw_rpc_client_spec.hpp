@@ -0,0 +1,39 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_COMMON_SVC_RELAY_RAW_RPC_CLIENT_SPEC_HPP_INCLUDED
+#define OCVSMD_COMMON_SVC_RELAY_RAW_RPC_CLIENT_SPEC_HPP_INCLUDED
+
+#include "ocvsmd/common/svc/relay/RawRpcClientSvcRequest_0_1.hpp"
+#include "ocvsmd/common/svc/relay/RawRpcClientSvcResponse_0_1.hpp"
+
+namespace ocvsmd
+{
+namespace common
+{
+namespace svc
+{
+namespace relay
+{
+
+struct RawRpcClientSpec
+{
+    using Request  = RawRpcClientSvcRequest_0_1;
+    using Response = RawRpcClientSvcResponse_0_1;
+
+    constexpr auto static svc_full_name()
+    {
+        return "ocvsmd.svc.relay.raw_rpc_client";
+    }
+
+    RawRpcClientSpec() = delete;
+};
+
+}  // namespace relay
+}  // namespace svc
+}  // namespace common
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_COMMON_SVC_RELAY_RAW_RPC_CLIENT_SPEC_HPP_INCLUDED
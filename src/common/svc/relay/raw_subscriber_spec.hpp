@@ -0,0 +1,39 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_COMMON_SVC_RELAY_RAW_SUBSCRIBER_SPEC_HPP_INCLUDED
+#define OCVSMD_COMMON_SVC_RELAY_RAW_SUBSCRIBER_SPEC_HPP_INCLUDED
+
+#include "ocvsmd/common/svc/relay/RawSubscriberSvcRequest_0_1.hpp"
+#include "ocvsmd/common/svc/relay/RawSubscriberSvcResponse_0_1.hpp"
+
+namespace ocvsmd
+{
+namespace common
+{
+namespace svc
+{
+namespace relay
+{
+
+struct RawSubscriberSpec
+{
+    using Request  = RawSubscriberSvcRequest_0_1;
+    using Response = RawSubscriberSvcResponse_0_1;
+
+    constexpr auto static svc_full_name()
+    {
+        return "ocvsmd.svc.relay.raw_subscriber";
+    }
+
+    RawSubscriberSpec() = delete;
+};
+
+}  // namespace relay
+}  // namespace svc
+}  // namespace common
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_COMMON_SVC_RELAY_RAW_SUBSCRIBER_SPEC_HPP_INCLUDED
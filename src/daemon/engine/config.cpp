@@ -11,6 +11,7 @@
 #include <toml.hpp>
 
 #include <chrono>
+#include <cstdint>
 #include <exception>
 #include <fstream>
 #include <ios>
@@ -87,11 +88,21 @@ public:
         is_dirty_ = true;
     }
 
+    auto getCyphalAppTransferIdMapFile() const -> cetl::optional<std::string> override
+    {
+        return findImpl<std::string>("cyphal", "application", "transfer_id_map_file");
+    }
+
     auto getCyphalTransportInterfaces() const -> std::vector<std::string> override
     {
         return find_or(root_, "cyphal", "transport", "interfaces", std::vector<std::string>{});
     }
 
+    auto getCyphalTransportCanMaxFilters() const -> cetl::optional<std::uint32_t> override
+    {
+        return findImpl<std::uint32_t>("cyphal", "transport", "can_max_filters");
+    }
+
     auto getFileServerRoots() const -> std::vector<std::string> override
     {
         return find_or(root_, "file_server", "roots", std::vector<std::string>{});
@@ -109,6 +120,40 @@ public:
         return find_or(root_, "ipc", "connections", std::vector<std::string>{});
     }
 
+    auto getSvcExecCmdMaxInFlightPerRequest() const -> cetl::optional<std::uint32_t> override
+    {
+        return findImpl<std::uint32_t>("svc", "node", "exec_cmd", "max_in_flight_per_request");
+    }
+
+    auto getSvcExecCmdMaxInFlight() const -> cetl::optional<std::uint32_t> override
+    {
+        return findImpl<std::uint32_t>("svc", "node", "exec_cmd", "max_in_flight");
+    }
+
+    auto getSvcExecCmdRequestSpacing() const -> cetl::optional<std::chrono::microseconds> override
+    {
+        if (const auto spacing_us = findImpl<std::uint32_t>("svc", "node", "exec_cmd", "request_spacing_us"))
+        {
+            return std::chrono::microseconds{spacing_us.value()};
+        }
+        return cetl::nullopt;
+    }
+
+    auto getSvcRegistersCacheCapacity() const -> cetl::optional<std::uint32_t> override
+    {
+        return findImpl<std::uint32_t>("svc", "node", "registers", "cache_capacity");
+    }
+
+    auto getSvcRawRpcClientMaxClients() const -> cetl::optional<std::uint32_t> override
+    {
+        return findImpl<std::uint32_t>("svc", "relay", "raw_rpc_client", "max_clients");
+    }
+
+    auto getSvcRawRpcClientMaxClientsBytes() const -> cetl::optional<std::uint32_t> override
+    {
+        return findImpl<std::uint32_t>("svc", "relay", "raw_rpc_client", "max_clients_bytes");
+    }
+
     auto getLoggingFile() const -> cetl::optional<std::string> override
     {
         return findImpl<std::string>("logging", "file");
@@ -124,6 +169,15 @@ public:
         return findImpl<std::string>("logging", "flush_level");
     }
 
+    auto getLoggingStatsPeriod() const -> cetl::optional<std::chrono::seconds> override
+    {
+        if (const auto period_s = findImpl<std::uint32_t>("logging", "stats_period"))
+        {
+            return std::chrono::seconds{period_s.value()};
+        }
+        return cetl::nullopt;
+    }
+
 private:
     template <typename T, typename... Keys>
     cetl::optional<T> findImpl(Keys&&... keys) const
@@ -10,6 +10,7 @@
 #include <cetl/pf17/cetlpf.hpp>
 
 #include <array>
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -44,20 +45,32 @@ public:
 
     virtual void save() = 0;
 
-    CETL_NODISCARD virtual auto getCyphalAppNodeId() const -> cetl::optional<CyphalApp::NodeId>     = 0;
-    CETL_NODISCARD virtual auto getCyphalAppUniqueId() const -> cetl::optional<CyphalApp::UniqueId> = 0;
-    virtual void                setCyphalAppUniqueId(const CyphalApp::UniqueId& unique_id)          = 0;
+    CETL_NODISCARD virtual auto getCyphalAppNodeId() const -> cetl::optional<CyphalApp::NodeId>      = 0;
+    CETL_NODISCARD virtual auto getCyphalAppUniqueId() const -> cetl::optional<CyphalApp::UniqueId>  = 0;
+    virtual void                setCyphalAppUniqueId(const CyphalApp::UniqueId& unique_id)           = 0;
+    CETL_NODISCARD virtual auto getCyphalAppTransferIdMapFile() const -> cetl::optional<std::string> = 0;
 
-    CETL_NODISCARD virtual auto getCyphalTransportInterfaces() const -> std::vector<std::string> = 0;
+    CETL_NODISCARD virtual auto getCyphalTransportInterfaces() const -> std::vector<std::string>         = 0;
+    CETL_NODISCARD virtual auto getCyphalTransportCanMaxFilters() const -> cetl::optional<std::uint32_t> = 0;
 
     CETL_NODISCARD virtual auto getFileServerRoots() const -> std::vector<std::string>    = 0;
     virtual void                setFileServerRoots(const std::vector<std::string>& roots) = 0;
 
     CETL_NODISCARD virtual auto getIpcConnections() const -> std::vector<std::string> = 0;
 
-    CETL_NODISCARD virtual auto getLoggingFile() const -> cetl::optional<std::string>       = 0;
-    CETL_NODISCARD virtual auto getLoggingLevel() const -> cetl::optional<std::string>      = 0;
-    CETL_NODISCARD virtual auto getLoggingFlushLevel() const -> cetl::optional<std::string> = 0;
+    CETL_NODISCARD virtual auto getSvcExecCmdMaxInFlightPerRequest() const -> cetl::optional<std::uint32_t>      = 0;
+    CETL_NODISCARD virtual auto getSvcExecCmdMaxInFlight() const -> cetl::optional<std::uint32_t>                = 0;
+    CETL_NODISCARD virtual auto getSvcExecCmdRequestSpacing() const -> cetl::optional<std::chrono::microseconds> = 0;
+
+    CETL_NODISCARD virtual auto getSvcRegistersCacheCapacity() const -> cetl::optional<std::uint32_t> = 0;
+
+    CETL_NODISCARD virtual auto getSvcRawRpcClientMaxClients() const -> cetl::optional<std::uint32_t>     = 0;
+    CETL_NODISCARD virtual auto getSvcRawRpcClientMaxClientsBytes() const -> cetl::optional<std::uint32_t> = 0;
+
+    CETL_NODISCARD virtual auto getLoggingFile() const -> cetl::optional<std::string>                 = 0;
+    CETL_NODISCARD virtual auto getLoggingLevel() const -> cetl::optional<std::string>                = 0;
+    CETL_NODISCARD virtual auto getLoggingFlushLevel() const -> cetl::optional<std::string>           = 0;
+    CETL_NODISCARD virtual auto getLoggingStatsPeriod() const -> cetl::optional<std::chrono::seconds> = 0;
 
 protected:
     Config() = default;
@@ -6,6 +6,8 @@
 #ifndef OCVSMD_DAEMON_ENGINE_CYPHAL_ANY_TRANSPORT_BAG_HPP_INCLUDED
 #define OCVSMD_DAEMON_ENGINE_CYPHAL_ANY_TRANSPORT_BAG_HPP_INCLUDED
 
+#include "logging.hpp"
+
 #include <libcyphal/transport/transport.hpp>
 #include <libcyphal/types.hpp>
 
@@ -37,6 +39,13 @@ public:
 
     virtual Transport& getTransport() const = 0;
 
+    /// Logs transport specific statistics (if any).
+    ///
+    virtual void logStats(common::Logger& logger) const
+    {
+        (void) logger;
+    }
+
 protected:
     AnyTransportBag() = default;
 
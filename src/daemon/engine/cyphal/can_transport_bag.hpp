@@ -19,6 +19,7 @@
 #include <libcyphal/types.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <utility>
 
@@ -69,7 +70,8 @@ public:
         auto transport_bag = std::make_unique<CanTransportBag>(Spec{}, memory, executor);
 
         auto& media_collection = transport_bag->media_collection_;
-        media_collection.parse(can_ifaces);
+        const auto max_filters = config->getCyphalTransportCanMaxFilters().value_or(DefaultMaxFilters);
+        media_collection.parse(can_ifaces, max_filters);
         if (media_collection.count() == 0)
         {
             return nullptr;
@@ -97,6 +99,11 @@ public:
         return transport_bag;
     }
 
+    void logStats(common::Logger& logger) const override
+    {
+        media_collection_.logStats(logger);
+    }
+
     CanTransportBag(Spec, cetl::pmr::memory_resource& memory, libcyphal::IExecutor& executor)
         : memory_{memory}
         , executor_{executor}
@@ -112,6 +119,9 @@ private:
     // let's calculate the required TX queue capacity, and make it twice to accommodate 2 such messages.
     static constexpr std::size_t TxQueueCapacity = 2 * (313U + 8U) / 7U;
 
+    // Default max number of kernel acceptance filters per CAN interface.
+    static constexpr std::uint32_t DefaultMaxFilters = 32;
+
     cetl::pmr::memory_resource&       memory_;
     libcyphal::IExecutor&             executor_;
     platform::can::CanMediaCollection media_collection_;
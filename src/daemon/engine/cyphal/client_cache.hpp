@@ -0,0 +1,212 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_DAEMON_ENGINE_CYPHAL_CLIENT_CACHE_HPP_INCLUDED
+#define OCVSMD_DAEMON_ENGINE_CYPHAL_CLIENT_CACHE_HPP_INCLUDED
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/types.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace cyphal
+{
+
+/// Defines LRU cache of Cyphal service clients.
+///
+/// Making a presentation client is not free - it creates transport RX session for the responses
+/// (which in turn updates the transport's acceptance filters). So services which repeatedly talk to
+/// the same nodes keep their clients here, and share them between all their requests.
+///
+/// The cache is bounded both in size (the least recently used client is evicted when the capacity
+/// is exceeded) and in time (clients which were not used for the idle timeout are evicted
+/// by a periodic executor callback). Optionally, it's also bounded by the total "cost" of its clients -
+/// f.e. their approximate memory footprint, when clients differ a lot (like raw clients with different extents).
+/// Eviction just drops the cache's own reference to a client,
+/// so clients which are still in use (f.e. by pending request promises) are not affected.
+///
+/// @tparam Key Type of the cache key - usually the server node ID.
+/// @tparam Client Type of the (copyable) client, f.e. `libcyphal::presentation::ServiceClient<Service>`.
+///
+template <typename Key, typename Client>
+class ClientCache final
+{
+    /// Defines private specification for making interface shared ptr.
+    ///
+    struct Spec
+    {
+        explicit Spec() = default;
+    };
+
+public:
+    using Ptr = std::shared_ptr<ClientCache>;
+
+    /// Makes a new cache.
+    ///
+    /// The idle eviction callback is registered at the executor; so the cache should not outlive it.
+    ///
+    /// @param max_total_cost Limit of the total cost of cached clients (see `getOrMake`). Not limited by default.
+    ///
+    CETL_NODISCARD static Ptr make(libcyphal::IExecutor&     executor,
+                                   const std::size_t         capacity,
+                                   const libcyphal::Duration idle_timeout,
+                                   const std::size_t         max_total_cost = std::numeric_limits<std::size_t>::max())
+    {
+        return std::make_shared<ClientCache>(Spec{}, executor, capacity, idle_timeout, max_total_cost);
+    }
+
+    /// Gets the cached client for the given key, or makes (and caches) a new one using the given factory.
+    ///
+    /// The factory is expected to return `cetl::variant<Client, Failure>` (like `Presentation::makeClient` does).
+    /// The result is returned as is - failures are not cached, and a successful client is a copy of the cached one.
+    ///
+    template <typename Factory>
+    auto getOrMake(const Key& key, Factory&& factory) -> decltype(std::forward<Factory>(factory)())
+    {
+        return getOrMake(key, 0, std::forward<Factory>(factory));
+    }
+
+    /// Same as above, but the new client is accounted with the given cost.
+    ///
+    /// Least recently used clients are evicted until the total cost fits into the limit
+    /// (but the new client itself is always cached - even if its own cost exceeds the limit).
+    ///
+    template <typename Factory>
+    auto getOrMake(const Key& key, const std::size_t cost, Factory&& factory)
+        -> decltype(std::forward<Factory>(factory)())
+    {
+        const auto now = executor_.now();
+
+        const auto found = key_to_entry_.find(key);
+        if (found != key_to_entry_.end())
+        {
+            // Move the entry to the front - the most recently used one.
+            entries_.splice(entries_.begin(), entries_, found->second);
+            found->second->last_used = now;
+            return found->second->client;
+        }
+
+        auto result = std::forward<Factory>(factory)();
+        if (const auto* const client = cetl::get_if<Client>(&result))
+        {
+            entries_.push_front(Entry{key, *client, now, cost});
+            key_to_entry_[key] = entries_.begin();
+            total_cost_ += cost;
+            while ((entries_.size() > capacity_) || ((total_cost_ > max_total_cost_) && (entries_.size() > 1)))
+            {
+                evictBack();
+            }
+        }
+        return result;
+    }
+
+    /// Drops the cached client for the given key (if any).
+    ///
+    /// Useful when a client is known to be broken, so that the next request makes a fresh one.
+    ///
+    void evict(const Key& key)
+    {
+        const auto found = key_to_entry_.find(key);
+        if (found != key_to_entry_.end())
+        {
+            total_cost_ -= found->second->cost;
+            entries_.erase(found->second);
+            key_to_entry_.erase(found);
+        }
+    }
+
+    CETL_NODISCARD std::size_t size() const noexcept
+    {
+        return entries_.size();
+    }
+
+    CETL_NODISCARD std::size_t totalCost() const noexcept
+    {
+        return total_cost_;
+    }
+
+    ClientCache(Spec,
+                libcyphal::IExecutor&     executor,
+                const std::size_t         capacity,
+                const libcyphal::Duration idle_timeout,
+                const std::size_t         max_total_cost)
+        : executor_{executor}
+        , capacity_{std::max<std::size_t>(1, capacity)}
+        , max_total_cost_{max_total_cost}
+        , idle_timeout_{idle_timeout}
+    {
+        using Schedule = libcyphal::IExecutor::Callback::Schedule;
+
+        idle_callback_ = executor_.registerCallback([this](const auto& arg) {
+            //
+            evictIdle(arg.approx_now);
+        });
+        idle_callback_.schedule(Schedule::Repeat{executor_.now() + idle_timeout_, idle_timeout_});
+    }
+
+    ClientCache(const ClientCache&)                = delete;
+    ClientCache(ClientCache&&) noexcept            = delete;
+    ClientCache& operator=(const ClientCache&)     = delete;
+    ClientCache& operator=(ClientCache&&) noexcept = delete;
+
+    ~ClientCache() = default;
+
+private:
+    struct Entry
+    {
+        Key                  key;
+        Client               client;
+        libcyphal::TimePoint last_used;
+        std::size_t          cost;
+    };
+    using Entries = std::list<Entry>;
+
+    void evictBack()
+    {
+        total_cost_ -= entries_.back().cost;
+        key_to_entry_.erase(entries_.back().key);
+        entries_.pop_back();
+    }
+
+    void evictIdle(const libcyphal::TimePoint now)
+    {
+        // Entries are ordered by their usage, so the idle ones are at the back.
+        while (!entries_.empty() && ((now - entries_.back().last_used) >= idle_timeout_))
+        {
+            evictBack();
+        }
+    }
+
+    libcyphal::IExecutor&                               executor_;
+    const std::size_t                                   capacity_;
+    const std::size_t                                   max_total_cost_;
+    const libcyphal::Duration                           idle_timeout_;
+    std::size_t                                         total_cost_{0};
+    Entries                                             entries_;
+    std::unordered_map<Key, typename Entries::iterator> key_to_entry_;
+    libcyphal::IExecutor::Callback::Any                 idle_callback_;
+
+};  // ClientCache
+
+}  // namespace cyphal
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_DAEMON_ENGINE_CYPHAL_CLIENT_CACHE_HPP_INCLUDED
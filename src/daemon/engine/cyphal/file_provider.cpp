@@ -0,0 +1,181 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "file_provider.hpp"
+
+#include "config.hpp"
+#include "engine_helpers.hpp"
+#include "logging.hpp"
+#include "mapped_file_cache.hpp"
+
+#include <uavcan/file/Error_1_0.hpp>
+#include <uavcan/file/Read_1_1.hpp>
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/presentation/presentation.hpp>
+#include <libcyphal/presentation/server.hpp>
+#include <libcyphal/types.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace cyphal
+{
+namespace
+{
+
+class FileProviderImpl final : public FileProvider
+{
+    using ReadSvc    = uavcan::file::Read_1_1;
+    using FileError  = uavcan::file::Error_1_0;
+    using ReadServer = libcyphal::presentation::ServiceServer<ReadSvc>;
+
+    static constexpr libcyphal::Duration ResponseTimeout = std::chrono::seconds{1};
+    // Max size of the data chunk of a single `uavcan.file.Read.1.1` response.
+    static constexpr std::size_t MaxChunkSize = 256;
+    // Firmware distribution usually involves just a few different files.
+    static constexpr std::size_t MaxMappedFiles   = 16;
+    static constexpr std::size_t MaxResolvedPaths = 256;
+
+public:
+    FileProviderImpl(cetl::pmr::memory_resource& memory, const Config::Ptr& config)
+        : memory_{memory}
+        , file_cache_{config->getFileServerRoots(), MaxMappedFiles, MaxResolvedPaths}
+    {
+        for (const auto& root : file_cache_.roots())
+        {
+            logger_->info("File server root '{}'.", root);
+        }
+    }
+
+    FileProviderImpl(const FileProviderImpl&)                = delete;
+    FileProviderImpl(FileProviderImpl&&) noexcept            = delete;
+    FileProviderImpl& operator=(const FileProviderImpl&)     = delete;
+    FileProviderImpl& operator=(FileProviderImpl&&) noexcept = delete;
+
+    ~FileProviderImpl() override = default;
+
+    CETL_NODISCARD bool start(libcyphal::presentation::Presentation& presentation)
+    {
+        using MakeFailure = libcyphal::presentation::Presentation::MakeFailure;
+
+        auto maybe_read_srv = presentation.makeServer<ReadSvc>([this](const auto& arg, auto continuation) {
+            //
+            handleReadRequest(arg.request, arg.approx_now, std::move(continuation));
+        });
+        if (const auto* const failure = cetl::get_if<MakeFailure>(&maybe_read_srv))
+        {
+            logger_->error("Failed to make 'uavcan.file.Read' server (err={}).", failureToErrorCode(*failure));
+            return false;
+        }
+        read_server_.emplace(cetl::get<ReadServer>(std::move(maybe_read_srv)));
+        return true;
+    }
+
+private:
+    template <typename Continuation>
+    void handleReadRequest(const ReadSvc::Request&    request,
+                           const libcyphal::TimePoint approx_now,
+                           Continuation&&             continuation)
+    {
+        const std::string path{request.path.path.begin(), request.path.path.end()};
+
+        // A read at zero offset is (most likely) the beginning of a new download, so it's a good moment
+        // to check whether the file has been changed (or removed) on disk since it was cached.
+        const bool is_first_read = request.offset == 0;
+
+        ReadSvc::Response response{&memory_};
+        const auto        find_result = file_cache_.find(path, is_first_read);
+        if (const auto* const file = cetl::get_if<MappedFileCache::File>(&find_result))
+        {
+            response._error.value = FileError::OK;
+            if (request.offset < file->size)
+            {
+                // The chunk is copied straight from the mapping (see `MappedFileCache`).
+                const auto offset = static_cast<std::size_t>(request.offset);
+                const auto chunk  = std::min(file->size - offset, MaxChunkSize);
+                response.data.value.resize(chunk);
+                std::copy_n(file->data + offset, chunk, response.data.value.data());  // NOLINT(*-pointer-arithmetic)
+            }
+            if (is_first_read)
+            {
+                logger_->debug("FileProvider: serving '{}' (size={}).", path, file->size);
+            }
+        }
+        else
+        {
+            const auto err        = cetl::get<int>(find_result);
+            response._error.value = toFileError(err);
+            logger_->debug("FileProvider: can't read '{}' (offset={}, err={}).", path, request.offset, err);
+        }
+
+        if (const auto failure = continuation(approx_now + ResponseTimeout, response))
+        {
+            logger_->warn("FileProvider: failed to send 'uavcan.file.Read' response (err={}).",
+                          failureToErrorCode(*failure));
+        }
+    }
+
+    static std::uint16_t toFileError(const int err)
+    {
+        switch (err)
+        {
+        case ENOENT:
+            return FileError::NOT_FOUND;
+        case EISDIR:
+            return FileError::IS_DIRECTORY;
+        case EACCES:
+        case EPERM:
+            return FileError::ACCESS_DENIED;
+        case EINVAL:
+            return FileError::INVALID_VALUE;
+        default:
+            return FileError::IO_ERROR;
+        }
+    }
+
+    cetl::pmr::memory_resource& memory_;
+    MappedFileCache             file_cache_;
+    cetl::optional<ReadServer>  read_server_;
+    common::LoggerPtr           logger_{common::getLogger("engine")};
+
+};  // FileProviderImpl
+
+constexpr libcyphal::Duration FileProviderImpl::ResponseTimeout;
+constexpr std::size_t         FileProviderImpl::MaxChunkSize;
+constexpr std::size_t         FileProviderImpl::MaxMappedFiles;
+constexpr std::size_t         FileProviderImpl::MaxResolvedPaths;
+
+}  // namespace
+
+FileProvider::Ptr FileProvider::make(cetl::pmr::memory_resource&            memory,
+                                     libcyphal::presentation::Presentation& presentation,
+                                     const Config::Ptr&                     config)
+{
+    auto provider = std::make_unique<FileProviderImpl>(memory, config);
+    if (!provider->start(presentation))
+    {
+        return nullptr;
+    }
+    return provider;
+}
+
+}  // namespace cyphal
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
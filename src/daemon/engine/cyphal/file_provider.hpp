@@ -0,0 +1,63 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_DAEMON_ENGINE_CYPHAL_FILE_PROVIDER_HPP_INCLUDED
+#define OCVSMD_DAEMON_ENGINE_CYPHAL_FILE_PROVIDER_HPP_INCLUDED
+
+#include "config.hpp"
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/presentation/presentation.hpp>
+
+#include <memory>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace cyphal
+{
+
+/// Defines the standard Cyphal file server - it serves `uavcan.file.Read` requests from the configured roots.
+///
+/// A requested path is matched against the list of root directories (see `[file_server] roots` config),
+/// and the very first found file is served. Both the path resolution and the open files are cached,
+/// and the files are memory-mapped - so a read is served straight from the mapping (see `MappedFileCache`).
+/// This is what firmware distribution to many nodes at once needs - thousands of small reads of the same file.
+///
+class FileProvider
+{
+public:
+    using Ptr = std::unique_ptr<FileProvider>;
+
+    /// Makes a new file provider, and starts serving the network of the given presentation layer.
+    ///
+    /// @return `nullptr` if the server couldn't be made (see logs for the reason of failure).
+    ///
+    CETL_NODISCARD static Ptr make(cetl::pmr::memory_resource&            memory,
+                                   libcyphal::presentation::Presentation& presentation,
+                                   const Config::Ptr&                     config);
+
+    FileProvider(const FileProvider&)                = delete;
+    FileProvider(FileProvider&&) noexcept            = delete;
+    FileProvider& operator=(const FileProvider&)     = delete;
+    FileProvider& operator=(FileProvider&&) noexcept = delete;
+
+    virtual ~FileProvider() = default;
+
+protected:
+    FileProvider() = default;
+
+};  // FileProvider
+
+}  // namespace cyphal
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_DAEMON_ENGINE_CYPHAL_FILE_PROVIDER_HPP_INCLUDED
@@ -0,0 +1,293 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "mapped_file_cache.hpp"
+
+#include "io/io.hpp"
+#include "ocvsmd/platform/posix_utils.hpp"
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <utility>
+#include <vector>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace cyphal
+{
+namespace
+{
+
+/// Canonicalizes the path (resolves symlinks, `.` and `..`). Returns empty string on failure.
+///
+std::string realPathOf(const std::string& path)
+{
+    std::array<char, PATH_MAX> buffer{};
+    if (::realpath(path.c_str(), buffer.data()) == nullptr)
+    {
+        return {};
+    }
+    return buffer.data();
+}
+
+bool isWithinRoot(const std::string& real_path, const std::string& root)
+{
+    if (root == "/")
+    {
+        return true;
+    }
+    return (real_path.size() > root.size()) && (real_path.compare(0, root.size(), root) == 0) &&
+           (real_path[root.size()] == '/');
+}
+
+}  // namespace
+
+MappedFileCache::Mapping::Mapping(Mapping&& other) noexcept
+    : data_{std::exchange(other.data_, nullptr)}
+    , size_{std::exchange(other.size_, 0)}
+{
+}
+
+MappedFileCache::Mapping& MappedFileCache::Mapping::operator=(Mapping&& other) noexcept
+{
+    const Mapping old{std::move(*this)};
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    return *this;
+}
+
+MappedFileCache::Mapping::~Mapping()
+{
+    if (data_ != nullptr)
+    {
+        ::munmap(data_, size_);
+    }
+}
+
+MappedFileCache::MappedFileCache(const std::vector<std::string>& roots,
+                                 const std::size_t               max_files,
+                                 const std::size_t               max_paths)
+    : max_files_{std::max<std::size_t>(1, max_files)}
+    , max_paths_{std::max<std::size_t>(1, max_paths)}
+{
+    for (const auto& root : roots)
+    {
+        auto real_root = realPathOf(root);
+        if (!real_root.empty())
+        {
+            roots_.push_back(std::move(real_root));
+        }
+    }
+}
+
+MappedFileCache::FindResult MappedFileCache::find(const std::string& path, const bool revalidate)
+{
+    const auto found = path_to_resolved_.find(path);
+    if ((found != path_to_resolved_.end()) && !revalidate)
+    {
+        paths_.splice(paths_.begin(), paths_, found->second);
+        return findMapped(found->second->real_path, false);
+    }
+
+    auto resolve_result = resolve(path);
+    if (const auto* const err = cetl::get_if<int>(&resolve_result))
+    {
+        if (found != path_to_resolved_.end())
+        {
+            paths_.erase(found->second);
+            path_to_resolved_.erase(found);
+        }
+        return *err;
+    }
+    const auto real_path = cetl::get<std::string>(std::move(resolve_result));
+
+    auto result = findMapped(real_path, true);
+    if (cetl::get_if<File>(&result) != nullptr)
+    {
+        rememberPath(path, real_path);
+    }
+    return result;
+}
+
+cetl::variant<std::string, int> MappedFileCache::resolve(const std::string& path) const
+{
+    // Cyphal file paths are always relative (to the roots), but let's tolerate the leading separators.
+    const auto first    = path.find_first_not_of('/');
+    const auto rel_path = (first != std::string::npos) ? path.substr(first) : std::string{};
+
+    for (const auto& root : roots_)
+    {
+        auto real_path = realPathOf(root + '/' + rel_path);
+        if (!real_path.empty() && isWithinRoot(real_path, root))
+        {
+            return real_path;
+        }
+        if (rel_path.empty() && (real_path == root))
+        {
+            return EISDIR;
+        }
+    }
+    return ENOENT;
+}
+
+MappedFileCache::FindResult MappedFileCache::findMapped(const std::string& real_path, const bool revalidate)
+{
+    const auto found = real_path_to_file_.find(real_path);
+    if ((found != real_path_to_file_.end()) && !revalidate)
+    {
+        files_.splice(files_.begin(), files_, found->second);
+        return refresh(*found->second);
+    }
+
+    common::io::OwnFd fd{::open(real_path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (fd.get() < 0)
+    {
+        return errno;
+    }
+    auto identity_result = identityOf(fd.get());
+    if (const auto* const err = cetl::get_if<int>(&identity_result))
+    {
+        return *err;
+    }
+    const auto identity = cetl::get<Identity>(identity_result);
+
+    if (found != real_path_to_file_.end())
+    {
+        if (found->second->identity == identity)
+        {
+            files_.splice(files_.begin(), files_, found->second);
+            return found->second->mapping.view();
+        }
+        files_.erase(found->second);
+        real_path_to_file_.erase(found);
+    }
+
+    auto map_result = map(fd.get(), static_cast<std::size_t>(identity.size));
+    if (const auto* const err = cetl::get_if<int>(&map_result))
+    {
+        return *err;
+    }
+
+    // The file descriptor is kept open - so that changes of the file (in place) could be detected by `fstat`.
+    files_.push_front(MappedFile{real_path, identity, std::move(fd), cetl::get<Mapping>(std::move(map_result))});
+    real_path_to_file_[real_path] = files_.begin();
+    while (files_.size() > max_files_)
+    {
+        real_path_to_file_.erase(files_.back().real_path);
+        files_.pop_back();
+    }
+    return files_.front().mapping.view();
+}
+
+MappedFileCache::FindResult MappedFileCache::refresh(MappedFile& file)
+{
+    auto identity_result = identityOf(file.fd.get());
+    if (const auto* const err = cetl::get_if<int>(&identity_result))
+    {
+        return *err;
+    }
+    const auto identity = cetl::get<Identity>(identity_result);
+    if (identity == file.identity)
+    {
+        return file.mapping.view();
+    }
+
+    // The file has been changed in place (f.e. truncated) - the old mapping might be past its end now.
+    // So the old mapping is released first (even if the new one fails) - to never serve it again.
+    file.mapping = Mapping{nullptr, 0};
+    auto map_result = map(file.fd.get(), static_cast<std::size_t>(identity.size));
+    if (const auto* const err = cetl::get_if<int>(&map_result))
+    {
+        file.identity = Identity{};
+        return *err;
+    }
+    file.identity = identity;
+    file.mapping  = cetl::get<Mapping>(std::move(map_result));
+    return file.mapping.view();
+}
+
+cetl::variant<MappedFileCache::Identity, int> MappedFileCache::identityOf(const int fd)
+{
+    struct stat file_stat{};
+    if (const auto err = ocvsmd::platform::posixSyscallError([fd, &file_stat] {
+            //
+            return ::fstat(fd, &file_stat);
+        }))
+    {
+        return err;
+    }
+    if (S_ISDIR(file_stat.st_mode))
+    {
+        return EISDIR;
+    }
+    if (!S_ISREG(file_stat.st_mode))
+    {
+        return EINVAL;
+    }
+
+    return Identity{static_cast<std::uint64_t>(file_stat.st_dev),
+                    static_cast<std::uint64_t>(file_stat.st_ino),
+                    static_cast<std::uint64_t>(file_stat.st_size),
+                    static_cast<std::int64_t>(file_stat.st_mtime)};
+}
+
+cetl::variant<MappedFileCache::Mapping, int> MappedFileCache::map(const int fd, const std::size_t size)
+{
+    // Empty files can't be mapped, but they are still valid (empty) files.
+    if (size == 0)
+    {
+        return Mapping{nullptr, 0};
+    }
+
+    // Shared (rather than private) mapping - so that in place changes of the file are seen consistently.
+    void* const data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED)  // NOLINT(*-cstyle-cast, *-no-int-to-ptr)
+    {
+        return errno;
+    }
+    // Many nodes usually download the same file at once (at different offsets), so let's read it ahead.
+    (void) ::madvise(data, size, MADV_WILLNEED);
+    return Mapping{data, size};
+}
+
+void MappedFileCache::rememberPath(const std::string& path, const std::string& real_path)
+{
+    const auto found = path_to_resolved_.find(path);
+    if (found != path_to_resolved_.end())
+    {
+        paths_.splice(paths_.begin(), paths_, found->second);
+        found->second->real_path = real_path;
+        return;
+    }
+
+    paths_.push_front(ResolvedPath{path, real_path});
+    path_to_resolved_[path] = paths_.begin();
+    while (paths_.size() > max_paths_)
+    {
+        path_to_resolved_.erase(paths_.back().path);
+        paths_.pop_back();
+    }
+}
+
+}  // namespace cyphal
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
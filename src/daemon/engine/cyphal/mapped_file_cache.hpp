@@ -0,0 +1,193 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_DAEMON_ENGINE_CYPHAL_MAPPED_FILE_CACHE_HPP_INCLUDED
+#define OCVSMD_DAEMON_ENGINE_CYPHAL_MAPPED_FILE_CACHE_HPP_INCLUDED
+
+#include "io/io.hpp"
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace cyphal
+{
+
+/// Defines cache of memory-mapped files found (by their relative paths) under a list of root directories.
+///
+/// Made for serving of `uavcan.file.Read` requests - typically, many nodes download the same (firmware) file
+/// by small chunks at once. So there are two bounded LRU caches:
+/// - resolution of a requested (relative) path to the real path of a file (the first root which has it wins);
+/// - open files (keyed by their real paths) which are mapped into memory - a chunk is served directly
+///   from the mapping (no per-request open/seek/read syscalls).
+///
+/// Files might be replaced on disk (f.e. by a new firmware build), so a lookup could ask for revalidation -
+/// then the path is resolved again, and the file is remapped if its identity (inode, size or modification time)
+/// has changed. It's expected to be done at the beginning of a download (a read at zero offset).
+///
+/// Files might also be modified in place (f.e. truncated) in the middle of a download. Touching mapped pages
+/// past the current end of a file raises `SIGBUS`, so mapped files are also kept open, and every lookup
+/// checks (by `fstat`) the current identity of the file - its view is remapped if the file has been changed.
+///
+class MappedFileCache final
+{
+public:
+    /// Defines a view of the mapped file content.
+    ///
+    /// The view stays valid until the next lookup (which might evict or remap the file).
+    /// It should be consumed right away - the file could be truncated by another process at any moment.
+    ///
+    struct File
+    {
+        const std::uint8_t* data;
+        std::size_t         size;
+    };
+
+    /// Lookup result is either a file view, or an errno-like error code (f.e. `ENOENT` or `EISDIR`).
+    ///
+    using FindResult = cetl::variant<File, int>;
+
+    /// Makes a new cache for the given roots.
+    ///
+    /// Roots are canonicalized (symlinks are resolved) - ones which don't exist are ignored.
+    ///
+    MappedFileCache(const std::vector<std::string>& roots, const std::size_t max_files, const std::size_t max_paths);
+
+    MappedFileCache(const MappedFileCache&)                = delete;
+    MappedFileCache(MappedFileCache&&) noexcept            = delete;
+    MappedFileCache& operator=(const MappedFileCache&)     = delete;
+    MappedFileCache& operator=(MappedFileCache&&) noexcept = delete;
+
+    ~MappedFileCache() = default;
+
+    /// Finds (and maps if needed) the file at the given path - relative to the roots.
+    ///
+    /// Paths which escape their root (f.e. by `..` or symlinks) are not found.
+    ///
+    CETL_NODISCARD FindResult find(const std::string& path, const bool revalidate);
+
+    CETL_NODISCARD const std::vector<std::string>& roots() const noexcept
+    {
+        return roots_;
+    }
+
+    CETL_NODISCARD std::size_t mappedFilesCount() const noexcept
+    {
+        return files_.size();
+    }
+
+private:
+    /// Holds a single mapping of a file - unmaps it on destruction.
+    ///
+    class Mapping final
+    {
+    public:
+        Mapping(void* const data, const std::size_t size) noexcept
+            : data_{data}
+            , size_{size}
+        {
+        }
+
+        Mapping(Mapping&& other) noexcept;
+        Mapping& operator=(Mapping&& other) noexcept;
+
+        Mapping(const Mapping&)            = delete;
+        Mapping& operator=(const Mapping&) = delete;
+
+        ~Mapping();
+
+        File view() const noexcept
+        {
+            return {static_cast<const std::uint8_t*>(data_), size_};
+        }
+
+    private:
+        void*       data_;
+        std::size_t size_;
+
+    };  // Mapping
+
+    /// Identity of a file version - a change of any of these means that the file has been replaced (or modified).
+    ///
+    struct Identity
+    {
+        std::uint64_t device;
+        std::uint64_t inode;
+        std::uint64_t size;
+        std::int64_t  mtime;
+
+        bool operator==(const Identity& other) const noexcept
+        {
+            return (device == other.device) && (inode == other.inode) && (size == other.size) &&
+                   (mtime == other.mtime);
+        }
+    };
+
+    struct MappedFile
+    {
+        std::string       real_path;
+        Identity          identity;
+        common::io::OwnFd fd;
+        Mapping           mapping;
+    };
+    using MappedFiles = std::list<MappedFile>;
+
+    struct ResolvedPath
+    {
+        std::string path;
+        std::string real_path;
+    };
+    using ResolvedPaths = std::list<ResolvedPath>;
+
+    /// Resolves the path against the roots (the first match wins).
+    ///
+    /// @return Either the real path of the found file, or an error code.
+    ///
+    CETL_NODISCARD cetl::variant<std::string, int> resolve(const std::string& path) const;
+
+    CETL_NODISCARD FindResult findMapped(const std::string& real_path, const bool revalidate);
+
+    /// Gets the current view of the cached file - it's remapped if the file has been changed in place.
+    ///
+    CETL_NODISCARD static FindResult refresh(MappedFile& file);
+
+    /// Gets identity of the open file - or an error code (f.e. `EISDIR` if it's not a regular file).
+    ///
+    CETL_NODISCARD static cetl::variant<Identity, int> identityOf(const int fd);
+
+    /// Maps the whole file into memory (empty files are not mapped, but still have a valid empty view).
+    ///
+    CETL_NODISCARD static cetl::variant<Mapping, int> map(const int fd, const std::size_t size);
+
+    void rememberPath(const std::string& path, const std::string& real_path);
+
+    const std::size_t                                        max_files_;
+    const std::size_t                                        max_paths_;
+    std::vector<std::string>                                 roots_;
+    MappedFiles                                              files_;
+    std::unordered_map<std::string, MappedFiles::iterator>   real_path_to_file_;
+    ResolvedPaths                                            paths_;
+    std::unordered_map<std::string, ResolvedPaths::iterator> path_to_resolved_;
+
+};  // MappedFileCache
+
+}  // namespace cyphal
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_DAEMON_ENGINE_CYPHAL_MAPPED_FILE_CACHE_HPP_INCLUDED
@@ -0,0 +1,467 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "node_monitor.hpp"
+
+#include "engine_helpers.hpp"
+#include "logging.hpp"
+
+#include <uavcan/node/GetInfo_1_0.hpp>
+#include <uavcan/node/Heartbeat_1_0.hpp>
+#include <uavcan/node/port/List_0_1.hpp>
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/presentation/client.hpp>
+#include <libcyphal/presentation/presentation.hpp>
+#include <libcyphal/presentation/response_promise.hpp>
+#include <libcyphal/presentation/subscriber.hpp>
+#include <libcyphal/types.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace cyphal
+{
+namespace
+{
+
+class NodeMonitorImpl final : public NodeMonitor
+{
+    using PortListMsg         = uavcan::node::port::List_0_1;
+    using GetInfoSvc          = uavcan::node::GetInfo_1_0;
+    using HeartbeatSubscriber = libcyphal::presentation::Subscriber<Heartbeat>;
+    using PortListSubscriber  = libcyphal::presentation::Subscriber<PortListMsg>;
+    using GetInfoClient       = libcyphal::presentation::ServiceClient<GetInfoSvc>;
+    using GetInfoPromise      = libcyphal::presentation::ResponsePromise<GetInfoSvc::Response>;
+
+    static constexpr libcyphal::Duration OfflineTimeout     = std::chrono::seconds{Heartbeat::OFFLINE_TIMEOUT};
+    static constexpr libcyphal::Duration GetInfoTimeout     = std::chrono::seconds{1};
+    static constexpr std::size_t         MaxGetInfoInFlight = 8;
+
+public:
+    NodeMonitorImpl(cetl::pmr::memory_resource&            memory,
+                    libcyphal::IExecutor&                  executor,
+                    libcyphal::presentation::Presentation& presentation)
+        : memory_{memory}
+        , executor_{executor}
+        , presentation_{presentation}
+        , empty_port_list_{Shadow::PortList::makeEmpty(memory)}
+    {
+    }
+
+    NodeMonitorImpl(const NodeMonitorImpl&)                = delete;
+    NodeMonitorImpl(NodeMonitorImpl&&) noexcept            = delete;
+    NodeMonitorImpl& operator=(const NodeMonitorImpl&)     = delete;
+    NodeMonitorImpl& operator=(NodeMonitorImpl&&) noexcept = delete;
+
+    ~NodeMonitorImpl() override = default;
+
+    CETL_NODISCARD bool start()
+    {
+        using MakeFailure = libcyphal::presentation::Presentation::MakeFailure;
+        using Schedule    = libcyphal::IExecutor::Callback::Schedule;
+
+        auto maybe_hb_sub = presentation_.makeSubscriber<Heartbeat>(Heartbeat::_traits_::FixedPortId);
+        if (const auto* const failure = cetl::get_if<MakeFailure>(&maybe_hb_sub))
+        {
+            logger_->error("NodeMonitor: failed to make heartbeat subscriber (err={}).", failureToErrorCode(*failure));
+            return false;
+        }
+        heartbeat_sub_.emplace(cetl::get<HeartbeatSubscriber>(std::move(maybe_hb_sub)));
+        heartbeat_sub_->setOnReceiveCallback([this](const auto& arg) {
+            //
+            handleHeartbeat(arg.message, arg.metadata.publisher_node_id, arg.approx_now);
+        });
+
+        auto maybe_pl_sub = presentation_.makeSubscriber<PortListMsg>(PortListMsg::_traits_::FixedPortId);
+        if (const auto* const failure = cetl::get_if<MakeFailure>(&maybe_pl_sub))
+        {
+            logger_->error("NodeMonitor: failed to make port list subscriber (err={}).", failureToErrorCode(*failure));
+            return false;
+        }
+        port_list_sub_.emplace(cetl::get<PortListSubscriber>(std::move(maybe_pl_sub)));
+        port_list_sub_->setOnReceiveCallback([this](const auto& arg) {
+            //
+            handlePortList(arg.message, arg.metadata.publisher_node_id, arg.approx_now);
+        });
+
+        // Periodic maintenance: detection of offline nodes, and (re)requesting of missing node infos.
+        maintenance_callback_ = executor_.registerCallback([this](const auto& arg) {
+            //
+            maintain(arg.approx_now);
+        });
+        constexpr auto period = std::chrono::seconds{Heartbeat::MAX_PUBLICATION_PERIOD};
+        maintenance_callback_.schedule(Schedule::Repeat{executor_.now() + period, period});
+
+        return true;
+    }
+
+    // NodeMonitor
+
+    std::uint64_t sequence() const noexcept override
+    {
+        return sequence_;
+    }
+
+    bool hasAnonymous() const noexcept override
+    {
+        return has_anonymous_;
+    }
+
+    const PortIndex& portIndex() const noexcept override
+    {
+        return port_index_;
+    }
+
+    const Shadow* findShadow(const std::uint16_t node_id) const override
+    {
+        const auto found = id_to_shadow_.find(node_id);
+        return (found != id_to_shadow_.end()) ? &found->second : nullptr;
+    }
+
+    void visitChangedSince(const std::uint64_t since_sequence, const ShadowVisitor& visitor) const override
+    {
+        for (auto it = seq_to_node_id_.upper_bound(since_sequence); it != seq_to_node_id_.end(); ++it)
+        {
+            visitor(id_to_shadow_.at(it->second));
+        }
+    }
+
+private:
+    struct GetInfoOp
+    {
+        GetInfoClient  client;
+        GetInfoPromise promise;
+    };
+
+    /// Stamps the given shadow with the next sequence number, and moves it to the end of the change order.
+    ///
+    void markChanged(Shadow& shadow)
+    {
+        seq_to_node_id_.erase(shadow.sequence);
+        shadow.sequence = ++sequence_;
+        seq_to_node_id_.emplace(shadow.sequence, shadow.node_id);
+    }
+
+    void handleHeartbeat(const Heartbeat&                    heartbeat,
+                         const cetl::optional<std::uint16_t> publisher_node_id,
+                         const libcyphal::TimePoint          now)
+    {
+        if (!publisher_node_id)
+        {
+            last_anonymous_at_ = now;
+            if (!has_anonymous_)
+            {
+                has_anonymous_ = true;
+                ++sequence_;
+            }
+            return;
+        }
+        const auto node_id = *publisher_node_id;
+
+        auto found = id_to_shadow_.find(node_id);
+        if (found == id_to_shadow_.end())
+        {
+            logger_->debug("NodeMonitor: node {} is discovered.", node_id);
+
+            Shadow new_shadow{node_id, true, now, heartbeat, cetl::nullopt, cetl::nullopt, 0, 0, 0, 0};
+            auto&  shadow = id_to_shadow_.emplace(node_id, std::move(new_shadow)).first->second;
+            markChanged(shadow);
+            shadow.info_sequence      = shadow.sequence;
+            shadow.port_list_sequence = shadow.sequence;
+            shadow.boot_sequence      = shadow.sequence;
+            requestInfo(node_id, now);
+            return;
+        }
+        auto& shadow = found->second;
+
+        const auto& prev_hb      = shadow.last_heartbeat;
+        const bool  was_online   = shadow.is_online;
+        const bool  is_restarted = heartbeat.uptime < prev_hb.uptime;
+        const bool  is_changed   = !was_online || is_restarted ||                          //
+                               (heartbeat.health.value != prev_hb.health.value) ||  //
+                               (heartbeat.mode.value != prev_hb.mode.value) ||      //
+                               (heartbeat.vendor_specific_status_code != prev_hb.vendor_specific_status_code);
+
+        shadow.is_online         = true;
+        shadow.last_heartbeat_at = now;
+        shadow.last_heartbeat    = heartbeat;
+        if (!is_changed)
+        {
+            return;
+        }
+
+        markChanged(shadow);
+        if (is_restarted || !was_online)
+        {
+            shadow.boot_sequence = shadow.sequence;
+        }
+        if (is_restarted)
+        {
+            logger_->debug("NodeMonitor: node {} has restarted.", node_id);
+
+            if (was_online)
+            {
+                indexPortList(shadow, shadow.port_list, cetl::nullopt);
+            }
+            shadow.info.reset();
+            shadow.port_list.reset();
+            shadow.info_sequence      = shadow.sequence;
+            shadow.port_list_sequence = shadow.sequence;
+            node_id_to_get_info_op_.erase(node_id);
+        }
+        else if (!was_online)
+        {
+            indexPortList(shadow, cetl::nullopt, shadow.port_list);
+        }
+        if (!shadow.info)
+        {
+            requestInfo(node_id, now);
+        }
+    }
+
+    void handlePortList(const PortListMsg&                  port_list,
+                        const cetl::optional<std::uint16_t> publisher_node_id,
+                        const libcyphal::TimePoint          now)
+    {
+        if (!publisher_node_id)
+        {
+            return;
+        }
+        const auto found = id_to_shadow_.find(*publisher_node_id);
+        if (found == id_to_shadow_.end())
+        {
+            // Port lists of nodes which were not (yet) seen via heartbeats are ignored.
+            return;
+        }
+        auto& shadow = found->second;
+
+        Shadow::PortList new_port_list{now,
+                                       subjectIdsOf(port_list.publishers),
+                                       subjectIdsOf(port_list.subscribers),
+                                       ServiceIdSet::fromMask(port_list.clients.mask, memory_),
+                                       ServiceIdSet::fromMask(port_list.servers.mask, memory_)};
+
+        const bool is_changed = !shadow.port_list ||                                            //
+                                (shadow.port_list->publishers != new_port_list.publishers) ||    //
+                                (shadow.port_list->subscribers != new_port_list.subscribers) ||  //
+                                (shadow.port_list->clients != new_port_list.clients) ||          //
+                                (shadow.port_list->servers != new_port_list.servers);
+        if (!is_changed)
+        {
+            shadow.port_list->received_at = now;
+            return;
+        }
+
+        markChanged(shadow);
+        if (shadow.is_online)
+        {
+            indexPortList(shadow, shadow.port_list, new_port_list);
+        }
+        shadow.port_list          = std::move(new_port_list);
+        shadow.port_list_sequence = shadow.sequence;
+    }
+
+    template <typename SubjectIdList>
+    SubjectIdSet subjectIdsOf(const SubjectIdList& list) const
+    {
+        if (const auto* const mask = list.get_mask_if())
+        {
+            return SubjectIdSet::fromMask(*mask, memory_);
+        }
+        if (const auto* const sparse_list = list.get_sparse_list_if())
+        {
+            SubjectIdSet set{memory_};
+            for (const auto& subject_id : *sparse_list)
+            {
+                set.insert(subject_id.value);
+            }
+            return set;
+        }
+        if (list.is_total())
+        {
+            // The node uses all subject IDs (f.e. it's a bus sniffer).
+            return SubjectIdSet::full(memory_);
+        }
+        return SubjectIdSet{memory_};
+    }
+
+    /// Updates the port index by the difference between the old and the new port lists of the node.
+    ///
+    /// Only online nodes are indexed - so a node going offline "removes" its port list from the index,
+    /// and going back online "adds" it again. Missing port list is the same as an empty one.
+    ///
+    void indexPortList(const Shadow&                          shadow,
+                       const cetl::optional<Shadow::PortList>& old_list,
+                       const cetl::optional<Shadow::PortList>& new_list)
+    {
+        const auto& old_ports = old_list ? *old_list : empty_port_list_;
+        const auto& new_ports = new_list ? *new_list : empty_port_list_;
+        const auto  node_id   = shadow.node_id;
+        const auto  sequence  = shadow.sequence;
+
+        using Kind = PortIndex::Kind;
+        port_index_.update(Kind::Publisher, node_id, old_ports.publishers, new_ports.publishers, sequence);
+        port_index_.update(Kind::Subscriber, node_id, old_ports.subscribers, new_ports.subscribers, sequence);
+        port_index_.update(Kind::Client, node_id, old_ports.clients, new_ports.clients, sequence);
+        port_index_.update(Kind::Server, node_id, old_ports.servers, new_ports.servers, sequence);
+    }
+
+    void maintain(const libcyphal::TimePoint now)
+    {
+        if (has_anonymous_ && ((now - last_anonymous_at_) > OfflineTimeout))
+        {
+            has_anonymous_ = false;
+            ++sequence_;
+        }
+
+        for (auto& id_and_shadow : id_to_shadow_)
+        {
+            auto& shadow = id_and_shadow.second;
+            if (!shadow.is_online)
+            {
+                continue;
+            }
+            if ((now - shadow.last_heartbeat_at) > OfflineTimeout)
+            {
+                logger_->debug("NodeMonitor: node {} went offline.", shadow.node_id);
+
+                shadow.is_online = false;
+                node_id_to_get_info_op_.erase(shadow.node_id);
+                markChanged(shadow);
+                indexPortList(shadow, shadow.port_list, cetl::nullopt);
+                continue;
+            }
+            if (!shadow.info)
+            {
+                requestInfo(shadow.node_id, now);
+            }
+        }
+    }
+
+    /// Sends `GetInfo` request to the given node (unless one is already in flight, or there are too many of them).
+    ///
+    /// Nodes which did not respond (or were skipped because of the in-flight limit) are re-requested
+    /// by the periodic maintenance - until they respond, or go offline.
+    ///
+    void requestInfo(const std::uint16_t node_id, const libcyphal::TimePoint now)
+    {
+        using MakeFailure    = libcyphal::presentation::Presentation::MakeFailure;
+        using PromiseFailure = libcyphal::presentation::ResponsePromiseFailure;
+
+        if ((node_id_to_get_info_op_.size() >= MaxGetInfoInFlight) ||
+            (node_id_to_get_info_op_.find(node_id) != node_id_to_get_info_op_.end()))
+        {
+            return;
+        }
+
+        auto maybe_client = presentation_.makeClient<GetInfoSvc>(node_id);
+        if (const auto* const failure = cetl::get_if<MakeFailure>(&maybe_client))
+        {
+            logger_->warn("NodeMonitor: failed to make GetInfo client for node {} (err={}).",
+                          node_id,
+                          failureToErrorCode(*failure));
+            return;
+        }
+        auto client = cetl::get<GetInfoClient>(std::move(maybe_client));
+
+        auto maybe_promise = client.request(now + GetInfoTimeout, GetInfoSvc::Request{&memory_});
+        if (const auto* const failure = cetl::get_if<GetInfoClient::Failure>(&maybe_promise))
+        {
+            logger_->warn("NodeMonitor: failed to send GetInfo request to node {} (err={}).",
+                          node_id,
+                          failureToErrorCode(*failure));
+            return;
+        }
+        auto promise = cetl::get<GetInfoPromise>(std::move(maybe_promise));
+
+        promise.setCallback([this, node_id](const auto& arg) {
+            //
+            if (const auto* const success = cetl::get_if<GetInfoPromise::Success>(&arg.result))
+            {
+                handleInfo(node_id, success->response, arg.approx_now);
+            }
+            else if (const auto* const failure = cetl::get_if<PromiseFailure>(&arg.result))
+            {
+                logger_->trace("NodeMonitor: no GetInfo response from node {} (err={}).",
+                               node_id,
+                               failureToErrorCode(*failure));
+            }
+            // Note that this erases the promise (and so this lambda together with its captures),
+            // hence the key is copied beforehand - nothing of the lambda should be touched after it.
+            const auto key = node_id;
+            node_id_to_get_info_op_.erase(key);
+        });
+        node_id_to_get_info_op_.emplace(node_id, GetInfoOp{std::move(client), std::move(promise)});
+    }
+
+    void handleInfo(const std::uint16_t node_id, const NodeInfo& info, const libcyphal::TimePoint now)
+    {
+        const auto found = id_to_shadow_.find(node_id);
+        if (found == id_to_shadow_.end())
+        {
+            return;
+        }
+        auto& shadow = found->second;
+
+        logger_->debug("NodeMonitor: got info of node {}.", node_id);
+        shadow.info.emplace(Shadow::Info{now, info});
+        markChanged(shadow);
+        shadow.info_sequence = shadow.sequence;
+    }
+
+    cetl::pmr::memory_resource&                  memory_;
+    libcyphal::IExecutor&                        executor_;
+    libcyphal::presentation::Presentation&       presentation_;
+    common::LoggerPtr                            logger_{common::getLogger("engine")};
+    std::uint64_t                                sequence_{0};
+    bool                                         has_anonymous_{false};
+    libcyphal::TimePoint                         last_anonymous_at_{};
+    std::map<std::uint16_t, Shadow>              id_to_shadow_;
+    std::map<std::uint64_t, std::uint16_t>       seq_to_node_id_;
+    PortIndex                                    port_index_;
+    const Shadow::PortList                       empty_port_list_;
+    std::unordered_map<std::uint16_t, GetInfoOp> node_id_to_get_info_op_;
+    cetl::optional<HeartbeatSubscriber>          heartbeat_sub_;
+    cetl::optional<PortListSubscriber>           port_list_sub_;
+    libcyphal::IExecutor::Callback::Any          maintenance_callback_;
+
+};  // NodeMonitorImpl
+
+constexpr libcyphal::Duration NodeMonitorImpl::OfflineTimeout;
+constexpr libcyphal::Duration NodeMonitorImpl::GetInfoTimeout;
+constexpr std::size_t         NodeMonitorImpl::MaxGetInfoInFlight;
+
+}  // namespace
+
+CETL_NODISCARD NodeMonitor::Ptr NodeMonitor::make(cetl::pmr::memory_resource&            memory,
+                                                  libcyphal::IExecutor&                  executor,
+                                                  libcyphal::presentation::Presentation& presentation)
+{
+    auto monitor = std::make_unique<NodeMonitorImpl>(memory, executor, presentation);
+    if (!monitor->start())
+    {
+        return nullptr;
+    }
+    return monitor;
+}
+
+}  // namespace cyphal
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
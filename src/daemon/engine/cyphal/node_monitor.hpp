@@ -0,0 +1,159 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_DAEMON_ENGINE_CYPHAL_NODE_MONITOR_HPP_INCLUDED
+#define OCVSMD_DAEMON_ENGINE_CYPHAL_NODE_MONITOR_HPP_INCLUDED
+
+#include "port_index.hpp"
+#include "port_set.hpp"
+
+#include <uavcan/node/GetInfo_1_0.hpp>
+#include <uavcan/node/Heartbeat_1_0.hpp>
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/presentation/presentation.hpp>
+#include <libcyphal/types.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace cyphal
+{
+
+/// Defines the network monitor - it continuously maintains a table of nodes seen in the network.
+///
+/// The monitor subscribes to `uavcan.node.Heartbeat` and `uavcan.node.port.List` messages,
+/// and requests `uavcan.node.GetInfo` from each node (until it responds) when the node appears or restarts.
+/// Port lists of online nodes are also maintained in the inverted index (see `PortIndex`).
+///
+/// Every significant change of the table (a node going online/offline or restarting, a change of its health,
+/// mode, vendor status, info or port list) is stamped with the next value of the monitor's sequence number.
+/// Consumers remember the last sequence they've seen, and then visit only shadows which have changed since -
+/// the monitor keeps its nodes ordered by their latest change, so such a visit costs proportionally to
+/// the number of changed nodes, not to the size of the table.
+/// Uptime alone is not a significant change (otherwise every heartbeat would be one).
+///
+class NodeMonitor
+{
+public:
+    using Ptr       = std::unique_ptr<NodeMonitor>;
+    using Heartbeat = uavcan::node::Heartbeat_1_0;
+    using NodeInfo  = uavcan::node::GetInfo_1_0::Response;
+
+    /// A shadow represents the latest known state of the remote node.
+    ///
+    struct Shadow
+    {
+        /// The info is available only if the node responded to a `GetInfo` request since its last bootup.
+        /// It's reset when the remote node is detected to have restarted.
+        ///
+        struct Info
+        {
+            libcyphal::TimePoint received_at;
+            NodeInfo             info;
+        };
+
+        /// The port list is reset when the remote node is detected to have restarted.
+        /// It's re-populated as soon as the next `uavcan.node.port.List` message is received.
+        ///
+        /// Port sets are compact (see `PortSet`) - a typical node with a few dozen ports takes tens of bytes.
+        ///
+        struct PortList
+        {
+            libcyphal::TimePoint received_at;
+            SubjectIdSet         publishers;
+            SubjectIdSet         subscribers;
+            ServiceIdSet         clients;
+            ServiceIdSet         servers;
+
+            static PortList makeEmpty(cetl::pmr::memory_resource& memory)
+            {
+                return {{}, SubjectIdSet{memory}, SubjectIdSet{memory}, ServiceIdSet{memory}, ServiceIdSet{memory}};
+            }
+        };
+
+        std::uint16_t node_id;
+        /// If not online, the other fields contain the latest known information.
+        bool                     is_online;
+        libcyphal::TimePoint     last_heartbeat_at;
+        Heartbeat                last_heartbeat;
+        cetl::optional<Info>     info;
+        cetl::optional<PortList> port_list;
+
+        /// Sequence number of the last significant change of the node.
+        std::uint64_t sequence;
+        /// Sequence number of the last change of the info (a subset of the above).
+        std::uint64_t info_sequence;
+        /// Sequence number of the last change of the port list (a subset of the above).
+        std::uint64_t port_list_sequence;
+        /// Sequence number of the latest (re)appearance of the node - its discovery, restart or return from offline.
+        /// Anything learned from the node before it (f.e. values of its registers) might be stale.
+        std::uint64_t boot_sequence;
+
+    };  // Shadow
+
+    using ShadowVisitor = std::function<void(const Shadow& shadow)>;
+
+    /// Makes a new monitor, and starts monitoring the network of the given presentation layer.
+    ///
+    /// @return `nullptr` if subscriptions couldn't be made (see logs for the reason of failure).
+    ///
+    CETL_NODISCARD static Ptr make(cetl::pmr::memory_resource&            memory,
+                                   libcyphal::IExecutor&                  executor,
+                                   libcyphal::presentation::Presentation& presentation);
+
+    NodeMonitor(const NodeMonitor&)                = delete;
+    NodeMonitor(NodeMonitor&&) noexcept            = delete;
+    NodeMonitor& operator=(const NodeMonitor&)     = delete;
+    NodeMonitor& operator=(NodeMonitor&&) noexcept = delete;
+
+    virtual ~NodeMonitor() = default;
+
+    /// Gets the current sequence number - the one of the latest significant change.
+    ///
+    /// Changes are numbered starting from one, so zero could be used by consumers as "nothing seen yet".
+    ///
+    CETL_NODISCARD virtual std::uint64_t sequence() const noexcept = 0;
+
+    /// Says whether any anonymous nodes are online (f.e. someone is trying to get a PnP node-ID allocation).
+    ///
+    CETL_NODISCARD virtual bool hasAnonymous() const noexcept = 0;
+
+    /// Gets the inverted index of port lists of online nodes (f.e. "which nodes publish subject 7509?").
+    ///
+    /// Entries of the index are stamped with the same sequence numbers as the shadows.
+    ///
+    CETL_NODISCARD virtual const PortIndex& portIndex() const noexcept = 0;
+
+    /// Gets the shadow of the given node (if it was ever seen online).
+    ///
+    CETL_NODISCARD virtual const Shadow* findShadow(const std::uint16_t node_id) const = 0;
+
+    /// Visits (in the order of their changes) shadows which have changed after the given sequence number.
+    ///
+    /// Nodes, once seen online, are never removed from the table - so passing zero visits the whole table.
+    ///
+    virtual void visitChangedSince(const std::uint64_t since_sequence, const ShadowVisitor& visitor) const = 0;
+
+protected:
+    NodeMonitor() = default;
+
+};  // NodeMonitor
+
+}  // namespace cyphal
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_DAEMON_ENGINE_CYPHAL_NODE_MONITOR_HPP_INCLUDED
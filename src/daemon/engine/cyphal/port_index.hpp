@@ -0,0 +1,129 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_DAEMON_ENGINE_CYPHAL_PORT_INDEX_HPP_INCLUDED
+#define OCVSMD_DAEMON_ENGINE_CYPHAL_PORT_INDEX_HPP_INCLUDED
+
+#include <cetl/cetl.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace cyphal
+{
+
+/// Defines inverted index of port lists - from a port (subject or service ID) to the nodes which use it.
+///
+/// Answers questions like "which nodes publish subject 7509?" or "who serves service 430?" with a single
+/// hash lookup - instead of scanning port lists of all nodes. The index is updated incrementally -
+/// by the difference between the previous and the new port list of a node (see `update`).
+///
+/// Each entry remembers the sequence number of its last change, so that consumers could detect
+/// changes of the ports they're interested in. Entries are never removed (even when there are no users left),
+/// so that the "no users anymore" change is detectable as well.
+///
+class PortIndex final
+{
+public:
+    enum class Kind : std::uint8_t
+    {
+        Publisher  = 0,
+        Subscriber = 1,
+        Client     = 2,
+        Server     = 3,
+    };
+
+    struct Users
+    {
+        /// Sorted and unique.
+        std::vector<std::uint16_t> node_ids;
+        /// Sequence number of the last change of the entry.
+        std::uint64_t sequence;
+    };
+
+    /// Finds users of the given port.
+    ///
+    /// @return `nullptr` if the port was never used by any node.
+    ///
+    CETL_NODISCARD const Users* find(const Kind kind, const std::uint16_t port_id) const
+    {
+        const auto& port_to_users = kindToPortUsers(kind);
+        const auto  found         = port_to_users.find(port_id);
+        return (found != port_to_users.end()) ? &found->second : nullptr;
+    }
+
+    /// Updates the index by the difference between the old and the new port sets of the given node.
+    ///
+    /// @tparam Set Type of the port set (see `PortSet`).
+    /// @param sequence Sequence number of the change - it's stamped onto all affected entries.
+    ///
+    template <typename Set>
+    void update(const Kind          kind,
+                const std::uint16_t node_id,
+                const Set&          old_ports,
+                const Set&          new_ports,
+                const std::uint64_t sequence)
+    {
+        auto& port_to_users = kindToPortUsers(kind);
+        Set::diff(
+            old_ports,
+            new_ports,
+            [&port_to_users, node_id, sequence](const std::uint16_t port_id) {
+                //
+                auto& users    = port_to_users[port_id];
+                users.sequence = sequence;
+                const auto it  = std::lower_bound(users.node_ids.begin(), users.node_ids.end(), node_id);
+                if ((it == users.node_ids.end()) || (*it != node_id))
+                {
+                    users.node_ids.insert(it, node_id);
+                }
+            },
+            [&port_to_users, node_id, sequence](const std::uint16_t port_id) {
+                //
+                auto& users    = port_to_users[port_id];
+                users.sequence = sequence;
+                const auto it  = std::lower_bound(users.node_ids.begin(), users.node_ids.end(), node_id);
+                if ((it != users.node_ids.end()) && (*it == node_id))
+                {
+                    users.node_ids.erase(it);
+                }
+            });
+    }
+
+private:
+    using PortToUsers = std::unordered_map<std::uint16_t, Users>;
+
+    static constexpr std::size_t KindCount = 4;
+
+    PortToUsers& kindToPortUsers(const Kind kind)
+    {
+        return kind_to_port_users_[static_cast<std::size_t>(kind)];  // NOLINT(*-constant-array-index)
+    }
+
+    const PortToUsers& kindToPortUsers(const Kind kind) const
+    {
+        return kind_to_port_users_[static_cast<std::size_t>(kind)];  // NOLINT(*-constant-array-index)
+    }
+
+    std::array<PortToUsers, KindCount> kind_to_port_users_;
+
+};  // PortIndex
+
+}  // namespace cyphal
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_DAEMON_ENGINE_CYPHAL_PORT_INDEX_HPP_INCLUDED
@@ -0,0 +1,432 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_DAEMON_ENGINE_CYPHAL_PORT_SET_HPP_INCLUDED
+#define OCVSMD_DAEMON_ENGINE_CYPHAL_PORT_SET_HPP_INCLUDED
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace cyphal
+{
+
+/// Defines a compact set of Cyphal port IDs (subject or service ones).
+///
+/// Real nodes use only a few dozen ports, so the set is normally "sparse" - a sorted vector of port IDs
+/// (2 bytes per port). Only when the set grows above the density threshold (where the sparse form would
+/// take more memory than a bitmap) it switches to the "dense" form - a bitmap of the whole port ID range.
+/// There is a hysteresis, so that a set which oscillates around the threshold doesn't switch back and forth.
+///
+/// Set operations (equality, difference) work on 64-bit words of bitmaps if any of the operands is dense,
+/// and by merging of sorted vectors otherwise.
+///
+/// Both forms are allocated from the memory resource given on construction (and inherited by copies).
+/// Note that assignment keeps the memory resource of the target set.
+///
+/// @tparam Capacity Number of possible port IDs (f.e. 8192 for subjects, and 512 for services).
+///
+template <std::size_t Capacity>
+class PortSet final
+{
+    static constexpr std::size_t WordBits  = 64;
+    static constexpr std::size_t WordCount = (Capacity + WordBits - 1) / WordBits;
+
+    using Word   = std::uint64_t;
+    using Bitmap = std::array<Word, WordCount>;
+
+public:
+    using PortId = std::uint16_t;
+
+    /// Number of ports above which the set switches to the dense form (when the sparse one becomes bigger).
+    static constexpr std::size_t DenseThreshold = sizeof(Bitmap) / sizeof(PortId);
+    /// Number of ports below which the dense set switches back to the sparse form.
+    static constexpr std::size_t SparseThreshold = DenseThreshold / 2;
+
+    static_assert(Capacity <= (std::size_t{1} << (sizeof(PortId) * 8U)), "Port IDs must fit into `PortId`.");
+
+    explicit PortSet(cetl::pmr::memory_resource& memory)
+        : sparse_{Sparse::allocator_type{&memory}}
+        , dense_{Dense::allocator_type{&memory}}
+    {
+    }
+
+    // Allocators are passed explicitly - otherwise the copy would get them
+    // from `select_on_container_copy_construction`, which is the default memory resource.
+    PortSet(const PortSet& other)
+        : sparse_{other.sparse_, other.sparse_.get_allocator()}
+        , dense_{other.dense_, other.dense_.get_allocator()}
+        , size_{other.size_}
+    {
+    }
+
+    PortSet(PortSet&& other) noexcept = default;
+
+    PortSet& operator=(const PortSet& other) = default;
+    PortSet& operator=(PortSet&& other)      = default;
+
+    ~PortSet() = default;
+
+    /// Makes a new set from the given mask - anything which has `size()` and `operator[]` returning `bool`
+    /// (f.e. `std::bitset` or a DSDL `bool[N]` array). Mask bits beyond the capacity are ignored.
+    ///
+    template <typename Mask>
+    CETL_NODISCARD static PortSet fromMask(const Mask& mask, cetl::pmr::memory_resource& memory)
+    {
+        PortSet set{memory};
+        set.dense_.assign(WordCount, 0);
+        const auto count = std::min<std::size_t>(mask.size(), Capacity);
+        for (std::size_t port_id = 0; port_id < count; ++port_id)
+        {
+            if (mask[port_id])
+            {
+                set.dense_[port_id / WordBits] |= Word{1} << (port_id % WordBits);
+                ++set.size_;
+            }
+        }
+        set.compact(DenseThreshold);
+        return set;
+    }
+
+    /// Makes a new set from the given (not necessarily sorted or unique) port IDs.
+    /// Port IDs beyond the capacity are ignored.
+    ///
+    template <typename Iterator>
+    CETL_NODISCARD static PortSet fromIds(Iterator first, Iterator last, cetl::pmr::memory_resource& memory)
+    {
+        PortSet set{memory};
+        for (; first != last; ++first)
+        {
+            const auto port_id = static_cast<std::size_t>(*first);
+            if (port_id < Capacity)
+            {
+                set.sparse_.push_back(static_cast<PortId>(port_id));
+            }
+        }
+        std::sort(set.sparse_.begin(), set.sparse_.end());
+        set.sparse_.erase(std::unique(set.sparse_.begin(), set.sparse_.end()), set.sparse_.end());
+        set.size_ = set.sparse_.size();
+        if (set.size_ > DenseThreshold)
+        {
+            set.makeDense();
+        }
+        else
+        {
+            set.sparse_.shrink_to_fit();
+        }
+        return set;
+    }
+
+    /// Makes a new set containing all possible port IDs.
+    ///
+    CETL_NODISCARD static PortSet full(cetl::pmr::memory_resource& memory)
+    {
+        PortSet set{memory};
+        set.dense_.assign(WordCount, ~Word{0});
+        if ((Capacity % WordBits) != 0)
+        {
+            set.dense_.back() = (Word{1} << (Capacity % WordBits)) - 1U;
+        }
+        set.size_ = Capacity;
+        return set;
+    }
+
+    CETL_NODISCARD std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    CETL_NODISCARD bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    CETL_NODISCARD bool isDense() const noexcept
+    {
+        return !dense_.empty();
+    }
+
+    /// Gets number of bytes allocated by the set from its memory resource.
+    ///
+    CETL_NODISCARD std::size_t heapBytes() const noexcept
+    {
+        return (sparse_.capacity() * sizeof(PortId)) + (dense_.capacity() * sizeof(Word));
+    }
+
+    CETL_NODISCARD bool contains(const PortId port_id) const
+    {
+        if (port_id >= Capacity)
+        {
+            return false;
+        }
+        if (isDense())
+        {
+            return (dense_[port_id / WordBits] & (Word{1} << (port_id % WordBits))) != 0;
+        }
+        return std::binary_search(sparse_.begin(), sparse_.end(), port_id);
+    }
+
+    /// Inserts the given port ID.
+    ///
+    /// @return `true` if the port ID was inserted (`false` if already present, or out of the capacity).
+    ///
+    bool insert(const PortId port_id)
+    {
+        if (port_id >= Capacity)
+        {
+            return false;
+        }
+        if (isDense())
+        {
+            auto&      word = dense_[port_id / WordBits];
+            const Word bit  = Word{1} << (port_id % WordBits);
+            if ((word & bit) != 0)
+            {
+                return false;
+            }
+            word |= bit;
+            ++size_;
+            return true;
+        }
+
+        const auto it = std::lower_bound(sparse_.begin(), sparse_.end(), port_id);
+        if ((it != sparse_.end()) && (*it == port_id))
+        {
+            return false;
+        }
+        sparse_.insert(it, port_id);
+        ++size_;
+        if (size_ > DenseThreshold)
+        {
+            makeDense();
+        }
+        return true;
+    }
+
+    /// Erases the given port ID.
+    ///
+    /// @return `true` if the port ID was erased (`false` if it was not present).
+    ///
+    bool erase(const PortId port_id)
+    {
+        if (!contains(port_id))
+        {
+            return false;
+        }
+        --size_;
+        if (isDense())
+        {
+            dense_[port_id / WordBits] &= ~(Word{1} << (port_id % WordBits));
+            compact(SparseThreshold);
+        }
+        else
+        {
+            sparse_.erase(std::lower_bound(sparse_.begin(), sparse_.end(), port_id));
+        }
+        return true;
+    }
+
+    /// Visits all port IDs of the set in ascending order.
+    ///
+    template <typename Visitor>
+    void forEach(Visitor&& visitor) const
+    {
+        if (isDense())
+        {
+            forEachBit(dense_, std::forward<Visitor>(visitor));
+            return;
+        }
+        for (const auto port_id : sparse_)
+        {
+            visitor(port_id);
+        }
+    }
+
+    /// Visits runs (maximal ranges of consecutive port IDs) of the set in ascending order.
+    ///
+    /// The visitor is called with the first and the last port IDs of each run.
+    ///
+    template <typename Visitor>
+    void forEachRun(Visitor&& visitor) const
+    {
+        bool   has_run = false;
+        PortId first   = 0;
+        PortId last    = 0;
+        forEach([&](const PortId port_id) {
+            //
+            if (has_run && (port_id == (last + 1U)))
+            {
+                last = port_id;
+                return;
+            }
+            if (has_run)
+            {
+                visitor(first, last);
+            }
+            has_run = true;
+            first   = port_id;
+            last    = port_id;
+        });
+        if (has_run)
+        {
+            visitor(first, last);
+        }
+    }
+
+    /// Visits the difference between two sets - port IDs which are only in the `to` set are "added",
+    /// and those which are only in the `from` set are "removed". Both visits are in ascending order.
+    ///
+    template <typename AddedVisitor, typename RemovedVisitor>
+    static void diff(const PortSet& from, const PortSet& to, AddedVisitor&& added, RemovedVisitor&& removed)
+    {
+        if (!from.isDense() && !to.isDense())
+        {
+            auto from_it = from.sparse_.begin();
+            auto to_it   = to.sparse_.begin();
+            while ((from_it != from.sparse_.end()) || (to_it != to.sparse_.end()))
+            {
+                if ((to_it == to.sparse_.end()) || ((from_it != from.sparse_.end()) && (*from_it < *to_it)))
+                {
+                    removed(*from_it++);
+                }
+                else if ((from_it == from.sparse_.end()) || (*to_it < *from_it))
+                {
+                    added(*to_it++);
+                }
+                else
+                {
+                    ++from_it;
+                    ++to_it;
+                }
+            }
+            return;
+        }
+
+        const Bitmap from_bits = from.toBitmap();
+        const Bitmap to_bits   = to.toBitmap();
+        Bitmap       added_bits{};
+        Bitmap       removed_bits{};
+        for (std::size_t i = 0; i < WordCount; ++i)
+        {
+            added_bits[i]   = to_bits[i] & ~from_bits[i];  // NOLINT(*-constant-array-index)
+            removed_bits[i] = from_bits[i] & ~to_bits[i];  // NOLINT(*-constant-array-index)
+        }
+        forEachBit(added_bits, std::forward<AddedVisitor>(added));
+        forEachBit(removed_bits, std::forward<RemovedVisitor>(removed));
+    }
+
+    friend bool operator==(const PortSet& lhs, const PortSet& rhs)
+    {
+        if (lhs.size_ != rhs.size_)
+        {
+            return false;
+        }
+        if (!lhs.isDense() && !rhs.isDense())
+        {
+            return lhs.sparse_ == rhs.sparse_;
+        }
+        return lhs.toBitmap() == rhs.toBitmap();
+    }
+
+    friend bool operator!=(const PortSet& lhs, const PortSet& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    using Sparse = std::vector<PortId, cetl::pmr::polymorphic_allocator<PortId>>;
+    using Dense  = std::vector<Word, cetl::pmr::polymorphic_allocator<Word>>;
+
+    /// Visits set bits of the given words (either a `Bitmap` or the dense form) in ascending order.
+    ///
+    template <typename Words, typename Visitor>
+    static void forEachBit(const Words& bitmap, Visitor&& visitor)
+    {
+        for (std::size_t i = 0; i < WordCount; ++i)
+        {
+            Word word = bitmap[i];  // NOLINT(*-constant-array-index)
+            while (word != 0)
+            {
+                const auto bit = static_cast<std::size_t>(__builtin_ctzll(word));
+                visitor(static_cast<PortId>((i * WordBits) + bit));
+                word &= word - 1U;
+            }
+        }
+    }
+
+    Bitmap toBitmap() const
+    {
+        Bitmap bitmap{};
+        if (isDense())
+        {
+            std::copy(dense_.begin(), dense_.end(), bitmap.begin());
+            return bitmap;
+        }
+        for (const auto port_id : sparse_)
+        {
+            bitmap[port_id / WordBits] |= Word{1} << (port_id % WordBits);  // NOLINT(*-constant-array-index)
+        }
+        return bitmap;
+    }
+
+    void makeDense()
+    {
+        const Bitmap bitmap = toBitmap();
+        dense_.assign(bitmap.begin(), bitmap.end());
+        Sparse{sparse_.get_allocator()}.swap(sparse_);
+    }
+
+    /// Switches the dense set to the sparse form if it's below the given threshold.
+    ///
+    void compact(const std::size_t threshold)
+    {
+        if (!isDense() || (size_ >= threshold))
+        {
+            return;
+        }
+        sparse_.reserve(size_);
+        forEachBit(dense_, [this](const PortId port_id) { sparse_.push_back(port_id); });
+        Dense{dense_.get_allocator()}.swap(dense_);
+    }
+
+    Sparse      sparse_;
+    Dense       dense_;  // Either empty (the sparse form) or of `WordCount` words.
+    std::size_t size_{0};
+
+};  // PortSet
+
+template <std::size_t Capacity>
+constexpr std::size_t PortSet<Capacity>::WordBits;
+template <std::size_t Capacity>
+constexpr std::size_t PortSet<Capacity>::WordCount;
+template <std::size_t Capacity>
+constexpr std::size_t PortSet<Capacity>::DenseThreshold;
+template <std::size_t Capacity>
+constexpr std::size_t PortSet<Capacity>::SparseThreshold;
+
+/// Set of subject IDs (see `uavcan.node.port.SubjectID.1.0`).
+using SubjectIdSet = PortSet<8192>;  // NOLINT(*-magic-numbers)
+
+/// Set of service IDs (see `uavcan.node.port.ServiceID.1.0`).
+using ServiceIdSet = PortSet<512>;  // NOLINT(*-magic-numbers)
+
+}  // namespace cyphal
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_DAEMON_ENGINE_CYPHAL_PORT_SET_HPP_INCLUDED
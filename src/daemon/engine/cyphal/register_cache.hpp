@@ -0,0 +1,178 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_DAEMON_ENGINE_CYPHAL_REGISTER_CACHE_HPP_INCLUDED
+#define OCVSMD_DAEMON_ENGINE_CYPHAL_REGISTER_CACHE_HPP_INCLUDED
+
+#include <libcyphal/types.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace cyphal
+{
+
+/// Defines bounded cache of register values of remote nodes - from (node ID, register name) to the latest known value.
+///
+/// Every value is stored together with the "boot sequence" of its node (see `NodeMonitor::Shadow::boot_sequence`).
+/// As soon as the node is seen with a different boot sequence (f.e. it has restarted), all its values are dropped -
+/// the node might have come back with a different configuration.
+///
+/// The cache is bounded in number of entries - the least recently used one is evicted when the capacity is exceeded.
+///
+/// @tparam Value Type of cached values (f.e. `uavcan.register.Access` response).
+///
+template <typename Value>
+class RegisterCache final
+{
+public:
+    struct Entry
+    {
+        Value                value;
+        libcyphal::TimePoint stored_at;
+    };
+
+    explicit RegisterCache(const std::size_t capacity)
+        : capacity_{std::max<std::size_t>(1, capacity)}
+    {
+    }
+
+    /// Stores the latest value of the node's register.
+    ///
+    void store(const std::uint16_t        node_id,
+               const std::uint64_t        boot_sequence,
+               const std::string&         name,
+               Value                      value,
+               const libcyphal::TimePoint now)
+    {
+        syncBootSequence(node_id, boot_sequence);
+
+        auto key   = makeKey(node_id, name);
+        auto found = key_to_item_.find(key);
+        if (found != key_to_item_.end())
+        {
+            items_.splice(items_.begin(), items_, found->second);
+            found->second->entry = Entry{std::move(value), now};
+            return;
+        }
+
+        items_.push_front(Item{key, node_id, Entry{std::move(value), now}});
+        key_to_item_.emplace(std::move(key), items_.begin());
+        while (items_.size() > capacity_)
+        {
+            eraseItem(std::prev(items_.end()));
+        }
+    }
+
+    /// Finds the value of the node's register - if it's not older than the given maximum age.
+    ///
+    /// @return Pointer to the entry which stays valid until the next modification of the cache.
+    ///
+    const Entry* find(const std::uint16_t        node_id,
+                      const std::uint64_t        boot_sequence,
+                      const std::string&         name,
+                      const libcyphal::TimePoint now,
+                      const libcyphal::Duration  max_age)
+    {
+        syncBootSequence(node_id, boot_sequence);
+
+        const auto found = key_to_item_.find(makeKey(node_id, name));
+        if ((found == key_to_item_.end()) || ((now - found->second->entry.stored_at) > max_age))
+        {
+            return nullptr;
+        }
+        items_.splice(items_.begin(), items_, found->second);
+        return &found->second->entry;
+    }
+
+    /// Drops the value of the node's register (if any) - f.e. when a write has failed, and so the value is unknown.
+    ///
+    void erase(const std::uint16_t node_id, const std::string& name)
+    {
+        const auto found = key_to_item_.find(makeKey(node_id, name));
+        if (found != key_to_item_.end())
+        {
+            eraseItem(found->second);
+        }
+    }
+
+    std::size_t size() const noexcept
+    {
+        return items_.size();
+    }
+
+private:
+    struct Item
+    {
+        std::string   key;
+        std::uint16_t node_id;
+        Entry         entry;
+    };
+    using Items = std::list<Item>;
+
+    static std::string makeKey(const std::uint16_t node_id, const std::string& name)
+    {
+        std::string key;
+        key.reserve(name.size() + 2);
+        key.push_back(static_cast<char>(node_id & 0xFFU));
+        key.push_back(static_cast<char>(node_id >> 8U));
+        key.append(name);
+        return key;
+    }
+
+    /// Drops all values of the node if its boot sequence has changed.
+    ///
+    /// Restarts are rare, so it's ok to scan the whole cache for the node's values.
+    ///
+    void syncBootSequence(const std::uint16_t node_id, const std::uint64_t boot_sequence)
+    {
+        auto& node_boot_sequence = node_to_boot_sequence_[node_id];
+        if (node_boot_sequence == boot_sequence)
+        {
+            return;
+        }
+        node_boot_sequence = boot_sequence;
+
+        for (auto it = items_.begin(); it != items_.end();)
+        {
+            const auto curr = it++;
+            if (curr->node_id == node_id)
+            {
+                eraseItem(curr);
+            }
+        }
+    }
+
+    void eraseItem(const typename Items::iterator item)
+    {
+        key_to_item_.erase(item->key);
+        items_.erase(item);
+    }
+
+    const std::size_t                                         capacity_;
+    Items                                                     items_;
+    std::unordered_map<std::string, typename Items::iterator> key_to_item_;
+    std::unordered_map<std::uint16_t, std::uint64_t>          node_to_boot_sequence_;
+
+};  // RegisterCache
+
+}  // namespace cyphal
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_DAEMON_ENGINE_CYPHAL_REGISTER_CACHE_HPP_INCLUDED
@@ -0,0 +1,569 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "register_client.hpp"
+
+#include "client_cache.hpp"
+#include "node_monitor.hpp"
+#include "register_cache.hpp"
+#include "engine_helpers.hpp"
+#include "logging.hpp"
+
+#include <uavcan/_register/Access_1_0.hpp>
+#include <uavcan/_register/List_1_0.hpp>
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/presentation/client.hpp>
+#include <libcyphal/presentation/presentation.hpp>
+#include <libcyphal/presentation/response_promise.hpp>
+#include <libcyphal/types.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace cyphal
+{
+namespace
+{
+
+/// Defines common machinery of pipelined multi-node operations (both list and access ones).
+///
+/// Each node has its own sequence of calls (numbered by index), and its own window of calls in flight.
+/// As soon as a call completes, the next one (if any) is sent to the same node - so the node is never idle.
+///
+/// @tparam Svc Cyphal service type of calls (`uavcan.register.List` or `Access`).
+///
+template <typename Svc>
+class PipelinedOperation : public RegisterClient::Operation
+{
+public:
+    using Client      = libcyphal::presentation::ServiceClient<Svc>;
+    using ClientCache = cyphal::ClientCache<std::uint16_t, Client>;
+
+    /// Holds references to the register client parts needed by its operations.
+    ///
+    struct Context
+    {
+        cetl::pmr::memory_resource&            memory;
+        libcyphal::IExecutor&                  executor;
+        libcyphal::presentation::Presentation& presentation;
+        typename ClientCache::Ptr              clients;
+    };
+
+    PipelinedOperation(const Context&                    context,
+                       const std::vector<std::uint16_t>& node_ids,
+                       const RegisterClient::Options&    options,
+                       const std::size_t                 calls_per_node,
+                       RegisterClient::DoneHandler       done_handler)
+        : context_{context}
+        , deadline_{options.deadline}
+        , window_{std::min(MaxWindow, (options.window > 0) ? options.window : DefaultWindow)}
+        , done_handler_{std::move(done_handler)}
+    {
+        // It's ok to have duplicates in the request - we just ignore duplicates, and work with unique ones.
+        const std::unordered_set<std::uint16_t> unique_node_ids{node_ids.begin(), node_ids.end()};
+        nodes_.reserve(unique_node_ids.size());
+        for (const auto node_id : unique_node_ids)
+        {
+            nodes_.push_back(Node{node_id, 0, calls_per_node, 0, false});
+        }
+        remaining_nodes_ = nodes_.size();
+    }
+
+    PipelinedOperation(const PipelinedOperation&)                = delete;
+    PipelinedOperation(PipelinedOperation&&) noexcept            = delete;
+    PipelinedOperation& operator=(const PipelinedOperation&)     = delete;
+    PipelinedOperation& operator=(PipelinedOperation&&) noexcept = delete;
+
+    ~PipelinedOperation() override = default;
+
+    /// Starts the operation on the next spin of the executor (see `RegisterClient::Operation`).
+    ///
+    void start()
+    {
+        using Schedule = libcyphal::IExecutor::Callback::Schedule;
+
+        start_callback_ = context_.executor.registerCallback([this](const auto&) {
+            //
+            for (auto& node : nodes_)
+            {
+                if (!pump(node))
+                {
+                    return;
+                }
+            }
+            if (remaining_nodes_ == 0)
+            {
+                done_handler_();
+            }
+        });
+        start_callback_.schedule(Schedule::Once{context_.executor.now()});
+    }
+
+protected:
+    /// Holds the pipeline state of a single node.
+    ///
+    struct Node
+    {
+        std::uint16_t node_id;
+        /// Index of the next call to send.
+        std::size_t next;
+        /// Index past the last call to send - could be shrunk by a derived operation (f.e. at the end of a list).
+        std::size_t end;
+        std::size_t in_flight;
+        bool        is_done;
+    };
+
+    cetl::pmr::memory_resource& memory() const
+    {
+        return context_.memory;
+    }
+
+    /// Makes the Cyphal request of the call at the given index.
+    ///
+    CETL_NODISCARD virtual typename Svc::Request makeRequest(const std::size_t index) const = 0;
+
+    /// Gives a chance to complete the call at the given index locally - without a remote call (f.e. from a cache).
+    ///
+    /// @return `cetl::nullopt` if the call has to be sent to the node,
+    ///         otherwise the result of the local completion (see `handleResult`).
+    ///
+    CETL_NODISCARD virtual cetl::optional<bool> tryCompleteLocally(Node& node, const std::size_t index)
+    {
+        (void) node;
+        (void) index;
+        return cetl::nullopt;
+    }
+
+    /// Handles result of the call at the given index - either its response, or an error (then `response` is null).
+    ///
+    /// @return `false` if the operation was stopped (see `RegisterClient::ListHandler`).
+    ///
+    CETL_NODISCARD virtual bool handleResult(Node&                         node,
+                                             const std::size_t             index,
+                                             const int                     error_code,
+                                             const typename Svc::Response* response) = 0;
+
+private:
+    using Promise        = libcyphal::presentation::ResponsePromise<typename Svc::Response>;
+    using PromiseFailure = libcyphal::presentation::ResponsePromiseFailure;
+
+    static constexpr std::size_t DefaultWindow = 4;
+    static constexpr std::size_t MaxWindow     = 16;
+
+    struct Call
+    {
+        Client  client;
+        Promise promise;
+    };
+
+    static std::uint64_t callKey(const std::uint16_t node_id, const std::size_t index) noexcept
+    {
+        return (static_cast<std::uint64_t>(index) << 16U) | node_id;
+    }
+
+    /// Sends calls to the node until its window is full (or there is nothing more to send).
+    ///
+    /// @return `false` if the operation was stopped.
+    ///
+    CETL_NODISCARD bool pump(Node& node)
+    {
+        while ((node.in_flight < window_) && (node.next < node.end))
+        {
+            const auto index = node.next++;
+            if (const auto local_result = tryCompleteLocally(node, index))
+            {
+                if (!*local_result)
+                {
+                    return false;
+                }
+                continue;
+            }
+            if (const auto err = call(node, index))
+            {
+                if (!handleResult(node, index, err, nullptr))
+                {
+                    return false;
+                }
+            }
+        }
+
+        if (!node.is_done && (node.in_flight == 0) && (node.next >= node.end))
+        {
+            node.is_done = true;
+            --remaining_nodes_;
+        }
+        return true;
+    }
+
+    CETL_NODISCARD int call(Node& node, const std::size_t index)
+    {
+        using MakeFailure = libcyphal::presentation::Presentation::MakeFailure;
+
+        // Calls which didn't get their turn before the deadline are timed out.
+        if (context_.executor.now() >= deadline_)
+        {
+            return ETIMEDOUT;
+        }
+
+        const auto node_id     = node.node_id;
+        auto       make_result = context_.clients->getOrMake(node_id, [this, node_id] {
+            //
+            return context_.presentation.template makeClient<Svc>(node_id);
+        });
+        if (const auto* const failure = cetl::get_if<MakeFailure>(&make_result))
+        {
+            return failureToErrorCode(*failure);
+        }
+        auto client = cetl::get<Client>(std::move(make_result));
+
+        auto req_result = client.request(deadline_, makeRequest(index));
+        if (const auto* const failure = cetl::get_if<typename Client::Failure>(&req_result))
+        {
+            context_.clients->evict(node_id);  // Next call will try a fresh client.
+            return failureToErrorCode(*failure);
+        }
+        auto promise = cetl::get<Promise>(std::move(req_result));
+
+        auto* const node_ptr = &node;
+        promise.setCallback([this, node_ptr, index](const auto& arg) {
+            //
+            // The call is released right away - together with its promise, and so with this very lambda.
+            // Hence everything needed after the release (captures and the response) is copied to locals first.
+            auto* const self       = this;
+            auto&       call_node  = *node_ptr;
+            const auto  call_index = index;
+            const auto  key        = callKey(call_node.node_id, call_index);
+            --call_node.in_flight;
+
+            if (const auto* const success = cetl::get_if<typename Promise::Success>(&arg.result))
+            {
+                const auto response = success->response;
+                self->calls_.erase(key);
+                self->onCallDone(call_node, call_index, 0, &response);
+            }
+            else
+            {
+                const auto err = failureToErrorCode(cetl::get<PromiseFailure>(arg.result));
+                self->calls_.erase(key);
+                self->onCallDone(call_node, call_index, err, nullptr);
+            }
+        });
+
+        calls_.emplace(callKey(node_id, index), Call{std::move(client), std::move(promise)});
+        ++node.in_flight;
+        return 0;
+    }
+
+    void onCallDone(Node&                         node,
+                    const std::size_t             index,
+                    const int                     error_code,
+                    const typename Svc::Response* response)
+    {
+        if (!handleResult(node, index, error_code, response) || !pump(node))
+        {
+            return;
+        }
+        if (node.is_done && (remaining_nodes_ == 0))
+        {
+            done_handler_();
+        }
+    }
+
+    const Context                           context_;
+    const libcyphal::TimePoint              deadline_;
+    const std::size_t                       window_;
+    RegisterClient::DoneHandler             done_handler_;
+    std::vector<Node>                       nodes_;
+    std::size_t                             remaining_nodes_{0};
+    libcyphal::IExecutor::Callback::Any     start_callback_;
+    std::unordered_map<std::uint64_t, Call> calls_;
+
+};  // PipelinedOperation
+
+template <typename Svc>
+constexpr std::size_t PipelinedOperation<Svc>::DefaultWindow;
+template <typename Svc>
+constexpr std::size_t PipelinedOperation<Svc>::MaxWindow;
+
+/// Enumerates register names by `uavcan.register.List` requests with increasing indices.
+///
+/// The total number of registers is not known in advance, so requests are sent speculatively (up to the window
+/// ahead), and the first empty name marks the end of the list - results of requests past it are ignored.
+///
+class ListOperation final : public PipelinedOperation<RegisterClient::ListSvc>
+{
+    using Base = PipelinedOperation<RegisterClient::ListSvc>;
+    using Svc  = RegisterClient::ListSvc;
+
+public:
+    ListOperation(const Context&                    context,
+                  const std::vector<std::uint16_t>& node_ids,
+                  const RegisterClient::Options&    options,
+                  RegisterClient::ListHandler       list_handler,
+                  RegisterClient::DoneHandler       done_handler)
+        : Base{context, node_ids, options, MaxListSize, std::move(done_handler)}
+        , list_handler_{std::move(list_handler)}
+    {
+    }
+
+private:
+    // `uavcan.register.List` request index is 16-bit.
+    static constexpr std::size_t MaxListSize = std::numeric_limits<std::uint16_t>::max() + 1UL;
+
+    Svc::Request makeRequest(const std::size_t index) const override
+    {
+        Svc::Request request{&memory()};
+        request.index = static_cast<std::uint16_t>(index);
+        return request;
+    }
+
+    bool handleResult(Node&                      node,
+                      const std::size_t          index,
+                      const int                  error_code,
+                      const Svc::Response* const response) override
+    {
+        if (index >= node.end)
+        {
+            return true;
+        }
+        if (error_code != 0)
+        {
+            node.end = index;
+            return list_handler_(node.node_id, static_cast<std::uint16_t>(index), error_code, RegisterClient::Name{});
+        }
+        if (response->name.name.empty())
+        {
+            node.end = index;
+            return true;
+        }
+        return list_handler_(node.node_id, static_cast<std::uint16_t>(index), 0, response->name);
+    }
+
+    RegisterClient::ListHandler list_handler_;
+
+};  // ListOperation
+
+constexpr std::size_t ListOperation::MaxListSize;
+
+using AccessCache = RegisterCache<RegisterClient::AccessSvc::Response>;
+
+/// Sends the same set of `uavcan.register.Access` requests to each node.
+///
+/// Reads are served from the register cache (if allowed by the max age option, and the value is fresh enough).
+/// Results of all remote calls (both reads and writes) are stored back to the cache.
+///
+class AccessOperation final : public PipelinedOperation<RegisterClient::AccessSvc>
+{
+    using Base = PipelinedOperation<RegisterClient::AccessSvc>;
+    using Svc  = RegisterClient::AccessSvc;
+
+public:
+    AccessOperation(const Context&                    context,
+                    AccessCache&                      cache,
+                    const NodeMonitor&                node_monitor,
+                    const std::vector<std::uint16_t>& node_ids,
+                    std::vector<Svc::Request>         requests,
+                    const RegisterClient::Options&    options,
+                    RegisterClient::AccessHandler     access_handler,
+                    RegisterClient::DoneHandler       done_handler)
+        : Base{context, node_ids, options, requests.size(), std::move(done_handler)}
+        , executor_{context.executor}
+        , cache_{cache}
+        , node_monitor_{node_monitor}
+        , max_age_{options.max_age}
+        , requests_{std::move(requests)}
+        , access_handler_{std::move(access_handler)}
+        , empty_response_{&context.memory}
+    {
+        names_.reserve(requests_.size());
+        for (const auto& request : requests_)
+        {
+            names_.emplace_back(request.name.name.begin(), request.name.name.end());
+        }
+    }
+
+private:
+    Svc::Request makeRequest(const std::size_t index) const override
+    {
+        return requests_[index];
+    }
+
+    cetl::optional<bool> tryCompleteLocally(Node& node, const std::size_t index) override
+    {
+        const auto& request = requests_[index];
+        if ((max_age_ <= libcyphal::Duration::zero()) || !request.value.is_empty())
+        {
+            return cetl::nullopt;
+        }
+
+        const auto* const entry = cache_.find(node.node_id, bootSequenceOf(node), names_[index], now(), max_age_);
+        if (entry == nullptr)
+        {
+            return cetl::nullopt;
+        }
+        return access_handler_(node.node_id, request.name, 0, entry->value);
+    }
+
+    bool handleResult(Node&                      node,
+                      const std::size_t          index,
+                      const int                  error_code,
+                      const Svc::Response* const response) override
+    {
+        if (response != nullptr)
+        {
+            cache_.store(node.node_id, bootSequenceOf(node), names_[index], *response, now());
+        }
+        else if (!requests_[index].value.is_empty())
+        {
+            // The write has failed, so the current value of the register is unknown.
+            cache_.erase(node.node_id, names_[index]);
+        }
+
+        return access_handler_(node.node_id,
+                               requests_[index].name,
+                               error_code,
+                               (response != nullptr) ? *response : empty_response_);
+    }
+
+    libcyphal::TimePoint now() const
+    {
+        return executor_.now();
+    }
+
+    std::uint64_t bootSequenceOf(const Node& node) const
+    {
+        const auto* const shadow = node_monitor_.findShadow(node.node_id);
+        return (shadow != nullptr) ? shadow->boot_sequence : 0;
+    }
+
+    libcyphal::IExecutor&           executor_;
+    AccessCache&                    cache_;
+    const NodeMonitor&              node_monitor_;
+    const libcyphal::Duration       max_age_;
+    const std::vector<Svc::Request> requests_;
+    std::vector<std::string>        names_;
+    RegisterClient::AccessHandler   access_handler_;
+    const Svc::Response             empty_response_;
+
+};  // AccessOperation
+
+class RegisterClientImpl final : public RegisterClient
+{
+public:
+    RegisterClientImpl(cetl::pmr::memory_resource&            memory,
+                       libcyphal::IExecutor&                  executor,
+                       libcyphal::presentation::Presentation& presentation,
+                       const NodeMonitor&                     node_monitor,
+                       const std::size_t                      cache_capacity)
+        : memory_{memory}
+        , executor_{executor}
+        , presentation_{presentation}
+        , node_monitor_{node_monitor}
+        , cache_{cache_capacity}
+        , list_clients_{ListOperation::ClientCache::make(executor, ClientCacheCapacity, ClientCacheIdleTimeout)}
+        , access_clients_{AccessOperation::ClientCache::make(executor, ClientCacheCapacity, ClientCacheIdleTimeout)}
+    {
+    }
+
+    // MARK: RegisterClient
+
+    Operation::Ptr list(const std::vector<std::uint16_t>& node_ids,
+                        const Options&                    options,
+                        ListHandler                       list_handler,
+                        DoneHandler                       done_handler) override
+    {
+        logger_->trace("RegisterClient::list (nodes={}, window={}).", node_ids.size(), options.window);
+
+        auto operation = std::make_unique<ListOperation>(ListOperation::Context{memory_,
+                                                                                executor_,
+                                                                                presentation_,
+                                                                                list_clients_},
+                                                         node_ids,
+                                                         options,
+                                                         std::move(list_handler),
+                                                         std::move(done_handler));
+        operation->start();
+        return operation;
+    }
+
+    Operation::Ptr access(const std::vector<std::uint16_t>&      node_ids,
+                          const std::vector<AccessSvc::Request>& requests,
+                          const Options&                         options,
+                          AccessHandler                          access_handler,
+                          DoneHandler                            done_handler) override
+    {
+        logger_->trace("RegisterClient::access (nodes={}, registers={}, window={}, cached={}).",
+                       node_ids.size(),
+                       requests.size(),
+                       options.window,
+                       cache_.size());
+
+        auto operation = std::make_unique<AccessOperation>(AccessOperation::Context{memory_,
+                                                                                    executor_,
+                                                                                    presentation_,
+                                                                                    access_clients_},
+                                                           cache_,
+                                                           node_monitor_,
+                                                           node_ids,
+                                                           requests,
+                                                           options,
+                                                           std::move(access_handler),
+                                                           std::move(done_handler));
+        operation->start();
+        return operation;
+    }
+
+private:
+    static constexpr std::size_t         ClientCacheCapacity    = 256;
+    static constexpr libcyphal::Duration ClientCacheIdleTimeout = std::chrono::seconds{30};
+
+    cetl::pmr::memory_resource&            memory_;
+    libcyphal::IExecutor&                  executor_;
+    libcyphal::presentation::Presentation& presentation_;
+    const NodeMonitor&                     node_monitor_;
+    AccessCache                            cache_;
+    ListOperation::ClientCache::Ptr        list_clients_;
+    AccessOperation::ClientCache::Ptr      access_clients_;
+    common::LoggerPtr                      logger_{common::getLogger("engine")};
+
+};  // RegisterClientImpl
+
+constexpr std::size_t         RegisterClientImpl::ClientCacheCapacity;
+constexpr libcyphal::Duration RegisterClientImpl::ClientCacheIdleTimeout;
+
+}  // namespace
+
+RegisterClient::Ptr RegisterClient::make(cetl::pmr::memory_resource&            memory,
+                                         libcyphal::IExecutor&                  executor,
+                                         libcyphal::presentation::Presentation& presentation,
+                                         const NodeMonitor&                     node_monitor,
+                                         const std::size_t                      cache_capacity)
+{
+    return std::make_unique<RegisterClientImpl>(memory, executor, presentation, node_monitor, cache_capacity);
+}
+
+}  // namespace cyphal
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
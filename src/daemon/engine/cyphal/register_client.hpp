@@ -0,0 +1,167 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_DAEMON_ENGINE_CYPHAL_REGISTER_CLIENT_HPP_INCLUDED
+#define OCVSMD_DAEMON_ENGINE_CYPHAL_REGISTER_CLIENT_HPP_INCLUDED
+
+#include "node_monitor.hpp"
+
+#include <uavcan/_register/Access_1_0.hpp>
+#include <uavcan/_register/List_1_0.hpp>
+#include <uavcan/_register/Name_1_0.hpp>
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/presentation/presentation.hpp>
+#include <libcyphal/types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace cyphal
+{
+
+/// Defines the register client - it lists, reads and writes registers of many remote nodes at once.
+///
+/// Remote calls are pipelined: up to a "window" of `uavcan.register.Access` (or `List`) requests is kept in flight
+/// per node, and all nodes of an operation are served in parallel. So the cost of a whole node dump is
+/// roughly its number of registers divided by the window, multiplied by the round-trip time -
+/// independently of the number of nodes.
+///
+/// Results are reported as they arrive (not necessarily in the order of requests).
+/// Service clients are cached (per node) and shared by all operations.
+///
+/// Every successfully accessed value is also kept in the bounded register cache (see `RegisterCache`),
+/// so that repeated reads could be served without bus traffic (see `Options::max_age`). Values of a node are
+/// invalidated as soon as the node monitor sees it restarted (or returned from offline).
+///
+class RegisterClient
+{
+public:
+    using Ptr       = std::unique_ptr<RegisterClient>;
+    using AccessSvc = uavcan::_register::Access_1_0;
+    using ListSvc   = uavcan::_register::List_1_0;
+    using Name      = uavcan::_register::Name_1_0;
+
+    /// Defines parameters of a multi-node operation.
+    ///
+    struct Options
+    {
+        /// Deadline of the whole operation - all its remote calls (even not sent yet) fail after it.
+        libcyphal::TimePoint deadline;
+        /// Maximum number of requests in flight per node. Zero means the default one.
+        std::size_t window;
+        /// Maximum age of a cached value which is still acceptable for a read (instead of a remote call).
+        /// Zero means that reads always go to the nodes. Not in use by the list operation.
+        libcyphal::Duration max_age;
+    };
+
+    /// Handles a single result of the list operation - the name of the register at the given index.
+    ///
+    /// On failure (non-zero `error_code`) the name is empty, and enumeration of the node stops.
+    /// Returning `false` stops the whole operation - it won't touch itself after that,
+    /// so the handler is allowed to destroy the operation (but only if it returns `false`).
+    ///
+    using ListHandler = std::function<bool(const std::uint16_t node_id,
+                                           const std::uint16_t index,
+                                           const int           error_code,
+                                           const Name&         name)>;
+
+    /// Handles a single result of the access operation - response of the node for the given register.
+    ///
+    /// On failure (non-zero `error_code`) the response is empty. The same "stop" contract as for `ListHandler`.
+    ///
+    using AccessHandler = std::function<bool(const std::uint16_t        node_id,
+                                             const Name&                name,
+                                             const int                  error_code,
+                                             const AccessSvc::Response& response)>;
+
+    /// Called once all nodes of the operation are done (either successfully or not).
+    ///
+    /// It's the last call of the operation, so the handler is allowed to destroy it.
+    ///
+    using DoneHandler = std::function<void()>;
+
+    /// Defines an ongoing multi-node operation.
+    ///
+    /// Handlers are never called from within `list` or `access` methods - the operation starts
+    /// on the next spin of the executor. Destruction of the operation cancels everything still pending.
+    ///
+    class Operation
+    {
+    public:
+        using Ptr = std::unique_ptr<Operation>;
+
+        Operation(const Operation&)                = delete;
+        Operation(Operation&&) noexcept            = delete;
+        Operation& operator=(const Operation&)     = delete;
+        Operation& operator=(Operation&&) noexcept = delete;
+
+        virtual ~Operation() = default;
+
+    protected:
+        Operation() = default;
+
+    };  // Operation
+
+    /// Makes a new register client.
+    ///
+    /// @param node_monitor Source of nodes' restarts - the client should not outlive it.
+    /// @param cache_capacity Maximum number of cached register values (of all nodes).
+    ///
+    CETL_NODISCARD static Ptr make(cetl::pmr::memory_resource&            memory,
+                                   libcyphal::IExecutor&                  executor,
+                                   libcyphal::presentation::Presentation& presentation,
+                                   const NodeMonitor&                     node_monitor,
+                                   const std::size_t                      cache_capacity);
+
+    RegisterClient(const RegisterClient&)                = delete;
+    RegisterClient(RegisterClient&&) noexcept            = delete;
+    RegisterClient& operator=(const RegisterClient&)     = delete;
+    RegisterClient& operator=(RegisterClient&&) noexcept = delete;
+
+    virtual ~RegisterClient() = default;
+
+    /// Enumerates names of all registers of the given nodes (by pipelined `uavcan.register.List` requests).
+    ///
+    /// Enumeration of a node stops at the first empty name (which is not reported).
+    ///
+    CETL_NODISCARD virtual Operation::Ptr list(const std::vector<std::uint16_t>& node_ids,
+                                               const Options&                    options,
+                                               ListHandler                       list_handler,
+                                               DoneHandler                       done_handler) = 0;
+
+    /// Reads (or writes) the given registers of the given nodes (by pipelined `uavcan.register.Access` requests).
+    ///
+    /// Each request is sent to each node - an empty value of the request means a read,
+    /// otherwise it's a write (and the node responds with the value after the write).
+    ///
+    CETL_NODISCARD virtual Operation::Ptr access(const std::vector<std::uint16_t>&      node_ids,
+                                                 const std::vector<AccessSvc::Request>& requests,
+                                                 const Options&                         options,
+                                                 AccessHandler                          access_handler,
+                                                 DoneHandler                            done_handler) = 0;
+
+protected:
+    RegisterClient() = default;
+
+};  // RegisterClient
+
+}  // namespace cyphal
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_DAEMON_ENGINE_CYPHAL_REGISTER_CLIENT_HPP_INCLUDED
@@ -0,0 +1,273 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_DAEMON_ENGINE_CYPHAL_REQUEST_PACER_HPP_INCLUDED
+#define OCVSMD_DAEMON_ENGINE_CYPHAL_REQUEST_PACER_HPP_INCLUDED
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/types.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace cyphal
+{
+
+/// Defines pacer of outgoing Cyphal RPC requests.
+///
+/// Services which fan out the same request to many nodes (f.e. a fleet-wide `ExecuteCommand`) submit
+/// one "send" action per node, and the pacer runs these actions respecting the following limits:
+/// - max number of in-flight requests per owner (an owner is usually a single IPC request/FSM);
+/// - max number of in-flight requests in total (across all owners of the pacer);
+/// - min spacing between two consecutive sends.
+/// An action could also be delayed (see `submitAfter`) - f.e. a re-attempt after a backoff.
+///
+/// Actions beyond the limits are queued (in FIFO order), not failed. An owner reports completion of
+/// each in-flight request via `release`, which lets the next queued action go. Actions always run from
+/// the pacer's own executor callback, so it's safe to submit/release from within other callbacks
+/// (f.e. from a response promise callback).
+///
+class RequestPacer final
+{
+    /// Defines private specification for making interface shared ptr.
+    ///
+    struct Spec
+    {
+        explicit Spec() = default;
+    };
+
+public:
+    using Ptr     = std::shared_ptr<RequestPacer>;
+    using OwnerId = std::uint64_t;
+    using Action  = std::function<void()>;
+
+    struct Limits
+    {
+        /// Zero means unlimited.
+        std::size_t max_in_flight_per_owner;
+        /// Zero means unlimited.
+        std::size_t max_in_flight;
+        /// Zero means no spacing.
+        libcyphal::Duration spacing;
+    };
+
+    CETL_NODISCARD static Ptr make(libcyphal::IExecutor& executor, const Limits& limits)
+    {
+        return std::make_shared<RequestPacer>(Spec{}, executor, limits);
+    }
+
+    /// Queues the given action for the given owner.
+    ///
+    /// The action is expected to send one request, and later (on response or timeout) the owner
+    /// should `release` its in-flight slot. If the action fails to send, it should `release` as well.
+    ///
+    void submit(const OwnerId owner_id, Action&& action)
+    {
+        const auto now = executor_.now();
+        queue_.push_back(Pending{owner_id, now, std::move(action)});
+        schedulePump(now);
+    }
+
+    /// Queues the given action for the given owner, but not to be run before the given time.
+    ///
+    /// Useful for delayed re-attempts (backoff). Delayed actions don't block other queued ones.
+    ///
+    void submitAfter(const OwnerId owner_id, const libcyphal::TimePoint not_before, Action&& action)
+    {
+        queue_.push_back(Pending{owner_id, not_before, std::move(action)});
+        schedulePump(not_before);
+    }
+
+    /// Releases one in-flight slot of the given owner.
+    ///
+    void release(const OwnerId owner_id)
+    {
+        const auto found = owner_to_in_flight_.find(owner_id);
+        if ((found == owner_to_in_flight_.end()) || (found->second == 0))
+        {
+            return;
+        }
+        --found->second;
+        --in_flight_;
+        if (found->second == 0)
+        {
+            owner_to_in_flight_.erase(found);
+        }
+
+        if (!queue_.empty())
+        {
+            schedulePump(executor_.now());
+        }
+    }
+
+    /// Drops all queued actions of the given owner, and releases all its in-flight slots.
+    ///
+    /// Should be called when the owner is completed (or canceled).
+    ///
+    void cancel(const OwnerId owner_id)
+    {
+        queue_.erase(std::remove_if(queue_.begin(),
+                                    queue_.end(),
+                                    [owner_id](const auto& pending) { return pending.owner_id == owner_id; }),
+                     queue_.end());
+
+        const auto found = owner_to_in_flight_.find(owner_id);
+        if (found != owner_to_in_flight_.end())
+        {
+            in_flight_ -= found->second;
+            owner_to_in_flight_.erase(found);
+
+            if (!queue_.empty())
+            {
+                schedulePump(executor_.now());
+            }
+        }
+    }
+
+    CETL_NODISCARD std::size_t queued() const noexcept
+    {
+        return queue_.size();
+    }
+
+    CETL_NODISCARD std::size_t inFlight() const noexcept
+    {
+        return in_flight_;
+    }
+
+    RequestPacer(Spec, libcyphal::IExecutor& executor, const Limits& limits)
+        : executor_{executor}
+        , limits_{limits}
+        , next_send_time_{executor.now()}
+    {
+        pump_callback_ = executor_.registerCallback([this](const auto& arg) {
+            //
+            pump(arg.approx_now);
+        });
+    }
+
+    RequestPacer(const RequestPacer&)                = delete;
+    RequestPacer(RequestPacer&&) noexcept            = delete;
+    RequestPacer& operator=(const RequestPacer&)     = delete;
+    RequestPacer& operator=(RequestPacer&&) noexcept = delete;
+
+    ~RequestPacer() = default;
+
+private:
+    struct Pending
+    {
+        OwnerId              owner_id;
+        libcyphal::TimePoint not_before;
+        Action               action;
+    };
+
+    void schedulePump(const libcyphal::TimePoint time)
+    {
+        using Schedule = libcyphal::IExecutor::Callback::Schedule;
+
+        // There is only one pump callback, so an earlier pump (if any) should not be postponed.
+        const auto pump_time = std::max(time, next_send_time_);
+        if (!next_pump_time_ || (pump_time < *next_pump_time_) || (*next_pump_time_ < executor_.now()))
+        {
+            next_pump_time_ = pump_time;
+            pump_callback_.schedule(Schedule::Once{pump_time});
+        }
+    }
+
+    void scheduleDelayed(const libcyphal::TimePoint now)
+    {
+        cetl::optional<libcyphal::TimePoint> earliest;
+        for (const auto& pending : queue_)
+        {
+            if ((pending.not_before > now) && (!earliest || (pending.not_before < *earliest)))
+            {
+                earliest = pending.not_before;
+            }
+        }
+        if (earliest)
+        {
+            schedulePump(*earliest);
+        }
+    }
+
+    bool isOwnerAtLimit(const OwnerId owner_id) const
+    {
+        if (limits_.max_in_flight_per_owner == 0)
+        {
+            return false;
+        }
+        const auto found = owner_to_in_flight_.find(owner_id);
+        return (found != owner_to_in_flight_.end()) && (found->second >= limits_.max_in_flight_per_owner);
+    }
+
+    void pump(const libcyphal::TimePoint now)
+    {
+        next_pump_time_.reset();
+
+        while (!queue_.empty())
+        {
+            if ((limits_.max_in_flight != 0) && (in_flight_ >= limits_.max_in_flight))
+            {
+                return;  // `release` will pump again.
+            }
+            if (now < next_send_time_)
+            {
+                schedulePump(now);
+                return;
+            }
+
+            // Find the first due action whose owner still has a free slot.
+            const auto pending_it = std::find_if(queue_.begin(), queue_.end(), [this, now](const auto& pending) {
+                //
+                return (pending.not_before <= now) && !isOwnerAtLimit(pending.owner_id);
+            });
+            if (pending_it == queue_.end())
+            {
+                scheduleDelayed(now);
+                return;  // Otherwise, `release` will pump again.
+            }
+
+            Pending pending = std::move(*pending_it);
+            queue_.erase(pending_it);
+
+            ++owner_to_in_flight_[pending.owner_id];
+            ++in_flight_;
+            next_send_time_ = now + limits_.spacing;
+
+            // Note that the action might reenter the pacer (f.e. `cancel` or `release` on failure).
+            pending.action();
+        }
+    }
+
+    libcyphal::IExecutor&                    executor_;
+    const Limits                             limits_;
+    libcyphal::TimePoint                     next_send_time_;
+    cetl::optional<libcyphal::TimePoint>     next_pump_time_;
+    std::size_t                              in_flight_{0};
+    std::deque<Pending>                      queue_;
+    std::unordered_map<OwnerId, std::size_t> owner_to_in_flight_;
+    libcyphal::IExecutor::Callback::Any      pump_callback_;
+
+};  // RequestPacer
+
+}  // namespace cyphal
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_DAEMON_ENGINE_CYPHAL_REQUEST_PACER_HPP_INCLUDED
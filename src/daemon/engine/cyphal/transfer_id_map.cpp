@@ -0,0 +1,276 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "transfer_id_map.hpp"
+
+#include "io/io.hpp"
+#include "logging.hpp"
+#include "ocvsmd/platform/posix_utils.hpp"
+
+#include <cetl/cetl.hpp>
+#include <libcyphal/transport/types.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace cyphal
+{
+namespace
+{
+
+class TransferIdMapImpl final : public TransferIdMap
+{
+    using TransferId = libcyphal::transport::TransferId;
+
+    static constexpr std::uint32_t Magic         = 0x4449544FU;  // 'OTID'
+    static constexpr std::uint16_t Version       = 1;
+    static constexpr std::size_t   CapacityBits  = 12;
+    static constexpr std::uint32_t HashFactor    = 2654435761U;  // Knuth's multiplicative hash.
+    static constexpr std::uint32_t EntryIsInUse  = 1;
+    static constexpr std::size_t   HeaderPadding = 48;
+
+    static_assert(Capacity == (std::size_t{1} << CapacityBits), "Capacity must be a power of two.");
+
+    // Layout of the mapping is: the header, followed by `Capacity` entries.
+    // Both are plain-old-data of fixed size, so that the file could be used directly (without parsing).
+    //
+    struct Header
+    {
+        std::uint32_t magic;
+        std::uint16_t version;
+        std::uint16_t entry_size;
+        std::uint32_t capacity;
+        std::uint32_t size;
+        std::uint8_t  reserved[HeaderPadding];  // NOLINT(*-avoid-c-arrays)
+    };
+    static_assert(sizeof(Header) == 64, "");
+
+    struct Entry
+    {
+        std::uint16_t port_id;
+        std::uint16_t node_id;
+        std::uint32_t in_use;
+        std::uint64_t transfer_id;
+    };
+    static_assert(sizeof(Entry) == 16, "Four entries per typical cache line.");
+
+public:
+    static constexpr std::size_t MappingSize = sizeof(Header) + (Capacity * sizeof(Entry));
+
+    TransferIdMapImpl(void* const mapping, const bool is_persistent)
+        : mapping_{mapping}
+        , is_persistent_{is_persistent}
+    {
+        auto& hdr = header();
+        if ((hdr.magic != Magic) || (hdr.version != Version) || (hdr.entry_size != sizeof(Entry)) ||
+            (hdr.capacity != Capacity))
+        {
+            // Either a brand-new (zero-filled) storage, or an incompatible one - start from scratch.
+            std::memset(mapping_, 0, MappingSize);
+            hdr.magic      = Magic;
+            hdr.version    = Version;
+            hdr.entry_size = sizeof(Entry);
+            hdr.capacity   = Capacity;
+        }
+    }
+
+    TransferIdMapImpl(const TransferIdMapImpl&)                = delete;
+    TransferIdMapImpl(TransferIdMapImpl&&) noexcept            = delete;
+    TransferIdMapImpl& operator=(const TransferIdMapImpl&)     = delete;
+    TransferIdMapImpl& operator=(TransferIdMapImpl&&) noexcept = delete;
+
+    ~TransferIdMapImpl() override
+    {
+        if (is_persistent_)
+        {
+            // Schedule write back of the latest state; there is no need to wait for it.
+            ::msync(mapping_, MappingSize, MS_ASYNC);
+        }
+        ::munmap(mapping_, MappingSize);
+    }
+
+    // MARK: TransferIdMap
+
+    std::size_t size() const noexcept override
+    {
+        return header().size;
+    }
+
+    bool isPersistent() const noexcept override
+    {
+        return is_persistent_;
+    }
+
+    // MARK: ITransferIdMap
+
+    TransferId getIdFor(const SessionSpec& session_spec) const noexcept override
+    {
+        const auto* const entry = findEntry(session_spec);
+        return ((entry != nullptr) && (entry->in_use == EntryIsInUse)) ? entry->transfer_id : 0;
+    }
+
+    void setIdFor(const SessionSpec& session_spec, const TransferId transfer_id) noexcept override
+    {
+        auto* const entry = findEntry(session_spec);
+        if (entry == nullptr)
+        {
+            if (!is_full_reported_)
+            {
+                is_full_reported_ = true;
+                common::getLogger("engine")->warn("Transfer ID map is full (capacity={}).", Capacity);
+            }
+            return;
+        }
+
+        if (entry->in_use != EntryIsInUse)
+        {
+            entry->port_id = session_spec.port_id;
+            entry->node_id = session_spec.node_id;
+            entry->in_use  = EntryIsInUse;
+            ++header().size;
+        }
+        entry->transfer_id = transfer_id;
+    }
+
+private:
+    Header& header() const noexcept
+    {
+        return *static_cast<Header*>(mapping_);
+    }
+
+    Entry* entries() const noexcept
+    {
+        return reinterpret_cast<Entry*>(&header() + 1);  // NOLINT(*-reinterpret-cast, *-pointer-arithmetic)
+    }
+
+    /// Finds either the entry of the given session, or the free entry where it should be inserted.
+    ///
+    /// Entries are never removed, so linear probing stops at the first free entry.
+    /// Returns `nullptr` if the session is not in the (completely full) table.
+    ///
+    Entry* findEntry(const SessionSpec& session_spec) const noexcept
+    {
+        const std::uint32_t key  = (static_cast<std::uint32_t>(session_spec.port_id) << 16U) | session_spec.node_id;
+        const std::size_t   mask = Capacity - 1;
+
+        std::size_t index = static_cast<std::uint32_t>(key * HashFactor) >> (32U - CapacityBits);
+        for (std::size_t probe = 0; probe < Capacity; ++probe, index = (index + 1) & mask)
+        {
+            auto& entry = entries()[index];  // NOLINT(*-pointer-arithmetic)
+            if ((entry.in_use != EntryIsInUse) ||
+                ((entry.port_id == session_spec.port_id) && (entry.node_id == session_spec.node_id)))
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    void* const mapping_;
+    const bool  is_persistent_;
+    bool        is_full_reported_{false};
+
+};  // TransferIdMapImpl
+
+/// Maps the given file (creating or resizing it if needed) into memory.
+///
+/// Returns `nullptr` on failure.
+///
+void* mapFile(const std::string& file_path, common::Logger& logger)
+{
+    const common::io::OwnFd fd{::open(file_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR)};
+    if (fd.get() < 0)
+    {
+        logger.warn("Failed to open transfer ID map file '{}' (err={}).", file_path, errno);
+        return nullptr;
+    }
+
+    struct stat file_stat{};
+    if (const auto err = ocvsmd::platform::posixSyscallError([&fd, &file_stat] {
+            //
+            return ::fstat(fd.get(), &file_stat);
+        }))
+    {
+        logger.warn("Failed to stat transfer ID map file '{}' (err={}).", file_path, err);
+        return nullptr;
+    }
+    if (static_cast<std::size_t>(file_stat.st_size) != TransferIdMapImpl::MappingSize)
+    {
+        // Truncation to zero first ensures that the resized file is zero-filled.
+        if (const auto err = ocvsmd::platform::posixSyscallError([&fd] {
+                //
+                return ((::ftruncate(fd.get(), 0) == 0) &&
+                        (::ftruncate(fd.get(), static_cast<off_t>(TransferIdMapImpl::MappingSize)) == 0))
+                           ? 0
+                           : -1;
+            }))
+        {
+            logger.warn("Failed to resize transfer ID map file '{}' (err={}).", file_path, err);
+            return nullptr;
+        }
+    }
+
+    // The file descriptor is not needed after mapping - the mapping keeps the file referenced.
+    void* const mapping =
+        ::mmap(nullptr, TransferIdMapImpl::MappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd.get(), 0);
+    if (mapping == MAP_FAILED)  // NOLINT(*-cstyle-cast, *-no-int-to-ptr)
+    {
+        logger.warn("Failed to map transfer ID map file '{}' (err={}).", file_path, errno);
+        return nullptr;
+    }
+    return mapping;
+}
+
+}  // namespace
+
+constexpr std::size_t TransferIdMap::Capacity;
+
+TransferIdMap::Ptr TransferIdMap::make(const std::string& file_path)
+{
+    const auto logger = common::getLogger("engine");
+
+    if (!file_path.empty())
+    {
+        if (void* const mapping = mapFile(file_path, *logger))
+        {
+            auto map = std::make_unique<TransferIdMapImpl>(mapping, true);
+            logger->debug("Transfer ID map is mapped to '{}' (sessions={}).", file_path, map->size());
+            return map;
+        }
+        logger->warn("Transfer IDs won't be persisted.");
+    }
+
+    void* const mapping = ::mmap(nullptr,
+                                 TransferIdMapImpl::MappingSize,
+                                 PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS,
+                                 -1,
+                                 0);
+    if (mapping == MAP_FAILED)  // NOLINT(*-cstyle-cast, *-no-int-to-ptr)
+    {
+        logger->error("Failed to allocate transfer ID map (err={}).", errno);
+        return nullptr;
+    }
+    return std::make_unique<TransferIdMapImpl>(mapping, false);
+}
+
+}  // namespace cyphal
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
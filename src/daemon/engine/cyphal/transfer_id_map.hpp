@@ -0,0 +1,78 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_DAEMON_ENGINE_CYPHAL_TRANSFER_ID_MAP_HPP_INCLUDED
+#define OCVSMD_DAEMON_ENGINE_CYPHAL_TRANSFER_ID_MAP_HPP_INCLUDED
+
+#include <cetl/cetl.hpp>
+#include <libcyphal/transport/transfer_id_map.hpp>
+#include <libcyphal/transport/types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace cyphal
+{
+
+/// Defines persistent map of session specs to their transfer IDs.
+///
+/// The map is a flat open-addressing (linear probing) table of fixed capacity.
+/// Its storage is a memory mapping of a small binary file, so every update is just a store into
+/// the shared mapping (the kernel writes dirty pages back in the background), and there is no
+/// parsing on startup - the file is mapped and used as is. If the file can't be used
+/// then anonymous (RAM only) mapping is used instead, so transfer IDs won't survive a restart.
+///
+class TransferIdMap : public libcyphal::transport::ITransferIdMap
+{
+public:
+    using Ptr = std::unique_ptr<TransferIdMap>;
+
+    /// Maximum number of sessions which could be stored in the map.
+    ///
+    /// Sessions beyond the capacity are not remembered (their transfer IDs will start from zero).
+    ///
+    static constexpr std::size_t Capacity = 4096;
+
+    /// Makes a new map backed by the given file.
+    ///
+    /// @param file_path Path to the backing file. If empty then the map is not persistent.
+    /// @return `nullptr` only if even the non-persistent storage couldn't be allocated.
+    ///
+    CETL_NODISCARD static Ptr make(const std::string& file_path);
+
+    TransferIdMap(const TransferIdMap&)                = delete;
+    TransferIdMap(TransferIdMap&&) noexcept            = delete;
+    TransferIdMap& operator=(const TransferIdMap&)     = delete;
+    TransferIdMap& operator=(TransferIdMap&&) noexcept = delete;
+
+    ~TransferIdMap() override = default;
+
+    /// Gets the number of sessions currently stored in the map.
+    ///
+    CETL_NODISCARD virtual std::size_t size() const noexcept = 0;
+
+    /// Says whether the map is backed by a file (and so survives restarts).
+    ///
+    CETL_NODISCARD virtual bool isPersistent() const noexcept = 0;
+
+protected:
+    TransferIdMap() = default;
+
+};  // TransferIdMap
+
+}  // namespace cyphal
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_DAEMON_ENGINE_CYPHAL_TRANSFER_ID_MAP_HPP_INCLUDED
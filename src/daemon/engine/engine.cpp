@@ -7,20 +7,28 @@
 
 #include "config.hpp"
 #include "cyphal/can_transport_bag.hpp"
-// ➕ #include "cyphal/file_provider.hpp"
+#include "cyphal/file_provider.hpp"
+#include "cyphal/node_monitor.hpp"
+#include "cyphal/register_client.hpp"
+#include "cyphal/transfer_id_map.hpp"
 #include "cyphal/udp_transport_bag.hpp"
 #include "engine_helpers.hpp"
 #include "io/socket_address.hpp"
 #include "ipc/pipe/server_pipe.hpp"
 #include "ipc/pipe/socket_server.hpp"
 #include "ipc/server_router.hpp"
+#include "svc/diag/services.hpp"
+#include "svc/monitor/services.hpp"
 #include "svc/node/services.hpp"
+#include "svc/relay/services.hpp"
 #include "svc/svc_helpers.hpp"
 
 #include <cetl/pf17/cetlpf.hpp>
 #include <libcyphal/application/node.hpp>
+#include <libcyphal/executor.hpp>
 #include <libcyphal/types.hpp>
 
+#include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
@@ -49,68 +57,48 @@ cetl::optional<std::string> Engine::init()
 {
     logger_->trace("Initializing engine...");
 
-    // 1. Create the transport layer object (try first UDP, then CAN).
-    //    Set the local node ID if configured.
+    // 1. Create Cyphal stacks (transport, presentation & node) - one per each configured transport family.
+    //    UDP stack (if any) goes first, so it's the primary one.
     //
-    if (auto maybe_udp_transport_bag = cyphal::UdpTransportBag::make(memory_, executor_, config_))
+    if (auto udp_transport_bag = cyphal::UdpTransportBag::make(  //
+            memory_accounting_.resourceFor("udp"),
+            executor_,
+            config_))
     {
-        any_transport_bag_ = std::move(maybe_udp_transport_bag);
+        if (auto error = addCyphalStack("udp", std::move(udp_transport_bag)))
+        {
+            return error;
+        }
     }
-    else
+    if (auto can_transport_bag = cyphal::CanTransportBag::make(  //
+            memory_accounting_.resourceFor("can"),
+            executor_,
+            config_))
     {
-        if (auto maybe_can_transport_bag = cyphal::CanTransportBag::make(memory_, executor_, config_))
+        if (auto error = addCyphalStack("can", std::move(can_transport_bag)))
         {
-            any_transport_bag_ = std::move(maybe_can_transport_bag);
-        }
-        else
-        {
-            std::string msg = "Failed to create Cyphal transport.";
-            logger_->error(msg);
-            return msg;
+            return error;
         }
     }
-    if (const auto node_id = config_->getCyphalAppNodeId())
+    if (cyphal_stacks_.empty())
     {
-        any_transport_bag_->getTransport().setLocalNodeId(node_id.value());
-    }
-
-    // 2. Create the presentation layer object.
-    //
-    presentation_.emplace(memory_, executor_, any_transport_bag_->getTransport());
-    presentation_->setTransferIdMap(&transfer_id_map_);
-
-    // 3. Create the node object with name.
-    //
-    auto maybe_node = libcyphal::application::Node::make(*presentation_);
-    if (const auto* failure = cetl::get_if<libcyphal::application::Node::MakeFailure>(&maybe_node))
-    {
-        (void) failure;
-        std::string msg = "Failed to create cyphal node.";
+        std::string msg = "Failed to create Cyphal transport.";
         logger_->error(msg);
         return msg;
     }
-    node_.emplace(cetl::get<libcyphal::application::Node>(std::move(maybe_node)));
 
-    // 4. Populate the node info.
+    // 2. Bring up various providers - for each network.
     //
-    auto& get_info_prov = node_->getInfoProvider();
-    get_info_prov  //
-        .setName(NODE_NAME)
-        .setSoftwareVersion(VERSION_MAJOR, VERSION_MINOR)
-        .setSoftwareVcsRevisionId(VCS_REVISION_ID)
-        .setUniqueId(getUniqueId());
+    for (const auto& stack : cyphal_stacks_)
+    {
+        if (auto error = addProviders(*stack))
+        {
+            return error;
+        }
+    }
 
-    // 5. Bring up various providers.
-    //
-    // ➕ file_provider_ = cyphal::FileProvider::make(memory_, *presentation_, config_);
-    // ➕ if (file_provider_ == nullptr)
-    // ➕ {
-    // ➕     std::string msg = "Failed to create cyphal file provider.";
-    // ➕     logger_->error(msg);
-    // ➕     return msg;
-    // ➕ }
-
-    // 6. Bring up the IPC router and its services.
+    // 3. Bring up the IPC router and its services.
+    //    Services which talk to Cyphal are registered once per each network (see `ScvContext::registerChannel`).
     //
     common::ipc::pipe::ServerPipe::Ptr server_pipe;
     {
@@ -137,11 +125,28 @@ cetl::optional<std::string> Engine::init()
         server_pipe               = std::make_unique<common::ipc::pipe::SocketServer>(executor_, socket_address);
     }
     //
-    ipc_router_ = common::ipc::ServerRouter::make(memory_, std::move(server_pipe));
+    ipc_router_ = common::ipc::ServerRouter::make(memory_accounting_.resourceFor("ipc"), std::move(server_pipe));
     //
-    const svc::ScvContext svc_context{memory_, executor_, *ipc_router_, *presentation_};
-    svc::node::registerAllServices(svc_context);
-    // ➕ svc::file_server::registerAllServices(svc_context, *file_provider_);
+    for (const auto& stack : cyphal_stacks_)
+    {
+        const bool            is_primary = stack == cyphal_stacks_.front();
+        const svc::ScvContext svc_context{memory_accounting_.resourceFor("svc"),
+                                          executor_,
+                                          *ipc_router_,
+                                          stack->presentation.value(),
+                                          memory_accounting_,
+                                          *config_,
+                                          stack->name,
+                                          is_primary};
+        svc::node::registerAllServices(svc_context, *stack->register_client);
+        svc::monitor::registerAllServices(svc_context, *stack->node_monitor);
+        svc::relay::registerAllServices(svc_context);
+        // ➕ svc::file_server::registerAllServices(svc_context, *stack->file_provider);
+        if (is_primary)
+        {
+            svc::diag::registerAllServices(svc_context);
+        }
+    }
     //
     if (0 != ipc_router_->start())
     {
@@ -150,6 +155,8 @@ cetl::optional<std::string> Engine::init()
         return msg;
     }
 
+    startStatsLogging();
+
     logger_->debug("Engine is initialized.");
     return cetl::nullopt;
 }
@@ -180,6 +187,128 @@ void Engine::runWhile(const std::function<bool()>& loop_predicate)
                   std::chrono::duration_cast<std::chrono::microseconds>(worst_lateness).count());
 }
 
+cetl::optional<std::string> Engine::addCyphalStack(const std::string& name, cyphal::AnyTransportBag::Ptr transport_bag)
+{
+    auto stack           = std::make_unique<CyphalStack>();
+    stack->name          = name;
+    stack->transport_bag = std::move(transport_bag);
+
+    // 1. Set the local node ID if configured.
+    //
+    if (const auto node_id = config_->getCyphalAppNodeId())
+    {
+        if (const auto failure = stack->transport_bag->getTransport().setLocalNodeId(node_id.value()))
+        {
+            std::string msg = fmt::format("Failed to set local node ID {} of '{}' transport.", node_id.value(), name);
+            logger_->error(msg);
+            return msg;
+        }
+    }
+
+    // 2. Create the presentation layer object.
+    //    Each stack has its own transfer ID map - sessions of different networks are independent.
+    //
+    auto& presentation_memory = memory_accounting_.resourceFor(name + ".presentation");
+    stack->presentation.emplace(presentation_memory, executor_, stack->transport_bag->getTransport());
+    auto transfer_id_map_file = config_->getCyphalAppTransferIdMapFile().value_or("");
+    if (!transfer_id_map_file.empty())
+    {
+        transfer_id_map_file += "." + name;
+    }
+    stack->transfer_id_map = cyphal::TransferIdMap::make(transfer_id_map_file);
+    if (stack->transfer_id_map == nullptr)
+    {
+        std::string msg = "Failed to create transfer ID map.";
+        logger_->error(msg);
+        return msg;
+    }
+    stack->presentation->setTransferIdMap(stack->transfer_id_map.get());
+
+    // 3. Create the node object with name.
+    //
+    auto maybe_node = libcyphal::application::Node::make(*stack->presentation);
+    if (const auto* failure = cetl::get_if<libcyphal::application::Node::MakeFailure>(&maybe_node))
+    {
+        (void) failure;
+        std::string msg = fmt::format("Failed to create cyphal node of '{}' transport.", name);
+        logger_->error(msg);
+        return msg;
+    }
+    stack->node.emplace(cetl::get<libcyphal::application::Node>(std::move(maybe_node)));
+
+    // 4. Populate the node info.
+    //
+    auto& get_info_prov = stack->node->getInfoProvider();
+    get_info_prov  //
+        .setName(NODE_NAME)
+        .setSoftwareVersion(VERSION_MAJOR, VERSION_MINOR)
+        .setSoftwareVcsRevisionId(VCS_REVISION_ID)
+        .setUniqueId(getUniqueId());
+
+    logger_->debug("Cyphal '{}' stack is created.", name);
+    cyphal_stacks_.push_back(std::move(stack));
+    return cetl::nullopt;
+}
+
+cetl::optional<std::string> Engine::addProviders(CyphalStack& stack)
+{
+    auto& presentation = stack.presentation.value();
+
+    stack.file_provider = cyphal::FileProvider::make(  //
+        memory_accounting_.resourceFor(stack.name + ".files"),
+        presentation,
+        config_);
+    if (stack.file_provider == nullptr)
+    {
+        std::string msg = fmt::format("Failed to create cyphal file provider of '{}' transport.", stack.name);
+        logger_->error(msg);
+        return msg;
+    }
+    //
+    stack.node_monitor = cyphal::NodeMonitor::make(  //
+        memory_accounting_.resourceFor(stack.name + ".monitor"),
+        executor_,
+        presentation);
+    if (stack.node_monitor == nullptr)
+    {
+        std::string msg = fmt::format("Failed to create cyphal node monitor of '{}' transport.", stack.name);
+        logger_->error(msg);
+        return msg;
+    }
+    //
+    constexpr std::uint32_t DefaultRegistersCacheCapacity = 4096;
+    stack.register_client = cyphal::RegisterClient::make(  //
+        memory_accounting_.resourceFor(stack.name + ".registers"),
+        executor_,
+        presentation,
+        *stack.node_monitor,
+        config_->getSvcRegistersCacheCapacity().value_or(DefaultRegistersCacheCapacity));
+
+    return cetl::nullopt;
+}
+
+void Engine::startStatsLogging()
+{
+    using std::chrono_literals::operator""s;
+    using Schedule = libcyphal::IExecutor::Callback::Schedule;
+
+    const auto period = config_->getLoggingStatsPeriod().value_or(600s);
+    if (period <= libcyphal::Duration::zero())
+    {
+        return;
+    }
+
+    stats_callback_ = executor_.registerCallback([this](const auto&) {
+        //
+        memory_accounting_.logStats(*logger_);
+        for (const auto& stack : cyphal_stacks_)
+        {
+            stack->transport_bag->logStats(*logger_);
+        }
+    });
+    stats_callback_.schedule(Schedule::Repeat{executor_.now() + period, period});
+}
+
 Engine::UniqueId Engine::getUniqueId() const
 {
     if (const auto unique_id = config_->getCyphalAppUniqueId())
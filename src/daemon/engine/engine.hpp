@@ -8,8 +8,12 @@
 
 #include "config.hpp"
 #include "cyphal/any_transport_bag.hpp"
-// ➕ #include "cyphal/file_provider.hpp"
+#include "cyphal/file_provider.hpp"
+#include "cyphal/node_monitor.hpp"
+#include "cyphal/register_client.hpp"
+#include "cyphal/transfer_id_map.hpp"
 #include "logging.hpp"
+#include "memory_accounting.hpp"
 #include "ocvsmd/platform/defines.hpp"
 
 #include <ipc/server_router.hpp>
@@ -17,13 +21,13 @@
 #include <cetl/cetl.hpp>
 #include <cetl/pf17/cetlpf.hpp>
 #include <libcyphal/application/node.hpp>
+#include <libcyphal/executor.hpp>
 #include <libcyphal/presentation/presentation.hpp>
-#include <libcyphal/transport/transfer_id_map.hpp>
-#include <libcyphal/transport/types.hpp>
 
 #include <functional>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 namespace ocvsmd
 {
@@ -43,40 +47,43 @@ public:
 private:
     using UniqueId = Config::CyphalApp::UniqueId;
 
-    class TransferIdMap final : public libcyphal::transport::ITransferIdMap
+    /// Holds a complete Cyphal stack of a single transport family (UDP or CAN) - together with its providers.
+    ///
+    /// Each network is served on its own - it has its own monitor, file server and register client,
+    /// and IPC services are registered once per each stack (see `svc::ScvContext::registerChannel`).
+    ///
+    /// Order of the fields is important - it defines the reverse order of destruction.
+    ///
+    struct CyphalStack
     {
-        using TransferId = libcyphal::transport::TransferId;
-        using Map        = std::unordered_map<SessionSpec, TransferId>;
+        using Ptr = std::unique_ptr<CyphalStack>;
 
-        // ITransferIdMap
+        std::string                                           name;
+        cyphal::AnyTransportBag::Ptr                          transport_bag;
+        cyphal::TransferIdMap::Ptr                            transfer_id_map;
+        cetl::optional<libcyphal::presentation::Presentation> presentation;
+        cetl::optional<libcyphal::application::Node>          node;
+        cyphal::FileProvider::Ptr                             file_provider;
+        cyphal::NodeMonitor::Ptr                              node_monitor;
+        cyphal::RegisterClient::Ptr                           register_client;
 
-        TransferId getIdFor(const SessionSpec& session_spec) const noexcept override
-        {
-            const auto it = session_spec_to_transfer_id_.find(session_spec);
-            return it != session_spec_to_transfer_id_.end() ? it->second : 0;
-        }
+    };  // CyphalStack
 
-        void setIdFor(const SessionSpec& session_spec, const TransferId transfer_id) noexcept override
-        {
-            session_spec_to_transfer_id_[session_spec] = transfer_id;
-        }
-
-        Map session_spec_to_transfer_id_;
-
-    };  // TransferIdMap
+    CETL_NODISCARD cetl::optional<std::string> addCyphalStack(const std::string&           name,
+                                                              cyphal::AnyTransportBag::Ptr transport_bag);
+    CETL_NODISCARD cetl::optional<std::string> addProviders(CyphalStack& stack);
 
     UniqueId getUniqueId() const;
-
-    Config::Ptr                                           config_;
-    common::LoggerPtr                                     logger_{common::getLogger("engine")};
-    platform::SingleThreadedExecutor                      executor_;
-    cetl::pmr::memory_resource&                           memory_{*cetl::pmr::get_default_resource()};
-    cyphal::AnyTransportBag::Ptr                          any_transport_bag_;
-    TransferIdMap                                         transfer_id_map_;
-    cetl::optional<libcyphal::presentation::Presentation> presentation_;
-    cetl::optional<libcyphal::application::Node>          node_;
-    // ➕ cyphal::FileProvider::Ptr                             file_provider_;
-    common::ipc::ServerRouter::Ptr ipc_router_;
+    void     startStatsLogging();
+
+    Config::Ptr                         config_;
+    common::LoggerPtr                   logger_{common::getLogger("engine")};
+    platform::SingleThreadedExecutor    executor_;
+    cetl::pmr::memory_resource&         memory_{*cetl::pmr::get_default_resource()};
+    MemoryAccounting                    memory_accounting_{memory_};
+    std::vector<CyphalStack::Ptr>       cyphal_stacks_;
+    common::ipc::ServerRouter::Ptr      ipc_router_;
+    libcyphal::IExecutor::Callback::Any stats_callback_;
 
 };  // Engine
 
@@ -0,0 +1,90 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_DAEMON_ENGINE_MEMORY_ACCOUNTING_HPP_INCLUDED
+#define OCVSMD_DAEMON_ENGINE_MEMORY_ACCOUNTING_HPP_INCLUDED
+
+#include "logging.hpp"
+#include "stats_memory_resource.hpp"
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+
+#include <deque>
+#include <string>
+#include <utility>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+
+/// Defines a registry of per-subsystem memory resources.
+///
+/// Each subsystem (IPC router, a service, transport media, presentation, etc.) is given its own
+/// `StatsMemoryResource`, so that memory usage of the daemon can be attributed to its parts.
+/// Registered resources have stable addresses for the whole lifetime of the registry.
+///
+class MemoryAccounting final
+{
+public:
+    explicit MemoryAccounting(cetl::pmr::memory_resource& upstream)
+        : upstream_{upstream}
+    {
+    }
+
+    /// Gets (or creates on the first demand) the memory resource of a given subsystem.
+    ///
+    CETL_NODISCARD cetl::pmr::memory_resource& resourceFor(const std::string& subsystem)
+    {
+        for (auto& resource : resources_)
+        {
+            if (resource.name() == subsystem)
+            {
+                return resource;
+            }
+        }
+        resources_.emplace_back(subsystem, upstream_);
+        return resources_.back();
+    }
+
+    /// Visits all registered subsystem resources (in order of their registration).
+    ///
+    template <typename Visitor>
+    void forEach(Visitor&& visitor) const
+    {
+        for (const auto& resource : resources_)
+        {
+            std::forward<Visitor>(visitor)(resource.name(), resource.stats());
+        }
+    }
+
+    void logStats(common::Logger& logger) const
+    {
+        forEach([&logger](const std::string& name, const common::MemoryStats& stats) {
+            //
+            logger.info("Memory '{}': bytes={} (peak={}), allocs={}, deallocs={}, failed={}.",
+                        name,
+                        stats.allocated_bytes,
+                        stats.peak_allocated_bytes,
+                        stats.allocations,
+                        stats.deallocations,
+                        stats.failed_allocations);
+        });
+    }
+
+private:
+    cetl::pmr::memory_resource&             upstream_;
+    std::deque<common::StatsMemoryResource> resources_;
+
+};  // MemoryAccounting
+
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_DAEMON_ENGINE_MEMORY_ACCOUNTING_HPP_INCLUDED
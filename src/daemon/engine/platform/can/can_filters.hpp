@@ -0,0 +1,195 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_DAEMON_ENGINE_PLATFORM_CAN_FILTERS_HPP_INCLUDED
+#define OCVSMD_DAEMON_ENGINE_PLATFORM_CAN_FILTERS_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace platform
+{
+namespace can
+{
+
+/// Defines an acceptance filter of extended (29-bit) CAN IDs.
+///
+/// A frame is accepted if `(can_id & mask) == id`; so zero bits of the mask are "don't care" bits.
+///
+struct CanFilter
+{
+    std::uint32_t id;
+    std::uint32_t mask;
+
+    bool accepts(const std::uint32_t can_id) const noexcept
+    {
+        return (can_id & mask) == id;
+    }
+
+    /// Says whether this filter accepts all CAN IDs accepted by the other one.
+    ///
+    bool covers(const CanFilter& other) const noexcept
+    {
+        return ((mask & other.mask) == mask) && ((other.id & mask) == id);
+    }
+
+    /// Makes the most specific filter which accepts everything accepted by both filters.
+    ///
+    static CanFilter merge(const CanFilter& lhs, const CanFilter& rhs) noexcept
+    {
+        const std::uint32_t mask = lhs.mask & rhs.mask & ~(lhs.id ^ rhs.id);
+        return {lhs.id & mask, mask};
+    }
+
+    friend bool operator==(const CanFilter& lhs, const CanFilter& rhs) noexcept
+    {
+        return (lhs.id == rhs.id) && (lhs.mask == rhs.mask);
+    }
+
+};  // CanFilter
+
+/// Compacts the given list of filters so that it contains no more than `max_count` items (but at least one).
+///
+/// First, filters which are covered by other ones are dropped (this never changes the accepted set).
+/// Then, while the list is still too long, the pair of filters which gives the most specific merged
+/// filter (the one with the most significant mask bits, i.e. the least false accepts) is replaced
+/// by their merge. The resulting list accepts a superset of what the original list accepts.
+///
+/// Complexity is cubic in the worst case, which is fine for realistic lists of up to a few hundred filters
+/// (and filters are updated only on subscription changes).
+///
+inline void compactFilters(std::vector<CanFilter>& filters, const std::size_t max_count)
+{
+    const auto drop_covered = [&filters] {
+        //
+        for (std::size_t i = 0; i < filters.size(); ++i)
+        {
+            const CanFilter keeper = filters[i];
+            const auto      first  = filters.begin() + static_cast<std::ptrdiff_t>(i) + 1;
+            filters.erase(std::remove_if(first, filters.end(), [&keeper](const auto& flt) {
+                              //
+                              return keeper.covers(flt);
+                          }),
+                          filters.end());
+        }
+    };
+
+    // Order from the most generic filters to the most specific ones, so that `drop_covered` could work
+    // in a single pass (a filter can be covered only by one with the same or fewer mask bits).
+    std::sort(filters.begin(), filters.end(), [](const auto& lhs, const auto& rhs) {
+        //
+        const auto lhs_bits = __builtin_popcount(lhs.mask);
+        const auto rhs_bits = __builtin_popcount(rhs.mask);
+        return (lhs_bits != rhs_bits) ? (lhs_bits < rhs_bits) : (lhs.id < rhs.id);
+    });
+    drop_covered();
+
+    while ((filters.size() > max_count) && (filters.size() > 1))
+    {
+        std::size_t best_i    = 0;
+        std::size_t best_j    = 1;
+        int         best_bits = -1;
+        for (std::size_t i = 0; i < filters.size(); ++i)
+        {
+            for (std::size_t j = i + 1; j < filters.size(); ++j)
+            {
+                const auto bits = __builtin_popcount(CanFilter::merge(filters[i], filters[j]).mask);
+                if (bits > best_bits)
+                {
+                    best_i    = i;
+                    best_j    = j;
+                    best_bits = bits;
+                }
+            }
+        }
+
+        const CanFilter merged = CanFilter::merge(filters[best_i], filters[best_j]);
+        filters.erase(filters.begin() + static_cast<std::ptrdiff_t>(best_j));
+        filters.erase(filters.begin() + static_cast<std::ptrdiff_t>(best_i));
+
+        // The merged filter might cover some other filters as well.
+        filters.erase(std::remove_if(filters.begin(),
+                                     filters.end(),
+                                     [&merged](const auto& flt) { return merged.covers(flt); }),
+                      filters.end());
+        filters.push_back(merged);
+    }
+}
+
+/// Defines exact (software) matcher of a list of filters.
+///
+/// Used to detect frames which were accepted by compacted kernel filters,
+/// but which don't match any of the original (exact) filters. Filters are grouped by their masks,
+/// and IDs of each group are kept sorted, so matching costs one binary search per distinct mask -
+/// typically there are just a few of them (message, service request and response filters share masks).
+///
+class CanFilterMatcher final
+{
+public:
+    void assign(const std::vector<CanFilter>& filters)
+    {
+        groups_.clear();
+        for (const auto& flt : filters)
+        {
+            auto group = std::find_if(groups_.begin(), groups_.end(), [&flt](const auto& grp) {
+                //
+                return grp.mask == flt.mask;
+            });
+            if (group == groups_.end())
+            {
+                group = groups_.insert(groups_.end(), MaskGroup{flt.mask, {}});
+            }
+            group->ids.push_back(flt.id & flt.mask);
+        }
+        for (auto& group : groups_)
+        {
+            std::sort(group.ids.begin(), group.ids.end());
+        }
+    }
+
+    void clear() noexcept
+    {
+        groups_.clear();
+    }
+
+    bool empty() const noexcept
+    {
+        return groups_.empty();
+    }
+
+    bool accepts(const std::uint32_t can_id) const noexcept
+    {
+        return std::any_of(groups_.cbegin(), groups_.cend(), [can_id](const auto& group) {
+            //
+            return std::binary_search(group.ids.cbegin(), group.ids.cend(), can_id & group.mask);
+        });
+    }
+
+private:
+    struct MaskGroup
+    {
+        std::uint32_t              mask;
+        std::vector<std::uint32_t> ids;
+    };
+
+    std::vector<MaskGroup> groups_;
+
+};  // CanFilterMatcher
+
+}  // namespace can
+}  // namespace platform
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_DAEMON_ENGINE_PLATFORM_CAN_FILTERS_HPP_INCLUDED
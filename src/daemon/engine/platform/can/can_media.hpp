@@ -6,9 +6,12 @@
 #ifndef OCVSMD_DAEMON_ENGINE_PLATFORM_CAN_MEDIA_HPP_INCLUDED
 #define OCVSMD_DAEMON_ENGINE_PLATFORM_CAN_MEDIA_HPP_INCLUDED
 
+#include "can_filters.hpp"
+#include "io/io.hpp"
+#include "logging.hpp"
 #include "ocvsmd/platform/posix_executor_extension.hpp"
 #include "ocvsmd/platform/posix_platform_error.hpp"
-#include "socketcan.h"
+#include "ocvsmd/platform/posix_utils.hpp"
 
 #include <canard.h>
 #include <cetl/pf17/cetlpf.hpp>
@@ -26,8 +29,15 @@
 #include <cerrno>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
 #include <string>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <utility>
 #include <vector>
@@ -43,48 +53,57 @@ namespace platform
 namespace can
 {
 
+/// Defines Linux SocketCAN media of a single CAN interface.
+///
+/// Uses native SocketCAN API directly (without the libcanard `socketcan` shim):
+/// - there is only one socket per interface - both readable and writable callbacks are registered
+///   on the same file descriptor (the executor combines them into a single readiness registration);
+/// - kernel acceptance filters (`CAN_RAW_FILTER`) are computed from the libcyphal filters,
+///   and compacted (merged) to a bounded number of filters - a short list of kernel filters means less
+///   per-frame kernel work, at the cost of a few false accepts, which are then dropped early by `pop`;
+/// - received frames are read in batches (by `recvmmsg`) - one syscall per up to `RxBatchSize` frames.
+///
 class CanMedia final : public libcyphal::transport::can::IMedia
 {
 public:
+    /// Defines statistics of the acceptance filtering.
+    ///
+    struct FilterStats
+    {
+        /// Number of filters requested by the transport.
+        std::size_t requested_filters{0};
+
+        /// Number of filters installed into the kernel - the kernel scans them linearly per each frame.
+        std::size_t kernel_filters{0};
+
+        /// Number of frames accepted by the kernel and passed to the transport.
+        std::uint64_t accepted_frames{0};
+
+        /// Number of frames accepted by the kernel (due to compacted filters),
+        /// but discarded because they don't match any of the requested filters.
+        std::uint64_t discarded_frames{0};
+
+    };  // FilterStats
+
     CETL_NODISCARD static cetl::variant<CanMedia, libcyphal::transport::PlatformError> make(
         cetl::pmr::memory_resource& general_mr,
         libcyphal::IExecutor&       executor,
         const cetl::string_view     iface_address_sv,
-        cetl::pmr::memory_resource& tx_mr)
+        cetl::pmr::memory_resource& tx_mr,
+        const std::size_t           max_filters)
     {
-        const std::string iface_address{iface_address_sv.data(), iface_address_sv.size()};
+        std::string iface_address{iface_address_sv.data(), iface_address_sv.size()};
 
-        const SocketCANFD socket_can_rx_fd = ::socketcanOpen(iface_address.c_str(), false);
-        if (socket_can_rx_fd < 0)
+        common::io::OwnFd socket_fd;
+        if (const auto err = openSocket(iface_address, socket_fd))
         {
-            return libcyphal::transport::PlatformError{ocvsmd::platform::PosixPlatformError{-socket_can_rx_fd}};
+            return libcyphal::transport::PlatformError{ocvsmd::platform::PosixPlatformError{err}};
         }
 
-        // We gonna register separate callbacks for rx & tx (aka pop & push),
-        // so at executor (especially in case of the "epoll" one) we need separate file descriptors.
-        //
-        const SocketCANFD socket_can_tx_fd = ::socketcanOpen(iface_address.c_str(), false);
-        if (socket_can_tx_fd < 0)
-        {
-            const int error_code = -socket_can_tx_fd;
-            (void) ::close(socket_can_rx_fd);
-            return libcyphal::transport::PlatformError{ocvsmd::platform::PosixPlatformError{error_code}};
-        }
-
-        return CanMedia{general_mr, executor, socket_can_rx_fd, socket_can_tx_fd, std::move(iface_address), tx_mr};
+        return CanMedia{general_mr, executor, std::move(socket_fd), std::move(iface_address), tx_mr, max_filters};
     }
 
-    ~CanMedia()
-    {
-        if (socket_can_rx_fd_ >= 0)
-        {
-            (void) ::close(socket_can_rx_fd_);
-        }
-        if (socket_can_tx_fd_ >= 0)
-        {
-            (void) ::close(socket_can_tx_fd_);
-        }
-    }
+    ~CanMedia() = default;
 
     CanMedia(const CanMedia&)                = delete;
     CanMedia& operator=(const CanMedia&)     = delete;
@@ -93,36 +112,39 @@ public:
     CanMedia(CanMedia&& other) noexcept
         : general_mr_{other.general_mr_}
         , executor_{other.executor_}
-        , socket_can_rx_fd_{std::exchange(other.socket_can_rx_fd_, -1)}
-        , socket_can_tx_fd_{std::exchange(other.socket_can_tx_fd_, -1)}
+        , socket_fd_{std::move(other.socket_fd_)}
         , iface_address_{std::move(other.iface_address_)}
         , tx_mr_{other.tx_mr_}
+        , max_filters_{other.max_filters_}
+        , exact_matcher_{std::move(other.exact_matcher_)}
+        , filter_stats_{other.filter_stats_}
+        , pop_function_{std::move(other.pop_function_)}
+        , rx_frames_{other.rx_frames_}
+        , rx_next_{std::exchange(other.rx_next_, 0)}
+        , rx_size_{std::exchange(other.rx_size_, 0)}
+        , rx_consumed_{other.rx_consumed_}
     {
     }
 
-    void tryReopen()
+    const std::string& getIfaceAddress() const noexcept
     {
-        if (socket_can_rx_fd_ >= 0)
-        {
-            (void) ::close(socket_can_rx_fd_);
-            socket_can_rx_fd_ = -1;
-        }
-        if (socket_can_tx_fd_ >= 0)
-        {
-            (void) ::close(socket_can_tx_fd_);
-            socket_can_tx_fd_ = -1;
-        }
+        return iface_address_;
+    }
 
-        const SocketCANFD socket_can_rx_fd = ::socketcanOpen(iface_address_.c_str(), false);
-        if (socket_can_rx_fd >= 0)
-        {
-            socket_can_rx_fd_ = socket_can_rx_fd;
-        }
+    const FilterStats& getFilterStats() const noexcept
+    {
+        return filter_stats_;
+    }
+
+    void tryReopen()
+    {
+        socket_fd_.reset();
+        rx_next_ = rx_size_ = 0;
 
-        const SocketCANFD socket_can_tx_fd = ::socketcanOpen(iface_address_.c_str(), false);
-        if (socket_can_tx_fd >= 0)
+        common::io::OwnFd socket_fd;
+        if (0 == openSocket(iface_address_, socket_fd))
         {
-            socket_can_tx_fd_ = socket_can_tx_fd;
+            socket_fd_ = std::move(socket_fd);
         }
     }
 
@@ -130,21 +152,70 @@ private:
     using Filter  = libcyphal::transport::can::Filter;
     using Filters = libcyphal::transport::can::Filters;
 
+    /// Max number of frames received by a single syscall.
+    static constexpr std::size_t RxBatchSize = 16;
+
     CanMedia(cetl::pmr::memory_resource& general_mr,
              libcyphal::IExecutor&       executor,
-             const SocketCANFD           socket_can_rx_fd,
-             const SocketCANFD           socket_can_tx_fd,
+             common::io::OwnFd&&         socket_fd,
              std::string                 iface_address,
-             cetl::pmr::memory_resource& tx_mr)
+             cetl::pmr::memory_resource& tx_mr,
+             const std::size_t           max_filters)
         : general_mr_{general_mr}
         , executor_{executor}
-        , socket_can_rx_fd_{socket_can_rx_fd}
-        , socket_can_tx_fd_{socket_can_tx_fd}
+        , socket_fd_{std::move(socket_fd)}
         , iface_address_{std::move(iface_address)}
         , tx_mr_{tx_mr}
+        , max_filters_{std::max<std::size_t>(1, std::min<std::size_t>(max_filters, CAN_RAW_FILTER_MAX))}
     {
     }
 
+    /// Opens non-blocking raw CAN socket bound to the given interface.
+    ///
+    /// @return Zero on success, otherwise `errno`-like error code.
+    ///
+    static int openSocket(const std::string& iface_name, common::io::OwnFd& out_fd)
+    {
+        if ((iface_name.size() + 1) > IFNAMSIZ)
+        {
+            return ENAMETOOLONG;
+        }
+
+        common::io::OwnFd fd{::socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, CAN_RAW)};
+        if (fd.get() < 0)
+        {
+            return errno;
+        }
+
+        ::ifreq ifr{};
+        std::memcpy(ifr.ifr_name, iface_name.c_str(), iface_name.size() + 1);  // NOLINT(*-array-to-pointer-decay)
+        if (const auto err = ocvsmd::platform::posixSyscallError([&fd, &ifr] {
+                //
+                return ::ioctl(fd.get(), SIOCGIFINDEX, &ifr);  // NOLINT(*-vararg)
+            }))
+        {
+            return err;
+        }
+
+        ::sockaddr_can addr{};
+        addr.can_family  = AF_CAN;
+        addr.can_ifindex = ifr.ifr_ifindex;
+        if (const auto err = ocvsmd::platform::posixSyscallError([&fd, &addr] {
+                //
+                // NOLINTNEXTLINE(*-reinterpret-cast)
+                return ::bind(fd.get(), reinterpret_cast<const ::sockaddr*>(&addr), sizeof(addr));
+            }))
+        {
+            return err;
+        }
+
+        // Note that `CAN_RAW_RECV_OWN_MSGS` is intentionally not enabled -
+        // there is no need to receive our own frames (and then drop them).
+
+        out_fd = std::move(fd);
+        return 0;
+    }
+
     CETL_NODISCARD libcyphal::IExecutor::Callback::Any registerAwaitableCallback(
         libcyphal::IExecutor::Callback::Function&&                         function,
         const ocvsmd::platform::IPosixExecutorExtension::Trigger::Variant& trigger) const
@@ -158,6 +229,44 @@ private:
         return posix_executor_ext->registerAwaitableCallback(std::move(function), trigger);
     }
 
+    /// Receives next batch of frames (if any) into the RX buffer.
+    ///
+    /// @return Zero on success (even if nothing was received), otherwise `errno`-like error code.
+    ///
+    int receiveBatch() noexcept
+    {
+        CETL_DEBUG_ASSERT(rx_next_ == rx_size_, "Previous batch should be consumed first.");
+
+        std::array<::iovec, RxBatchSize>   iovs{};
+        std::array<::mmsghdr, RxBatchSize> msgs{};
+        for (std::size_t i = 0; i < RxBatchSize; ++i)
+        {
+            iovs[i].iov_base           = &rx_frames_[i];
+            iovs[i].iov_len            = sizeof(::can_frame);
+            msgs[i].msg_hdr.msg_iov    = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        rx_next_ = rx_size_ = 0;
+        const int result    = ::recvmmsg(socket_fd_.get(), msgs.data(), RxBatchSize, MSG_DONTWAIT, nullptr);
+        if (result < 0)
+        {
+            const int err = errno;
+            return ((err == EAGAIN) || (err == EWOULDBLOCK) || (err == EINTR)) ? 0 : err;
+        }
+        rx_size_ = static_cast<std::size_t>(result);
+
+        // Truncated (or CAN FD) frames are not expected, but just in case make them invalid ones.
+        for (std::size_t i = 0; i < rx_size_; ++i)
+        {
+            if (msgs[i].msg_len != sizeof(::can_frame))
+            {
+                rx_frames_[i].can_id = CAN_ERR_FLAG;
+            }
+        }
+        return 0;
+    }
+
     // MARK: - IMedia
 
     std::size_t getMtu() const noexcept override
@@ -167,18 +276,57 @@ private:
 
     cetl::optional<libcyphal::transport::MediaFailure> setFilters(const Filters filters) noexcept override
     {
-        std::vector<CanardFilter> can_filters;
+        std::vector<CanFilter> can_filters;
         can_filters.reserve(filters.size());
         std::transform(filters.begin(), filters.end(), std::back_inserter(can_filters), [](const Filter filter) {
             //
-            return CanardFilter{filter.id, filter.mask};
+            const std::uint32_t mask = filter.mask & CAN_EFF_MASK;
+            return CanFilter{filter.id & mask, mask};
         });
+        const std::size_t requested_filters = can_filters.size();
+        if (requested_filters > max_filters_)
+        {
+            // Compacted kernel filters will accept more than requested, so keep the exact ones
+            // to discard such frames before they reach the transport.
+            exact_matcher_.assign(can_filters);
+            compactFilters(can_filters, max_filters_);
+        }
+        else
+        {
+            exact_matcher_.clear();
+        }
 
-        const std::int16_t result = ::socketcanFilter(socket_can_rx_fd_, can_filters.size(), can_filters.data());
-        if (result < 0)
+        // Only extended data frames are of interest - the rest are rejected by the kernel.
+        std::vector<::can_filter> raw_filters;
+        raw_filters.reserve(can_filters.size());
+        std::transform(can_filters.begin(),
+                       can_filters.end(),
+                       std::back_inserter(raw_filters),
+                       [](const CanFilter& flt) {
+                           //
+                           return ::can_filter{flt.id | CAN_EFF_FLAG, flt.mask | CAN_EFF_FLAG | CAN_RTR_FLAG};
+                       });
+
+        if (const auto err = ocvsmd::platform::posixSyscallError([this, &raw_filters] {
+                //
+                return ::setsockopt(socket_fd_.get(),
+                                    SOL_CAN_RAW,
+                                    CAN_RAW_FILTER,
+                                    raw_filters.data(),
+                                    static_cast<socklen_t>(sizeof(::can_filter) * raw_filters.size()));
+            }))
         {
-            return libcyphal::transport::PlatformError{ocvsmd::platform::PosixPlatformError{-result}};
+            return libcyphal::transport::PlatformError{ocvsmd::platform::PosixPlatformError{err}};
         }
+
+        common::getLogger("io")->debug("CAN '{}' filters: requested={}, kernel={} (accepted={}, discarded={}).",
+                                       iface_address_,
+                                       requested_filters,
+                                       raw_filters.size(),
+                                       filter_stats_.accepted_frames,
+                                       filter_stats_.discarded_frames);
+        filter_stats_.requested_filters = requested_filters;
+        filter_stats_.kernel_filters    = raw_filters.size();
         return cetl::nullopt;
     }
 
@@ -186,60 +334,102 @@ private:
                           const libcyphal::transport::can::CanId can_id,
                           libcyphal::transport::MediaPayload&    payload) noexcept override
     {
-        const CanardFrame  canard_frame{can_id,
-                                        {payload.getSpan().size(), static_cast<const void*>(payload.getSpan().data())}};
-        const std::int16_t result = ::socketcanPush(socket_can_tx_fd_, &canard_frame, 0);
-        if (result < 0)
+        const auto payload_span = payload.getSpan();
+        if (payload_span.size() > CAN_MAX_DLEN)
         {
-            return libcyphal::transport::PlatformError{ocvsmd::platform::PosixPlatformError{-result}};
+            return libcyphal::transport::PlatformError{ocvsmd::platform::PosixPlatformError{EINVAL}};
         }
 
-        const bool is_accepted = result > 0;
-        if (is_accepted)
+        ::can_frame frame{};
+        frame.can_id  = (can_id & CAN_EFF_MASK) | CAN_EFF_FLAG;
+        frame.can_dlc = static_cast<std::uint8_t>(payload_span.size());
+        std::memcpy(frame.data, payload_span.data(), payload_span.size());  // NOLINT(*-array-to-pointer-decay)
+
+        if (::write(socket_fd_.get(), &frame, sizeof(frame)) < 0)
         {
-            // Payload is not needed anymore, so return memory asap.
-            payload.reset();
+            const int err = errno;
+            if ((err == EAGAIN) || (err == EWOULDBLOCK) || (err == EINTR))
+            {
+                return PushResult::Success{false};
+            }
+            return libcyphal::transport::PlatformError{ocvsmd::platform::PosixPlatformError{err}};
         }
 
-        return PushResult::Success{is_accepted};
+        // Payload is not needed anymore, so return memory asap.
+        payload.reset();
+
+        return PushResult::Success{true};
     }
 
     CETL_NODISCARD PopResult::Type pop(const cetl::span<cetl::byte> payload_buffer) noexcept override
     {
-        CanardFrame canard_frame{};
-        bool        is_loopback{false};
-
-        const std::int16_t result = ::socketcanPop(socket_can_rx_fd_,
-                                                   &canard_frame,
-                                                   nullptr,
-                                                   payload_buffer.size(),
-                                                   payload_buffer.data(),
-                                                   0,
-                                                   &is_loopback);
-        if (result < 0)
+        if (rx_next_ == rx_size_)
         {
-            return libcyphal::transport::PlatformError{ocvsmd::platform::PosixPlatformError{-result}};
+            if (const auto err = receiveBatch())
+            {
+                return libcyphal::transport::PlatformError{ocvsmd::platform::PosixPlatformError{err}};
+            }
         }
-        if (result == 0)
+
+        while (rx_next_ < rx_size_)
         {
-            return cetl::nullopt;
+            const ::can_frame& frame = rx_frames_[rx_next_++];
+            ++rx_consumed_;
+
+            const bool is_valid = ((frame.can_id & CAN_EFF_FLAG) != 0) &&  // Extended frame
+                                  ((frame.can_id & CAN_ERR_FLAG) == 0) &&  // Not error frame
+                                  ((frame.can_id & CAN_RTR_FLAG) == 0);    // Not RTR frame
+            if (!is_valid)
+            {
+                continue;
+            }
+            const std::uint32_t can_id = frame.can_id & CAN_EFF_MASK;
+            if (!exact_matcher_.empty() && !exact_matcher_.accepts(can_id))
+            {
+                ++filter_stats_.discarded_frames;
+                continue;
+            }
+            if (frame.can_dlc > payload_buffer.size())
+            {
+                return libcyphal::transport::PlatformError{ocvsmd::platform::PosixPlatformError{EFBIG}};
+            }
+
+            ++filter_stats_.accepted_frames;
+            std::memcpy(payload_buffer.data(), frame.data, frame.can_dlc);  // NOLINT(*-array-to-pointer-decay)
+            return PopResult::Metadata{executor_.now(), can_id, frame.can_dlc};
         }
 
-        return PopResult::Metadata{executor_.now(), canard_frame.extended_can_id, canard_frame.payload.size};
+        return cetl::nullopt;
     }
 
     CETL_NODISCARD libcyphal::IExecutor::Callback::Any registerPushCallback(
         libcyphal::IExecutor::Callback::Function&& function) override
     {
         using WritableTrigger = ocvsmd::platform::IPosixExecutorExtension::Trigger::Writable;
-        return registerAwaitableCallback(std::move(function), WritableTrigger{socket_can_tx_fd_});
+        return registerAwaitableCallback(std::move(function), WritableTrigger{socket_fd_.get()});
     }
 
     CETL_NODISCARD libcyphal::IExecutor::Callback::Any registerPopCallback(
         libcyphal::IExecutor::Callback::Function&& function) override
     {
         using ReadableTrigger = ocvsmd::platform::IPosixExecutorExtension::Trigger::Readable;
-        return registerAwaitableCallback(std::move(function), ReadableTrigger{socket_can_rx_fd_});
+
+        // Frames which were already received (as part of a batch) won't make the socket readable again,
+        // so keep handing them over to the transport for as long as it consumes them.
+        //
+        pop_function_ = std::move(function);
+        return registerAwaitableCallback(
+            [this](const auto& arg) {
+                //
+                std::uint64_t consumed_before = 0;
+                do
+                {
+                    consumed_before = rx_consumed_;
+                    pop_function_(arg);
+
+                } while ((rx_next_ < rx_size_) && (rx_consumed_ != consumed_before));
+            },
+            ReadableTrigger{socket_fd_.get()});
     }
 
     cetl::pmr::memory_resource& getTxMemoryResource() override
@@ -249,12 +439,19 @@ private:
 
     // MARK: Data members:
 
-    cetl::pmr::memory_resource& general_mr_;
-    libcyphal::IExecutor&       executor_;
-    SocketCANFD                 socket_can_rx_fd_;
-    SocketCANFD                 socket_can_tx_fd_;
-    std::string                 iface_address_;
-    cetl::pmr::memory_resource& tx_mr_;
+    cetl::pmr::memory_resource&              general_mr_;
+    libcyphal::IExecutor&                    executor_;
+    common::io::OwnFd                        socket_fd_;
+    std::string                              iface_address_;
+    cetl::pmr::memory_resource&              tx_mr_;
+    std::size_t                              max_filters_;
+    CanFilterMatcher                         exact_matcher_;
+    FilterStats                              filter_stats_;
+    libcyphal::IExecutor::Callback::Function pop_function_;
+    std::array<::can_frame, RxBatchSize>     rx_frames_{};
+    std::size_t                              rx_next_{0};
+    std::size_t                              rx_size_{0};
+    std::uint64_t                            rx_consumed_{0};
 
 };  // CanMedia
 
@@ -272,7 +469,7 @@ struct CanMediaCollection
     {
     }
 
-    void parse(const cetl::string_view iface_addresses)
+    void parse(const cetl::string_view iface_addresses, const std::size_t max_filters)
     {
         // Reset the collection.
         for (std::size_t i = 0; i < MaxCanMedia; i++)
@@ -291,7 +488,7 @@ struct CanMediaCollection
             const auto iface_address = iface_addresses.substr(curr, next - curr);
             if (!iface_address.empty())
             {
-                auto maybe_media = CanMedia::make(general_mr_, executor_, iface_address, tx_mr_);
+                auto maybe_media = CanMedia::make(general_mr_, executor_, iface_address, tx_mr_, max_filters);
                 if (auto* const media_ptr = cetl::get_if<CanMedia>(&maybe_media))
                 {
                     media_array_[index].emplace(std::move(*media_ptr));     // NOLINT
@@ -309,6 +506,23 @@ struct CanMediaCollection
         return {media_ifaces_.data(), media_ifaces_.size()};
     }
 
+    void logStats(common::Logger& logger) const
+    {
+        for (const auto& media : media_array_)
+        {
+            if (media)
+            {
+                const auto& stats = media->getFilterStats();
+                logger.info("CAN '{}' filters: requested={}, kernel={}, accepted={}, discarded={}.",
+                            media->getIfaceAddress(),
+                            stats.requested_filters,
+                            stats.kernel_filters,
+                            stats.accepted_frames,
+                            stats.discarded_frames);
+            }
+        }
+    }
+
     std::size_t count() const
     {
         return std::count_if(media_ifaces_.cbegin(), media_ifaces_.cend(), [](const auto* iface) {
@@ -0,0 +1,110 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "memory_stats_service.hpp"
+
+#include "ipc/channel.hpp"
+#include "ipc/server_router.hpp"
+#include "logging.hpp"
+#include "stats_memory_resource.hpp"
+#include "svc/diag/memory_stats_spec.hpp"
+#include "svc/svc_helpers.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <utility>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace svc
+{
+namespace diag
+{
+namespace
+{
+
+/// Defines 'Diag: Memory Stats' service implementation.
+///
+/// It's passed (as a functor) to the IPC server router to handle incoming service requests.
+/// See `ipc::ServerRouter::registerChannel` for details, and below `operator()` for the actual implementation.
+///
+class MemoryStatsServiceImpl final
+{
+public:
+    using Spec    = common::svc::diag::MemoryStatsSpec;
+    using Channel = common::ipc::Channel<Spec::Request, Spec::Response>;
+
+    explicit MemoryStatsServiceImpl(const ScvContext& context)
+        : context_{context}
+    {
+    }
+
+    /// Handles the `diag::MemoryStats` service request of a new IPC channel.
+    ///
+    /// Defined as a functor operator - as it's required/expected by the IPC server router.
+    /// The request is served immediately - one response per (matching) subsystem is sent,
+    /// and then the channel is completed.
+    ///
+    void operator()(Channel&& channel, const Spec::Request& request)
+    {
+        const std::string subsystem{request.subsystem.begin(), request.subsystem.end()};
+        logger_->debug("New '{}' service channel (subsystem='{}').", Spec::svc_full_name(), subsystem);
+
+        int result = 0;
+        context_.memory_accounting.forEach([&](const std::string& name, const common::MemoryStats& stats) {
+            //
+            if ((0 != result) || (!subsystem.empty() && (subsystem != name)))
+            {
+                return;
+            }
+
+            Spec::Response response{&context_.memory};
+            const auto     name_len = std::min<std::size_t>(name.size(),  //
+                                                        Spec::Response::_traits_::ArrayCapacity::subsystem);
+            std::copy_n(name.begin(), name_len, std::back_inserter(response.subsystem));
+            response.allocated_bytes      = stats.allocated_bytes;
+            response.peak_allocated_bytes = stats.peak_allocated_bytes;
+            response.allocations          = stats.allocations;
+            response.deallocations        = stats.deallocations;
+            response.failed_allocations   = stats.failed_allocations;
+
+            result = channel.send(response);
+            if (0 != result)
+            {
+                logger_->warn("MemoryStatsSvc: failed to send ipc response (subsystem='{}', err={}).", name, result);
+            }
+        });
+
+        channel.complete(result);
+    }
+
+private:
+    const ScvContext  context_;
+    common::LoggerPtr logger_{common::getLogger("engine")};
+
+};  // MemoryStatsServiceImpl
+
+}  // namespace
+
+void MemoryStatsService::registerWithContext(const ScvContext& context)
+{
+    using Impl = MemoryStatsServiceImpl;
+
+    context.ipc_router.registerChannel<Impl::Channel>(Impl::Spec::svc_full_name(), Impl{context});
+}
+
+}  // namespace diag
+}  // namespace svc
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
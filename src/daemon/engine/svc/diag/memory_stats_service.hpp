@@ -0,0 +1,38 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_DAEMON_ENGINE_SVC_DIAG_MEMORY_STATS_SERVICE_HPP_INCLUDED
+#define OCVSMD_DAEMON_ENGINE_SVC_DIAG_MEMORY_STATS_SERVICE_HPP_INCLUDED
+
+#include "svc/svc_helpers.hpp"
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace svc
+{
+namespace diag
+{
+
+/// Defines registration factory of the 'Diag: Memory Stats' service.
+///
+class MemoryStatsService
+{
+public:
+    MemoryStatsService() = delete;
+    static void registerWithContext(const ScvContext& context);
+
+};  // MemoryStatsService
+
+}  // namespace diag
+}  // namespace svc
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_DAEMON_ENGINE_SVC_DIAG_MEMORY_STATS_SERVICE_HPP_INCLUDED
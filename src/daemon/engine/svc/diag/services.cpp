@@ -0,0 +1,31 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "services.hpp"
+
+#include "memory_stats_service.hpp"
+#include "svc/svc_helpers.hpp"
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace svc
+{
+namespace diag
+{
+
+void registerAllServices(const ScvContext& context)
+{
+    MemoryStatsService::registerWithContext(context.withMemoryOf("svc.diag.memory_stats"));
+}
+
+}  // namespace diag
+}  // namespace svc
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
@@ -0,0 +1,341 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "port_users_service.hpp"
+
+#include "cyphal/node_monitor.hpp"
+#include "cyphal/port_index.hpp"
+#include "ipc/channel.hpp"
+#include "ipc/server_router.hpp"
+#include "logging.hpp"
+#include "ocvsmd/common/svc/monitor/PortRef_0_1.hpp"
+#include "svc/monitor/port_users_spec.hpp"
+#include "svc/svc_helpers.hpp"
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/types.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace svc
+{
+namespace monitor
+{
+namespace
+{
+
+/// Defines 'Monitor: Port Users' service implementation.
+///
+/// It's passed (as a functor) to the IPC server router to handle incoming service requests.
+/// See `ipc::ServerRouter::registerChannel` for details, and below `operator()` for the actual implementation.
+///
+class PortUsersServiceImpl final
+{
+public:
+    using Spec    = common::svc::monitor::PortUsersSpec;
+    using Channel = common::ipc::Channel<Spec::Request, Spec::Response>;
+
+    PortUsersServiceImpl(const ScvContext& context, cyphal::NodeMonitor& node_monitor)
+        : context_{context}
+        , node_monitor_{node_monitor}
+    {
+    }
+
+    /// Handles the initial `monitor::PortUsers` service request of a new IPC channel.
+    ///
+    /// Defined as a functor operator - as it's required/expected by the IPC server router.
+    ///
+    void operator()(Channel&& channel, const Spec::Request& request)
+    {
+        const auto session_id = next_session_id_++;
+        logger_->debug("New '{}' service channel (session={}).", Spec::svc_full_name(), session_id);
+
+        auto session               = std::make_shared<Session>(*this, session_id, std::move(channel), request);
+        id_to_session_[session_id] = session;
+
+        session->start();
+    }
+
+private:
+    using PortRef   = common::svc::monitor::PortRef_0_1;
+    using PortIndex = cyphal::PortIndex;
+
+    static constexpr libcyphal::Duration DefaultUpdatePeriod = std::chrono::seconds{1};
+    static constexpr libcyphal::Duration MinUpdatePeriod     = std::chrono::milliseconds{100};
+
+    // Defines private session of a single port users query. There is one session per each service request channel.
+    //
+    // 1. On its `start` the session sends users of all requested ports (looked up in the monitor's port index).
+    // 2. If not subscribed, the session completes right away. Otherwise, periodically, it checks the monitor's
+    //    sequence number, and if there were changes since the previously sent update, sends the next update -
+    //    only ports which index entries have changed since (according to their sequence numbers).
+    // 3. The subscribed session lasts until the channel is completed by the client (or a send failure).
+    //
+    class Session final
+    {
+    public:
+        using Id  = std::uint64_t;
+        using Ptr = std::shared_ptr<Session>;
+
+        Session(PortUsersServiceImpl& service, const Id id, Channel&& channel, const Spec::Request& request)
+            : id_{id}
+            , channel_{std::move(channel)}
+            , service_{service}
+            , subscribe_{request.subscribe}
+            , update_period_{std::max<libcyphal::Duration>(MinUpdatePeriod,
+                                                           (request.update_period_ms > 0)
+                                                               ? std::chrono::milliseconds{request.update_period_ms}
+                                                               : DefaultUpdatePeriod)}
+        {
+            logger().trace("PortUsersSvc::Session (id={}).", id_);
+
+            ports_.reserve(request.ports.size());
+            std::transform(request.ports.begin(),
+                           request.ports.end(),
+                           std::back_inserter(ports_),
+                           [](const PortRef& ref) { return Port{ref.kind, ref.port_id, 0}; });
+
+            channel_.subscribe([this](const auto& event_var) {
+                //
+                cetl::visit([this](const auto& event) { handleEvent(event); }, event_var);
+            });
+        }
+
+        ~Session()
+        {
+            logger().trace("PortUsersSvc::~Session (id={}).", id_);
+        }
+
+        Session(const Session&)                = delete;
+        Session(Session&&) noexcept            = delete;
+        Session& operator=(const Session&)     = delete;
+        Session& operator=(Session&&) noexcept = delete;
+
+        void start()
+        {
+            using Schedule = libcyphal::IExecutor::Callback::Schedule;
+
+            const auto invalid = std::find_if(ports_.begin(), ports_.end(), [](const Port& port) {
+                //
+                return port.kind > PortRef::KIND_SERVER;
+            });
+            if (invalid != ports_.end())
+            {
+                logger().warn("PortUsersSvc: invalid port kind (kind={}, session={}).", invalid->kind, id_);
+                complete(EINVAL);
+                return;
+            }
+
+            if (const auto err = sendUpdate(true))
+            {
+                complete(err);
+                return;
+            }
+            if (!subscribe_)
+            {
+                complete(0);
+                return;
+            }
+
+            auto& executor   = service_.context_.executor;
+            update_callback_ = executor.registerCallback([this](const auto&) {
+                //
+                if (monitor().sequence() == sent_sequence_)
+                {
+                    return;
+                }
+                if (const auto err = sendUpdate(false))
+                {
+                    complete(err);
+                }
+            });
+            update_callback_.schedule(Schedule::Repeat{executor.now() + update_period_, update_period_});
+        }
+
+    private:
+        /// Holds a requested port, and the sequence number of its index entry which was sent to the client.
+        ///
+        struct Port
+        {
+            std::uint8_t  kind;
+            std::uint16_t port_id;
+            std::uint64_t sent_sequence;
+        };
+
+        common::Logger& logger() const
+        {
+            return *service_.logger_;
+        }
+
+        cetl::pmr::memory_resource& memory() const
+        {
+            return service_.context_.memory;
+        }
+
+        cyphal::NodeMonitor& monitor() const
+        {
+            return service_.node_monitor_;
+        }
+
+        // We are not interested in handling these events.
+        static void handleEvent(const Channel::Connected&) {}
+        static void handleEvent(const Channel::Input&) {}
+        static void handleEvent(const Channel::Resumed&) {}
+
+        void handleEvent(const Channel::Completed& completed)
+        {
+            logger().debug("PortUsersSvc::Session::handleEvent({}) (id={}).", completed, id_);
+            complete(ECANCELED);
+        }
+
+        /// Sends users of ports which have changed since the previous update (or all of them for the initial one).
+        ///
+        /// The end message is sent only if there was at least one port to send (or for the initial update).
+        ///
+        CETL_NODISCARD int sendUpdate(const bool is_initial)
+        {
+            const auto  sequence   = monitor().sequence();
+            const auto& port_index = monitor().portIndex();
+
+            bool has_sent = false;
+            for (auto& port : ports_)
+            {
+                const auto* const users = port_index.find(static_cast<PortIndex::Kind>(port.kind), port.port_id);
+                const auto        users_sequence = (users != nullptr) ? users->sequence : 0;
+                if (!is_initial && (users_sequence <= port.sent_sequence))
+                {
+                    continue;
+                }
+
+                if (const auto err = sendPort(port, users, sequence))
+                {
+                    logger().warn("PortUsersSvc: failed to send ipc update (err={}, session={}).", err, id_);
+                    return err;
+                }
+                port.sent_sequence = users_sequence;
+                has_sent           = true;
+            }
+
+            if (is_initial || has_sent)
+            {
+                Spec::Response response{&memory()};
+                response.sequence      = sequence;
+                response.is_update_end = true;
+                if (const auto err = channel_.send(response))
+                {
+                    logger().warn("PortUsersSvc: failed to send ipc update end (err={}, session={}).", err, id_);
+                    return err;
+                }
+            }
+
+            sent_sequence_ = sequence;
+            return 0;
+        }
+
+        /// Sends users of the port - split into several messages if there are too many of them.
+        ///
+        CETL_NODISCARD int sendPort(const Port& port, const PortIndex::Users* const users, const std::uint64_t sequence)
+        {
+            constexpr auto Limit = static_cast<std::size_t>(Spec::Response::MAX_NODE_IDS);
+
+            PortRef port_ref{};
+            port_ref.kind    = port.kind;
+            port_ref.port_id = port.port_id;
+
+            Spec::Response response{&memory()};
+            response.sequence = sequence;
+            response.port.push_back(port_ref);
+
+            const std::size_t total  = (users != nullptr) ? users->node_ids.size() : 0;
+            std::size_t       offset = 0;
+            do
+            {
+                const auto end = std::min(total, offset + Limit);
+                response.node_ids.clear();
+                if (users != nullptr)
+                {
+                    std::copy(users->node_ids.begin() + static_cast<std::ptrdiff_t>(offset),
+                              users->node_ids.begin() + static_cast<std::ptrdiff_t>(end),
+                              std::back_inserter(response.node_ids));
+                }
+                response.is_continued = end < total;
+
+                if (const auto err = channel_.send(response))
+                {
+                    return err;
+                }
+                offset = end;
+
+            } while (offset < total);
+
+            return 0;
+        }
+
+        void complete(const int err)
+        {
+            update_callback_.reset();
+            channel_.complete(err);
+
+            service_.releaseSessionBy(id_);
+        }
+
+        const Id                            id_;
+        Channel                             channel_;
+        PortUsersServiceImpl&               service_;
+        const bool                          subscribe_;
+        const libcyphal::Duration           update_period_;
+        std::vector<Port>                   ports_;
+        std::uint64_t                       sent_sequence_{0};
+        libcyphal::IExecutor::Callback::Any update_callback_;
+
+    };  // Session
+
+    void releaseSessionBy(const Session::Id session_id)
+    {
+        id_to_session_.erase(session_id);
+    }
+
+    const ScvContext                              context_;
+    cyphal::NodeMonitor&                          node_monitor_;
+    Session::Id                                   next_session_id_{0};
+    std::unordered_map<Session::Id, Session::Ptr> id_to_session_;
+    common::LoggerPtr                             logger_{common::getLogger("engine")};
+
+};  // PortUsersServiceImpl
+
+constexpr libcyphal::Duration PortUsersServiceImpl::DefaultUpdatePeriod;
+constexpr libcyphal::Duration PortUsersServiceImpl::MinUpdatePeriod;
+
+}  // namespace
+
+void PortUsersService::registerWithContext(const ScvContext& context, cyphal::NodeMonitor& node_monitor)
+{
+    using Impl = PortUsersServiceImpl;
+
+    context.registerChannel<Impl::Channel>(Impl::Spec::svc_full_name(), Impl{context, node_monitor});
+}
+
+}  // namespace monitor
+}  // namespace svc
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
@@ -0,0 +1,39 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_DAEMON_ENGINE_SVC_MONITOR_PORT_USERS_SERVICE_HPP_INCLUDED
+#define OCVSMD_DAEMON_ENGINE_SVC_MONITOR_PORT_USERS_SERVICE_HPP_INCLUDED
+
+#include "cyphal/node_monitor.hpp"
+#include "svc/svc_helpers.hpp"
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace svc
+{
+namespace monitor
+{
+
+/// Defines registration factory of the 'Monitor: Port Users' service.
+///
+class PortUsersService
+{
+public:
+    PortUsersService() = delete;
+    static void registerWithContext(const ScvContext& context, cyphal::NodeMonitor& node_monitor);
+
+};  // PortUsersService
+
+}  // namespace monitor
+}  // namespace svc
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_DAEMON_ENGINE_SVC_MONITOR_PORT_USERS_SERVICE_HPP_INCLUDED
@@ -0,0 +1,34 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "services.hpp"
+
+#include "port_users_service.hpp"
+#include "snapshot_service.hpp"
+#include "cyphal/node_monitor.hpp"
+#include "svc/svc_helpers.hpp"
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace svc
+{
+namespace monitor
+{
+
+void registerAllServices(const ScvContext& context, cyphal::NodeMonitor& node_monitor)
+{
+    SnapshotService::registerWithContext(context.withMemoryOf("svc.monitor.snapshot"), node_monitor);
+    PortUsersService::registerWithContext(context.withMemoryOf("svc.monitor.port_users"), node_monitor);
+}
+
+}  // namespace monitor
+}  // namespace svc
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
@@ -0,0 +1,442 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "snapshot_service.hpp"
+
+#include "cyphal/node_monitor.hpp"
+#include "ipc/channel.hpp"
+#include "ipc/server_router.hpp"
+#include "logging.hpp"
+#include "ocvsmd/common/svc/monitor/NodeDelta_0_1.hpp"
+#include "ocvsmd/common/svc/monitor/PortIdRun_0_1.hpp"
+#include "ocvsmd/common/svc/monitor/UavcanNodeGetInfoRes_0_1.hpp"
+#include "svc/monitor/snapshot_spec.hpp"
+#include "svc/svc_helpers.hpp"
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace svc
+{
+namespace monitor
+{
+namespace
+{
+
+/// Defines 'Monitor: Snapshot' service implementation.
+///
+/// It's passed (as a functor) to the IPC server router to handle incoming service requests.
+/// See `ipc::ServerRouter::registerChannel` for details, and below `operator()` for the actual implementation.
+///
+class SnapshotServiceImpl final
+{
+public:
+    using Spec    = common::svc::monitor::SnapshotSpec;
+    using Channel = common::ipc::Channel<Spec::Request, Spec::Response>;
+
+    SnapshotServiceImpl(const ScvContext& context, cyphal::NodeMonitor& node_monitor)
+        : context_{context}
+        , node_monitor_{node_monitor}
+    {
+    }
+
+    /// Handles the initial `monitor::Snapshot` service request of a new IPC channel.
+    ///
+    /// Defined as a functor operator - as it's required/expected by the IPC server router.
+    ///
+    void operator()(Channel&& channel, const Spec::Request& request)
+    {
+        const auto session_id = next_session_id_++;
+        logger_->debug("New '{}' service channel (session={}).", Spec::svc_full_name(), session_id);
+
+        auto session               = std::make_shared<Session>(*this, session_id, std::move(channel), request);
+        id_to_session_[session_id] = session;
+
+        session->start();
+    }
+
+private:
+    using Shadow      = cyphal::NodeMonitor::Shadow;
+    using NodeInfo    = cyphal::NodeMonitor::NodeInfo;
+    using NodeDelta   = common::svc::monitor::NodeDelta_0_1;
+    using IpcNodeInfo = common::svc::monitor::UavcanNodeGetInfoRes_0_1;
+    using PortRun     = common::svc::monitor::PortIdRun_0_1;
+    using PortRuns    = std::vector<PortRun>;
+
+    static constexpr libcyphal::Duration DefaultUpdatePeriod = std::chrono::seconds{1};
+    static constexpr libcyphal::Duration MinUpdatePeriod     = std::chrono::milliseconds{100};
+
+    // Defines private session of a single monitor stream. There is one session per each service request channel.
+    //
+    // 1. On its `start` the session sends the initial snapshot (all shadows of the monitor).
+    // 2. Then, periodically, it checks the monitor's sequence number, and if there were changes since
+    //    the previously sent update, sends the next update - only shadows which have changed since.
+    //    The session remembers what it has sent per each node, so that only changed parts are sent
+    //    (f.e. info only if it has changed, and port lists as run-length encoded sets of added/removed port IDs).
+    // 3. The session lasts until the channel is completed by the client (or a send failure).
+    //
+    class Session final
+    {
+    public:
+        using Id  = std::uint64_t;
+        using Ptr = std::shared_ptr<Session>;
+
+        Session(SnapshotServiceImpl& service, const Id id, Channel&& channel, const Spec::Request& request)
+            : id_{id}
+            , channel_{std::move(channel)}
+            , service_{service}
+            , with_port_lists_{request.with_port_lists}
+            , update_period_{std::max<libcyphal::Duration>(MinUpdatePeriod,
+                                                           (request.update_period_ms > 0)
+                                                               ? std::chrono::milliseconds{request.update_period_ms}
+                                                               : DefaultUpdatePeriod)}
+        {
+            logger().trace("SnapshotSvc::Session (id={}).", id_);
+
+            channel_.subscribe([this](const auto& event_var) {
+                //
+                cetl::visit([this](const auto& event) { handleEvent(event); }, event_var);
+            });
+        }
+
+        ~Session()
+        {
+            logger().trace("SnapshotSvc::~Session (id={}).", id_);
+        }
+
+        Session(const Session&)                = delete;
+        Session(Session&&) noexcept            = delete;
+        Session& operator=(const Session&)     = delete;
+        Session& operator=(Session&&) noexcept = delete;
+
+        void start()
+        {
+            using Schedule = libcyphal::IExecutor::Callback::Schedule;
+
+            auto& executor = service_.context_.executor;
+            if (const auto err = sendUpdate(true, executor.now()))
+            {
+                complete(err);
+                return;
+            }
+
+            update_callback_ = executor.registerCallback([this](const auto& arg) {
+                //
+                if (monitor().sequence() == sent_sequence_)
+                {
+                    return;
+                }
+                if (const auto err = sendUpdate(false, arg.approx_now))
+                {
+                    complete(err);
+                }
+            });
+            update_callback_.schedule(Schedule::Repeat{executor.now() + update_period_, update_period_});
+        }
+
+    private:
+        /// Holds what was sent (so what the client knows) about a node.
+        ///
+        struct SentNode
+        {
+            explicit SentNode(cetl::pmr::memory_resource& memory)
+                : port_list{Shadow::PortList::makeEmpty(memory)}
+            {
+            }
+
+            std::uint64_t    info_sequence{0};
+            std::uint64_t    port_list_sequence{0};
+            Shadow::PortList port_list;
+        };
+
+        // Runs of added and removed port IDs in the order of `NodeDelta` fields.
+        using PortListDiff = std::array<PortRuns, 8>;
+
+        common::Logger& logger() const
+        {
+            return *service_.logger_;
+        }
+
+        cetl::pmr::memory_resource& memory() const
+        {
+            return service_.context_.memory;
+        }
+
+        cyphal::NodeMonitor& monitor() const
+        {
+            return service_.node_monitor_;
+        }
+
+        // We are not interested in handling these events.
+        static void handleEvent(const Channel::Connected&) {}
+        static void handleEvent(const Channel::Input&) {}
+        static void handleEvent(const Channel::Resumed&) {}
+
+        void handleEvent(const Channel::Completed& completed)
+        {
+            logger().debug("SnapshotSvc::Session::handleEvent({}) (id={}).", completed, id_);
+            complete(ECANCELED);
+        }
+
+        CETL_NODISCARD int sendUpdate(const bool is_snapshot, const libcyphal::TimePoint now)
+        {
+            const auto sequence = monitor().sequence();
+
+            int result = 0;
+            monitor().visitChangedSince(sent_sequence_, [&](const Shadow& shadow) {
+                //
+                if (0 == result)
+                {
+                    result = sendNode(shadow, is_snapshot, sequence, now);
+                }
+            });
+            if (0 == result)
+            {
+                result = channel_.send(makeResponse(is_snapshot, sequence, true));
+            }
+            if (0 != result)
+            {
+                logger().warn("SnapshotSvc: failed to send ipc update (err={}, session={}).", result, id_);
+                return result;
+            }
+
+            sent_sequence_ = sequence;
+            return 0;
+        }
+
+        CETL_NODISCARD int sendNode(const Shadow&              shadow,
+                                    const bool                 is_snapshot,
+                                    const std::uint64_t        sequence,
+                                    const libcyphal::TimePoint now)
+        {
+            auto found = id_to_sent_node_.find(shadow.node_id);
+            if (found == id_to_sent_node_.end())
+            {
+                found = id_to_sent_node_.emplace(shadow.node_id, SentNode{memory()}).first;
+            }
+            auto& sent = found->second;
+
+            NodeDelta delta{&memory()};
+            delta.node_id          = shadow.node_id;
+            delta.is_online        = shadow.is_online;
+            delta.heartbeat_age_us = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(now - shadow.last_heartbeat_at).count());
+            delta.heartbeat = shadow.last_heartbeat;
+
+            if ((0 == sent.info_sequence) || (shadow.info_sequence > sent.info_sequence))
+            {
+                delta.is_info_changed = true;
+                if (shadow.info)
+                {
+                    delta.info.push_back(makeIpcInfo(shadow.info->info));
+                }
+                sent.info_sequence = shadow.info_sequence;
+            }
+
+            PortListDiff diff;
+            if (with_port_lists_ &&
+                ((0 == sent.port_list_sequence) || (shadow.port_list_sequence > sent.port_list_sequence)))
+            {
+                // Missing port list (f.e. after a restart of the node) is sent as a reset without any ports.
+                delta.is_port_list_reset = (0 == sent.port_list_sequence) || !shadow.port_list;
+                if (delta.is_port_list_reset)
+                {
+                    sent.port_list = Shadow::PortList::makeEmpty(memory());
+                }
+                if (shadow.port_list)
+                {
+                    diff           = makePortListDiff(sent.port_list, *shadow.port_list);
+                    sent.port_list = *shadow.port_list;
+                }
+                sent.port_list_sequence = shadow.port_list_sequence;
+            }
+
+            auto response = makeResponse(is_snapshot, sequence, false);
+            response.node.push_back(std::move(delta));
+            return sendPortListDiff(response, diff);
+        }
+
+        /// Sends the response (with a node delta) - split into several messages if the port list diff is too big.
+        ///
+        /// Only the first message carries the info and the port list reset flag.
+        ///
+        CETL_NODISCARD int sendPortListDiff(Spec::Response& response, const PortListDiff& diff)
+        {
+            constexpr auto Limit = static_cast<std::size_t>(NodeDelta::MAX_PORT_RUNS);
+
+            auto& delta  = response.node[0];
+            auto  fields = std::array<decltype(&delta.added_publishers), std::tuple_size<PortListDiff>::value>{
+                &delta.added_publishers,
+                &delta.removed_publishers,
+                &delta.added_subscribers,
+                &delta.removed_subscribers,
+                &delta.added_clients,
+                &delta.removed_clients,
+                &delta.added_servers,
+                &delta.removed_servers};
+
+            std::size_t offset = 0;
+            bool        has_more = false;
+            do
+            {
+                has_more = false;
+                for (std::size_t i = 0; i < fields.size(); ++i)
+                {
+                    auto&       field = *fields[i];
+                    const auto& runs  = diff[i];  // NOLINT(*-constant-array-index)
+                    field.clear();
+                    if (offset < runs.size())
+                    {
+                        const auto end = std::min(runs.size(), offset + Limit);
+                        std::copy(runs.begin() + static_cast<std::ptrdiff_t>(offset),
+                                  runs.begin() + static_cast<std::ptrdiff_t>(end),
+                                  std::back_inserter(field));
+                        has_more = has_more || (end < runs.size());
+                    }
+                }
+
+                if (const auto err = channel_.send(response))
+                {
+                    return err;
+                }
+
+                delta.is_info_changed    = false;
+                delta.is_port_list_reset = false;
+                delta.info.clear();
+                offset += Limit;
+
+            } while (has_more);
+
+            return 0;
+        }
+
+        /// Appends the port ID to the runs - extending the last run if the port ID is the next one after it.
+        ///
+        static void appendToRuns(PortRuns& runs, const std::uint16_t port_id)
+        {
+            if (!runs.empty() && ((runs.back().last + 1U) == port_id))
+            {
+                runs.back().last = port_id;
+                return;
+            }
+            PortRun run{};
+            run.first = port_id;
+            run.last  = port_id;
+            runs.push_back(run);
+        }
+
+        template <typename Set>
+        static void diffPortSets(const Set& old_set, const Set& new_set, PortRuns& added, PortRuns& removed)
+        {
+            Set::diff(
+                old_set,
+                new_set,
+                [&added](const std::uint16_t port_id) { appendToRuns(added, port_id); },
+                [&removed](const std::uint16_t port_id) { appendToRuns(removed, port_id); });
+        }
+
+        static PortListDiff makePortListDiff(const Shadow::PortList& old_list, const Shadow::PortList& new_list)
+        {
+            PortListDiff diff;
+            diffPortSets(old_list.publishers, new_list.publishers, diff[0], diff[1]);
+            diffPortSets(old_list.subscribers, new_list.subscribers, diff[2], diff[3]);
+            diffPortSets(old_list.clients, new_list.clients, diff[4], diff[5]);
+            diffPortSets(old_list.servers, new_list.servers, diff[6], diff[7]);
+            return diff;
+        }
+
+        Spec::Response makeResponse(const bool is_snapshot, const std::uint64_t sequence, const bool is_end) const
+        {
+            Spec::Response response{&memory()};
+            response.sequence      = sequence;
+            response.is_snapshot   = is_snapshot;
+            response.is_update_end = is_end;
+            response.has_anonymous = monitor().hasAnonymous();
+            return response;
+        }
+
+        IpcNodeInfo makeIpcInfo(const NodeInfo& info) const
+        {
+            IpcNodeInfo ipc_info{&memory()};
+            ipc_info.protocol_version            = info.protocol_version;
+            ipc_info.hardware_version            = info.hardware_version;
+            ipc_info.software_version            = info.software_version;
+            ipc_info.software_vcs_revision_id    = info.software_vcs_revision_id;
+            ipc_info.unique_id                   = info.unique_id;
+            ipc_info.name                        = info.name;
+            ipc_info.software_image_crc          = info.software_image_crc;
+            ipc_info.certificate_of_authenticity = info.certificate_of_authenticity;
+            return ipc_info;
+        }
+
+        void complete(const int err)
+        {
+            update_callback_.reset();
+            channel_.complete(err);
+
+            service_.releaseSessionBy(id_);
+        }
+
+        const Id                                    id_;
+        Channel                                     channel_;
+        SnapshotServiceImpl&                        service_;
+        const bool                                  with_port_lists_;
+        const libcyphal::Duration                   update_period_;
+        std::uint64_t                               sent_sequence_{0};
+        std::unordered_map<std::uint16_t, SentNode> id_to_sent_node_;
+        libcyphal::IExecutor::Callback::Any         update_callback_;
+
+    };  // Session
+
+    void releaseSessionBy(const Session::Id session_id)
+    {
+        id_to_session_.erase(session_id);
+    }
+
+    const ScvContext                              context_;
+    cyphal::NodeMonitor&                          node_monitor_;
+    Session::Id                                   next_session_id_{0};
+    std::unordered_map<Session::Id, Session::Ptr> id_to_session_;
+    common::LoggerPtr                             logger_{common::getLogger("engine")};
+
+};  // SnapshotServiceImpl
+
+constexpr libcyphal::Duration SnapshotServiceImpl::DefaultUpdatePeriod;
+constexpr libcyphal::Duration SnapshotServiceImpl::MinUpdatePeriod;
+
+}  // namespace
+
+void SnapshotService::registerWithContext(const ScvContext& context, cyphal::NodeMonitor& node_monitor)
+{
+    using Impl = SnapshotServiceImpl;
+
+    context.registerChannel<Impl::Channel>(Impl::Spec::svc_full_name(), Impl{context, node_monitor});
+}
+
+}  // namespace monitor
+}  // namespace svc
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
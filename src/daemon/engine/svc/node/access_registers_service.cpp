@@ -0,0 +1,229 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "access_registers_service.hpp"
+
+#include "cyphal/register_client.hpp"
+#include "ipc/channel.hpp"
+#include "ipc/server_router.hpp"
+#include "logging.hpp"
+#include "svc/node/access_registers_spec.hpp"
+#include "svc/svc_helpers.hpp"
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/types.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace svc
+{
+namespace node
+{
+namespace
+{
+
+/// Defines 'Node: Access Registers' service implementation.
+///
+/// It's passed (as a functor) to the IPC server router to handle incoming service requests.
+/// See `ipc::ServerRouter::registerChannel` for details, and below `operator()` for the actual implementation.
+///
+class AccessRegistersServiceImpl final
+{
+public:
+    using Spec    = common::svc::node::AccessRegistersSpec;
+    using Channel = common::ipc::Channel<Spec::Request, Spec::Response>;
+
+    AccessRegistersServiceImpl(const ScvContext& context, cyphal::RegisterClient& register_client)
+        : context_{context}
+        , register_client_{register_client}
+    {
+    }
+
+    /// Handles the initial `node::AccessRegisters` service request of a new IPC channel.
+    ///
+    /// Defined as a functor operator - as it's required/expected by the IPC server router.
+    ///
+    void operator()(Channel&& channel, const Spec::Request& request)
+    {
+        const auto session_id = next_session_id_++;
+        logger_->debug("New '{}' service channel (session={}, nodes={}).",
+                       Spec::svc_full_name(),
+                       session_id,
+                       request.node_ids.size());
+
+        auto session               = std::make_shared<Session>(*this, session_id, std::move(channel));
+        id_to_session_[session_id] = session;
+
+        session->start(request);
+    }
+
+private:
+    using AccessSvc = cyphal::RegisterClient::AccessSvc;
+
+    static constexpr libcyphal::Duration DefaultTimeout = std::chrono::seconds{5};
+
+    // Defines private session of a single access request. There is one session per each service request channel.
+    //
+    // 1. On its `start` the session starts the (pipelined) access operation of the register client.
+    // 2. Each node response is streamed back to the IPC client as soon as it arrives.
+    // 3. Finally, the session completes the channel (when all nodes are done, or on a send failure).
+    //
+    class Session final
+    {
+    public:
+        using Id  = std::uint64_t;
+        using Ptr = std::shared_ptr<Session>;
+
+        Session(AccessRegistersServiceImpl& service, const Id id, Channel&& channel)
+            : id_{id}
+            , channel_{std::move(channel)}
+            , service_{service}
+        {
+            logger().trace("AccessRegistersSvc::Session (id={}).", id_);
+
+            channel_.subscribe([this](const auto& event_var) {
+                //
+                cetl::visit([this](const auto& event) { handleEvent(event); }, event_var);
+            });
+        }
+
+        ~Session()
+        {
+            logger().trace("AccessRegistersSvc::~Session (id={}).", id_);
+        }
+
+        Session(const Session&)                = delete;
+        Session(Session&&) noexcept            = delete;
+        Session& operator=(const Session&)     = delete;
+        Session& operator=(Session&&) noexcept = delete;
+
+        void start(const Spec::Request& request)
+        {
+            const libcyphal::Duration timeout = (request.timeout_us > 0)  //
+                                                    ? std::chrono::microseconds{request.timeout_us}
+                                                    : DefaultTimeout;
+
+            std::vector<AccessSvc::Request> cy_requests;
+            cy_requests.reserve(request.items.size());
+            for (const auto& item : request.items)
+            {
+                cy_requests.emplace_back(item.name, item.value, &service_.context_.memory);
+            }
+
+            const std::vector<std::uint16_t>      node_ids{request.node_ids.begin(), request.node_ids.end()};
+            const cyphal::RegisterClient::Options options{service_.context_.executor.now() + timeout,
+                                                          request.window,
+                                                          std::chrono::microseconds{request.max_age_us}};
+
+            operation_ = service_.register_client_.access(  //
+                node_ids,
+                cy_requests,
+                options,
+                [this](const auto node_id, const auto& name, const auto error_code, const auto& cy_response) {
+                    //
+                    return sendResult(node_id, name, error_code, cy_response);
+                },
+                [this] {
+                    //
+                    complete(0);
+                });
+        }
+
+    private:
+        common::Logger& logger() const
+        {
+            return *service_.logger_;
+        }
+
+        // We are not interested in handling these events.
+        static void handleEvent(const Channel::Connected&) {}
+        static void handleEvent(const Channel::Input&) {}
+        static void handleEvent(const Channel::Resumed&) {}
+
+        void handleEvent(const Channel::Completed& completed)
+        {
+            logger().debug("AccessRegistersSvc::Session::handleEvent({}) (id={}).", completed, id_);
+            complete(ECANCELED);
+        }
+
+        bool sendResult(const std::uint16_t                 node_id,
+                        const cyphal::RegisterClient::Name& name,
+                        const int                           error_code,
+                        const AccessSvc::Response&          cy_response)
+        {
+            Spec::Response response{&service_.context_.memory};
+            response.node_id       = node_id;
+            response.name          = name;
+            response.error_code    = error_code;
+            response.timestamp_us  = cy_response.timestamp.microsecond;
+            response.is_mutable    = cy_response._mutable;
+            response.is_persistent = cy_response.persistent;
+            response.value         = cy_response.value;
+            if (const auto err = channel_.send(response))
+            {
+                logger().warn("AccessRegistersSvc: failed to send ipc response (err={}, session={}).", err, id_);
+                complete(err);
+                return false;
+            }
+            return true;
+        }
+
+        void complete(const int err)
+        {
+            operation_.reset();
+            channel_.complete(err);
+
+            service_.releaseSessionBy(id_);
+        }
+
+        const Id                               id_;
+        Channel                                channel_;
+        AccessRegistersServiceImpl&             service_;
+        cyphal::RegisterClient::Operation::Ptr operation_;
+
+    };  // Session
+
+    void releaseSessionBy(const Session::Id session_id)
+    {
+        id_to_session_.erase(session_id);
+    }
+
+    const ScvContext                              context_;
+    cyphal::RegisterClient&                       register_client_;
+    Session::Id                                   next_session_id_{0};
+    std::unordered_map<Session::Id, Session::Ptr> id_to_session_;
+    common::LoggerPtr                             logger_{common::getLogger("engine")};
+
+};  // AccessRegistersServiceImpl
+
+constexpr libcyphal::Duration AccessRegistersServiceImpl::DefaultTimeout;
+
+}  // namespace
+
+void AccessRegistersService::registerWithContext(const ScvContext& context, cyphal::RegisterClient& register_client)
+{
+    using Impl = AccessRegistersServiceImpl;
+
+    context.registerChannel<Impl::Channel>(Impl::Spec::svc_full_name(), Impl{context, register_client});
+}
+
+}  // namespace node
+}  // namespace svc
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
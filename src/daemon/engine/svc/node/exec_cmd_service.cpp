@@ -5,26 +5,36 @@
 
 #include "exec_cmd_service.hpp"
 
+#include "config.hpp"
+#include "cyphal/client_cache.hpp"
+#include "cyphal/request_pacer.hpp"
 #include "engine_helpers.hpp"
 #include "ipc/channel.hpp"
 #include "ipc/server_router.hpp"
 #include "logging.hpp"
+#include "svc/node/exec_cmd_batch_spec.hpp"
 #include "svc/node/exec_cmd_spec.hpp"
 #include "svc/svc_helpers.hpp"
 
 #include <uavcan/node/ExecuteCommand_1_3.hpp>
 
+#include <cetl/cetl.hpp>
 #include <cetl/pf17/cetlpf.hpp>
 #include <libcyphal/presentation/client.hpp>
 #include <libcyphal/presentation/presentation.hpp>
 #include <libcyphal/presentation/response_promise.hpp>
+#include <libcyphal/types.hpp>
 
+#include <algorithm>
 #include <cerrno>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace ocvsmd
 {
@@ -39,29 +49,159 @@ namespace node
 namespace
 {
 
+using CyphalExecCmdSvc = uavcan::node::ExecuteCommand_1_3;
+
+/// Defines a single item of command execution - the same Cyphal command request to a set of nodes.
+///
+struct ExecCmdItem
+{
+    CyphalExecCmdSvc::Request  cy_request;
+    std::vector<std::uint16_t> node_ids;  // unique
+};
+using ExecCmdItems = std::vector<ExecCmdItem>;
+
+/// Makes command execution item from the given IPC request parts.
+///
+/// It's ok to have duplicates in the request - we just ignore duplicates, and work with unique ones.
+///
+template <typename NodeIds, typename Payload>
+ExecCmdItem makeExecCmdItem(const NodeIds& node_ids, const Payload& payload, cetl::pmr::memory_resource& memory)
+{
+    const std::unordered_set<std::uint16_t> unique_node_ids{node_ids.begin(), node_ids.end()};
+    return {CyphalExecCmdSvc::Request{payload.command, payload.parameter, &memory},
+            {unique_node_ids.begin(), unique_node_ids.end()}};
+}
+
+/// Adapts different IPC service specs (single and batch commands) to the common command execution.
+///
+template <typename Spec>
+struct ExecCmdSpecAdapter;
+//
+template <>
+struct ExecCmdSpecAdapter<common::svc::node::ExecCmdSpec>
+{
+    using Spec = common::svc::node::ExecCmdSpec;
+
+    static ExecCmdItems makeItems(const Spec::Request& request, cetl::pmr::memory_resource& memory)
+    {
+        ExecCmdItems items;
+        items.push_back(makeExecCmdItem(request.node_ids, request.payload, memory));
+        return items;
+    }
+
+    static Spec::Response makeResponse(const std::size_t                 item_index,
+                                       const std::uint16_t               node_id,
+                                       const CyphalExecCmdSvc::Response& cy_response,
+                                       cetl::pmr::memory_resource&       memory)
+    {
+        (void) item_index;
+        return Spec::Response{node_id, {cy_response.status, cy_response.output, &memory}, &memory};
+    }
+};
+//
+template <>
+struct ExecCmdSpecAdapter<common::svc::node::ExecCmdBatchSpec>
+{
+    using Spec = common::svc::node::ExecCmdBatchSpec;
+
+    static ExecCmdItems makeItems(const Spec::Request& request, cetl::pmr::memory_resource& memory)
+    {
+        ExecCmdItems items;
+        items.reserve(request.items.size());
+        for (const auto& item : request.items)
+        {
+            items.push_back(makeExecCmdItem(item.node_ids, item.payload, memory));
+        }
+        return items;
+    }
+
+    static Spec::Response makeResponse(const std::size_t                 item_index,
+                                       const std::uint16_t               node_id,
+                                       const CyphalExecCmdSvc::Response& cy_response,
+                                       cetl::pmr::memory_resource&       memory)
+    {
+        return Spec::Response{static_cast<std::uint16_t>(item_index),
+                              node_id,
+                              {cy_response.status, cy_response.output, &memory},
+                              &memory};
+    }
+};
+
+/// Defines state shared by all 'Node: Execute Command' services (both single and batch ones).
+///
+/// Clients are shared by all FSMs of the services, so that repeated (fleet-wide) commands
+/// don't create and destroy RX sessions (and so don't churn transport filters) on every request.
+/// The pacer is shared as well, so that bus traffic of all command requests is scheduled globally.
+///
+class ExecCmdShared final
+{
+public:
+    using Ptr               = std::shared_ptr<ExecCmdShared>;
+    using CyphalSvcClient   = libcyphal::presentation::ServiceClient<CyphalExecCmdSvc>;
+    using CyphalClientCache = cyphal::ClientCache<std::uint16_t, CyphalSvcClient>;
+
+    explicit ExecCmdShared(const ScvContext& context)
+        : cy_clients{CyphalClientCache::make(context.executor, ClientCacheCapacity, ClientCacheIdleTimeout)}
+        , pacer{cyphal::RequestPacer::make(context.executor, makePacerLimits(context.config))}
+    {
+    }
+
+    CyphalClientCache::Ptr    cy_clients;
+    cyphal::RequestPacer::Ptr pacer;
+    std::uint64_t             next_fsm_id{0};
+
+private:
+    static constexpr std::size_t         ClientCacheCapacity    = 256;
+    static constexpr libcyphal::Duration ClientCacheIdleTimeout = std::chrono::seconds{30};
+
+    // Default pacing of the fan-out requests (see also `[svc.node.exec_cmd]` section of the config).
+    static constexpr std::uint32_t             DefaultMaxInFlightPerRequest = 16;
+    static constexpr std::uint32_t             DefaultMaxInFlight           = 32;
+    static constexpr std::chrono::microseconds DefaultRequestSpacing{500};
+
+    static cyphal::RequestPacer::Limits makePacerLimits(const Config& config)
+    {
+        return {config.getSvcExecCmdMaxInFlightPerRequest().value_or(DefaultMaxInFlightPerRequest),
+                config.getSvcExecCmdMaxInFlight().value_or(DefaultMaxInFlight),
+                config.getSvcExecCmdRequestSpacing().value_or(DefaultRequestSpacing)};
+    }
+
+};  // ExecCmdShared
+
+constexpr std::size_t               ExecCmdShared::ClientCacheCapacity;
+constexpr libcyphal::Duration       ExecCmdShared::ClientCacheIdleTimeout;
+constexpr std::uint32_t             ExecCmdShared::DefaultMaxInFlightPerRequest;
+constexpr std::uint32_t             ExecCmdShared::DefaultMaxInFlight;
+constexpr std::chrono::microseconds ExecCmdShared::DefaultRequestSpacing;
+
 /// Defines 'Node: Execute Command' service implementation.
 ///
 /// It's passed (as a functor) to the IPC server router to handle incoming service requests.
 /// See `ipc::ServerRouter::registerChannel` for details, and below `operator()` for the actual implementation.
 ///
+/// @tparam Spec_ Either single (`ExecCmdSpec`) or batch (`ExecCmdBatchSpec`) command service spec.
+///
+template <typename Spec_>
 class ExecCmdServiceImpl final
 {
 public:
-    using Spec    = common::svc::node::ExecCmdSpec;
-    using Channel = common::ipc::Channel<Spec::Request, Spec::Response>;
+    using Spec    = Spec_;
+    using Channel = common::ipc::Channel<typename Spec::Request, typename Spec::Response>;
 
-    explicit ExecCmdServiceImpl(const ScvContext& context)
+    ExecCmdServiceImpl(const ScvContext& context, ExecCmdShared::Ptr shared)
         : context_{context}
+        , shared_{std::move(shared)}
     {
     }
 
-    /// Handles the initial `node::ExecCmd` service request of a new IPC channel.
+    /// Handles the initial `node::ExecCmd` (or `node::ExecCmdBatch`) service request of a new IPC channel.
     ///
     /// Defined as a functor operator - as it's required/expected by the IPC server router.
     ///
-    void operator()(Channel&& channel, const Spec::Request& request)
+    void operator()(Channel&& channel, const typename Spec::Request& request)
     {
-        const auto fsm_id = next_fsm_id_++;
+        // FSM ids are unique across both services, so that they could share the pacer.
+        const auto fsm_id = shared_->next_fsm_id++;
         logger_->debug("New '{}' service channel (fsm={}).", Spec::svc_full_name(), fsm_id);
 
         auto fsm           = std::make_shared<Fsm>(*this, fsm_id, std::move(channel));
@@ -71,14 +211,19 @@ public:
     }
 
 private:
+    using Adapter           = ExecCmdSpecAdapter<Spec>;
+    using CyphalSvcClient   = ExecCmdShared::CyphalSvcClient;
+    using CyphalClientCache = ExecCmdShared::CyphalClientCache;
+
     // Defines private Finite State Machine (FSM) which tracks the progress of a single service request.
     // There is one FSM per each service request channel.
     //
-    // 1. On its `start` a set of Cyphal RPC clients is created (one per each node ID in the request),
-    //    and a command request is sent to each of them.
-    // 2. Then, the FSM waits for the RPC responses from the Cyphal nodes, collecting them.
-    // 3. Finally, FSM sends the accumulated result (when all responses are received or timed out)
-    //    and completes the channel.
+    // 1. On its `start` a command request per each (item, node ID) pair in the request is submitted
+    //    to the shared pacer, which sends them (using clients from the shared cache) respecting in-flight
+    //    limits and spacing. A single command request is just a batch of one item.
+    // 2. Then, the FSM waits for the RPC responses from the Cyphal nodes, streaming them back to the IPC client.
+    //    Nodes which didn't respond in time are retried (after a backoff) according to the request's retry policy.
+    // 3. Finally, FSM completes the channel (when all responses are received or timed out).
     //
     class Fsm final
     {
@@ -109,41 +254,58 @@ private:
         Fsm& operator=(const Fsm&)     = delete;
         Fsm& operator=(Fsm&&) noexcept = delete;
 
-        void start(const Spec::Request& request)
+        void start(const typename Spec::Request& request)
         {
             logger().trace("ExecCmdSvc::Fsm::start (fsm_id={}).", id_);
 
+            items_           = Adapter::makeItems(request, memory());
+            deadline_        = service_.context_.executor.now() + std::chrono::microseconds{request.timeout_us};
+            max_attempts_    = std::max<std::uint8_t>(1, request.max_attempts);
+            attempt_timeout_ = std::chrono::microseconds{request.attempt_timeout_us};
+            backoff_         = std::chrono::microseconds{request.backoff_us};
+
+            remaining_ops_ = 0;
+            for (const auto& item : items_)
+            {
+                remaining_ops_ += item.node_ids.size();
+            }
+
             // Immediately complete if there are no nodes to execute the command on.
             //
-            if (request.node_ids.empty())
+            if (remaining_ops_ == 0)
             {
                 complete(0);
                 return;
             }
 
-            // It's ok to have duplicates in the request -
-            // we just ignore duplicates, and work with unique ones.
-            const SetOfNodeIds unique_node_ids{request.node_ids.begin(), request.node_ids.end()};
-
-            const auto deadline = service_.context_.executor.now() + std::chrono::microseconds{request.timeout_us};
-            const CyphalExecCmdSvc::Request cy_request{request.payload.command, request.payload.parameter, &memory()};
-            for (const auto node_id : unique_node_ids)
+            // Requests are not sent right away, but paced (see `RequestPacer` for details).
+            for (std::size_t item_index = 0; item_index < items_.size(); ++item_index)
             {
-                if (const auto err = makeCyphalSvcCallFor(deadline, node_id, cy_request))
+                for (const auto node_id : items_[item_index].node_ids)
                 {
-                    complete(err);
-                    return;
+                    const OpKey op_key{item_index, node_id};
+                    pacer().submit(id_, [this, op_key] { attempt(op_key); });
                 }
             }
         }
 
     private:
-        using SetOfNodeIds         = std::unordered_set<std::uint16_t>;
-        using CyphalExecCmdSvc     = uavcan::node::ExecuteCommand_1_3;
-        using CyphalSvcClient      = libcyphal::presentation::ServiceClient<CyphalExecCmdSvc>;
         using CyphalPromise        = libcyphal::presentation::ResponsePromise<CyphalExecCmdSvc::Response>;
         using CyphalPromiseFailure = libcyphal::presentation::ResponsePromiseFailure;
 
+        // Identifies a single operation of the FSM - a command request of an item to a node.
+        //
+        struct OpKey
+        {
+            std::size_t   item_index;
+            std::uint16_t node_id;
+
+            std::uint32_t packed() const noexcept
+            {
+                return (static_cast<std::uint32_t>(item_index) << 16U) | node_id;
+            }
+        };
+
         struct CyNodeOp
         {
             CyphalSvcClient client;
@@ -160,23 +322,84 @@ private:
             return service_.context_.memory;
         }
 
+        cyphal::RequestPacer& pacer() const
+        {
+            return *service_.shared_->pacer;
+        }
+
+        CyphalClientCache& cyClients() const
+        {
+            return *service_.shared_->cy_clients;
+        }
+
         // We are not interested in handling these events.
-        static void handleEvent(const Channel::Connected&) {}
-        static void handleEvent(const Channel::Input&) {}
+        static void handleEvent(const typename Channel::Connected&) {}
+        static void handleEvent(const typename Channel::Input&) {}
+        static void handleEvent(const typename Channel::Resumed&) {}
 
-        void handleEvent(const Channel::Completed& completed)
+        void handleEvent(const typename Channel::Completed& completed)
         {
             logger().debug("ExecCmdSvc::Fsm::handleEvent({}) (id={}).", completed, id_);
             complete(ECANCELED);
         }
 
-        int makeCyphalSvcCallFor(const libcyphal::TimePoint       deadline,
-                                 const std::uint16_t              node_id,
-                                 const CyphalExecCmdSvc::Request& cy_request)
+        // Makes the next attempt to send the item's command to the node.
+        // Called by the pacer (so an in-flight slot is already taken).
+        //
+        void attempt(const OpKey op_key)
+        {
+            // Queued (or backed off) requests which didn't get their turn before the deadline are timed out.
+            const auto now = service_.context_.executor.now();
+            if (now >= deadline_)
+            {
+                logger().warn("ExecCmdSvc: request to node {} timed out in queue (item={}, fsm_id={}).",
+                              op_key.node_id,
+                              op_key.item_index,
+                              id_);
+                onOpDone();
+                return;
+            }
+
+            const auto attempt_num      = ++op_to_attempts_[op_key.packed()];
+            const auto attempt_deadline = (attempt_timeout_ > libcyphal::Duration::zero())
+                                              ? std::min(deadline_, now + attempt_timeout_)
+                                              : deadline_;
+            logger().trace("ExecCmdSvc: attempt #{} to node {} (item={}, fsm_id={}).",
+                           attempt_num,
+                           op_key.node_id,
+                           op_key.item_index,
+                           id_);
+
+            if (const auto err = makeCyphalSvcCallFor(op_key, attempt_deadline))
+            {
+                complete(err);
+            }
+        }
+
+        // Re-issues the command to the (missing) node if the retry policy and the overall deadline allow.
+        //
+        bool tryRetry(const OpKey op_key)
+        {
+            const auto retry_time = service_.context_.executor.now() + backoff_;
+            if ((op_to_attempts_[op_key.packed()] >= max_attempts_) || (retry_time >= deadline_))
+            {
+                return false;
+            }
+
+            pacer().release(id_);
+            pacer().submitAfter(id_, retry_time, [this, op_key] { attempt(op_key); });
+            return true;
+        }
+
+        int makeCyphalSvcCallFor(const OpKey op_key, const libcyphal::TimePoint deadline)
         {
             using CyphalMakeFailure = libcyphal::presentation::Presentation::MakeFailure;
 
-            auto cy_make_result = service_.context_.presentation.makeClient<CyphalExecCmdSvc>(node_id);
+            const auto node_id        = op_key.node_id;
+            auto       cy_make_result = cyClients().getOrMake(node_id, [this, node_id] {
+                //
+                return service_.context_.presentation.makeClient<CyphalExecCmdSvc>(node_id);
+            });
             if (const auto* cy_failure = cetl::get_if<CyphalMakeFailure>(&cy_make_result))
             {
                 const auto err = failureToErrorCode(*cy_failure);
@@ -188,7 +411,8 @@ private:
             }
             auto cy_svc_client = cetl::get<CyphalSvcClient>(std::move(cy_make_result));
 
-            auto cy_req_result = cy_svc_client.request(deadline, cy_request);
+            const auto& cy_request    = items_[op_key.item_index].cy_request;
+            auto        cy_req_result = cy_svc_client.request(deadline, cy_request);
             if (const auto* cy_failure = cetl::get_if<CyphalSvcClient::Failure>(&cy_req_result))
             {
                 const auto err = failureToErrorCode(*cy_failure);
@@ -196,75 +420,110 @@ private:
                                node_id,
                                err,
                                id_);
+                cyClients().evict(node_id);  // Next request will try a fresh client.
                 return err;
             }
             auto cy_promise = cetl::get<CyphalPromise>(std::move(cy_req_result));
 
-            cy_promise.setCallback([this, node_id](const auto& arg) {
+            cy_promise.setCallback([this, op_key](const auto& arg) {
                 //
-                if (const auto* cy_failure = cetl::get_if<CyphalPromiseFailure>(&arg.result))
+                // The op is released below - together with its promise, and so with this very lambda.
+                // Hence the captures are copied to locals, and only these are in use after the release.
+                auto* const self      = this;
+                const auto  cy_op_key = op_key;
+
+                const auto* const cy_failure = cetl::get_if<CyphalPromiseFailure>(&arg.result);
+                if (cy_failure != nullptr)
                 {
-                    const auto err = failureToErrorCode(*cy_failure);
-                    logger().warn("ExecCmdSvc: promise failure for node {} (err={}, fsm_id={}).", node_id, err, id_);
+                    logger().warn("ExecCmdSvc: promise failure for node {} (err={}, item={}, fsm_id={}).",
+                                  cy_op_key.node_id,
+                                  failureToErrorCode(*cy_failure),
+                                  cy_op_key.item_index,
+                                  id_);
                 }
                 else if (const auto* success = cetl::get_if<CyphalPromise::Success>(&arg.result))
                 {
                     const auto& res = success->response;
-                    logger().debug("ExecCmdSvc: promise success from node {} (status={}, fsm_id={}).",
-                                   node_id,
+                    logger().debug("ExecCmdSvc: promise success from node {} (status={}, item={}, fsm_id={}).",
+                                   cy_op_key.node_id,
                                    res.status,
+                                   cy_op_key.item_index,
                                    id_);
 
-                    const Spec::Response ipc_response{node_id, {res.status, res.output, &memory()}, &memory()};
+                    const auto ipc_response =
+                        Adapter::makeResponse(cy_op_key.item_index, cy_op_key.node_id, res, memory());
                     if (const auto err = channel_.send(ipc_response))
                     {
                         logger().warn("ExecCmdSvc: failed to send ipc response for node {} (err={}, fsm_id={}).",
-                                      node_id,
+                                      cy_op_key.node_id,
                                       err,
                                       id_);
                     }
                 }
+                const bool is_failure = cy_failure != nullptr;
 
-                // We've got the response from the node, so we can release associated resources (client & promise).
-                // If no nodes left, then it means we did it for all nodes, so the whole FSM is completed.
+                // We are done with the promise result, so we can release associated resources (client & promise).
+                // Note that the client itself stays alive in the shared cache (until it's evicted).
                 //
-                node_id_to_op_.erase(node_id);
-                if (node_id_to_op_.empty())
+                self->op_to_cy_op_.erase(cy_op_key.packed());
+                if (is_failure && self->tryRetry(cy_op_key))
                 {
-                    complete(0);
+                    return;
                 }
+                self->onOpDone();
             });
 
-            node_id_to_op_.emplace(node_id, CyNodeOp{std::move(cy_svc_client), std::move(cy_promise)});
+            op_to_cy_op_.emplace(op_key.packed(), CyNodeOp{std::move(cy_svc_client), std::move(cy_promise)});
             return 0;
         }
 
+        void onOpDone()
+        {
+            pacer().release(id_);
+
+            // If no operations left, then it means we did it for all nodes, so the whole FSM is completed.
+            CETL_DEBUG_ASSERT(remaining_ops_ > 0, "");
+            --remaining_ops_;
+            if (remaining_ops_ == 0)
+            {
+                complete(0);
+            }
+        }
+
         void complete(const int err)
         {
-            // Cancel anything that might be still pending.
-            node_id_to_op_.clear();
+            // Cancel anything that might be still pending (either in flight or still queued).
+            op_to_cy_op_.clear();
+            pacer().cancel(id_);
 
             channel_.complete(err);
 
             service_.releaseFsmBy(id_);
         }
 
-        const Id                                    id_;
-        Channel                                     channel_;
-        ExecCmdServiceImpl&                         service_;
-        std::unordered_map<std::uint16_t, CyNodeOp> node_id_to_op_;
+        const Id                                        id_;
+        Channel                                         channel_;
+        ExecCmdServiceImpl&                             service_;
+        ExecCmdItems                                    items_;
+        libcyphal::TimePoint                            deadline_;
+        std::uint8_t                                    max_attempts_{1};
+        libcyphal::Duration                             attempt_timeout_{};
+        libcyphal::Duration                             backoff_{};
+        std::size_t                                     remaining_ops_{0};
+        std::unordered_map<std::uint32_t, CyNodeOp>     op_to_cy_op_;
+        std::unordered_map<std::uint32_t, std::uint8_t> op_to_attempts_;
 
     };  // Fsm
 
-    void releaseFsmBy(const Fsm::Id fsm_id)
+    void releaseFsmBy(const typename Fsm::Id fsm_id)
     {
         id_to_fsm_.erase(fsm_id);
     }
 
-    const ScvContext                      context_;
-    std::uint64_t                         next_fsm_id_{0};
-    std::unordered_map<Fsm::Id, Fsm::Ptr> id_to_fsm_;
-    common::LoggerPtr                     logger_{common::getLogger("engine")};
+    const ScvContext                                        context_;
+    ExecCmdShared::Ptr                                      shared_;
+    std::unordered_map<typename Fsm::Id, typename Fsm::Ptr> id_to_fsm_;
+    common::LoggerPtr                                       logger_{common::getLogger("engine")};
 
 };  // ExecCmdServiceImpl
 
@@ -272,9 +531,13 @@ private:
 
 void ExecCmdService::registerWithContext(const ScvContext& context)
 {
-    using Impl = ExecCmdServiceImpl;
+    using SingleImpl = ExecCmdServiceImpl<common::svc::node::ExecCmdSpec>;
+    using BatchImpl  = ExecCmdServiceImpl<common::svc::node::ExecCmdBatchSpec>;
+
+    const auto shared = std::make_shared<ExecCmdShared>(context);
 
-    context.ipc_router.registerChannel<Impl::Channel>(Impl::Spec::svc_full_name(), Impl{context});
+    context.registerChannel<SingleImpl::Channel>(SingleImpl::Spec::svc_full_name(), SingleImpl{context, shared});
+    context.registerChannel<BatchImpl::Channel>(BatchImpl::Spec::svc_full_name(), BatchImpl{context, shared});
 }
 
 }  // namespace node
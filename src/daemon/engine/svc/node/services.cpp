@@ -5,7 +5,10 @@
 
 #include "services.hpp"
 
+#include "access_registers_service.hpp"
+#include "cyphal/register_client.hpp"
 #include "exec_cmd_service.hpp"
+#include "list_registers_service.hpp"
 #include "svc/svc_helpers.hpp"
 
 namespace ocvsmd
@@ -19,9 +22,11 @@ namespace svc
 namespace node
 {
 
-void registerAllServices(const ScvContext& context)
+void registerAllServices(const ScvContext& context, cyphal::RegisterClient& register_client)
 {
-    ExecCmdService::registerWithContext(context);
+    ExecCmdService::registerWithContext(context.withMemoryOf("svc.node.exec_cmd"));
+    ListRegistersService::registerWithContext(context.withMemoryOf("svc.node.list_registers"), register_client);
+    AccessRegistersService::registerWithContext(context.withMemoryOf("svc.node.access_registers"), register_client);
 }
 
 }  // namespace node
@@ -6,6 +6,7 @@
 #ifndef OCVSMD_DAEMON_ENGINE_SVC_NODE_SERVICES_HPP_INCLUDED
 #define OCVSMD_DAEMON_ENGINE_SVC_NODE_SERVICES_HPP_INCLUDED
 
+#include "cyphal/register_client.hpp"
 #include "svc/svc_helpers.hpp"
 
 namespace ocvsmd
@@ -21,7 +22,7 @@ namespace node
 
 /// Registers all "node"-related services.
 ///
-void registerAllServices(const ScvContext& context);
+void registerAllServices(const ScvContext& context, cyphal::RegisterClient& register_client);
 
 }  // namespace node
 }  // namespace svc
@@ -0,0 +1,277 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "raw_publisher_service.hpp"
+
+#include "engine_helpers.hpp"
+#include "ipc/channel.hpp"
+#include "ipc/server_router.hpp"
+#include "logging.hpp"
+#include "svc/relay/raw_publisher_spec.hpp"
+#include "svc/svc_helpers.hpp"
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/presentation/presentation.hpp>
+#include <libcyphal/presentation/publisher.hpp>
+#include <libcyphal/transport/types.hpp>
+#include <libcyphal/types.hpp>
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace svc
+{
+namespace relay
+{
+namespace
+{
+
+/// Defines 'Relay: Raw Publisher' service implementation.
+///
+/// It's passed (as a functor) to the IPC server router to handle incoming service requests.
+/// See `ipc::ServerRouter::registerChannel` for details, and below `operator()` for the actual implementation.
+///
+class RawPublisherServiceImpl final
+{
+public:
+    using Spec    = common::svc::relay::RawPublisherSpec;
+    using Channel = common::ipc::Channel<Spec::Request, Spec::Response>;
+
+    explicit RawPublisherServiceImpl(const ScvContext& context)
+        : context_{context}
+    {
+    }
+
+    /// Handles the initial `relay::RawPublisher` service request of a new IPC channel.
+    ///
+    /// Defined as a functor operator - as it's required/expected by the IPC server router.
+    ///
+    void operator()(Channel&& channel, const Spec::Request& request)
+    {
+        const auto session_id = next_session_id_++;
+        logger_->debug("New '{}' service channel (session={}, subject={}).",
+                       Spec::svc_full_name(),
+                       session_id,
+                       request.subject_id);
+
+        auto session               = std::make_shared<Session>(*this, session_id, std::move(channel));
+        id_to_session_[session_id] = session;
+
+        session->start(request);
+    }
+
+private:
+    using CyphalPublisher = libcyphal::presentation::Publisher<void>;
+
+    static constexpr libcyphal::Duration DefaultTimeout = std::chrono::seconds{1};
+
+    // Defines private session of a single raw publisher. There is one session per each service request channel.
+    //
+    // 1. On its `start` the session makes raw Cyphal publisher for the requested subject
+    //    (presentation layer shares the underlying transport session between all publishers of the same subject).
+    // 2. Every request of the channel (including the initial one) is a batch of pre-serialized messages -
+    //    each one is published as is, directly from the received IPC payload (no copies, no re-serialization).
+    // 3. The session lasts until the channel is completed by the client (or a send failure).
+    //
+    class Session final
+    {
+    public:
+        using Id  = std::uint64_t;
+        using Ptr = std::shared_ptr<Session>;
+
+        Session(RawPublisherServiceImpl& service, const Id id, Channel&& channel)
+            : id_{id}
+            , channel_{std::move(channel)}
+            , service_{service}
+        {
+            logger().trace("RawPublisherSvc::Session (id={}).", id_);
+
+            channel_.subscribe([this](const auto& event_var) {
+                //
+                cetl::visit([this](const auto& event) { handleEvent(event); }, event_var);
+            });
+        }
+
+        ~Session()
+        {
+            logger().trace("RawPublisherSvc::~Session (id={}).", id_);
+        }
+
+        Session(const Session&)                = delete;
+        Session(Session&&) noexcept            = delete;
+        Session& operator=(const Session&)     = delete;
+        Session& operator=(Session&&) noexcept = delete;
+
+        void start(const Spec::Request& request)
+        {
+            using CyphalMakeFailure = libcyphal::presentation::Presentation::MakeFailure;
+            using CyphalPriority    = libcyphal::transport::Priority;
+
+            if (request.priority > static_cast<std::uint8_t>(CyphalPriority::Optional))
+            {
+                logger().warn("RawPublisherSvc: invalid priority (priority={}, session={}).", request.priority, id_);
+                complete(EINVAL);
+                return;
+            }
+
+            auto cy_make_result = service_.context_.presentation.makePublisher<void>(request.subject_id);
+            if (const auto* cy_failure = cetl::get_if<CyphalMakeFailure>(&cy_make_result))
+            {
+                const auto err = failureToErrorCode(*cy_failure);
+                logger().error("RawPublisherSvc: failed to make publisher for subject {} (err={}, session={}).",
+                               request.subject_id,
+                               err,
+                               id_);
+                complete(err);
+                return;
+            }
+            cy_publisher_.emplace(cetl::get<CyphalPublisher>(std::move(cy_make_result)));
+            cy_publisher_->setPriority(static_cast<CyphalPriority>(request.priority));
+
+            publishBatch(request);
+        }
+
+    private:
+        common::Logger& logger() const
+        {
+            return *service_.logger_;
+        }
+
+        void handleEvent(const Channel::Input& input)
+        {
+            if (cy_publisher_)
+            {
+                publishBatch(input);
+            }
+        }
+
+        void handleEvent(const Channel::Completed& completed)
+        {
+            logger().debug("RawPublisherSvc::Session::handleEvent({}) (id={}).", completed, id_);
+            complete(ECANCELED);
+        }
+
+        // We are not interested in handling these events.
+        static void handleEvent(const Channel::Connected&) {}
+        static void handleEvent(const Channel::Resumed&) {}
+
+        /// Publishes all messages of the batch.
+        ///
+        /// Failures of individual messages don't stop the batch (nor the session) -
+        /// they are just counted and reported back to the client.
+        ///
+        void publishBatch(const Spec::Request& request)
+        {
+            const libcyphal::Duration timeout  = (request.timeout_us > 0)  //
+                                                     ? std::chrono::microseconds{request.timeout_us}
+                                                     : DefaultTimeout;
+            const auto                deadline = service_.context_.executor.now() + timeout;
+
+            const auto* const payloads   = reinterpret_cast<const cetl::byte*>(request.payloads.data());  // NOLINT
+            const std::size_t total_size = request.payloads.size();
+
+            bool        has_failed = false;
+            std::size_t offset     = 0;
+            for (const auto payload_size : request.payload_sizes)
+            {
+                if ((total_size - offset) < payload_size)
+                {
+                    logger().warn("RawPublisherSvc: batch payload is truncated (session={}).", id_);
+                    complete(EINVAL);
+                    return;
+                }
+
+                const std::array<cetl::span<const cetl::byte>, 1> fragments{{{payloads + offset, payload_size}}};
+                if (const auto cy_failure = cy_publisher_->publish(deadline, fragments))
+                {
+                    error_code_ = failureToErrorCode(*cy_failure);
+                    has_failed  = true;
+                    ++failed_count_;
+                }
+                else
+                {
+                    ++published_count_;
+                }
+                offset += payload_size;
+            }
+
+            if (has_failed || request.with_ack)
+            {
+                sendStatus();
+            }
+        }
+
+        void sendStatus()
+        {
+            Spec::Response response{&service_.context_.memory};
+            response.published_count = published_count_;
+            response.failed_count    = failed_count_;
+            response.error_code      = error_code_;
+            if (const auto err = channel_.send(response))
+            {
+                logger().warn("RawPublisherSvc: failed to send ipc response (err={}, session={}).", err, id_);
+                complete(err);
+            }
+        }
+
+        void complete(const int err)
+        {
+            cy_publisher_.reset();
+            channel_.complete(err);
+
+            service_.releaseSessionBy(id_);
+        }
+
+        const Id                        id_;
+        Channel                         channel_;
+        RawPublisherServiceImpl&        service_;
+        cetl::optional<CyphalPublisher> cy_publisher_;
+        std::uint64_t                   published_count_{0};
+        std::uint64_t                   failed_count_{0};
+        std::int32_t                    error_code_{0};
+
+    };  // Session
+
+    void releaseSessionBy(const Session::Id session_id)
+    {
+        id_to_session_.erase(session_id);
+    }
+
+    const ScvContext                              context_;
+    Session::Id                                   next_session_id_{0};
+    std::unordered_map<Session::Id, Session::Ptr> id_to_session_;
+    common::LoggerPtr                             logger_{common::getLogger("engine")};
+
+};  // RawPublisherServiceImpl
+
+constexpr libcyphal::Duration RawPublisherServiceImpl::DefaultTimeout;
+
+}  // namespace
+
+void RawPublisherService::registerWithContext(const ScvContext& context)
+{
+    using Impl = RawPublisherServiceImpl;
+
+    context.registerChannel<Impl::Channel>(Impl::Spec::svc_full_name(), Impl{context});
+}
+
+}  // namespace relay
+}  // namespace svc
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
@@ -0,0 +1,359 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "raw_rpc_client_service.hpp"
+
+#include "cyphal/client_cache.hpp"
+#include "engine_helpers.hpp"
+#include "ipc/channel.hpp"
+#include "ipc/server_router.hpp"
+#include "logging.hpp"
+#include "svc/relay/raw_rpc_client_spec.hpp"
+#include "svc/svc_helpers.hpp"
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/presentation/client.hpp>
+#include <libcyphal/presentation/presentation.hpp>
+#include <libcyphal/presentation/response_promise.hpp>
+#include <libcyphal/transport/types.hpp>
+#include <libcyphal/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace svc
+{
+namespace relay
+{
+namespace
+{
+
+/// Defines 'Relay: Raw RPC Client' service implementation.
+///
+/// It's passed (as a functor) to the IPC server router to handle incoming service requests.
+/// See `ipc::ServerRouter::registerChannel` for details, and below `operator()` for the actual implementation.
+///
+class RawRpcClientServiceImpl final
+{
+public:
+    using Spec    = common::svc::relay::RawRpcClientSpec;
+    using Channel = common::ipc::Channel<Spec::Request, Spec::Response>;
+
+    explicit RawRpcClientServiceImpl(const ScvContext& context)
+        : context_{context}
+        , cy_clients_{CyphalClientCache::make(
+              context.executor,
+              context.config.getSvcRawRpcClientMaxClients().value_or(DefaultMaxClients),
+              ClientCacheIdleTimeout,
+              context.config.getSvcRawRpcClientMaxClientsBytes().value_or(DefaultMaxClientsBytes))}
+    {
+    }
+
+    /// Handles the initial `relay::RawRpcClient` service request of a new IPC channel.
+    ///
+    /// Defined as a functor operator - as it's required/expected by the IPC server router.
+    ///
+    void operator()(Channel&& channel, const Spec::Request& request)
+    {
+        const auto session_id = next_session_id_++;
+        logger_->debug("New '{}' service channel (session={}).", Spec::svc_full_name(), session_id);
+
+        auto session               = std::make_shared<Session>(*this, session_id, std::move(channel));
+        id_to_session_[session_id] = session;
+
+        session->call(request);
+    }
+
+private:
+    using CyphalSvcClient      = libcyphal::presentation::RawServiceClient;
+    using CyphalPromise        = libcyphal::presentation::ResponsePromise<void>;
+    using CyphalPromiseFailure = libcyphal::presentation::ResponsePromiseFailure;
+    using CyphalClientCache    = cyphal::ClientCache<std::uint64_t, CyphalSvcClient>;
+
+    static constexpr libcyphal::Duration DefaultTimeout         = std::chrono::seconds{1};
+    static constexpr libcyphal::Duration ClientCacheIdleTimeout = std::chrono::seconds{30};
+    static constexpr std::uint32_t       DefaultMaxClients      = 64;
+    static constexpr std::uint32_t       DefaultMaxClientsBytes = 1024 * 1024;
+    static constexpr std::size_t         ClientOverheadBytes    = 256;
+    static constexpr std::size_t         MaxInFlightPerSession  = 256;
+    static constexpr std::size_t         MaxPayloadSize         = Spec::Response::MAX_PAYLOAD_SIZE;
+
+    // Defines private session of a raw RPC client channel. There is one session per each service request channel.
+    //
+    // 1. Every request of the channel (including the initial one) is a separate call - the session gets a client
+    //    (from the shared cache) for its service, server and response extent, and sends the request.
+    // 2. Calls are multiplexed - many of them could be in flight at the same time (up to a limit),
+    //    and their responses (or failures) are sent back as soon as they arrive.
+    // 3. The session lasts until the channel is completed by the client.
+    //
+    class Session final
+    {
+    public:
+        using Id  = std::uint64_t;
+        using Ptr = std::shared_ptr<Session>;
+
+        Session(RawRpcClientServiceImpl& service, const Id id, Channel&& channel)
+            : id_{id}
+            , channel_{std::move(channel)}
+            , service_{service}
+        {
+            logger().trace("RawRpcClientSvc::Session (id={}).", id_);
+
+            channel_.subscribe([this](const auto& event_var) {
+                //
+                cetl::visit([this](const auto& event) { handleEvent(event); }, event_var);
+            });
+        }
+
+        ~Session()
+        {
+            logger().trace("RawRpcClientSvc::~Session (id={}).", id_);
+        }
+
+        Session(const Session&)                = delete;
+        Session(Session&&) noexcept            = delete;
+        Session& operator=(const Session&)     = delete;
+        Session& operator=(Session&&) noexcept = delete;
+
+        void call(const Spec::Request& request)
+        {
+            if (const auto err = startCall(request))
+            {
+                sendFailure(request.call_id, err);
+            }
+        }
+
+    private:
+        /// Holds an in-flight call - the client has to be kept alive together with its promise.
+        ///
+        struct Call
+        {
+            CyphalSvcClient cy_client;
+            CyphalPromise   cy_promise;
+        };
+
+        common::Logger& logger() const
+        {
+            return *service_.logger_;
+        }
+
+        cetl::pmr::memory_resource& memory() const
+        {
+            return service_.context_.memory;
+        }
+
+        void handleEvent(const Channel::Input& input)
+        {
+            call(input);
+        }
+
+        void handleEvent(const Channel::Completed& completed)
+        {
+            logger().debug("RawRpcClientSvc::Session::handleEvent({}) (id={}).", completed, id_);
+            complete(ECANCELED);
+        }
+
+        // We are not interested in handling these events.
+        static void handleEvent(const Channel::Connected&) {}
+        static void handleEvent(const Channel::Resumed&) {}
+
+        CETL_NODISCARD int startCall(const Spec::Request& request)
+        {
+            using CyphalMakeFailure = libcyphal::presentation::Presentation::MakeFailure;
+            using CyphalPriority    = libcyphal::transport::Priority;
+
+            const auto call_id = request.call_id;
+            if (request.priority > static_cast<std::uint8_t>(CyphalPriority::Optional))
+            {
+                return EINVAL;
+            }
+            if (call_id_to_call_.size() >= MaxInFlightPerSession)
+            {
+                return EBUSY;
+            }
+            if (call_id_to_call_.find(call_id) != call_id_to_call_.end())
+            {
+                return EEXIST;
+            }
+
+            const auto service_id = request.service_id;
+            const auto node_id    = request.server_node_id;
+            const auto extent     = (request.response_extent_bytes > 0)
+                                        ? std::min<std::size_t>(request.response_extent_bytes, MaxPayloadSize)
+                                        : MaxPayloadSize;
+
+            auto cy_make_result = service_.cy_clients_->getOrMake(  //
+                makeClientKey(service_id, node_id, extent),
+                extent + ClientOverheadBytes,
+                [this, service_id, node_id, extent] {
+                    //
+                    return service_.context_.presentation.makeClient(node_id, service_id, extent);
+                });
+            if (const auto* cy_failure = cetl::get_if<CyphalMakeFailure>(&cy_make_result))
+            {
+                const auto err = failureToErrorCode(*cy_failure);
+                logger().error("RawRpcClientSvc: failed to make client (svc={}, node={}, err={}, session={}).",
+                               service_id,
+                               node_id,
+                               err,
+                               id_);
+                return err;
+            }
+            auto cy_client = cetl::get<CyphalSvcClient>(std::move(cy_make_result));
+            cy_client.setPriority(static_cast<CyphalPriority>(request.priority));
+
+            const libcyphal::Duration timeout  = (request.timeout_us > 0)  //
+                                                     ? std::chrono::microseconds{request.timeout_us}
+                                                     : DefaultTimeout;
+            const auto                deadline = service_.context_.executor.now() + timeout;
+
+            const std::array<cetl::span<const cetl::byte>, 1> fragments{
+                {{reinterpret_cast<const cetl::byte*>(request.payload.data()), request.payload.size()}}};  // NOLINT
+
+            auto cy_req_result = cy_client.request(deadline, fragments, deadline);
+            if (const auto* cy_failure = cetl::get_if<CyphalSvcClient::Failure>(&cy_req_result))
+            {
+                const auto err = failureToErrorCode(*cy_failure);
+                logger().warn("RawRpcClientSvc: failed to send request to node {} (err={}, session={}).",
+                              node_id,
+                              err,
+                              id_);
+                service_.cy_clients_->evict(makeClientKey(service_id, node_id, extent));
+                return err;
+            }
+            auto cy_promise = cetl::get<CyphalPromise>(std::move(cy_req_result));
+
+            cy_promise.setCallback([this, call_id](const auto& arg) {
+                //
+                if (const auto* cy_failure = cetl::get_if<CyphalPromiseFailure>(&arg.result))
+                {
+                    sendFailure(call_id, failureToErrorCode(*cy_failure));
+                }
+                else if (const auto* success = cetl::get_if<CyphalPromise::Success>(&arg.result))
+                {
+                    sendSuccess(call_id, *success);
+                }
+
+                // The call is done - release its promise (the client itself stays alive in the shared cache).
+                // The key is copied b/c the release destroys this very lambda (together with its captures).
+                const auto done_call_id = call_id;
+                call_id_to_call_.erase(done_call_id);
+            });
+
+            call_id_to_call_.emplace(call_id, Call{std::move(cy_client), std::move(cy_promise)});
+            return 0;
+        }
+
+        void sendSuccess(const std::uint64_t call_id, const CyphalPromise::Success& success)
+        {
+            const auto& rx_meta = success.metadata.rx_meta;
+
+            Spec::Response response{&memory()};
+            response.call_id      = call_id;
+            response.timestamp_us = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(rx_meta.timestamp.time_since_epoch()).count());
+            response.priority    = static_cast<std::uint8_t>(rx_meta.base.priority);
+            response.transfer_id = rx_meta.base.transfer_id;
+
+            response.payload.resize(std::min<std::size_t>(success.response.size(), MaxPayloadSize));
+            auto* const payload_bytes = reinterpret_cast<cetl::byte*>(response.payload.data());  // NOLINT
+            response.payload.resize(success.response.copy(0, {payload_bytes, response.payload.size()}));
+
+            send(response);
+        }
+
+        void sendFailure(const std::uint64_t call_id, const int err)
+        {
+            Spec::Response response{&memory()};
+            response.call_id    = call_id;
+            response.error_code = err;
+            send(response);
+        }
+
+        void send(const Spec::Response& response)
+        {
+            if (const auto err = channel_.send(response))
+            {
+                logger().warn("RawRpcClientSvc: failed to send ipc response (call={}, err={}, session={}).",
+                              response.call_id,
+                              err,
+                              id_);
+            }
+        }
+
+        void complete(const int err)
+        {
+            call_id_to_call_.clear();
+            channel_.complete(err);
+
+            service_.releaseSessionBy(id_);
+        }
+
+        const Id                                id_;
+        Channel                                 channel_;
+        RawRpcClientServiceImpl&                service_;
+        std::unordered_map<std::uint64_t, Call> call_id_to_call_;
+
+    };  // Session
+
+    /// Clients are keyed by their service ID, server node ID and response extent.
+    ///
+    static std::uint64_t makeClientKey(const std::uint16_t service_id,
+                                       const std::uint16_t node_id,
+                                       const std::size_t   extent)
+    {
+        return (static_cast<std::uint64_t>(extent) << 32U) | (static_cast<std::uint64_t>(service_id) << 16U) |
+               node_id;
+    }
+
+    void releaseSessionBy(const Session::Id session_id)
+    {
+        id_to_session_.erase(session_id);
+    }
+
+    const ScvContext                              context_;
+    CyphalClientCache::Ptr                        cy_clients_;
+    Session::Id                                   next_session_id_{0};
+    std::unordered_map<Session::Id, Session::Ptr> id_to_session_;
+    common::LoggerPtr                             logger_{common::getLogger("engine")};
+
+};  // RawRpcClientServiceImpl
+
+constexpr libcyphal::Duration RawRpcClientServiceImpl::DefaultTimeout;
+constexpr libcyphal::Duration RawRpcClientServiceImpl::ClientCacheIdleTimeout;
+constexpr std::uint32_t       RawRpcClientServiceImpl::DefaultMaxClients;
+constexpr std::uint32_t       RawRpcClientServiceImpl::DefaultMaxClientsBytes;
+constexpr std::size_t         RawRpcClientServiceImpl::ClientOverheadBytes;
+constexpr std::size_t         RawRpcClientServiceImpl::MaxInFlightPerSession;
+constexpr std::size_t         RawRpcClientServiceImpl::MaxPayloadSize;
+
+}  // namespace
+
+void RawRpcClientService::registerWithContext(const ScvContext& context)
+{
+    using Impl = RawRpcClientServiceImpl;
+
+    context.registerChannel<Impl::Channel>(Impl::Spec::svc_full_name(), Impl{context});
+}
+
+}  // namespace relay
+}  // namespace svc
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
@@ -0,0 +1,510 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "raw_subscriber_service.hpp"
+
+#include "dsdl_helpers.hpp"
+#include "engine_helpers.hpp"
+#include "ipc/channel.hpp"
+#include "ipc/server_router.hpp"
+#include "logging.hpp"
+#include "ocvsmd/common/svc/relay/RawMessage_0_1.hpp"
+#include "svc/relay/raw_subscriber_spec.hpp"
+#include "svc/svc_helpers.hpp"
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/presentation/presentation.hpp>
+#include <libcyphal/presentation/subscriber.hpp>
+#include <libcyphal/types.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace svc
+{
+namespace relay
+{
+namespace
+{
+
+/// Defines 'Relay: Raw Subscriber' service implementation.
+///
+/// It's passed (as a functor) to the IPC server router to handle incoming service requests.
+/// See `ipc::ServerRouter::registerChannel` for details, and below `operator()` for the actual implementation.
+///
+class RawSubscriberServiceImpl final
+{
+public:
+    using Spec    = common::svc::relay::RawSubscriberSpec;
+    using Channel = common::ipc::Channel<Spec::Request, Spec::Response>;
+
+    explicit RawSubscriberServiceImpl(const ScvContext& context)
+        : context_{context}
+    {
+    }
+
+    /// Handles the initial `relay::RawSubscriber` service request of a new IPC channel.
+    ///
+    /// Defined as a functor operator - as it's required/expected by the IPC server router.
+    ///
+    void operator()(Channel&& channel, const Spec::Request& request)
+    {
+        const auto session_id = next_session_id_++;
+        logger_->debug("New '{}' service channel (session={}, subject={}).",
+                       Spec::svc_full_name(),
+                       session_id,
+                       request.subject_id);
+
+        auto session               = std::make_shared<Session>(*this, session_id, std::move(channel), request);
+        id_to_session_[session_id] = session;
+
+        session->start();
+    }
+
+private:
+    using CyphalSubscriber = libcyphal::presentation::Subscriber<void>;
+    using RawMessage       = common::svc::relay::RawMessage_0_1;
+    using Frame            = std::vector<std::uint8_t, cetl::pmr::polymorphic_allocator<std::uint8_t>>;
+    using FramePtr         = std::shared_ptr<const Frame>;
+
+    static constexpr std::size_t         DefaultQueueCapacity = 64;
+    static constexpr std::size_t         MaxQueueCapacity     = 1024;
+    static constexpr libcyphal::Duration DrainRetryPeriod     = std::chrono::milliseconds{10};
+
+    // Defines private session of a single raw subscription. There is one session per each service request channel.
+    //
+    // 1. On its `start` the session attaches itself to the relay of its subject (see `Relay` below).
+    // 2. The relay enqueues (already serialized) frames of received messages which have passed the session's filters
+    //    (see `accepts`). The queue is bounded - on overflow either the oldest queued frame, or the new one
+    //    is dropped (according to the client's policy). In the "latest only" mode the queue holds just one frame.
+    // 3. The queue is drained to the channel right away, until the IPC socket would block -
+    //    then the rest is retried a bit later (so a slow client never stalls the relay nor other clients).
+    // 4. The session lasts until the channel is completed by the client (or a send failure).
+    //
+    class Session final
+    {
+    public:
+        using Id  = std::uint64_t;
+        using Ptr = std::shared_ptr<Session>;
+
+        Session(RawSubscriberServiceImpl& service, const Id id, Channel&& channel, const Spec::Request& request)
+            : id_{id}
+            , channel_{std::move(channel)}
+            , service_{service}
+            , subject_id_{request.subject_id}
+            , is_drop_newest_{request.overflow_policy == Spec::Request::OVERFLOW_DROP_NEWEST}
+            , queue_capacity_{std::min<std::size_t>(MaxQueueCapacity,
+                                                    (request.queue_capacity > 0) ? request.queue_capacity
+                                                                                 : DefaultQueueCapacity)}
+            , source_node_ids_{request.source_node_ids.begin(), request.source_node_ids.end()}
+            , decimation_{request.decimation}
+            , min_period_{std::chrono::microseconds{request.min_period_us}}
+            , is_latest_only_{request.latest_only}
+        {
+            logger().trace("RawSubscriberSvc::Session (id={}).", id_);
+
+            std::sort(source_node_ids_.begin(), source_node_ids_.end());
+
+            // The session has its own bounded queue (with the overflow policy), so it has to know when
+            // the IPC socket would block - rather than let the pipe queue its frames.
+            channel_.enableBackPressure();
+            channel_.subscribe([this](const auto& event_var) {
+                //
+                cetl::visit([this](const auto& event) { handleEvent(event); }, event_var);
+            });
+        }
+
+        ~Session()
+        {
+            logger().trace("RawSubscriberSvc::~Session (id={}).", id_);
+        }
+
+        Session(const Session&)                = delete;
+        Session(Session&&) noexcept            = delete;
+        Session& operator=(const Session&)     = delete;
+        Session& operator=(Session&&) noexcept = delete;
+
+        void start()
+        {
+            // Draining (and failure completion) is always done from this callback - never directly from
+            // the relay's fan-out, so that sessions are not released while the relay iterates them.
+            drain_callback_ = service_.context_.executor.registerCallback([this](const auto&) {
+                //
+                if (0 != failure_err_)
+                {
+                    complete(failure_err_);
+                    return;
+                }
+                drain();
+            });
+
+            if (const auto err = service_.attachSession(subject_id_, *this))
+            {
+                complete(err);
+                return;
+            }
+            is_attached_ = true;
+        }
+
+        /// Applies filters of the client to a received message (see `RawSubscriberSvcRequest.0.1` for details).
+        ///
+        /// Called by the relay before the message is serialized - so messages which no session accepts
+        /// cost nothing but this check. State of the filters is advanced here only for rejected messages;
+        /// for an accepted one it's done by `enqueue` - so a message which never reaches the queue
+        /// (f.e. because of a serialization failure) doesn't count as accepted.
+        ///
+        CETL_NODISCARD bool accepts(const cetl::optional<std::uint16_t> publisher_node_id,
+                                    const libcyphal::TimePoint          now)
+        {
+            if (0 != failure_err_)
+            {
+                return false;
+            }
+
+            if (!source_node_ids_.empty() &&
+                (!publisher_node_id ||
+                 !std::binary_search(source_node_ids_.begin(), source_node_ids_.end(), *publisher_node_id)))
+            {
+                return false;
+            }
+
+            if ((decimation_ > 1) && (decimation_counter_ > 0))
+            {
+                advanceDecimation();
+                return false;
+            }
+
+            if ((min_period_ > libcyphal::Duration::zero()) && last_accepted_at_ &&
+                ((now - *last_accepted_at_) < min_period_))
+            {
+                // Still counted by the decimation filter - it's applied before the rate limit.
+                advanceDecimation();
+                return false;
+            }
+            return true;
+        }
+
+        /// Enqueues the frame (of a message accepted at the given time), and tries to drain the queue right away.
+        ///
+        void enqueue(const FramePtr& frame, const libcyphal::TimePoint accepted_at)
+        {
+            if (0 != failure_err_)
+            {
+                return;
+            }
+
+            advanceDecimation();
+            last_accepted_at_ = accepted_at;
+
+            if (is_latest_only_)
+            {
+                // Not yet sent messages are just replaced by the latest one.
+                queue_.clear();
+            }
+            else if (queue_.size() >= queue_capacity_)
+            {
+                ++dropped_count_;
+                if (is_drop_newest_)
+                {
+                    return;
+                }
+                queue_.pop_front();
+            }
+            queue_.push_back(frame);
+
+            if (!is_drain_scheduled_)
+            {
+                drain();
+            }
+        }
+
+    private:
+        common::Logger& logger() const
+        {
+            return *service_.logger_;
+        }
+
+        // We are not interested in handling these events.
+        static void handleEvent(const Channel::Connected&) {}
+        static void handleEvent(const Channel::Input&) {}
+        static void handleEvent(const Channel::Resumed&) {}
+
+        void handleEvent(const Channel::Completed& completed)
+        {
+            logger().debug("RawSubscriberSvc::Session::handleEvent({}) (id={}).", completed, id_);
+            complete(ECANCELED);
+        }
+
+        void advanceDecimation()
+        {
+            if (decimation_ > 1)
+            {
+                decimation_counter_ = static_cast<std::uint16_t>((decimation_counter_ + 1U) % decimation_);
+            }
+        }
+
+        static bool isWouldBlock(const int err)
+        {
+            return (err == EAGAIN) || (err == EWOULDBLOCK);
+        }
+
+        /// Sends queued frames (preceded by the drop status if there were new drops) until the queue is empty,
+        /// or the IPC socket would block (then the rest is retried later).
+        ///
+        void drain()
+        {
+            using Schedule = libcyphal::IExecutor::Callback::Schedule;
+
+            is_drain_scheduled_ = false;
+
+            int err = 0;
+            if (dropped_count_ != reported_dropped_count_)
+            {
+                Spec::Response status{&service_.context_.memory};
+                status.dropped_count = dropped_count_;
+                err                  = channel_.send(status);
+                if (0 == err)
+                {
+                    reported_dropped_count_ = dropped_count_;
+                }
+            }
+            while ((0 == err) && !queue_.empty())
+            {
+                const auto& frame = *queue_.front();
+                err               = channel_.sendSerialized({frame.data(), frame.size()});
+                if (0 == err)
+                {
+                    queue_.pop_front();
+                }
+            }
+
+            if (isWouldBlock(err))
+            {
+                is_drain_scheduled_ = true;
+                drain_callback_.schedule(Schedule::Once{service_.context_.executor.now() + DrainRetryPeriod});
+            }
+            else if (0 != err)
+            {
+                logger().warn("RawSubscriberSvc: failed to send ipc message (err={}, session={}).", err, id_);
+                failure_err_ = err;
+                drain_callback_.schedule(Schedule::Once{service_.context_.executor.now()});
+            }
+        }
+
+        void complete(const int err)
+        {
+            if (is_attached_)
+            {
+                is_attached_ = false;
+                service_.detachSession(subject_id_, *this);
+            }
+            drain_callback_.reset();
+            channel_.complete(err);
+
+            service_.releaseSessionBy(id_);
+        }
+
+        const Id                             id_;
+        Channel                              channel_;
+        RawSubscriberServiceImpl&            service_;
+        const std::uint16_t                  subject_id_;
+        const bool                           is_drop_newest_;
+        const std::size_t                    queue_capacity_;
+        std::vector<std::uint16_t>           source_node_ids_;
+        const std::uint16_t                  decimation_;
+        std::uint16_t                        decimation_counter_{0};
+        const libcyphal::Duration            min_period_;
+        cetl::optional<libcyphal::TimePoint> last_accepted_at_;
+        const bool                           is_latest_only_;
+        std::deque<FramePtr>                 queue_;
+        std::uint64_t                        dropped_count_{0};
+        std::uint64_t                        reported_dropped_count_{0};
+        bool                                 is_attached_{false};
+        bool                                 is_drain_scheduled_{false};
+        int                                  failure_err_{0};
+        libcyphal::IExecutor::Callback::Any  drain_callback_;
+
+    };  // Session
+
+    // Defines private relay of a single subject. There is one relay per each subject with at least one session.
+    //
+    // The relay owns the only Cyphal subscriber of the subject. Each received message is serialized (as IPC
+    // response) only once - into a shared frame, which is then enqueued to every attached session.
+    //
+    class Relay final
+    {
+    public:
+        using Ptr = std::shared_ptr<Relay>;
+
+        Relay(RawSubscriberServiceImpl& service, CyphalSubscriber&& cy_subscriber)
+            : service_{service}
+            , cy_subscriber_{std::move(cy_subscriber)}
+        {
+            cy_subscriber_.setOnReceiveCallback([this](const auto& arg) {
+                //
+                handleMessage(arg);
+            });
+        }
+
+        Relay(const Relay&)                = delete;
+        Relay(Relay&&) noexcept            = delete;
+        Relay& operator=(const Relay&)     = delete;
+        Relay& operator=(Relay&&) noexcept = delete;
+
+        ~Relay() = default;
+
+        void attach(Session& session)
+        {
+            sessions_.push_back(&session);
+        }
+
+        /// @return `true` if there are no more sessions attached.
+        ///
+        CETL_NODISCARD bool detach(Session& session)
+        {
+            sessions_.erase(std::remove(sessions_.begin(), sessions_.end(), &session), sessions_.end());
+            return sessions_.empty();
+        }
+
+    private:
+        void handleMessage(const CyphalSubscriber::OnReceiveCallback::Arg& arg)
+        {
+            // Filter first - so that messages which no session accepts are not even serialized.
+            accepting_sessions_.clear();
+            std::copy_if(sessions_.begin(),
+                         sessions_.end(),
+                         std::back_inserter(accepting_sessions_),
+                         [&arg](Session* const session) {
+                             //
+                             return session->accepts(arg.metadata.publisher_node_id, arg.approx_now);
+                         });
+            if (accepting_sessions_.empty())
+            {
+                return;
+            }
+
+            auto& memory = service_.context_.memory;
+
+            const auto& rx_meta = arg.metadata.rx_meta;
+            RawMessage  message{&memory};
+            message.timestamp_us = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(rx_meta.timestamp.time_since_epoch()).count());
+            message.priority    = static_cast<std::uint8_t>(rx_meta.base.priority);
+            message.transfer_id = rx_meta.base.transfer_id;
+            if (arg.metadata.publisher_node_id)
+            {
+                message.publisher_node_id.push_back(*arg.metadata.publisher_node_id);
+            }
+            message.payload.resize(std::min<std::size_t>(arg.raw_message.size(), RawMessage::MAX_PAYLOAD_SIZE));
+            auto* const payload_bytes = reinterpret_cast<cetl::byte*>(message.payload.data());  // NOLINT
+            message.payload.resize(arg.raw_message.copy(0, {payload_bytes, message.payload.size()}));
+
+            Spec::Response response{&memory};
+            response.message.push_back(std::move(message));
+
+            FramePtr   frame;
+            const auto err = common::tryPerformOnSerialized(response, [&frame, &memory](const auto bytes) {
+                //
+                frame = std::make_shared<const Frame>(bytes.begin(), bytes.end(), Frame::allocator_type{&memory});
+                return 0;
+            });
+            if (0 != err)
+            {
+                service_.logger_->warn("RawSubscriberSvc: failed to serialize ipc message (err={}).", err);
+                return;
+            }
+
+            for (auto* const session : accepting_sessions_)
+            {
+                session->enqueue(frame, arg.approx_now);
+            }
+        }
+
+        RawSubscriberServiceImpl& service_;
+        CyphalSubscriber          cy_subscriber_;
+        std::vector<Session*>     sessions_;
+        std::vector<Session*>     accepting_sessions_;
+
+    };  // Relay
+
+    CETL_NODISCARD int attachSession(const std::uint16_t subject_id, Session& session)
+    {
+        using CyphalMakeFailure = libcyphal::presentation::Presentation::MakeFailure;
+
+        auto found = subject_to_relay_.find(subject_id);
+        if (found == subject_to_relay_.end())
+        {
+            auto cy_make_result = context_.presentation.makeSubscriber<void>(subject_id, RawMessage::MAX_PAYLOAD_SIZE);
+            if (const auto* cy_failure = cetl::get_if<CyphalMakeFailure>(&cy_make_result))
+            {
+                const auto err = failureToErrorCode(*cy_failure);
+                logger_->error("RawSubscriberSvc: failed to make subscriber for subject {} (err={}).", subject_id, err);
+                return err;
+            }
+            auto relay = std::make_shared<Relay>(*this, cetl::get<CyphalSubscriber>(std::move(cy_make_result)));
+            found      = subject_to_relay_.emplace(subject_id, std::move(relay)).first;
+        }
+        found->second->attach(session);
+        return 0;
+    }
+
+    void detachSession(const std::uint16_t subject_id, Session& session)
+    {
+        const auto found = subject_to_relay_.find(subject_id);
+        if ((found != subject_to_relay_.end()) && found->second->detach(session))
+        {
+            // The last session is gone - so is the Cyphal subscriber.
+            subject_to_relay_.erase(found);
+        }
+    }
+
+    void releaseSessionBy(const Session::Id session_id)
+    {
+        id_to_session_.erase(session_id);
+    }
+
+    const ScvContext                              context_;
+    Session::Id                                   next_session_id_{0};
+    std::unordered_map<Session::Id, Session::Ptr> id_to_session_;
+    std::unordered_map<std::uint16_t, Relay::Ptr> subject_to_relay_;
+    common::LoggerPtr                             logger_{common::getLogger("engine")};
+
+};  // RawSubscriberServiceImpl
+
+constexpr std::size_t         RawSubscriberServiceImpl::DefaultQueueCapacity;
+constexpr std::size_t         RawSubscriberServiceImpl::MaxQueueCapacity;
+constexpr libcyphal::Duration RawSubscriberServiceImpl::DrainRetryPeriod;
+
+}  // namespace
+
+void RawSubscriberService::registerWithContext(const ScvContext& context)
+{
+    using Impl = RawSubscriberServiceImpl;
+
+    context.registerChannel<Impl::Channel>(Impl::Spec::svc_full_name(), Impl{context});
+}
+
+}  // namespace relay
+}  // namespace svc
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
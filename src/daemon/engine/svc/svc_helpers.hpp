@@ -6,12 +6,20 @@
 #ifndef OCVSMD_DAEMON_ENGINE_SVC_HELPERS_HPP_INCLUDED
 #define OCVSMD_DAEMON_ENGINE_SVC_HELPERS_HPP_INCLUDED
 
+#include "config.hpp"
 #include "ipc/server_router.hpp"
+#include "memory_accounting.hpp"
+#include "svc/network_spec.hpp"
 
 #include <cetl/pf17/cetlpf.hpp>
 #include <libcyphal/executor.hpp>
 #include <libcyphal/presentation/presentation.hpp>
 
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
 namespace ocvsmd
 {
 namespace daemon
@@ -25,12 +33,58 @@ namespace svc
 ///
 /// Contains references to the core engine components. Most (if not all) services require these.
 ///
+/// The engine might run several Cyphal networks, so services which talk to a network are registered
+/// once per each network - each time with the context of that network (see `registerChannel` below).
+///
 struct ScvContext
 {
     cetl::pmr::memory_resource&            memory;
     libcyphal::IExecutor&                  executor;
     common::ipc::ServerRouter&             ipc_router;
     libcyphal::presentation::Presentation& presentation;
+    MemoryAccounting&                      memory_accounting;
+    const Config&                          config;
+    /// Name of the network of the above presentation layer (f.e. "udp" or "can").
+    std::string network;
+    /// The primary network is the default one - it's also served by the plain service names.
+    bool is_primary_network;
+
+    /// Makes a copy of the context, but with its own (accounted) memory resource for the given subsystem.
+    ///
+    ScvContext withMemoryOf(const std::string& subsystem) const
+    {
+        return {memory_accounting.resourceFor(subsystem),
+                executor,
+                ipc_router,
+                presentation,
+                memory_accounting,
+                config,
+                network,
+                is_primary_network};
+    }
+
+    /// Registers the service channel handler for the network of the context.
+    ///
+    /// The service is served by its network qualified name (see `common::svc::NetworkSpec`), and, if it's
+    /// the primary network, by its plain name as well. Both names share the very same handler instance.
+    ///
+    template <typename Channel, typename Handler>
+    void registerChannel(const cetl::string_view svc_full_name, Handler&& handler) const
+    {
+        using NetworkSpec = common::svc::NetworkSpec;
+
+        auto shared_handler = std::make_shared<std::decay_t<Handler>>(std::forward<Handler>(handler));
+
+        const auto new_channel_handler = [shared_handler](Channel&& channel, const typename Channel::Input& input) {
+            //
+            (*shared_handler)(std::move(channel), input);
+        };
+        if (is_primary_network)
+        {
+            ipc_router.registerChannel<Channel>(svc_full_name, new_channel_handler);
+        }
+        ipc_router.registerChannel<Channel>(NetworkSpec::svc_full_name(svc_full_name, network), new_channel_handler);
+    }
 
 };  // ScvContext
 
@@ -18,8 +18,11 @@
 #include <libcyphal/executor.hpp>
 
 #include <cstring>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <utility>
 
 namespace ocvsmd
@@ -29,6 +32,64 @@ namespace sdk
 namespace
 {
 
+/// Defines process-wide registry of IPC client routers shared between `Daemon` instances.
+///
+/// Each router owns one socket (and one reader callback registered at the executor), so all `Daemon` instances
+/// of the process which use the same connection string share one pipe to the daemon, and one tag space of channels.
+/// The socket and its callback are bound to a particular executor (and the router (de)serializes via
+/// a particular memory resource), so routers are shared per executor and memory resource as well.
+///
+/// Routers are held weakly - the last `Daemon` (or its last channel) releasing a router closes the connection.
+///
+class SharedRouters final
+{
+public:
+    /// Gets an already started router for the given key, or makes (and starts) a new one using the given factory.
+    ///
+    template <typename Factory>
+    CETL_NODISCARD static common::ipc::ClientRouter::Ptr getOrMake(cetl::pmr::memory_resource& memory,
+                                                                   libcyphal::IExecutor&       executor,
+                                                                   const std::string&          connection,
+                                                                   Factory&&                   factory)
+    {
+        auto& self = instance();
+
+        const std::lock_guard<std::mutex> lock{self.mutex_};
+
+        auto& weak_router = self.routers_[Key{&memory, &executor, connection}];
+        if (auto router = weak_router.lock())
+        {
+            return router;
+        }
+
+        auto router = std::forward<Factory>(factory)();
+        weak_router = router;
+        self.dropExpired();
+        return router;
+    }
+
+private:
+    using Key = std::tuple<const cetl::pmr::memory_resource*, const libcyphal::IExecutor*, std::string>;
+
+    static SharedRouters& instance()
+    {
+        static SharedRouters shared_routers;
+        return shared_routers;
+    }
+
+    void dropExpired()
+    {
+        for (auto it = routers_.begin(); it != routers_.end();)
+        {
+            it = it->second.expired() ? routers_.erase(it) : std::next(it);
+        }
+    }
+
+    std::mutex                                              mutex_;
+    std::map<Key, std::weak_ptr<common::ipc::ClientRouter>> routers_;
+
+};  // SharedRouters
+
 class DaemonImpl final : public Daemon
 {
 public:
@@ -43,6 +104,42 @@ public:
     {
         logger_->info("Starting with IPC connection '{}'...", connection);
 
+        int start_err = 0;
+        ipc_router_   = SharedRouters::getOrMake(memory_, executor_, connection, [this, &connection, &start_err] {
+            //
+            return makeRouter(connection, start_err);
+        });
+        if (!ipc_router_)
+        {
+            return start_err;
+        }
+
+        node_command_client_ = Factory::makeNodeCommandClient(memory_, ipc_router_);
+
+        logger_->debug("Started IPC connection.");
+        return 0;
+    }
+
+    // Daemon
+
+    NodeCommandClient::Ptr getNodeCommandClient() const override
+    {
+        return node_command_client_;
+    }
+
+    NodeCommandClient::Ptr getNodeCommandClient(const std::string& network) const override
+    {
+        return Factory::makeNodeCommandClient(memory_, ipc_router_, network);
+    }
+
+private:
+    /// Makes and starts a new IPC router (together with its socket client pipe).
+    ///
+    /// Channels made before the pipe gets connected are notified later (on the route connection),
+    /// so the router is started right away - before any channel is made.
+    ///
+    CETL_NODISCARD common::ipc::ClientRouter::Ptr makeRouter(const std::string& connection, int& out_err) const
+    {
         common::ipc::pipe::ClientPipe::Ptr client_pipe;
         {
             using ParseResult = common::io::SocketAddress::ParseResult;
@@ -51,34 +148,25 @@ public:
             if (const auto* const err = cetl::get_if<ParseResult::Failure>(&maybe_socket_address))
             {
                 logger_->error("Failed to parse IPC connection string ('{}'): {}.", connection, std::strerror(*err));
-                return *err;
+                out_err = *err;
+                return nullptr;
             }
             const auto socket_address = cetl::get<ParseResult::Success>(maybe_socket_address);
             client_pipe               = std::make_unique<common::ipc::pipe::SocketClient>(executor_, socket_address);
         }
 
-        ipc_router_ = common::ipc::ClientRouter::make(memory_, std::move(client_pipe));
-
-        node_command_client_ = Factory::makeNodeCommandClient(memory_, ipc_router_);
-
-        if (const int err = ipc_router_->start())
+        auto ipc_router = common::ipc::ClientRouter::make(memory_, std::move(client_pipe));
+        if (const int err = ipc_router->start())
         {
             logger_->error("Failed to start IPC router: {}.", std::strerror(err));
-            return err;
+            out_err = err;
+            return nullptr;
         }
 
-        logger_->debug("Started IPC connection.");
-        return 0;
-    }
-
-    // Daemon
-
-    NodeCommandClient::Ptr getNodeCommandClient() const override
-    {
-        return node_command_client_;
+        logger_->debug("Made new shared IPC connection.");
+        return ipc_router;
     }
 
-private:
     cetl::pmr::memory_resource&    memory_;
     libcyphal::IExecutor&          executor_;
     common::LoggerPtr              logger_;
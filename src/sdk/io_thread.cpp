@@ -0,0 +1,236 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include <ocvsmd/sdk/io_thread.hpp>
+
+#include "io/io.hpp"
+#include "logging.hpp"
+#include "mpsc_queue.hpp"
+#include "ocvsmd/platform/defines.hpp"
+#include "ocvsmd/platform/posix_executor_extension.hpp"
+#include "ocvsmd/platform/posix_utils.hpp"
+
+#include <ocvsmd/sdk/daemon.hpp>
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+#include <cetl/rtti.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <utility>
+
+namespace ocvsmd
+{
+namespace sdk
+{
+namespace
+{
+
+class IoThreadImpl final : public IoThread
+{
+public:
+    explicit IoThreadImpl(cetl::pmr::memory_resource& memory)
+        : memory_{memory}
+        , logger_{common::getLogger("sdk")}
+    {
+    }
+
+    IoThreadImpl(const IoThreadImpl&)                = delete;
+    IoThreadImpl(IoThreadImpl&&) noexcept            = delete;
+    IoThreadImpl& operator=(const IoThreadImpl&)     = delete;
+    IoThreadImpl& operator=(IoThreadImpl&&) noexcept = delete;
+
+    ~IoThreadImpl() override
+    {
+        if (thread_.joinable())
+        {
+            is_stop_requested_.store(true, std::memory_order_release);
+            wakeUp();
+            thread_.join();
+        }
+
+        // The thread is gone, so it's safe to release I/O thread entities here (in the reverse order).
+        senders_.clear();
+        daemon_.reset();
+        wakeup_callback_.reset();
+    }
+
+    CETL_NODISCARD int start(const std::string& connection)
+    {
+        if (const auto err = makeWakeupPipe())
+        {
+            logger_->error("Failed to make I/O thread wake-up pipe: {}.", std::strerror(err));
+            return err;
+        }
+
+        auto* const posix_executor_ext = cetl::rtti_cast<platform::IPosixExecutorExtension*>(&executor_);
+        CETL_DEBUG_ASSERT(posix_executor_ext != nullptr, "");
+        wakeup_callback_ = posix_executor_ext->registerAwaitableCallback(  //
+            [this](const auto&) {
+                //
+                handleWakeUp();
+            },
+            platform::IPosixExecutorExtension::Trigger::Readable{wakeup_read_fd_.get()});
+
+        // The thread is not running yet, so it's safe to make the daemon right here (on the caller thread).
+        daemon_ = Daemon::make(memory_, executor_, connection);
+        if (!daemon_)
+        {
+            return ENOTCONN;
+        }
+
+        thread_ = std::thread([this] { run(); });
+        return 0;
+    }
+
+    // IoThread
+
+    void post(Task&& task) override
+    {
+        if (tasks_.push(std::move(task)))
+        {
+            wakeUp();
+        }
+    }
+
+protected:
+    std::uint64_t retainSender(std::shared_ptr<void> sender) override
+    {
+        const auto sender_id = next_sender_id_++;
+        senders_.emplace(sender_id, std::move(sender));
+        return sender_id;
+    }
+
+    void releaseSender(const std::uint64_t sender_id) override
+    {
+        senders_.erase(sender_id);
+    }
+
+private:
+    CETL_NODISCARD int makeWakeupPipe()
+    {
+        std::array<int, 2> fds{-1, -1};
+        if (const auto err = platform::posixSyscallError([&fds] {
+                //
+                return ::pipe(fds.data());
+            }))
+        {
+            return err;
+        }
+        wakeup_read_fd_  = common::io::OwnFd{fds[0]};
+        wakeup_write_fd_ = common::io::OwnFd{fds[1]};
+
+        for (const int fd : fds)
+        {
+            if (const auto err = platform::posixSyscallError([fd] {
+                    //
+                    return ::fcntl(fd, F_SETFL, O_NONBLOCK);  // NOLINT(*-vararg)
+                }))
+            {
+                return err;
+            }
+        }
+        return 0;
+    }
+
+    /// Wakes up the I/O thread (if it's blocked on polling). Safe to call from any thread.
+    ///
+    /// The queue tells producers when it becomes non-empty, so there is at most one wake-up byte per batch of tasks.
+    ///
+    void wakeUp() const
+    {
+        const std::uint8_t byte = 1;
+        if (const auto err = platform::posixSyscallError([this, &byte] {
+                //
+                return ::write(wakeup_write_fd_.get(), &byte, sizeof(byte));
+            }))
+        {
+            // The pipe is full - the I/O thread is going to wake up anyway.
+            (void) err;
+        }
+    }
+
+    void handleWakeUp()
+    {
+        std::array<std::uint8_t, 64> buffer{};  // NOLINT(*-magic-numbers)
+        while (::read(wakeup_read_fd_.get(), buffer.data(), buffer.size()) > 0)
+        {
+            // Just drain the pipe.
+        }
+
+        tasks_.drain([this](Task&& task) {
+            //
+            task(*daemon_);
+        });
+    }
+
+    void run()
+    {
+        logger_->debug("I/O thread is running.");
+
+        while (!is_stop_requested_.load(std::memory_order_acquire))
+        {
+            const auto spin_result = executor_.spinOnce();
+
+            // Poll awaitable resources (including the wake-up pipe) but awake at least once per second.
+            libcyphal::Duration timeout{std::chrono::seconds{1}};
+            if (spin_result.next_exec_time.has_value())
+            {
+                timeout = std::min(timeout, spin_result.next_exec_time.value() - executor_.now());
+            }
+            if (const auto poll_failure = executor_.pollAwaitableResourcesFor(cetl::make_optional(timeout)))
+            {
+                (void) poll_failure;
+                logger_->warn("Failed to poll awaitable resources.");
+            }
+        }
+
+        logger_->debug("I/O thread is stopped.");
+    }
+
+    cetl::pmr::memory_resource&                              memory_;
+    common::LoggerPtr                                        logger_;
+    platform::SingleThreadedExecutor                         executor_;
+    common::io::OwnFd                                        wakeup_read_fd_;
+    common::io::OwnFd                                        wakeup_write_fd_;
+    libcyphal::IExecutor::Callback::Any                      wakeup_callback_;
+    MpscQueue<Task>                                          tasks_;
+    Daemon::Ptr                                              daemon_;
+    std::uint64_t                                            next_sender_id_{0};
+    std::unordered_map<std::uint64_t, std::shared_ptr<void>> senders_;
+    std::atomic<bool>                                        is_stop_requested_{false};
+    std::thread                                              thread_;
+
+};  // IoThreadImpl
+
+}  // namespace
+
+CETL_NODISCARD IoThread::Ptr IoThread::make(cetl::pmr::memory_resource& memory, const std::string& connection)
+{
+    auto io_thread = std::make_unique<IoThreadImpl>(memory);
+    if (0 != io_thread->start(connection))
+    {
+        return nullptr;
+    }
+
+    return io_thread;
+}
+
+}  // namespace sdk
+}  // namespace ocvsmd
@@ -0,0 +1,120 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_SDK_MPSC_QUEUE_HPP_INCLUDED
+#define OCVSMD_SDK_MPSC_QUEUE_HPP_INCLUDED
+
+#include <cetl/cetl.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace ocvsmd
+{
+namespace sdk
+{
+
+/// Defines lock-free multi-producer single-consumer queue.
+///
+/// Producers (any threads) push items one by one with a single CAS each. The consumer (one thread) takes
+/// all pushed items at once with a single atomic exchange, and then visits them in FIFO order.
+/// Taking the whole list (instead of popping items one by one) makes the queue immune to the ABA problem,
+/// and tells producers when the queue becomes non-empty - so that they know when to wake up the consumer.
+///
+/// Items are allocated on the usual c++ heap (one node per item).
+///
+template <typename Item>
+class MpscQueue final
+{
+public:
+    MpscQueue() = default;
+
+    MpscQueue(const MpscQueue&)                = delete;
+    MpscQueue(MpscQueue&&) noexcept            = delete;
+    MpscQueue& operator=(const MpscQueue&)     = delete;
+    MpscQueue& operator=(MpscQueue&&) noexcept = delete;
+
+    ~MpscQueue()
+    {
+        deleteList(head_.exchange(nullptr, std::memory_order_acquire));
+    }
+
+    /// Pushes a new item to the queue. Safe to call from any thread.
+    ///
+    /// @return `true` if the queue was empty before the push - the consumer might need a wake-up.
+    ///
+    bool push(Item&& item)
+    {
+        auto* const node = new Node{std::move(item), nullptr};
+        Node*       head = head_.load(std::memory_order_relaxed);
+        do
+        {
+            node->next = head;
+        } while (!head_.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+
+        // Once pushed, the node might be already taken (and even freed) by the consumer - so it's not touched anymore.
+        return head == nullptr;
+    }
+
+    /// Takes all currently pushed items, and passes them (in FIFO order) to the given visitor.
+    ///
+    /// Should be called by the consumer thread only.
+    /// The visitor might push new items - they will be taken by the next call.
+    ///
+    /// @return Number of visited items.
+    ///
+    template <typename Visitor>
+    std::size_t drain(Visitor&& visitor)
+    {
+        // Nodes are linked from the newest to the oldest one - reverse them to restore the FIFO order.
+        Node* fifo = nullptr;
+        Node* lifo = head_.exchange(nullptr, std::memory_order_acquire);
+        while (lifo != nullptr)
+        {
+            Node* const next = lifo->next;
+            lifo->next       = fifo;
+            fifo             = lifo;
+            lifo             = next;
+        }
+
+        std::size_t count = 0;
+        while (fifo != nullptr)
+        {
+            Node* const node = fifo;
+            fifo             = node->next;
+
+            const std::unique_ptr<Node> node_ptr{node};
+            visitor(std::move(node_ptr->item));
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    struct Node final
+    {
+        Item  item;
+        Node* next;
+    };
+
+    static void deleteList(Node* node)
+    {
+        while (node != nullptr)
+        {
+            const std::unique_ptr<Node> node_ptr{node};
+            node = node->next;
+        }
+    }
+
+    std::atomic<Node*> head_{nullptr};
+
+};  // MpscQueue
+
+}  // namespace sdk
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_SDK_MPSC_QUEUE_HPP_INCLUDED
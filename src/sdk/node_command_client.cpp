@@ -10,19 +10,24 @@
 #include "logging.hpp"
 #include "ocvsmd/sdk/execution.hpp"
 #include "sdk_factory.hpp"
+#include "svc/network_spec.hpp"
+#include "svc/node/exec_cmd_batch_client.hpp"
+#include "svc/node/exec_cmd_batch_spec.hpp"
 #include "svc/node/exec_cmd_client.hpp"
 #include "svc/node/exec_cmd_spec.hpp"
 
 #include <cetl/cetl.hpp>
 #include <cetl/pf17/cetlpf.hpp>
 #include <cetl/pf20/cetlpf.hpp>
+#include <cetl/pmr/interface_ptr.hpp>
 
 #include <algorithm>
 #include <cerrno>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <functional>
 #include <memory>
+#include <string>
 #include <utility>
 
 namespace ocvsmd
@@ -35,9 +40,13 @@ namespace
 class NodeCommandClientImpl final : public NodeCommandClient
 {
 public:
-    NodeCommandClientImpl(cetl::pmr::memory_resource& memory, common::ipc::ClientRouter::Ptr ipc_router)
+    NodeCommandClientImpl(cetl::pmr::memory_resource&    memory,
+                          common::ipc::ClientRouter::Ptr ipc_router,
+                          const cetl::string_view        network)
         : memory_{memory}
         , ipc_router_{std::move(ipc_router)}
+        , exec_cmd_svc_name_{NetworkSpec::svc_full_name(ExecCmdSpec::svc_full_name(), network)}
+        , exec_cmd_batch_svc_name_{NetworkSpec::svc_full_name(ExecCmdBatchSpec::svc_full_name(), network)}
         , logger_{common::getLogger("sdk")}
     {
     }
@@ -49,22 +58,137 @@ public:
         return memory_;
     }
 
+    void setRetryPolicy(const Command::RetryPolicy& retry_policy) override
+    {
+        retry_policy_ = retry_policy;
+    }
+
     SenderOf<Command::Result>::Ptr sendCommand(const cetl::span<const std::uint16_t> node_ids,
                                                const Command::NodeRequest&           node_request,
                                                const std::chrono::microseconds       timeout) override
     {
-        common::svc::node::ExecCmdSpec::Request request{std::max<std::uint64_t>(0, timeout.count()),
-                                                        {node_ids.begin(), node_ids.end(), &memory_},
-                                                        {node_request.command, node_request.parameter, &memory_},
-                                                        &memory_};
+        auto request    = makeRequest(node_ids, node_request, timeout);
+        auto svc_client = ExecCmdClient::make(memory_, ipc_router_, exec_cmd_svc_name_, std::move(request), timeout);
 
-        auto svc_client = ExecCmdClient::make(memory_, ipc_router_, std::move(request), timeout);
+        return makeSender<CommandSender>(std::move(svc_client));
+    }
 
-        return std::make_unique<CommandSender>(std::move(svc_client));
+    SenderOf<Command::StreamResult>::Ptr sendCommandStreaming(  //
+        const cetl::span<const std::uint16_t> node_ids,
+        const Command::NodeRequest&           node_request,
+        const std::chrono::microseconds       timeout,
+        Command::NodeObserver                 node_observer) override
+    {
+        auto request = makeRequest(node_ids, node_request, timeout);
+        return makeSender<StreamingCommandSender>(std::move(node_observer), [&](auto&& svc_observer) {
+            //
+            return ExecCmdClient::make(memory_,
+                                       ipc_router_,
+                                       exec_cmd_svc_name_,
+                                       std::move(request),
+                                       timeout,
+                                       std::forward<decltype(svc_observer)>(svc_observer));
+        });
+    }
+
+    SenderOf<Command::StreamResult>::Ptr sendCommandBatch(  //
+        const cetl::span<const Command::BatchItem> items,
+        const std::chrono::microseconds            timeout,
+        Command::BatchObserver                     batch_observer) override
+    {
+        using BatchSpec    = common::svc::node::ExecCmdBatchSpec;
+        using BatchReqItem = BatchSpec::Request::_traits_::TypeOf::items::value_type;
+
+        // Oversized batches are rejected up front - otherwise they would be silently truncated on serialization.
+        constexpr auto max_items    = BatchSpec::Request::_traits_::ArrayCapacity::items;
+        constexpr auto max_node_ids = BatchReqItem::_traits_::ArrayCapacity::node_ids;
+        const bool     has_too_many_node_ids = std::any_of(items.begin(), items.end(), [](const auto& item) {
+            //
+            return item.node_ids.size() > max_node_ids;
+        });
+        if ((items.size() > max_items) || has_too_many_node_ids)
+        {
+            logger_->warn("Rejecting command batch (items={}, max_items={}, max_node_ids={}).",
+                          items.size(),
+                          max_items,
+                          max_node_ids);
+            return makeSender<FailedSender<Command::StreamResult>>(Command::Failure{EINVAL});
+        }
+
+        BatchSpec::Request request{&memory_};
+        request.timeout_us         = std::max<std::uint64_t>(0, timeout.count());
+        request.max_attempts       = retry_policy_.max_attempts;
+        request.attempt_timeout_us = std::max<std::uint64_t>(0, retry_policy_.attempt_timeout.count());
+        request.backoff_us         = std::max<std::uint64_t>(0, retry_policy_.backoff.count());
+        request.items.reserve(items.size());
+        for (const auto& item : items)
+        {
+            request.items.push_back(BatchReqItem{{item.node_ids.begin(), item.node_ids.end(), &memory_},
+                                                 {item.node_request.command, item.node_request.parameter, &memory_},
+                                                 &memory_});
+        }
+
+        return makeSender<BatchSender>(std::move(batch_observer), [&](auto&& svc_observer) {
+            //
+            return ExecCmdBatchClient::make(memory_,
+                                            ipc_router_,
+                                            exec_cmd_batch_svc_name_,
+                                            std::move(request),
+                                            std::forward<decltype(svc_observer)>(svc_observer));
+        });
     }
 
 private:
-    using ExecCmdClient = svc::node::ExecCmdClient;
+    using NetworkSpec        = common::svc::NetworkSpec;
+    using ExecCmdSpec        = common::svc::node::ExecCmdSpec;
+    using ExecCmdBatchSpec   = common::svc::node::ExecCmdBatchSpec;
+    using ExecCmdClient      = svc::node::ExecCmdClient;
+    using ExecCmdBatchClient = svc::node::ExecCmdBatchClient;
+    using ExecCmdRequest     = ExecCmdSpec::Request;
+
+    /// Makes a new sender - senders are made per each command, so they are allocated from the memory resource.
+    ///
+    template <typename Sender, typename... Args>
+    typename SenderOf<typename Sender::Result>::Ptr makeSender(Args&&... args) const
+    {
+        return cetl::pmr::InterfaceFactory::make_unique<SenderOf<typename Sender::Result>>(
+            cetl::pmr::polymorphic_allocator<Sender>{&memory_},
+            std::forward<Args>(args)...);
+    }
+
+    ExecCmdRequest makeRequest(const cetl::span<const std::uint16_t> node_ids,
+                               const Command::NodeRequest&           node_request,
+                               const std::chrono::microseconds       timeout) const
+    {
+        return ExecCmdRequest{std::max<std::uint64_t>(0, timeout.count()),
+                              {node_ids.begin(), node_ids.end(), &memory_},
+                              {node_request.command, node_request.parameter, &memory_},
+                              retry_policy_.max_attempts,
+                              std::max<std::uint64_t>(0, retry_policy_.attempt_timeout.count()),
+                              std::max<std::uint64_t>(0, retry_policy_.backoff.count()),
+                              &memory_};
+    }
+
+    /// Defines a sender which fails right on submission (f.e. because of invalid arguments).
+    ///
+    template <typename Result>
+    class FailedSender final : public SenderOf<Result>
+    {
+    public:
+        explicit FailedSender(const Command::Failure failure)
+            : failure_{failure}
+        {
+        }
+
+        void submitImpl(typename SenderOf<Result>::Receiver&& receiver) override
+        {
+            receiver(Result{failure_});
+        }
+
+    private:
+        Command::Failure failure_;
+
+    };  // FailedSender
 
     class CommandSender final : public SenderOf<Command::Result>
     {
@@ -74,7 +198,7 @@ private:
         {
         }
 
-        void submitImpl(std::function<void(Command::Result&&)>&& receiver) override
+        void submitImpl(Receiver&& receiver) override
         {
             svc_client_->submit([receiver = std::move(receiver)](ExecCmdClient::Result&& result) mutable {
                 //
@@ -90,13 +214,8 @@ private:
     private:
         static Command::Result transform(ExecCmdClient::Success&& svc_success)
         {
-            Command::Success cmd_success{};
-            cmd_success.reserve(svc_success.size());
-            for (auto&& pair : std::move(svc_success))
-            {
-                cmd_success.emplace(pair.first, std::move(pair.second));
-            }
-            return cmd_success;
+            // Both are the same map type (allocated from the client's memory resource), so just moved.
+            return Command::Success{std::move(svc_success)};
         }
 
         static Command::Result transform(ExecCmdClient::Failure failure)
@@ -108,9 +227,96 @@ private:
 
     };  // CommandSender
 
+    class StreamingCommandSender final : public SenderOf<Command::StreamResult>
+    {
+    public:
+        /// The sender owns the service client (and so its observer), hence the observer is never
+        /// called after the sender is destroyed - it's safe to capture `this`.
+        ///
+        template <typename MakeSvcClient>
+        StreamingCommandSender(Command::NodeObserver node_observer, MakeSvcClient&& make_svc_client)
+            : node_observer_{std::move(node_observer)}
+            , svc_client_{std::forward<MakeSvcClient>(make_svc_client)(
+                  [this](const auto node_id, auto&& node_response) {
+                      //
+                      observe(node_id, std::move(node_response));
+                  })}
+        {
+        }
+
+        void observe(const std::uint16_t node_id, Command::NodeResponse&& node_response)
+        {
+            ++responses_count_;
+            if (node_observer_)
+            {
+                node_observer_(node_id, std::move(node_response));
+            }
+        }
+
+        void submitImpl(Receiver&& receiver) override
+        {
+            svc_client_->submit([this, receiver = std::move(receiver)](ExecCmdClient::Result&& result) mutable {
+                //
+                if (const auto* const failure = cetl::get_if<ExecCmdClient::Failure>(&result))
+                {
+                    receiver(Command::Failure{*failure});
+                    return;
+                }
+                receiver(Command::StreamSuccess{responses_count_});
+            });
+        }
+
+    private:
+        Command::NodeObserver node_observer_;
+        ExecCmdClient::Ptr    svc_client_;
+        std::size_t           responses_count_{0};
+
+    };  // StreamingCommandSender
+
+    class BatchSender final : public SenderOf<Command::StreamResult>
+    {
+    public:
+        /// Same as the streaming sender, this one owns the service client, and so it's safe to capture `this`.
+        ///
+        template <typename MakeSvcClient>
+        BatchSender(Command::BatchObserver batch_observer, MakeSvcClient&& make_svc_client)
+            : batch_observer_{std::move(batch_observer)}
+            , svc_client_{std::forward<MakeSvcClient>(make_svc_client)(
+                  [this](const auto item_index, const auto node_id, auto&& node_response) {
+                      //
+                      if (batch_observer_)
+                      {
+                          batch_observer_(item_index, node_id, std::move(node_response));
+                      }
+                  })}
+        {
+        }
+
+        void submitImpl(Receiver&& receiver) override
+        {
+            svc_client_->submit([receiver = std::move(receiver)](ExecCmdBatchClient::Result&& result) mutable {
+                //
+                if (const auto* const failure = cetl::get_if<ExecCmdBatchClient::Failure>(&result))
+                {
+                    receiver(Command::Failure{*failure});
+                    return;
+                }
+                receiver(Command::StreamSuccess{cetl::get<ExecCmdBatchClient::Success>(result)});
+            });
+        }
+
+    private:
+        Command::BatchObserver  batch_observer_;
+        ExecCmdBatchClient::Ptr svc_client_;
+
+    };  // BatchSender
+
     cetl::pmr::memory_resource&    memory_;
-    common::LoggerPtr              logger_;
     common::ipc::ClientRouter::Ptr ipc_router_;
+    const std::string              exec_cmd_svc_name_;
+    const std::string              exec_cmd_batch_svc_name_;
+    common::LoggerPtr              logger_;
+    Command::RetryPolicy           retry_policy_;
 
 };  // NodeCommandClientImpl
 
@@ -146,9 +352,10 @@ SenderOf<NodeCommandClient::Command::Result>::Ptr NodeCommandClient::beginSoftwa
 }
 
 CETL_NODISCARD NodeCommandClient::Ptr Factory::makeNodeCommandClient(cetl::pmr::memory_resource&    memory,
-                                                                     common::ipc::ClientRouter::Ptr ipc_router)
+                                                                     common::ipc::ClientRouter::Ptr ipc_router,
+                                                                     std::string                    network)
 {
-    return std::make_shared<NodeCommandClientImpl>(memory, std::move(ipc_router));
+    return std::make_shared<NodeCommandClientImpl>(memory, std::move(ipc_router), network);
 }
 
 }  // namespace sdk
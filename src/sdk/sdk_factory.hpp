@@ -14,6 +14,8 @@
 #include <cetl/cetl.hpp>
 #include <cetl/pf17/cetlpf.hpp>
 
+#include <string>
+
 namespace ocvsmd
 {
 namespace sdk
@@ -24,8 +26,11 @@ struct Factory
     // ➕ CETL_NODISCARD static FileServer::Ptr makeFileServer(cetl::pmr::memory_resource&    memory,
     // ➕                                                      common::ipc::ClientRouter::Ptr ipc_router);
 
+    /// Makes a client of the given Cyphal network of the daemon (empty name means the primary network).
+    ///
     CETL_NODISCARD static NodeCommandClient::Ptr makeNodeCommandClient(cetl::pmr::memory_resource&    memory,
-                                                                       common::ipc::ClientRouter::Ptr ipc_router);
+                                                                       common::ipc::ClientRouter::Ptr ipc_router,
+                                                                       std::string                    network = {});
 
 };  // Factory
 
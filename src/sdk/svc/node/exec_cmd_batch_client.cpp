@@ -0,0 +1,133 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "exec_cmd_batch_client.hpp"
+
+#include "ipc/channel.hpp"
+#include "ipc/client_router.hpp"
+#include "ipc/ipc_types.hpp"
+#include "logging.hpp"
+#include "svc/node/exec_cmd_batch_spec.hpp"
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace ocvsmd
+{
+namespace sdk
+{
+namespace svc
+{
+namespace node
+{
+namespace
+{
+
+class ExecCmdBatchClientImpl final : public ExecCmdBatchClient
+{
+public:
+    ExecCmdBatchClientImpl(cetl::pmr::memory_resource&           memory,
+                           const common::ipc::ClientRouter::Ptr& ipc_router,
+                           const cetl::string_view               svc_name,
+                           Spec::Request&&                       request,
+                           NodeObserver                          node_observer)
+        : memory_{memory}
+        , logger_{common::getLogger("svc")}
+        , request_{std::move(request)}
+        , channel_{ipc_router->makeChannel<Channel>(svc_name)}
+        , node_observer_{std::move(node_observer)}
+    {
+    }
+
+    void submitImpl(Receiver&& receiver) override
+    {
+        receiver_ = std::move(receiver);
+
+        channel_.subscribe([this](const auto& event_var) {
+            //
+            cetl::visit([this](const auto& event) { handleEvent(event); }, event_var);
+        });
+    }
+
+private:
+    using Channel     = common::ipc::Channel<Spec::Response, Spec::Request>;
+
+    void handleEvent(const Channel::Connected& connected)
+    {
+        logger_->trace("ExecCmdBatchClient::handleEvent({}).", connected);
+
+        if (const auto err = channel_.send(request_))
+        {
+            CETL_DEBUG_ASSERT(receiver_, "");
+
+            receiver_(Failure{err});
+        }
+    }
+
+    void handleEvent(const Channel::Input& input)
+    {
+        logger_->trace("ExecCmdBatchClient::handleEvent(Input).");
+
+        ++responses_count_;
+        if (node_observer_)
+        {
+            NodeResponse node_response{input.payload.status, input.payload.output, &memory_};
+            node_observer_(input.item_index, input.node_id, std::move(node_response));
+        }
+    }
+
+    // Commands are not safe to repeat, so resumption is never enabled for the channel.
+    static void handleEvent(const Channel::Resumed&) {}
+
+    void handleEvent(const Channel::Completed& completed) const
+    {
+        CETL_DEBUG_ASSERT(receiver_, "");
+
+        logger_->debug("ExecCmdBatchClient::handleEvent({}).", completed);
+
+        if (completed.error_code != common::ipc::ErrorCode::Success)
+        {
+            receiver_(static_cast<Failure>(completed.error_code));
+            return;
+        }
+        receiver_(Success{responses_count_});
+    }
+
+    cetl::pmr::memory_resource&   memory_;
+    common::LoggerPtr             logger_;
+    Spec::Request                 request_;
+    Channel                       channel_;
+    NodeObserver                  node_observer_;
+    Receiver                      receiver_;
+    std::size_t                   responses_count_{0};
+
+};  // ExecCmdBatchClientImpl
+
+}  // namespace
+
+CETL_NODISCARD ExecCmdBatchClient::Ptr ExecCmdBatchClient::make(cetl::pmr::memory_resource&           memory,
+                                                                const common::ipc::ClientRouter::Ptr& ipc_router,
+                                                                const cetl::string_view               svc_name,
+                                                                Spec::Request&&                       request,
+                                                                NodeObserver                          node_observer)
+{
+    return std::allocate_shared<ExecCmdBatchClientImpl>(  //
+        cetl::pmr::polymorphic_allocator<ExecCmdBatchClientImpl>{&memory},
+        memory,
+        ipc_router,
+        svc_name,
+        std::move(request),
+        std::move(node_observer));
+}
+
+}  // namespace node
+}  // namespace svc
+}  // namespace sdk
+}  // namespace ocvsmd
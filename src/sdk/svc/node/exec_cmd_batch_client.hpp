@@ -0,0 +1,101 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_SDK_SVC_NODE_EXEC_CMD_BATCH_CLIENT_HPP_INCLUDED
+#define OCVSMD_SDK_SVC_NODE_EXEC_CMD_BATCH_CLIENT_HPP_INCLUDED
+
+#include "ipc/client_router.hpp"
+#include "svc/node/exec_cmd_batch_spec.hpp"
+
+#include <uavcan/node/ExecuteCommand_1_3.hpp>
+
+#include <ocvsmd/sdk/execution.hpp>
+
+#include <cetl/cetl.hpp>
+#include <cetl/pf17/cetlpf.hpp>
+#include <cetl/pmr/function.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace ocvsmd
+{
+namespace sdk
+{
+namespace svc
+{
+namespace node
+{
+
+/// Defines interface of the 'Node: Exec Command Batch' service client.
+///
+/// Node responses are passed to the observer as they arrive (they are not accumulated),
+/// so on success the result is just the number of observed responses.
+///
+class ExecCmdBatchClient
+{
+public:
+    using Ptr          = std::shared_ptr<ExecCmdBatchClient>;
+    using Spec         = common::svc::node::ExecCmdBatchSpec;
+    using NodeResponse = uavcan::node::ExecuteCommand_1_3::Response;
+
+    using Success = std::size_t;
+    using Failure = int;  // `errno`-like error code
+    using Result  = cetl::variant<Success, Failure>;
+
+    /// Defines the type-erased receiver of the result.
+    ///
+    /// SDK senders adapt their own receivers into this one, so it's stored in place (no heap allocation),
+    /// and it's big enough for one SDK receiver plus a couple of pointers.
+    ///
+    using Receiver = cetl::pmr::function<void(Result&&), sizeof(SenderOf<Result>::Receiver) + (sizeof(void*) * 2)>;
+
+    /// Defines observer of node responses. Stored in place - SDK senders adapt their own observers.
+    ///
+    using NodeObserver = cetl::pmr::function<
+        void(const std::size_t item_index, const std::uint16_t node_id, NodeResponse&& node_response),
+        sizeof(void*) * 2>;
+
+    /// Makes a new client of the service.
+    ///
+    /// The client (together with its state) is allocated from the given memory resource.
+    /// The service name is already qualified with the Cyphal network (see `NetworkSpec::svc_full_name`).
+    ///
+    CETL_NODISCARD static Ptr make(cetl::pmr::memory_resource&           memory,
+                                   const common::ipc::ClientRouter::Ptr& ipc_router,
+                                   const cetl::string_view               svc_name,
+                                   Spec::Request&&                       request,
+                                   NodeObserver                          node_observer);
+
+    ExecCmdBatchClient(ExecCmdBatchClient&&)                 = delete;
+    ExecCmdBatchClient(const ExecCmdBatchClient&)            = delete;
+    ExecCmdBatchClient& operator=(ExecCmdBatchClient&&)      = delete;
+    ExecCmdBatchClient& operator=(const ExecCmdBatchClient&) = delete;
+
+    virtual ~ExecCmdBatchClient() = default;
+
+    template <typename Receiver_>
+    void submit(Receiver_&& receiver)
+    {
+        submitImpl(Receiver{std::forward<Receiver_>(receiver)});
+    }
+
+protected:
+    ExecCmdBatchClient() = default;
+
+    virtual void submitImpl(Receiver&& receiver) = 0;
+
+};  // ExecCmdBatchClient
+
+}  // namespace node
+}  // namespace svc
+}  // namespace sdk
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_SDK_SVC_NODE_EXEC_CMD_BATCH_CLIENT_HPP_INCLUDED
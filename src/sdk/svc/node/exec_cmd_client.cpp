@@ -39,18 +39,22 @@ class ExecCmdClientImpl final : public ExecCmdClient
 public:
     ExecCmdClientImpl(cetl::pmr::memory_resource&           memory,
                       const common::ipc::ClientRouter::Ptr& ipc_router,
+                      const cetl::string_view               svc_name,
                       Spec::Request&&                       request,
-                      const std::chrono::microseconds       timeout)
+                      const std::chrono::microseconds       timeout,
+                      NodeObserver                          node_observer)
         : memory_{memory}
         , logger_{common::getLogger("svc")}
         , request_{std::move(request)}
-        , channel_{ipc_router->makeChannel<Channel>(Spec::svc_full_name())}
+        , channel_{ipc_router->makeChannel<Channel>(svc_name)}
+        , node_observer_{std::move(node_observer)}
+        , node_id_to_response_{Success::allocator_type{&memory}}
     {
         // TODO: handle timeout
         (void) timeout;
     }
 
-    void submitImpl(std::function<void(Result&&)>&& receiver) override
+    void submitImpl(Receiver&& receiver) override
     {
         receiver_ = std::move(receiver);
 
@@ -61,7 +65,7 @@ public:
     }
 
 private:
-    using Channel = common::ipc::Channel<Spec::Response, Spec::Request>;
+    using Channel     = common::ipc::Channel<Spec::Response, Spec::Request>;
 
     void handleEvent(const Channel::Connected& connected)
     {
@@ -80,10 +84,18 @@ private:
         logger_->trace("ExecCmdClient::handleEvent(Input).");
 
         NodeResponse node_response{input.payload.status, input.payload.output, &memory_};
+        if (node_observer_)
+        {
+            node_observer_(input.node_id, std::move(node_response));
+            return;
+        }
         node_id_to_response_.emplace(input.node_id, std::move(node_response));
     }
 
-    void handleEvent(const Channel::Completed& completed) const
+    // Commands are not safe to repeat, so resumption is never enabled for the channel.
+    static void handleEvent(const Channel::Resumed&) {}
+
+    void handleEvent(const Channel::Completed& completed)
     {
         CETL_DEBUG_ASSERT(receiver_, "");
 
@@ -94,15 +106,16 @@ private:
             receiver_(static_cast<Failure>(completed.error_code));
             return;
         }
-        receiver_(Success{node_id_to_response_});
+        receiver_(std::move(node_id_to_response_));
     }
 
-    cetl::pmr::memory_resource&                     memory_;
-    common::LoggerPtr                               logger_;
-    Spec::Request                                   request_;
-    Channel                                         channel_;
-    std::function<void(Result&&)>                   receiver_;
-    std::unordered_map<std::uint16_t, NodeResponse> node_id_to_response_;
+    cetl::pmr::memory_resource& memory_;
+    common::LoggerPtr           logger_;
+    Spec::Request               request_;
+    Channel                     channel_;
+    Receiver                    receiver_;
+    NodeObserver                node_observer_;
+    Success                     node_id_to_response_;
 
 };  // ExecCmdClientImpl
 
@@ -110,10 +123,18 @@ private:
 
 CETL_NODISCARD ExecCmdClient::Ptr ExecCmdClient::make(cetl::pmr::memory_resource&           memory,
                                                       const common::ipc::ClientRouter::Ptr& ipc_router,
+                                                      const cetl::string_view               svc_name,
                                                       Spec::Request&&                       request,
-                                                      const std::chrono::microseconds       timeout)
+                                                      const std::chrono::microseconds       timeout,
+                                                      NodeObserver                          node_observer)
 {
-    return std::make_shared<ExecCmdClientImpl>(memory, ipc_router, std::move(request), timeout);
+    return std::allocate_shared<ExecCmdClientImpl>(cetl::pmr::polymorphic_allocator<ExecCmdClientImpl>{&memory},
+                                                   memory,
+                                                   ipc_router,
+                                                   svc_name,
+                                                   std::move(request),
+                                                   timeout,
+                                                   std::move(node_observer));
 }
 
 }  // namespace node
@@ -11,10 +11,15 @@
 
 #include <uavcan/node/ExecuteCommand_1_3.hpp>
 
+#include <ocvsmd/sdk/execution.hpp>
+
 #include <cetl/cetl.hpp>
 #include <cetl/pf17/cetlpf.hpp>
+#include <cetl/pmr/function.hpp>
 
 #include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <utility>
@@ -37,14 +42,42 @@ public:
     using Spec         = common::svc::node::ExecCmdSpec;
     using NodeResponse = uavcan::node::ExecuteCommand_1_3::Response;
 
-    using Success = std::unordered_map<std::uint16_t, NodeResponse>;
+    using Success = std::unordered_map<  //
+        std::uint16_t,
+        NodeResponse,
+        std::hash<std::uint16_t>,
+        std::equal_to<std::uint16_t>,
+        cetl::pmr::polymorphic_allocator<std::pair<const std::uint16_t, NodeResponse>>>;
     using Failure = int;  // `errno`-like error code
     using Result  = cetl::variant<Success, Failure>;
 
+    /// Defines the type-erased receiver of the result.
+    ///
+    /// SDK senders adapt their own receivers into this one, so it's stored in place (no heap allocation),
+    /// and it's big enough for one SDK receiver plus a couple of pointers.
+    ///
+    using Receiver = cetl::pmr::function<void(Result&&), sizeof(SenderOf<Result>::Receiver) + (sizeof(void*) * 2)>;
+
+    /// Optional observer of node responses.
+    ///
+    /// If provided then node responses are passed to it (as they arrive) instead of being accumulated,
+    /// so the `Success` result will be empty. Stored in place - SDK senders adapt their own observers.
+    ///
+    using NodeObserver =
+        cetl::pmr::function<void(const std::uint16_t node_id, NodeResponse&& node_response), sizeof(void*) * 2>;
+
+    /// Makes a new client of the service.
+    ///
+    /// The client (together with its state) is allocated from the given memory resource.
+    /// The service name is already qualified with the Cyphal network (see `NetworkSpec::svc_full_name`),
+    /// so that it's made once per SDK client rather than per each command.
+    ///
     CETL_NODISCARD static Ptr make(cetl::pmr::memory_resource&           memory,
                                    const common::ipc::ClientRouter::Ptr& ipc_router,
+                                   const cetl::string_view               svc_name,
                                    Spec::Request&&                       request,
-                                   const std::chrono::microseconds       timeout);
+                                   const std::chrono::microseconds       timeout,
+                                   NodeObserver                          node_observer = {});
 
     ExecCmdClient(ExecCmdClient&&)                 = delete;
     ExecCmdClient(const ExecCmdClient&)            = delete;
@@ -53,19 +86,16 @@ public:
 
     virtual ~ExecCmdClient() = default;
 
-    template <typename Receiver>
-    void submit(Receiver&& receiver)
+    template <typename Receiver_>
+    void submit(Receiver_&& receiver)
     {
-        submitImpl([receive = std::forward<Receiver>(receiver)](Result&& result) mutable {
-            //
-            receive(std::move(result));
-        });
+        submitImpl(Receiver{std::forward<Receiver_>(receiver)});
     }
 
 protected:
     ExecCmdClient() = default;
 
-    virtual void submitImpl(std::function<void(Result&&)>&& receiver) = 0;
+    virtual void submitImpl(Receiver&& receiver) = 0;
 
 };  // ExecCmdClient
 
@@ -0,0 +1,58 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_COMMON_IPC_GATEWAY_MOCK_HPP_INCLUDED
+#define OCVSMD_COMMON_IPC_GATEWAY_MOCK_HPP_INCLUDED
+
+#include "ipc/gateway.hpp"
+#include "ipc/ipc_types.hpp"
+
+#include <gmock/gmock.h>
+
+namespace ocvsmd
+{
+namespace common
+{
+namespace ipc
+{
+namespace detail
+{
+
+/// Mocks the gateway of a single channel - so that a service could be tested without an IPC router.
+///
+/// The subscribed event handler is captured, so that a test could emulate events of the channel.
+///
+class GatewayMock : public Gateway
+{
+public:
+    GatewayMock()
+    {
+        ON_CALL(*this, subscribe(testing::_)).WillByDefault(testing::Invoke([this](EventHandler event_handler) {
+            //
+            event_handler_ = std::move(event_handler);
+        }));
+    }
+
+    MOCK_METHOD(int, send, (const ServiceDesc::Id service_id, const Payload payload), (override));
+    MOCK_METHOD(void, complete, (int error_code), (override));
+    MOCK_METHOD(int, event, (const Event::Var& event), (override));
+    MOCK_METHOD(void, subscribe, (EventHandler event_handler), (override));
+    MOCK_METHOD(void, enableResumption, (), (override));
+    MOCK_METHOD(void, enableBackPressure, (), (override));
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    EventHandler event_handler_;
+    // NOLINTEND
+
+};  // GatewayMock
+
+}  // namespace detail
+}  // namespace ipc
+}  // namespace common
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_COMMON_IPC_GATEWAY_MOCK_HPP_INCLUDED
@@ -42,11 +42,17 @@ public:
             return reference().send(client_id, payloads);
         }
 
+        int trySend(const ClientId client_id, const Payloads payloads) override
+        {
+            return reference().trySend(client_id, payloads);
+        }
+
     };  // RefWrapper
 
     MOCK_METHOD(void, deinit, (), (const));
     MOCK_METHOD(int, start, (EventHandler event_handler), (override));
     MOCK_METHOD(int, send, (const ClientId client_id, const Payloads payloads), (override));
+    MOCK_METHOD(int, trySend, (const ClientId client_id, const Payloads payloads), (override));
 
     // MARK: Data members:
 
@@ -0,0 +1,285 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "ipc/pipe/socket_client.hpp"
+#include "ipc/pipe/socket_server.hpp"
+
+#include "io/socket_address.hpp"
+#include "ipc/ipc_types.hpp"
+#include "ipc/pipe/client_pipe.hpp"
+#include "ipc/pipe/server_pipe.hpp"
+#include "ocvsmd/platform/defines.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/types.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using ocvsmd::common::io::SocketAddress;
+using ocvsmd::common::ipc::Payload;
+using ocvsmd::common::ipc::pipe::ClientPipe;
+using ocvsmd::common::ipc::pipe::ServerPipe;
+using ocvsmd::common::ipc::pipe::SocketClient;
+using ocvsmd::common::ipc::pipe::SocketServer;
+
+using testing::Gt;
+using testing::IsTrue;
+using testing::SizeIs;
+using testing::ElementsAre;
+
+using std::literals::chrono_literals::operator""s;
+using std::literals::chrono_literals::operator""ms;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestSocketPipe : public testing::Test
+{
+protected:
+    using Message = std::vector<std::uint8_t>;
+
+    void SetUp() override
+    {
+        socket_path_ = "/tmp/ocvsmd_test_socket_pipe_" + std::to_string(::getpid()) + ".sock";
+        (void) std::remove(socket_path_.c_str());
+    }
+
+    void TearDown() override
+    {
+        (void) std::remove(socket_path_.c_str());
+    }
+
+    SocketAddress makeAddress() const
+    {
+        auto maybe_address = SocketAddress::parse("unix:" + socket_path_, 0);
+        EXPECT_THAT(cetl::holds_alternative<SocketAddress::ParseResult::Success>(maybe_address), IsTrue());
+        return cetl::get<SocketAddress::ParseResult::Success>(maybe_address);
+    }
+
+    /// Starts the server and the client, and waits until they are connected to each other.
+    ///
+    bool connect(ServerPipe& server, ClientPipe& client)
+    {
+        const int server_err = server.start([this](const ServerPipe::Event::Var& event) {
+            //
+            if (const auto* const connected = cetl::get_if<ServerPipe::Event::Connected>(&event))
+            {
+                client_id_ = connected->client_id;
+            }
+            else if (const auto* const message = cetl::get_if<ServerPipe::Event::Message>(&event))
+            {
+                server_messages_.emplace_back(message->payload.begin(), message->payload.end());
+            }
+            return 0;
+        });
+        const int client_err = client.start([this](const ClientPipe::Event::Var& event) {
+            //
+            if (cetl::holds_alternative<ClientPipe::Event::Connected>(event))
+            {
+                is_client_connected_ = true;
+            }
+            else if (const auto* const message = cetl::get_if<ClientPipe::Event::Message>(&event))
+            {
+                client_messages_.emplace_back(message->payload.begin(), message->payload.end());
+            }
+            return 0;
+        });
+        EXPECT_THAT(server_err, 0);
+        EXPECT_THAT(client_err, 0);
+
+        return spinUntil([this] { return is_client_connected_ && (client_id_ != 0); });
+    }
+
+    /// Spins the executor (and polls its sockets) until the condition is met, or the timeout is reached.
+    ///
+    bool spinUntil(const std::function<bool()>& condition, const libcyphal::Duration timeout = 5s)
+    {
+        const auto deadline = executor_.now() + timeout;
+        while (!condition())
+        {
+            if (executor_.now() >= deadline)
+            {
+                return false;
+            }
+            (void) executor_.spinOnce();
+            (void) executor_.pollAwaitableResourcesFor(cetl::make_optional<libcyphal::Duration>(10ms));
+        }
+        return true;
+    }
+
+    /// Makes a message of the given size, where each byte depends on the message index (and the byte position),
+    /// so that any lost, duplicated or shifted byte is detected.
+    ///
+    static Message makeMessage(const std::size_t index, const std::size_t size)
+    {
+        Message message(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            message[i] = static_cast<std::uint8_t>((index * 31U) + (i * 7U) + (i >> 8U));
+        }
+        return message;
+    }
+
+    /// Sends the message as two fragments - like the router does (a route prefix and a payload).
+    ///
+    /// If `can_queue` is false then the message is sent as if by a channel with back-pressure enabled.
+    ///
+    static int send(ServerPipe&                server,
+                    const ServerPipe::ClientId client_id,
+                    const Message&             message,
+                    const bool                 can_queue = true)
+    {
+        const auto                   half = message.size() / 2;
+        const std::array<Payload, 2> payloads{Payload{message.data(), half},
+                                              Payload{message.data() + half, message.size() - half}};
+        return can_queue ? server.send(client_id, {payloads.data(), payloads.size()})
+                         : server.trySend(client_id, {payloads.data(), payloads.size()});
+    }
+
+    /// Sends messages (without spinning - so the client doesn't read anything) until the socket would block.
+    ///
+    /// Message size is not a multiple of anything, so the last accepted message is most likely written
+    /// only partially - its rest is flushed later, and the next message is not accepted until then.
+    ///
+    std::vector<Message> saturate(ServerPipe& server, const std::size_t first_index)
+    {
+        constexpr std::size_t MessageSize = 65537;
+
+        std::vector<Message> sent;
+        int                  err = 0;
+        while ((err == 0) && (sent.size() < 1000))
+        {
+            auto message = makeMessage(first_index + sent.size(), MessageSize);
+            err          = send(server, client_id_, message, false);
+            if (err == 0)
+            {
+                sent.push_back(std::move(message));
+            }
+        }
+        EXPECT_THAT((err == EAGAIN) || (err == EWOULDBLOCK), IsTrue());
+        EXPECT_THAT(sent, SizeIs(Gt(0)));
+        return sent;
+    }
+
+    static int send(ClientPipe& client, const Message& message)
+    {
+        const std::array<Payload, 1> payloads{Payload{message.data(), message.size()}};
+        return client.send({payloads.data(), payloads.size()});
+    }
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    ocvsmd::platform::SingleThreadedExecutor executor_;
+    std::string                              socket_path_;
+    ServerPipe::ClientId                     client_id_{0};
+    bool                                     is_client_connected_{false};
+    std::vector<Message>                     server_messages_;
+    std::vector<Message>                     client_messages_;
+    // NOLINTEND
+};
+
+// MARK: - Tests:
+
+TEST_F(TestSocketPipe, round_trip)
+{
+    SocketServer server{executor_, makeAddress()};
+    SocketClient client{executor_, makeAddress()};
+    ASSERT_THAT(connect(server, client), IsTrue());
+
+    const auto request = makeMessage(1, 13);
+    EXPECT_THAT(send(client, request), 0);
+    ASSERT_THAT(spinUntil([this] { return !server_messages_.empty(); }), IsTrue());
+    EXPECT_THAT(server_messages_, ElementsAre(request));
+
+    const auto response = makeMessage(2, 1000);
+    EXPECT_THAT(send(server, client_id_, response), 0);
+    ASSERT_THAT(spinUntil([this] { return !client_messages_.empty(); }), IsTrue());
+    EXPECT_THAT(client_messages_, ElementsAre(response));
+}
+
+TEST_F(TestSocketPipe, saturated_socket)
+{
+    SocketServer server{executor_, makeAddress()};
+    SocketClient client{executor_, makeAddress()};
+    ASSERT_THAT(connect(server, client), IsTrue());
+
+    const auto sent = saturate(server, 0);
+    ASSERT_THAT(sent, SizeIs(Gt(0)));
+
+    // The client receives all accepted messages intact, and in order.
+    ASSERT_THAT(spinUntil([this, &sent] { return client_messages_.size() >= sent.size(); }), IsTrue());
+    EXPECT_THAT(client_messages_.size(), sent.size());
+    for (std::size_t i = 0; i < sent.size(); ++i)
+    {
+        EXPECT_THAT(client_messages_[i] == sent[i], IsTrue()) << "message #" << i;
+    }
+
+    // The stream is still in sync - so the connection is still usable.
+    client_messages_.clear();
+    const auto last = makeMessage(1000, 42);
+    EXPECT_THAT(send(server, client_id_, last), 0);
+    ASSERT_THAT(spinUntil([this] { return !client_messages_.empty(); }), IsTrue());
+    EXPECT_THAT(client_messages_, ElementsAre(last));
+}
+
+TEST_F(TestSocketPipe, saturated_socket_queues_other_channels)
+{
+    SocketServer server{executor_, makeAddress()};
+    SocketClient client{executor_, makeAddress()};
+    ASSERT_THAT(connect(server, client), IsTrue());
+
+    // One (back-pressured) channel saturates the socket.
+    auto sent = saturate(server, 0);
+    ASSERT_THAT(sent, SizeIs(Gt(0)));
+
+    // Still, messages of another channel are not refused - they are queued behind the pending ones,
+    // while the back-pressured channel keeps seeing `EAGAIN`.
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        auto other = makeMessage(2000 + i, 13 + i);
+        EXPECT_THAT(send(server, client_id_, other), 0);
+        sent.push_back(std::move(other));
+    }
+    const auto refused = makeMessage(3000, 42);
+    EXPECT_THAT(send(server, client_id_, refused, false), EAGAIN);
+
+    // The client receives all accepted messages intact, and in order.
+    ASSERT_THAT(spinUntil([this, &sent] { return client_messages_.size() >= sent.size(); }), IsTrue());
+    EXPECT_THAT(client_messages_.size(), sent.size());
+    for (std::size_t i = 0; i < sent.size(); ++i)
+    {
+        EXPECT_THAT(client_messages_[i] == sent[i], IsTrue()) << "message #" << i;
+    }
+
+    // The queue is bounded - once it's full, messages are refused even without back-pressure.
+    (void) saturate(server, 4000);
+    const auto big = makeMessage(5000, 512 * 1024);
+    int        err = 0;
+    for (std::size_t i = 0; (err == 0) && (i < 10); ++i)
+    {
+        err = send(server, client_id_, big);
+    }
+    EXPECT_THAT(err, ENOBUFS);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
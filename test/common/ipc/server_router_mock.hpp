@@ -0,0 +1,98 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_COMMON_IPC_SERVER_ROUTER_MOCK_HPP_INCLUDED
+#define OCVSMD_COMMON_IPC_SERVER_ROUTER_MOCK_HPP_INCLUDED
+
+#include "ipc/server_router.hpp"
+
+#include "dsdl_helpers.hpp"
+#include "ipc/channel.hpp"
+#include "ipc/gateway.hpp"
+#include "ipc/ipc_types.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+
+#include <gmock/gmock.h>
+
+#include <unordered_map>
+#include <utility>
+
+namespace ocvsmd
+{
+namespace common
+{
+namespace ipc
+{
+
+/// Mocks the IPC server router - it just collects factories of registered service channels.
+///
+/// A test then emulates a new channel (from a client) by passing a gateway (see `detail::GatewayMock`)
+/// and the initial request to the factory of the service - exactly as the real router does.
+///
+class ServerRouterMock : public ServerRouter
+{
+public:
+    explicit ServerRouterMock(cetl::pmr::memory_resource& memory)
+        : memory_{memory}
+    {
+    }
+
+    MOCK_METHOD(int, start, (), (override));
+
+    cetl::pmr::memory_resource& memory() override
+    {
+        return memory_;
+    }
+
+    /// Says whether a service with the given name is registered.
+    ///
+    template <typename Input>
+    bool isRegistered(const cetl::string_view service_name) const
+    {
+        const auto svc_desc = AnyChannel::getServiceDesc<Input>(service_name);
+        return id_to_factory_.find(svc_desc.id) != id_to_factory_.end();
+    }
+
+    /// Emulates a new channel of the given service (with the given initial request) from a client.
+    ///
+    /// @return `false` if the service is not registered, or the request couldn't be serialized.
+    ///
+    template <typename Input>
+    bool emulateNewChannel(const cetl::string_view service_name, detail::Gateway::Ptr gateway, const Input& request)
+    {
+        const auto svc_desc = AnyChannel::getServiceDesc<Input>(service_name);
+        const auto found    = id_to_factory_.find(svc_desc.id);
+        if (found == id_to_factory_.end())
+        {
+            return false;
+        }
+        // Copy, so that the factory could even re-register services.
+        const auto factory = found->second;
+        const int result = tryPerformOnSerialized(request, [&factory, &gateway](const auto payload) {
+            //
+            factory(std::move(gateway), payload);
+            return 0;
+        });
+        return 0 == result;
+    }
+
+private:
+    void registerChannelFactory(const detail::ServiceDesc service_desc,
+                                TypeErasedChannelFactory  channel_factory) override
+    {
+        id_to_factory_[service_desc.id] = std::move(channel_factory);
+    }
+
+    cetl::pmr::memory_resource&                                           memory_;
+    std::unordered_map<detail::ServiceDesc::Id, TypeErasedChannelFactory> id_to_factory_;
+
+};  // ServerRouterMock
+
+}  // namespace ipc
+}  // namespace common
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_COMMON_IPC_SERVER_ROUTER_MOCK_HPP_INCLUDED
@@ -261,6 +261,71 @@ TEST_F(TestClientRouter, makeChannel_receive_events)
     client_pipe_mock.event_handler_(pipe::ClientPipe::Event::Disconnected{});
 }
 
+TEST_F(TestClientRouter, makeChannel_resumption)
+{
+    using Msg     = ocvsmd::common::svc::node::ExecCmdSvcRequest_0_1;
+    using Channel = Channel<Msg, Msg>;
+
+    StrictMock<pipe::ClientPipeMock> client_pipe_mock;
+    EXPECT_CALL(client_pipe_mock, deinit()).Times(1);
+
+    const auto client_router = ClientRouter::make(  //
+        mr_,
+        std::make_unique<pipe::ClientPipeMock::RefWrapper>(client_pipe_mock));
+    ASSERT_THAT(client_router, NotNull());
+
+    EXPECT_CALL(client_pipe_mock, start(_)).Times(1);
+    EXPECT_THAT(client_router->start(), 0);
+
+    StrictMock<MockFunction<void(const Channel::EventVar&)>> ch1_event_mock;
+    StrictMock<MockFunction<void(const Channel::EventVar&)>> ch2_event_mock;
+    StrictMock<MockFunction<void(const Channel::EventVar&)>> ch3_event_mock;
+
+    // #1 is resumable and used; #2 is resumable but never used; #3 is not resumable.
+    //
+    auto channel1 = client_router->makeChannel<Channel>();
+    channel1.enableResumption();
+    channel1.subscribe(ch1_event_mock.AsStdFunction());
+    auto channel2 = client_router->makeChannel<Channel>();
+    channel2.enableResumption();
+    channel2.subscribe(ch2_event_mock.AsStdFunction());
+    auto channel3 = client_router->makeChannel<Channel>();
+    channel3.subscribe(ch3_event_mock.AsStdFunction());
+
+    EXPECT_CALL(ch1_event_mock, Call(VariantWith<Channel::Connected>(_))).Times(1);
+    EXPECT_CALL(ch2_event_mock, Call(VariantWith<Channel::Connected>(_))).Times(1);
+    EXPECT_CALL(ch3_event_mock, Call(VariantWith<Channel::Connected>(_))).Times(1);
+    emulateRouteConnect(client_pipe_mock);
+
+    const Msg msg{&mr_};
+    EXPECT_CALL(client_pipe_mock, send(PayloadOfRouteChannelMsg(msg, mr_, 0, 0)))  //
+        .WillOnce(Return(0));
+    EXPECT_THAT(channel1.send(msg), 0);
+    EXPECT_CALL(client_pipe_mock, send(PayloadOfRouteChannelMsg(msg, mr_, 2, 0)))  //
+        .WillOnce(Return(0));
+    EXPECT_THAT(channel3.send(msg), 0);
+
+    // Emulate that the pipe is disconnected - only the non-resumable channel should be completed.
+    //
+    EXPECT_CALL(ch3_event_mock, Call(VariantWith<Channel::Completed>(_))).Times(1);
+    client_pipe_mock.event_handler_(pipe::ClientPipe::Event::Disconnected{});
+    EXPECT_THAT(channel1.send(msg), static_cast<int>(ErrorCode::NotConnected));
+
+    // Emulate reconnection - the used channel should be resumed, and the unused one just connected.
+    //
+    EXPECT_CALL(ch1_event_mock, Call(VariantWith<Channel::Resumed>(_))).Times(1);
+    EXPECT_CALL(ch2_event_mock, Call(VariantWith<Channel::Connected>(_))).Times(1);
+    emulateRouteConnect(client_pipe_mock);
+
+    // The resumed channel starts its sequence from scratch.
+    EXPECT_CALL(client_pipe_mock, send(PayloadOfRouteChannelMsg(msg, mr_, 0, 0)))  //
+        .WillOnce(Return(0));
+    EXPECT_THAT(channel1.send(msg), 0);
+
+    EXPECT_CALL(client_pipe_mock, send(PayloadOfRouteChannelEnd(mr_, 0, ErrorCode::Success)))  //
+        .WillOnce(Return(0));
+}
+
 // NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
 
 }  // namespace
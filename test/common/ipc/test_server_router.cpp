@@ -20,6 +20,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <cerrno>
 #include <cstdint>
 #include <iterator>
 #include <memory>
@@ -231,6 +232,91 @@ TEST_F(TestServerRouter, channel_send)
     EXPECT_THAT(maybe_channel->send(msg), 0);  // NOLINT
 }
 
+TEST_F(TestServerRouter, channel_send_with_back_pressure)
+{
+    using Msg     = ocvsmd::common::svc::node::ExecCmdSvcRequest_0_1;
+    using Channel = Channel<Msg, Msg>;
+
+    StrictMock<pipe::ServerPipeMock> server_pipe_mock;
+    EXPECT_CALL(server_pipe_mock, deinit()).Times(1);
+
+    const auto server_router = ServerRouter::make(  //
+        mr_,
+        std::make_unique<pipe::ServerPipeMock::RefWrapper>(server_pipe_mock));
+    ASSERT_THAT(server_router, NotNull());
+
+    EXPECT_CALL(server_pipe_mock, start(_)).Times(1);
+    EXPECT_THAT(server_router->start(), 0);
+
+    cetl::optional<Channel> maybe_channel;
+    server_router->registerChannel<Channel>("", [&](Channel&& ch, const auto&) {
+        //
+        ch.subscribe(nullptr);
+        maybe_channel = std::move(ch);
+    });
+
+    constexpr std::uint64_t cl_id = 42;
+    emulateRouteConnect(cl_id, server_pipe_mock);
+
+    const std::uint64_t tag = 7;
+    std::uint64_t       seq = 0;
+    emulateRouteChannelMsg(cl_id, server_pipe_mock, tag, Channel::Input{&mr_}, seq);
+    ASSERT_THAT(maybe_channel.has_value(), IsTrue());
+    EXPECT_CALL(server_pipe_mock, send(cl_id, PayloadOfRouteChannelEnd(mr_, tag, ErrorCode::Success)))  //
+        .WillOnce(Return(0));
+
+    // By default, a busy pipe queues messages on its own.
+    seq = 0;
+    const Channel::Output msg{&mr_};
+    EXPECT_CALL(server_pipe_mock, send(cl_id, PayloadOfRouteChannelMsg(msg, mr_, tag, seq++)))  //
+        .WillOnce(Return(0));
+    EXPECT_THAT(maybe_channel->send(msg), 0);  // NOLINT
+
+    // With back-pressure enabled, the pipe could refuse messages - and the channel sees it.
+    // The refused message doesn't take its sequence number - the same one is used on retry.
+    maybe_channel->enableBackPressure();  // NOLINT
+    EXPECT_CALL(server_pipe_mock, trySend(cl_id, PayloadOfRouteChannelMsg(msg, mr_, tag, seq)))  //
+        .WillOnce(Return(EAGAIN))
+        .WillOnce(Return(0));
+    EXPECT_THAT(maybe_channel->send(msg), EAGAIN);  // NOLINT
+    EXPECT_THAT(maybe_channel->send(msg), 0);       // NOLINT
+}
+
+TEST_F(TestServerRouter, channel_to_unknown_service)
+{
+    using Msg     = ocvsmd::common::svc::node::ExecCmdSvcRequest_0_1;
+    using Channel = Channel<Msg, Msg>;
+
+    StrictMock<pipe::ServerPipeMock> server_pipe_mock;
+    EXPECT_CALL(server_pipe_mock, deinit()).Times(1);
+
+    const auto server_router = ServerRouter::make(  //
+        mr_,
+        std::make_unique<pipe::ServerPipeMock::RefWrapper>(server_pipe_mock));
+    ASSERT_THAT(server_router, NotNull());
+
+    EXPECT_CALL(server_pipe_mock, start(_)).Times(1);
+    EXPECT_THAT(server_router->start(), 0);
+
+    StrictMock<MockFunction<void(const Channel::EventVar&)>> ch_event_mock;
+    server_router->registerChannel<Channel>("svc@udp", [&](Channel&&, const auto& input) {
+        //
+        ch_event_mock.Call(input);
+    });
+
+    constexpr std::uint64_t cl_id = 42;
+    emulateRouteConnect(cl_id, server_pipe_mock);
+
+    // Emulate that client posted initial `RouteChannelMsg` to a service which is not registered.
+    // The channel is ended right away (instead of leaving the client waiting forever).
+    //
+    const std::uint64_t tag = 7;
+    std::uint64_t       seq = 0;
+    EXPECT_CALL(server_pipe_mock, send(cl_id, PayloadOfRouteChannelEnd(mr_, tag, ErrorCode::UnknownService)))  //
+        .WillOnce(Return(0));
+    emulateRouteChannelMsg(cl_id, server_pipe_mock, tag, Channel::Input{&mr_}, seq, "svc@can");
+}
+
 // NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
 
 }  // namespace
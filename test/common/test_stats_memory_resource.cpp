@@ -0,0 +1,114 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "stats_memory_resource.hpp"
+
+#include "tracking_memory_resource.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+
+namespace
+{
+
+using ocvsmd::common::StatsMemoryResource;
+
+using testing::IsEmpty;
+using testing::NotNull;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestStatsMemoryResource : public testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        EXPECT_THAT(mr_.allocations, IsEmpty());
+        EXPECT_THAT(mr_.total_allocated_bytes, mr_.total_deallocated_bytes);
+    }
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    ocvsmd::TrackingMemoryResource mr_;
+    // NOLINTEND
+};
+
+// MARK: - Tests:
+
+TEST_F(TestStatsMemoryResource, allocate_deallocate)
+{
+    StatsMemoryResource stats_mr{"test", mr_};
+    EXPECT_THAT(stats_mr.name(), "test");
+    EXPECT_THAT(stats_mr.stats().allocated_bytes, 0);
+
+    void* const ptr1 = stats_mr.allocate(16);
+    ASSERT_THAT(ptr1, NotNull());
+    void* const ptr2 = stats_mr.allocate(32);
+    ASSERT_THAT(ptr2, NotNull());
+    EXPECT_THAT(stats_mr.stats().allocated_bytes, 48);
+    EXPECT_THAT(stats_mr.stats().peak_allocated_bytes, 48);
+    EXPECT_THAT(stats_mr.stats().allocations, 2);
+    EXPECT_THAT(mr_.allocated_bytes, 48);
+
+    stats_mr.deallocate(ptr1, 16);
+    EXPECT_THAT(stats_mr.stats().allocated_bytes, 32);
+    EXPECT_THAT(stats_mr.stats().peak_allocated_bytes, 48);
+    EXPECT_THAT(stats_mr.stats().deallocations, 1);
+
+    stats_mr.deallocate(ptr2, 32);
+    EXPECT_THAT(stats_mr.stats().allocated_bytes, 0);
+    EXPECT_THAT(stats_mr.stats().peak_allocated_bytes, 48);
+    EXPECT_THAT(stats_mr.stats().allocations, 2);
+    EXPECT_THAT(stats_mr.stats().deallocations, 2);
+    EXPECT_THAT(stats_mr.stats().failed_allocations, 0);
+}
+
+TEST_F(TestStatsMemoryResource, allocate_failure)
+{
+    // Upstream which never throws but always fails to allocate.
+    class FailingMemoryResource final : public cetl::pmr::memory_resource
+    {
+        void* do_allocate(std::size_t, std::size_t) override
+        {
+            return nullptr;
+        }
+        void do_deallocate(void*, std::size_t, std::size_t) override {}
+#if (__cplusplus < CETL_CPP_STANDARD_17)
+        void* do_reallocate(void*, std::size_t, std::size_t, std::size_t) override
+        {
+            return nullptr;
+        }
+#endif
+        bool do_is_equal(const cetl::pmr::memory_resource& rhs) const noexcept override
+        {
+            return (&rhs == this);
+        }
+    } failing_mr;
+
+    StatsMemoryResource stats_mr{"test", failing_mr};
+
+    EXPECT_THAT(stats_mr.allocate(16), nullptr);
+    EXPECT_THAT(stats_mr.stats().allocated_bytes, 0);
+    EXPECT_THAT(stats_mr.stats().allocations, 0);
+    EXPECT_THAT(stats_mr.stats().failed_allocations, 1);
+}
+
+TEST_F(TestStatsMemoryResource, is_equal)
+{
+    const StatsMemoryResource stats_mr1{"test1", mr_};
+    const StatsMemoryResource stats_mr2{"test2", mr_};
+
+    EXPECT_TRUE(stats_mr1.is_equal(stats_mr1));
+    EXPECT_FALSE(stats_mr1.is_equal(stats_mr2));
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
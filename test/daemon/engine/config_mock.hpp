@@ -0,0 +1,65 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_DAEMON_ENGINE_CONFIG_MOCK_HPP_INCLUDED
+#define OCVSMD_DAEMON_ENGINE_CONFIG_MOCK_HPP_INCLUDED
+
+#include "config.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+
+class ConfigMock : public Config
+{
+public:
+    MOCK_METHOD(void, save, (), (override));
+
+    MOCK_METHOD(cetl::optional<CyphalApp::NodeId>, getCyphalAppNodeId, (), (const, override));
+    MOCK_METHOD(cetl::optional<CyphalApp::UniqueId>, getCyphalAppUniqueId, (), (const, override));
+    MOCK_METHOD(void, setCyphalAppUniqueId, (const CyphalApp::UniqueId& unique_id), (override));
+    MOCK_METHOD(cetl::optional<std::string>, getCyphalAppTransferIdMapFile, (), (const, override));
+
+    MOCK_METHOD(std::vector<std::string>, getCyphalTransportInterfaces, (), (const, override));
+    MOCK_METHOD(cetl::optional<std::uint32_t>, getCyphalTransportCanMaxFilters, (), (const, override));
+
+    MOCK_METHOD(std::vector<std::string>, getFileServerRoots, (), (const, override));
+    MOCK_METHOD(void, setFileServerRoots, (const std::vector<std::string>& roots), (override));
+
+    MOCK_METHOD(std::vector<std::string>, getIpcConnections, (), (const, override));
+
+    MOCK_METHOD(cetl::optional<std::uint32_t>, getSvcExecCmdMaxInFlightPerRequest, (), (const, override));
+    MOCK_METHOD(cetl::optional<std::uint32_t>, getSvcExecCmdMaxInFlight, (), (const, override));
+    MOCK_METHOD(cetl::optional<std::chrono::microseconds>, getSvcExecCmdRequestSpacing, (), (const, override));
+
+    MOCK_METHOD(cetl::optional<std::uint32_t>, getSvcRegistersCacheCapacity, (), (const, override));
+
+    MOCK_METHOD(cetl::optional<std::uint32_t>, getSvcRawRpcClientMaxClients, (), (const, override));
+    MOCK_METHOD(cetl::optional<std::uint32_t>, getSvcRawRpcClientMaxClientsBytes, (), (const, override));
+
+    MOCK_METHOD(cetl::optional<std::string>, getLoggingFile, (), (const, override));
+    MOCK_METHOD(cetl::optional<std::string>, getLoggingLevel, (), (const, override));
+    MOCK_METHOD(cetl::optional<std::string>, getLoggingFlushLevel, (), (const, override));
+    MOCK_METHOD(cetl::optional<std::chrono::seconds>, getLoggingStatsPeriod, (), (const, override));
+
+};  // ConfigMock
+
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_DAEMON_ENGINE_CONFIG_MOCK_HPP_INCLUDED
@@ -0,0 +1,191 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "cyphal/client_cache.hpp"
+
+#include "virtual_time_scheduler.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/types.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+using testing::Ne;
+using testing::IsTrue;
+using testing::NotNull;
+using testing::ElementsAre;
+
+using std::literals::chrono_literals::operator""s;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestClientCache : public testing::Test
+{
+protected:
+    using Client  = std::shared_ptr<int>;
+    using Failure = int;
+    using Result  = cetl::variant<Client, Failure>;
+    using Cache   = ocvsmd::daemon::engine::cyphal::ClientCache<int, Client>;
+
+    /// Gets the client of the key (which is also the client's value) - either the cached one, or a new one.
+    /// Keys of all newly made clients are collected (so that cache misses are visible to the test).
+    ///
+    Client get(Cache& cache, const int key, const std::size_t cost = 0)
+    {
+        auto result = cache.getOrMake(key, cost, [this, key] {
+            //
+            made_.push_back(key);
+            return Result{std::make_shared<int>(key)};
+        });
+        EXPECT_THAT(cetl::holds_alternative<Client>(result), IsTrue());
+        return cetl::get<Client>(result);
+    }
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    libcyphal::VirtualTimeScheduler scheduler_{};
+    std::vector<int>                made_;
+    // NOLINTEND
+};
+
+// MARK: - Tests:
+
+TEST_F(TestClientCache, getOrMake)
+{
+    const auto cache = Cache::make(scheduler_, 8, 10s);
+    ASSERT_THAT(cache, NotNull());
+
+    const auto client_a = get(*cache, 1);
+    EXPECT_THAT(get(*cache, 1), client_a);  // The same (cached) client.
+    EXPECT_THAT(get(*cache, 2), Ne(client_a));
+    EXPECT_THAT(made_, ElementsAre(1, 2));
+    EXPECT_THAT(cache->size(), 2);
+
+    // Failures are returned as is, and are not cached.
+    const auto result = cache->getOrMake(3, [] { return Result{Failure{42}}; });
+    ASSERT_THAT(cetl::holds_alternative<Failure>(result), IsTrue());
+    EXPECT_THAT(cetl::get<Failure>(result), 42);
+    EXPECT_THAT(cache->size(), 2);
+    (void) get(*cache, 3);
+    EXPECT_THAT(made_, ElementsAre(1, 2, 3));
+}
+
+TEST_F(TestClientCache, capacity)
+{
+    const auto cache = Cache::make(scheduler_, 2, 10s);
+    ASSERT_THAT(cache, NotNull());
+
+    (void) get(*cache, 1);
+    (void) get(*cache, 2);
+    (void) get(*cache, 1);  // Refreshes the 1st one - so the 2nd one becomes the least recently used.
+    (void) get(*cache, 3);
+    EXPECT_THAT(cache->size(), 2);
+    EXPECT_THAT(made_, ElementsAre(1, 2, 3));
+
+    // The 1st and 3rd ones are still cached, but the 2nd one is made again (and evicts the 1st one).
+    (void) get(*cache, 1);
+    (void) get(*cache, 3);
+    (void) get(*cache, 2);
+    (void) get(*cache, 3);
+    (void) get(*cache, 1);
+    EXPECT_THAT(made_, ElementsAre(1, 2, 3, 2, 1));
+    EXPECT_THAT(cache->size(), 2);
+
+    // Zero capacity is treated as one.
+    const auto tiny_cache = Cache::make(scheduler_, 0, 10s);
+    ASSERT_THAT(tiny_cache, NotNull());
+    (void) get(*tiny_cache, 7);
+    (void) get(*tiny_cache, 7);
+    EXPECT_THAT(tiny_cache->size(), 1);
+    EXPECT_THAT(made_, ElementsAre(1, 2, 3, 2, 1, 7));
+}
+
+TEST_F(TestClientCache, cost_budget)
+{
+    const auto cache = Cache::make(scheduler_, 8, 10s, 100);
+    ASSERT_THAT(cache, NotNull());
+
+    (void) get(*cache, 1, 60);
+    (void) get(*cache, 2, 30);
+    EXPECT_THAT(cache->totalCost(), 90);
+
+    // Least recently used clients are evicted until the new one fits into the budget.
+    (void) get(*cache, 3, 50);
+    EXPECT_THAT(cache->size(), 2);
+    EXPECT_THAT(cache->totalCost(), 80);
+
+    // A hit doesn't change the cost.
+    (void) get(*cache, 2, 1000);
+    EXPECT_THAT(cache->totalCost(), 80);
+    EXPECT_THAT(made_, ElementsAre(1, 2, 3));
+
+    // Too expensive client evicts all the others, but is still cached itself.
+    (void) get(*cache, 4, 200);
+    EXPECT_THAT(cache->size(), 1);
+    EXPECT_THAT(cache->totalCost(), 200);
+    (void) get(*cache, 4, 200);
+    EXPECT_THAT(made_, ElementsAre(1, 2, 3, 4));
+}
+
+TEST_F(TestClientCache, idle_eviction)
+{
+    const auto cache = Cache::make(scheduler_, 8, 10s);
+    ASSERT_THAT(cache, NotNull());
+
+    (void) get(*cache, 1);
+    scheduler_.spinFor(5s);
+    (void) get(*cache, 2);
+
+    // The periodic check (at the 10th second) evicts only clients which were idle for the whole timeout.
+    scheduler_.spinFor(6s);
+    EXPECT_THAT(cache->size(), 1);
+
+    // Usage refreshes the client - so the next check (at the 20th second) keeps it.
+    (void) get(*cache, 2);
+    scheduler_.spinFor(10s);
+    EXPECT_THAT(cache->size(), 1);
+    scheduler_.spinFor(10s);
+    EXPECT_THAT(cache->size(), 0);
+    EXPECT_THAT(made_, ElementsAre(1, 2));
+}
+
+TEST_F(TestClientCache, evict)
+{
+    const auto cache = Cache::make(scheduler_, 8, 10s);
+    ASSERT_THAT(cache, NotNull());
+
+    const auto client_a = get(*cache, 1, 10);
+    (void) get(*cache, 2, 20);
+    EXPECT_THAT(client_a.use_count(), 2);
+
+    // Eviction just drops the cache's reference - the client is still usable by its current holders.
+    cache->evict(1);
+    EXPECT_THAT(cache->size(), 1);
+    EXPECT_THAT(cache->totalCost(), 20);
+    EXPECT_THAT(client_a.use_count(), 1);
+
+    cache->evict(1);
+    cache->evict(3);
+    EXPECT_THAT(cache->size(), 1);
+    EXPECT_THAT(cache->totalCost(), 20);
+
+    // The next usage makes a fresh client.
+    EXPECT_THAT(get(*cache, 1, 10), Ne(client_a));
+    EXPECT_THAT(made_, ElementsAre(1, 2, 1));
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
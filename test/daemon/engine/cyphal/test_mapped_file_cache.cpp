@@ -0,0 +1,180 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "cyphal/mapped_file_cache.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+
+using ocvsmd::daemon::engine::cyphal::MappedFileCache;
+
+using testing::SizeIs;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestMappedFileCache : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        base_dir_ = testing::TempDir() + "ocvsmd_test_mapped_file_cache_" + std::to_string(::getpid());
+        root1_    = base_dir_ + "/root1";
+        root2_    = base_dir_ + "/root2";
+        (void) ::mkdir(base_dir_.c_str(), S_IRWXU);
+        (void) ::mkdir(root1_.c_str(), S_IRWXU);
+        (void) ::mkdir(root2_.c_str(), S_IRWXU);
+        (void) ::mkdir((root2_ + "/dir").c_str(), S_IRWXU);
+    }
+
+    void TearDown() override
+    {
+        for (const auto& file : written_files_)
+        {
+            (void) std::remove(file.c_str());
+        }
+        (void) ::rmdir((root2_ + "/dir").c_str());
+        (void) ::rmdir(root2_.c_str());
+        (void) ::rmdir(root1_.c_str());
+        (void) ::rmdir(base_dir_.c_str());
+    }
+
+    void writeFile(const std::string& file_path, const std::string& content)
+    {
+        // Replace (not overwrite) the file - like a build system would do.
+        (void) std::remove(file_path.c_str());
+        std::ofstream stream{file_path, std::ios::binary};
+        stream << content;
+        written_files_.push_back(file_path);
+    }
+
+    static std::string contentOf(const MappedFileCache::FindResult& result)
+    {
+        const auto* const file = cetl::get_if<MappedFileCache::File>(&result);
+        if (file == nullptr)
+        {
+            return "<error>";
+        }
+        return {reinterpret_cast<const char*>(file->data), file->size};  // NOLINT
+    }
+
+    static int errorOf(const MappedFileCache::FindResult& result)
+    {
+        const auto* const err = cetl::get_if<int>(&result);
+        return (err != nullptr) ? *err : 0;
+    }
+
+    std::string              base_dir_;
+    std::string              root1_;
+    std::string              root2_;
+    std::vector<std::string> written_files_;
+};
+
+// MARK: - Tests:
+
+TEST_F(TestMappedFileCache, find_first_root_wins)
+{
+    writeFile(root1_ + "/a.bin", "root1-a");
+    writeFile(root2_ + "/a.bin", "root2-a");
+    writeFile(root2_ + "/b.bin", "root2-b");
+
+    MappedFileCache cache{{root1_, base_dir_ + "/missing", root2_}, 4, 4};
+    EXPECT_THAT(cache.roots(), SizeIs(2));
+
+    EXPECT_THAT(contentOf(cache.find("a.bin", false)), "root1-a");
+    EXPECT_THAT(contentOf(cache.find("/b.bin", false)), "root2-b");
+    EXPECT_THAT(errorOf(cache.find("c.bin", false)), ENOENT);
+    EXPECT_THAT(errorOf(cache.find("dir", false)), EISDIR);
+    EXPECT_THAT(errorOf(cache.find("", false)), EISDIR);
+    EXPECT_THAT(cache.mappedFilesCount(), 2);
+}
+
+TEST_F(TestMappedFileCache, find_does_not_escape_roots)
+{
+    writeFile(base_dir_ + "/secret.bin", "secret");
+
+    MappedFileCache cache{{root1_}, 4, 4};
+    EXPECT_THAT(errorOf(cache.find("../secret.bin", false)), ENOENT);
+    EXPECT_THAT(errorOf(cache.find("/../secret.bin", false)), ENOENT);
+}
+
+TEST_F(TestMappedFileCache, revalidate_replaced_file)
+{
+    writeFile(root1_ + "/fw.bin", "v1");
+
+    MappedFileCache cache{{root1_}, 4, 4};
+    EXPECT_THAT(contentOf(cache.find("fw.bin", true)), "v1");
+
+    // Without revalidation the cached mapping (of the old file version) is served.
+    writeFile(root1_ + "/fw.bin", "v2-longer");
+    EXPECT_THAT(contentOf(cache.find("fw.bin", false)), "v1");
+    EXPECT_THAT(contentOf(cache.find("fw.bin", true)), "v2-longer");
+
+    // Removed file is not found anymore (on revalidation).
+    (void) std::remove((root1_ + "/fw.bin").c_str());
+    EXPECT_THAT(errorOf(cache.find("fw.bin", true)), ENOENT);
+
+    writeFile(root1_ + "/empty.bin", "");
+    EXPECT_THAT(contentOf(cache.find("empty.bin", false)), "");
+}
+
+TEST_F(TestMappedFileCache, modified_in_place)
+{
+    const auto file_path = root1_ + "/fw.bin";
+    writeFile(file_path, std::string(3 * 4096, 'x'));
+
+    MappedFileCache cache{{root1_}, 4, 4};
+    EXPECT_THAT(contentOf(cache.find("fw.bin", true)), SizeIs(3 * 4096));
+
+    // The file is truncated in place (not replaced) in the middle of a download - so even without revalidation
+    // the view is clamped to the new size (touching the old mapping past the new end of the file raises SIGBUS).
+    ASSERT_THAT(::truncate(file_path.c_str(), 100), 0);
+    EXPECT_THAT(contentOf(cache.find("fw.bin", false)), std::string(100, 'x'));
+
+    // Appended in place - the new content is served as well.
+    {
+        std::ofstream stream{file_path, std::ios::binary | std::ios::app};
+        stream << "yz";
+    }
+    EXPECT_THAT(contentOf(cache.find("fw.bin", false)), std::string(100, 'x') + "yz");
+
+    ASSERT_THAT(::truncate(file_path.c_str(), 0), 0);
+    EXPECT_THAT(contentOf(cache.find("fw.bin", false)), "");
+    EXPECT_THAT(cache.mappedFilesCount(), 1);
+}
+
+TEST_F(TestMappedFileCache, least_recently_used_file_unmapped)
+{
+    writeFile(root1_ + "/a.bin", "a");
+    writeFile(root1_ + "/b.bin", "b");
+    writeFile(root1_ + "/c.bin", "c");
+
+    MappedFileCache cache{{root1_}, 2, 8};
+    EXPECT_THAT(contentOf(cache.find("a.bin", false)), "a");
+    EXPECT_THAT(contentOf(cache.find("b.bin", false)), "b");
+    EXPECT_THAT(contentOf(cache.find("a.bin", false)), "a");
+    EXPECT_THAT(contentOf(cache.find("c.bin", false)), "c");
+    EXPECT_THAT(cache.mappedFilesCount(), 2);
+
+    // "b" has been evicted, but it's still found (and mapped again).
+    EXPECT_THAT(contentOf(cache.find("b.bin", false)), "b");
+    EXPECT_THAT(cache.mappedFilesCount(), 2);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
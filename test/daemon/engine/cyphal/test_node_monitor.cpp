@@ -0,0 +1,274 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "cyphal/node_monitor.hpp"
+
+#include "tracking_memory_resource.hpp"
+#include "transport_emulator.hpp"
+#include "virtual_time_scheduler.hpp"
+
+#include <uavcan/node/GetInfo_1_0.hpp>
+#include <uavcan/node/Health_1_0.hpp>
+#include <uavcan/node/Heartbeat_1_0.hpp>
+#include <uavcan/node/port/List_0_1.hpp>
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/presentation/presentation.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+using ocvsmd::daemon::engine::cyphal::NodeMonitor;
+using ocvsmd::daemon::engine::cyphal::TransportEmulator;
+
+using testing::Gt;
+using testing::IsNull;
+using testing::IsTrue;
+using testing::IsEmpty;
+using testing::IsFalse;
+using testing::NotNull;
+using testing::ElementsAre;
+
+using std::literals::chrono_literals::operator""s;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestNodeMonitor : public testing::Test
+{
+protected:
+    using Health    = uavcan::node::Health_1_0;
+    using GetInfo   = uavcan::node::GetInfo_1_0;
+    using PortList  = uavcan::node::port::List_0_1;
+    using Heartbeat = NodeMonitor::Heartbeat;
+
+    NodeMonitor::Ptr makeMonitor()
+    {
+        auto monitor = NodeMonitor::make(mr_, scheduler_, presentation_);
+        EXPECT_THAT(monitor, NotNull());
+        return monitor;
+    }
+
+    bool publishHeartbeat(const cetl::optional<std::uint16_t> node_id,
+                          const std::uint32_t                 uptime,
+                          const std::uint8_t                  health = Health::NOMINAL)
+    {
+        Heartbeat heartbeat{&mr_};
+        heartbeat.uptime       = uptime;
+        heartbeat.health.value = health;
+        return transport_.publish(Heartbeat::_traits_::FixedPortId, heartbeat, node_id);
+    }
+
+    bool publishPortList(const std::uint16_t node_id, const std::vector<std::uint16_t>& publishers)
+    {
+        PortList port_list{&mr_};
+        auto&    sparse_list = port_list.publishers.set_sparse_list();
+        for (const auto subject_id : publishers)
+        {
+            sparse_list.emplace_back();
+            sparse_list.back().value = subject_id;
+        }
+        return transport_.publish(PortList::_traits_::FixedPortId, port_list, node_id);
+    }
+
+    /// Responds to the `index`-th sent request (which is expected to be a `GetInfo` one) with the node info.
+    ///
+    bool respondInfo(const std::size_t index, const std::uint16_t node_id, const char* const name)
+    {
+        const auto& requests = transport_.requests();
+        EXPECT_THAT(requests.size(), Gt(index));
+        if (requests.size() <= index)
+        {
+            return false;
+        }
+        const auto& request = requests[index];
+        EXPECT_THAT(request.service_id, GetInfo::Request::_traits_::FixedPortId);
+        EXPECT_THAT(request.server_node_id, node_id);
+
+        GetInfo::Response info{&mr_};
+        info.name = {name, name + std::strlen(name), &mr_};
+        return transport_.respond(request, info);
+    }
+
+    /// Collects IDs of nodes which have changed since the given sequence (in the order of visiting).
+    ///
+    static std::vector<std::uint16_t> changedSince(const NodeMonitor& monitor, const std::uint64_t since_sequence)
+    {
+        std::vector<std::uint16_t> node_ids;
+        monitor.visitChangedSince(since_sequence, [&node_ids](const auto& shadow) {
+            //
+            node_ids.push_back(shadow.node_id);
+        });
+        return node_ids;
+    }
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    ocvsmd::TrackingMemoryResource        mr_;
+    libcyphal::VirtualTimeScheduler       scheduler_{};
+    TransportEmulator                     transport_{mr_, scheduler_};
+    libcyphal::presentation::Presentation presentation_{mr_, scheduler_, transport_.transport()};
+    // NOLINTEND
+};
+
+// MARK: - Tests:
+
+TEST_F(TestNodeMonitor, discovery)
+{
+    const auto monitor = makeMonitor();
+    ASSERT_THAT(monitor, NotNull());
+    EXPECT_THAT(monitor->sequence(), 0);
+    EXPECT_THAT(monitor->findShadow(42), IsNull());
+
+    // The first heartbeat discovers the node, and its info is requested right away.
+    ASSERT_THAT(publishHeartbeat(42, 10), IsTrue());
+    const auto* const shadow = monitor->findShadow(42);
+    ASSERT_THAT(shadow, NotNull());
+    EXPECT_THAT(shadow->is_online, IsTrue());
+    EXPECT_THAT(shadow->sequence, 1);
+    EXPECT_THAT(shadow->boot_sequence, 1);
+    EXPECT_THAT(shadow->info.has_value(), IsFalse());
+    EXPECT_THAT(monitor->sequence(), 1);
+
+    ASSERT_THAT(respondInfo(0, 42, "node42"), IsTrue());
+    ASSERT_THAT(shadow->info.has_value(), IsTrue());
+    EXPECT_THAT(std::string(shadow->info->info.name.begin(), shadow->info->info.name.end()), "node42");
+    EXPECT_THAT(shadow->sequence, 2);
+    EXPECT_THAT(shadow->info_sequence, 2);
+    EXPECT_THAT(shadow->boot_sequence, 1);
+
+    // Uptime alone is not a significant change - unlike the health.
+    ASSERT_THAT(publishHeartbeat(42, 11), IsTrue());
+    EXPECT_THAT(monitor->sequence(), 2);
+    ASSERT_THAT(publishHeartbeat(42, 12, Health::CAUTION), IsTrue());
+    EXPECT_THAT(monitor->sequence(), 3);
+    EXPECT_THAT(shadow->sequence, 3);
+    EXPECT_THAT(shadow->info_sequence, 2);
+    EXPECT_THAT(shadow->boot_sequence, 1);
+
+    // The node has responded - so it's not requested again.
+    scheduler_.spinFor(2s);
+    EXPECT_THAT(transport_.requests().size(), 1);
+}
+
+TEST_F(TestNodeMonitor, anonymous)
+{
+    const auto monitor = makeMonitor();
+    ASSERT_THAT(monitor, NotNull());
+
+    ASSERT_THAT(publishHeartbeat(cetl::nullopt, 1), IsTrue());
+    EXPECT_THAT(monitor->hasAnonymous(), IsTrue());
+    EXPECT_THAT(monitor->sequence(), 1);
+    EXPECT_THAT(changedSince(*monitor, 0), IsEmpty());
+
+    scheduler_.spinFor(5s);
+    EXPECT_THAT(monitor->hasAnonymous(), IsFalse());
+    EXPECT_THAT(monitor->sequence(), 2);
+}
+
+TEST_F(TestNodeMonitor, restart)
+{
+    const auto monitor = makeMonitor();
+    ASSERT_THAT(monitor, NotNull());
+
+    ASSERT_THAT(publishHeartbeat(42, 100), IsTrue());
+    ASSERT_THAT(respondInfo(0, 42, "node42"), IsTrue());
+    ASSERT_THAT(publishPortList(42, {7509, 7510}), IsTrue());
+    const auto* const shadow = monitor->findShadow(42);
+    ASSERT_THAT(shadow, NotNull());
+    EXPECT_THAT(shadow->info.has_value(), IsTrue());
+    EXPECT_THAT(shadow->port_list.has_value(), IsTrue());
+    EXPECT_THAT(shadow->sequence, 3);
+    EXPECT_THAT(shadow->port_list_sequence, 3);
+
+    // Decreased uptime means the node has restarted - everything learned from it before is dropped,
+    // and its info is requested again.
+    ASSERT_THAT(publishHeartbeat(42, 5), IsTrue());
+    EXPECT_THAT(shadow->is_online, IsTrue());
+    EXPECT_THAT(shadow->sequence, 4);
+    EXPECT_THAT(shadow->boot_sequence, 4);
+    EXPECT_THAT(shadow->info_sequence, 4);
+    EXPECT_THAT(shadow->port_list_sequence, 4);
+    EXPECT_THAT(shadow->info.has_value(), IsFalse());
+    EXPECT_THAT(shadow->port_list.has_value(), IsFalse());
+    ASSERT_THAT(transport_.requests().size(), 2);
+
+    ASSERT_THAT(respondInfo(1, 42, "node42 v2"), IsTrue());
+    ASSERT_THAT(shadow->info.has_value(), IsTrue());
+    EXPECT_THAT(std::string(shadow->info->info.name.begin(), shadow->info->info.name.end()), "node42 v2");
+    EXPECT_THAT(shadow->sequence, 5);
+    EXPECT_THAT(shadow->boot_sequence, 4);
+}
+
+TEST_F(TestNodeMonitor, offline_and_back)
+{
+    const auto monitor = makeMonitor();
+    ASSERT_THAT(monitor, NotNull());
+
+    ASSERT_THAT(publishHeartbeat(42, 10), IsTrue());
+    ASSERT_THAT(respondInfo(0, 42, "node42"), IsTrue());
+    const auto* const shadow = monitor->findShadow(42);
+    ASSERT_THAT(shadow, NotNull());
+    EXPECT_THAT(shadow->sequence, 2);
+
+    // No heartbeats for longer than the offline timeout (3s) - the node goes offline (at the 4th second,
+    // by the periodic maintenance), but it's kept in the table with all its latest known information.
+    scheduler_.spinFor(3s);
+    EXPECT_THAT(shadow->is_online, IsTrue());
+    scheduler_.spinFor(2s);
+    EXPECT_THAT(shadow->is_online, IsFalse());
+    EXPECT_THAT(shadow->sequence, 3);
+    EXPECT_THAT(shadow->boot_sequence, 1);
+    EXPECT_THAT(shadow->info.has_value(), IsTrue());
+
+    // Back online (without a restart) - it's a new "boot" from the monitor's point of view,
+    // but the info is still valid, so it's not requested again.
+    ASSERT_THAT(publishHeartbeat(42, 15), IsTrue());
+    EXPECT_THAT(shadow->is_online, IsTrue());
+    EXPECT_THAT(shadow->sequence, 4);
+    EXPECT_THAT(shadow->boot_sequence, 4);
+    EXPECT_THAT(shadow->info_sequence, 2);
+    EXPECT_THAT(shadow->info.has_value(), IsTrue());
+    EXPECT_THAT(transport_.requests().size(), 1);
+}
+
+TEST_F(TestNodeMonitor, visitChangedSince_order)
+{
+    const auto monitor = makeMonitor();
+    ASSERT_THAT(monitor, NotNull());
+
+    ASSERT_THAT(publishHeartbeat(1, 10), IsTrue());
+    ASSERT_THAT(publishHeartbeat(2, 10), IsTrue());
+    ASSERT_THAT(publishHeartbeat(3, 10), IsTrue());
+    EXPECT_THAT(changedSince(*monitor, 0), ElementsAre(1, 2, 3));
+
+    const auto since_sequence = monitor->sequence();
+    EXPECT_THAT(changedSince(*monitor, since_sequence), IsEmpty());
+
+    // Shadows are visited in the order of their latest changes - not of their node IDs or discovery.
+    ASSERT_THAT(publishHeartbeat(3, 11, Health::WARNING), IsTrue());
+    ASSERT_THAT(publishHeartbeat(1, 5), IsTrue());  // restart
+    EXPECT_THAT(changedSince(*monitor, since_sequence), ElementsAre(3, 1));
+    EXPECT_THAT(changedSince(*monitor, 0), ElementsAre(2, 3, 1));
+
+    // The same node changed again is visited only once - at its latest position.
+    ASSERT_THAT(publishHeartbeat(3, 12, Health::NOMINAL), IsTrue());
+    EXPECT_THAT(changedSince(*monitor, since_sequence), ElementsAre(1, 3));
+    EXPECT_THAT(changedSince(*monitor, monitor->sequence()), IsEmpty());
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
@@ -0,0 +1,91 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "cyphal/port_index.hpp"
+#include "cyphal/port_set.hpp"
+
+#include "tracking_memory_resource.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+using ocvsmd::daemon::engine::cyphal::PortIndex;
+using ocvsmd::daemon::engine::cyphal::ServiceIdSet;
+using ocvsmd::daemon::engine::cyphal::SubjectIdSet;
+
+using testing::IsNull;
+using testing::NotNull;
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestPortIndex : public testing::Test
+{
+protected:
+    template <typename Set>
+    Set makeSet(const std::vector<std::uint16_t>& ids)
+    {
+        return Set::fromIds(ids.begin(), ids.end(), mr_);
+    }
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    ocvsmd::TrackingMemoryResource mr_;
+    // NOLINTEND
+};
+
+// MARK: - Tests:
+
+TEST_F(TestPortIndex, update_and_find)
+{
+    using Kind = PortIndex::Kind;
+
+    PortIndex  index;
+    const auto none = makeSet<SubjectIdSet>({});
+    const auto set1 = makeSet<SubjectIdSet>({7509, 100});
+    const auto set2 = makeSet<SubjectIdSet>({7509, 200});
+
+    EXPECT_THAT(index.find(Kind::Publisher, 7509), IsNull());
+
+    index.update(Kind::Publisher, 42, none, set1, 1);
+    index.update(Kind::Publisher, 13, none, set1, 2);
+    const auto* users = index.find(Kind::Publisher, 7509);
+    ASSERT_THAT(users, NotNull());
+    EXPECT_THAT(users->node_ids, ElementsAre(13, 42));
+    EXPECT_THAT(users->sequence, 2);
+    EXPECT_THAT(index.find(Kind::Subscriber, 7509), IsNull());
+
+    // Only affected entries are stamped with the new sequence.
+    index.update(Kind::Publisher, 42, set1, set2, 3);
+    EXPECT_THAT(index.find(Kind::Publisher, 7509)->sequence, 2);
+    EXPECT_THAT(index.find(Kind::Publisher, 100)->node_ids, ElementsAre(13));
+    EXPECT_THAT(index.find(Kind::Publisher, 100)->sequence, 3);
+    EXPECT_THAT(index.find(Kind::Publisher, 200)->node_ids, ElementsAre(42));
+
+    // Entries without users are kept - so that their removal is still observable.
+    index.update(Kind::Publisher, 42, set2, none, 4);
+    index.update(Kind::Publisher, 13, set1, none, 5);
+    users = index.find(Kind::Publisher, 7509);
+    ASSERT_THAT(users, NotNull());
+    EXPECT_THAT(users->node_ids, IsEmpty());
+    EXPECT_THAT(users->sequence, 5);
+
+    const auto servers = makeSet<ServiceIdSet>({430});
+    index.update(Kind::Server, 42, ServiceIdSet{mr_}, servers, 6);
+    EXPECT_THAT(index.find(Kind::Server, 430)->node_ids, ElementsAre(42));
+    EXPECT_THAT(index.find(Kind::Client, 430), IsNull());
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
@@ -0,0 +1,209 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "cyphal/port_set.hpp"
+
+#include "tracking_memory_resource.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+using ocvsmd::daemon::engine::cyphal::ServiceIdSet;
+using ocvsmd::daemon::engine::cyphal::SubjectIdSet;
+
+using testing::IsTrue;
+using testing::IsFalse;
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestPortSet : public testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        EXPECT_THAT(mr_.allocations, IsEmpty());
+        EXPECT_THAT(mr_.total_allocated_bytes, mr_.total_deallocated_bytes);
+    }
+
+    template <typename Set>
+    static std::vector<std::uint16_t> idsOf(const Set& set)
+    {
+        std::vector<std::uint16_t> ids;
+        set.forEach([&ids](const std::uint16_t port_id) { ids.push_back(port_id); });
+        return ids;
+    }
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    ocvsmd::TrackingMemoryResource mr_;
+    // NOLINTEND
+};
+
+// MARK: - Tests:
+
+TEST_F(TestPortSet, insert_erase_contains)
+{
+    SubjectIdSet set{mr_};
+    EXPECT_THAT(set.empty(), IsTrue());
+    EXPECT_THAT(set.heapBytes(), 0);
+
+    EXPECT_THAT(set.insert(7509), IsTrue());
+    EXPECT_THAT(set.insert(100), IsTrue());
+    EXPECT_THAT(set.insert(7509), IsFalse());
+    EXPECT_THAT(set.insert(8192), IsFalse());
+    EXPECT_THAT(set.size(), 2);
+    EXPECT_THAT(set.isDense(), IsFalse());
+    EXPECT_THAT(set.contains(100), IsTrue());
+    EXPECT_THAT(set.contains(101), IsFalse());
+    EXPECT_THAT(idsOf(set), ElementsAre(100, 7509));
+
+    EXPECT_THAT(set.erase(100), IsTrue());
+    EXPECT_THAT(set.erase(100), IsFalse());
+    EXPECT_THAT(idsOf(set), ElementsAre(7509));
+}
+
+TEST_F(TestPortSet, dense_switch_with_hysteresis)
+{
+    ServiceIdSet set{mr_};
+    for (std::uint16_t port_id = 0; port_id <= ServiceIdSet::DenseThreshold; ++port_id)
+    {
+        EXPECT_THAT(set.insert(port_id * 2), IsTrue());
+    }
+    EXPECT_THAT(set.isDense(), IsTrue());
+    EXPECT_THAT(set.size(), ServiceIdSet::DenseThreshold + 1);
+    EXPECT_THAT(set.contains(2), IsTrue());
+    EXPECT_THAT(set.contains(3), IsFalse());
+
+    // Dropping below the dense threshold is not enough to switch back...
+    EXPECT_THAT(set.erase(0), IsTrue());
+    EXPECT_THAT(set.erase(2), IsTrue());
+    EXPECT_THAT(set.isDense(), IsTrue());
+
+    // ...but below the sparse one it is.
+    std::uint16_t port_id = 4;
+    while (set.size() >= ServiceIdSet::SparseThreshold)
+    {
+        EXPECT_THAT(set.erase(port_id), IsTrue());
+        port_id += 2;
+    }
+    EXPECT_THAT(set.isDense(), IsFalse());
+    EXPECT_THAT(set.size(), ServiceIdSet::SparseThreshold - 1);
+    EXPECT_THAT(set.contains(port_id), IsTrue());
+    EXPECT_THAT(set.contains(port_id - 2), IsFalse());
+}
+
+TEST_F(TestPortSet, fromMask_fromIds_full)
+{
+    std::bitset<512> mask;
+    mask.set(430);
+    mask.set(384);
+    const auto from_mask = ServiceIdSet::fromMask(mask, mr_);
+    EXPECT_THAT(from_mask.isDense(), IsFalse());
+    EXPECT_THAT(idsOf(from_mask), ElementsAre(384, 430));
+
+    const std::vector<std::uint16_t> ids{430, 384, 430, 600};
+    const auto                       from_ids = ServiceIdSet::fromIds(ids.begin(), ids.end(), mr_);
+    EXPECT_THAT(idsOf(from_ids), ElementsAre(384, 430));
+    EXPECT_THAT(from_ids == from_mask, IsTrue());
+
+    const auto full = SubjectIdSet::full(mr_);
+    EXPECT_THAT(full.isDense(), IsTrue());
+    EXPECT_THAT(full.size(), 8192);
+    EXPECT_THAT(full.contains(8191), IsTrue());
+    EXPECT_THAT(full.heapBytes(), 1024);
+
+    std::size_t runs = 0;
+    full.forEachRun([&runs](const std::uint16_t first, const std::uint16_t last) {
+        //
+        EXPECT_THAT(first, 0);
+        EXPECT_THAT(last, 8191);
+        ++runs;
+    });
+    EXPECT_THAT(runs, 1);
+}
+
+TEST_F(TestPortSet, diff)
+{
+    const std::vector<std::uint16_t> old_ids{1, 2, 3, 10};
+    const std::vector<std::uint16_t> new_ids{2, 3, 4, 11};
+    const auto                       old_set = SubjectIdSet::fromIds(old_ids.begin(), old_ids.end(), mr_);
+    const auto                       new_set = SubjectIdSet::fromIds(new_ids.begin(), new_ids.end(), mr_);
+
+    std::vector<std::uint16_t> added;
+    std::vector<std::uint16_t> removed;
+    const auto                 add = [&added](const std::uint16_t port_id) { added.push_back(port_id); };
+    const auto                 rem = [&removed](const std::uint16_t port_id) { removed.push_back(port_id); };
+
+    // Sparse vs sparse.
+    SubjectIdSet::diff(old_set, new_set, add, rem);
+    EXPECT_THAT(added, ElementsAre(4, 11));
+    EXPECT_THAT(removed, ElementsAre(1, 10));
+
+    // Dense vs dense.
+    added.clear();
+    removed.clear();
+    const auto full_set   = SubjectIdSet::full(mr_);
+    auto       almost_set = SubjectIdSet::full(mr_);
+    EXPECT_THAT(almost_set.erase(100), IsTrue());
+    EXPECT_THAT(almost_set.isDense(), IsTrue());
+    EXPECT_THAT(almost_set == full_set, IsFalse());
+    SubjectIdSet::diff(full_set, almost_set, add, rem);
+    EXPECT_THAT(added, IsEmpty());
+    EXPECT_THAT(removed, ElementsAre(100));
+
+    // Sparse vs dense.
+    added.clear();
+    removed.clear();
+    SubjectIdSet::diff(almost_set, old_set, add, rem);
+    EXPECT_THAT(added, IsEmpty());
+    EXPECT_THAT(removed.size(), 8191 - old_ids.size());
+}
+
+TEST_F(TestPortSet, memory_resource)
+{
+    const std::vector<std::uint16_t> ids{1, 2, 3};
+
+    // Both forms are allocated from the given memory resource only.
+    auto sparse_set = SubjectIdSet::fromIds(ids.begin(), ids.end(), mr_);
+    EXPECT_THAT(sparse_set.heapBytes(), 6);
+    EXPECT_THAT(mr_.allocated_bytes, 6);
+    {
+        const auto full_set = SubjectIdSet::full(mr_);
+        EXPECT_THAT(mr_.allocated_bytes, 6 + 1024);
+    }
+    EXPECT_THAT(mr_.allocated_bytes, 6);
+
+    // Copies inherit the memory resource of the original.
+    {
+        const auto copy_set = sparse_set;  // NOLINT(performance-unnecessary-copy-initialization)
+        EXPECT_THAT(copy_set == sparse_set, IsTrue());
+        EXPECT_THAT(mr_.allocated_bytes, 12);
+    }
+    EXPECT_THAT(mr_.allocated_bytes, 6);
+
+    // Switching between the forms releases memory of the previous form.
+    for (std::uint16_t port_id = 0; port_id <= SubjectIdSet::DenseThreshold; ++port_id)
+    {
+        (void) sparse_set.insert(port_id);
+    }
+    EXPECT_THAT(sparse_set.isDense(), IsTrue());
+    EXPECT_THAT(mr_.allocated_bytes, 1024);
+    EXPECT_THAT(sparse_set.heapBytes(), 1024);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
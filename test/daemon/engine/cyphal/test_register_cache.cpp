@@ -0,0 +1,103 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "cyphal/register_cache.hpp"
+
+#include <libcyphal/types.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+namespace
+{
+
+using ocvsmd::daemon::engine::cyphal::RegisterCache;
+
+using testing::IsNull;
+using testing::NotNull;
+
+using std::literals::chrono_literals::operator""s;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestRegisterCache : public testing::Test
+{
+protected:
+    using Cache = RegisterCache<int>;
+
+    static libcyphal::TimePoint at(const libcyphal::Duration duration)
+    {
+        return libcyphal::TimePoint{} + duration;
+    }
+};
+
+// MARK: - Tests:
+
+TEST_F(TestRegisterCache, store_and_find)
+{
+    Cache cache{8};
+
+    EXPECT_THAT(cache.find(42, 1, "uavcan.node.id", at(0s), 1s), IsNull());
+
+    cache.store(42, 1, "uavcan.node.id", 42, at(1s));
+    cache.store(13, 1, "uavcan.node.id", 13, at(1s));
+    const auto* entry = cache.find(42, 1, "uavcan.node.id", at(2s), 1s);
+    ASSERT_THAT(entry, NotNull());
+    EXPECT_THAT(entry->value, 42);
+    EXPECT_THAT(entry->stored_at, at(1s));
+
+    // Too old values are not found (but still kept).
+    EXPECT_THAT(cache.find(42, 1, "uavcan.node.id", at(3s), 1s), IsNull());
+    EXPECT_THAT(cache.find(42, 1, "uavcan.node.id", at(3s), 5s), NotNull());
+
+    // Re-stored value is refreshed.
+    cache.store(42, 1, "uavcan.node.id", 43, at(3s));
+    entry = cache.find(42, 1, "uavcan.node.id", at(3s), 0s);
+    ASSERT_THAT(entry, NotNull());
+    EXPECT_THAT(entry->value, 43);
+    EXPECT_THAT(cache.size(), 2);
+
+    cache.erase(42, "uavcan.node.id");
+    EXPECT_THAT(cache.find(42, 1, "uavcan.node.id", at(3s), 5s), IsNull());
+    EXPECT_THAT(cache.find(13, 1, "uavcan.node.id", at(3s), 5s), NotNull());
+}
+
+TEST_F(TestRegisterCache, restart_drops_node_values)
+{
+    Cache cache{8};
+
+    cache.store(42, 1, "a", 1, at(1s));
+    cache.store(42, 1, "b", 2, at(1s));
+    cache.store(13, 1, "a", 3, at(1s));
+    EXPECT_THAT(cache.size(), 3);
+
+    // Node 42 has restarted (so it has a new boot sequence) - all its values are gone.
+    EXPECT_THAT(cache.find(42, 7, "a", at(1s), 5s), IsNull());
+    EXPECT_THAT(cache.find(42, 7, "b", at(1s), 5s), IsNull());
+    EXPECT_THAT(cache.find(13, 1, "a", at(1s), 5s), NotNull());
+    EXPECT_THAT(cache.size(), 1);
+}
+
+TEST_F(TestRegisterCache, least_recently_used_evicted)
+{
+    Cache cache{2};
+
+    cache.store(42, 1, "a", 1, at(1s));
+    cache.store(42, 1, "b", 2, at(1s));
+    EXPECT_THAT(cache.find(42, 1, "a", at(1s), 5s), NotNull());
+
+    // "b" is the least recently used one now.
+    cache.store(42, 1, "c", 3, at(1s));
+    EXPECT_THAT(cache.size(), 2);
+    EXPECT_THAT(cache.find(42, 1, "a", at(1s), 5s), NotNull());
+    EXPECT_THAT(cache.find(42, 1, "b", at(1s), 5s), IsNull());
+    EXPECT_THAT(cache.find(42, 1, "c", at(1s), 5s), NotNull());
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
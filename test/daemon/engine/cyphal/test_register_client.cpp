@@ -0,0 +1,335 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "cyphal/register_client.hpp"
+
+#include "cyphal/node_monitor.hpp"
+#include "tracking_memory_resource.hpp"
+#include "transport_emulator.hpp"
+#include "virtual_time_scheduler.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/presentation/presentation.hpp>
+#include <libcyphal/types.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+using ocvsmd::daemon::engine::cyphal::NodeMonitor;
+using ocvsmd::daemon::engine::cyphal::RegisterClient;
+using ocvsmd::daemon::engine::cyphal::TransportEmulator;
+
+using testing::Gt;
+using testing::Le;
+using testing::Pair;
+using testing::IsNull;
+using testing::IsTrue;
+using testing::SizeIs;
+using testing::IsEmpty;
+using testing::NotNull;
+using testing::ElementsAre;
+using testing::UnorderedElementsAre;
+
+using std::literals::chrono_literals::operator""s;
+using std::literals::chrono_literals::operator""ms;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestRegisterClient : public testing::Test
+{
+protected:
+    using ListSvc   = RegisterClient::ListSvc;
+    using AccessSvc = RegisterClient::AccessSvc;
+    using Listed    = std::tuple<std::uint16_t, std::uint16_t, std::string, int>;
+    using Accessed  = std::tuple<std::uint16_t, std::string, int>;
+
+    void SetUp() override
+    {
+        monitor_ = NodeMonitor::make(mr_, scheduler_, presentation_);
+        ASSERT_THAT(monitor_, NotNull());
+        client_ = RegisterClient::make(mr_, scheduler_, presentation_, *monitor_, 16);
+        ASSERT_THAT(client_, NotNull());
+    }
+
+    RegisterClient::Options makeOptions(const std::size_t window) const
+    {
+        return {scheduler_.now() + 1s, window, libcyphal::Duration::zero()};
+    }
+
+    /// Starts the list operation - its results are collected, and the operation is destroyed when done.
+    ///
+    void list(const std::vector<std::uint16_t>& node_ids, const std::size_t window)
+    {
+        operation_ = client_->list(
+            node_ids,
+            makeOptions(window),
+            [this](const auto node_id, const auto index, const auto error_code, const auto& name) {
+                //
+                listed_.emplace_back(node_id, index, std::string(name.name.begin(), name.name.end()), error_code);
+                return handleResult();
+            },
+            [this] { handleDone(); });
+        ASSERT_THAT(operation_, NotNull());
+    }
+
+    /// Starts the access (read) operation - its results are collected, and the operation is destroyed when done.
+    ///
+    void read(const std::vector<std::uint16_t>& node_ids,
+              const std::vector<std::string>&   names,
+              const std::size_t                 window)
+    {
+        std::vector<AccessSvc::Request> requests;
+        for (const auto& name : names)
+        {
+            AccessSvc::Request request{&mr_};
+            request.name.name = {name.begin(), name.end(), &mr_};
+            requests.push_back(std::move(request));
+        }
+
+        operation_ = client_->access(
+            node_ids,
+            requests,
+            makeOptions(window),
+            [this](const auto node_id, const auto& name, const auto error_code, const auto&) {
+                //
+                accessed_.emplace_back(node_id, std::string(name.name.begin(), name.name.end()), error_code);
+                return handleResult();
+            },
+            [this] { handleDone(); });
+        ASSERT_THAT(operation_, NotNull());
+    }
+
+    /// A result handler is allowed to destroy the operation, but only if it stops the operation.
+    ///
+    bool handleResult()
+    {
+        if (should_stop_)
+        {
+            operation_.reset();
+            return false;
+        }
+        return true;
+    }
+
+    /// The done handler is allowed to destroy the operation unconditionally.
+    ///
+    void handleDone()
+    {
+        ++done_count_;
+        operation_.reset();
+    }
+
+    /// Gets indices of all sent `List` requests (in the order of their sending).
+    ///
+    std::vector<std::uint16_t> sentListIndices()
+    {
+        std::vector<std::uint16_t> indices;
+        for (const auto& request : transport_.requests())
+        {
+            ListSvc::Request list_request{&mr_};
+            EXPECT_THAT(request.tryDeserialize(list_request), IsTrue());
+            indices.push_back(list_request.index);
+        }
+        return indices;
+    }
+
+    /// Gets nodes and register names of all sent `Access` requests (in the order of their sending).
+    ///
+    std::vector<std::pair<std::uint16_t, std::string>> sentAccesses()
+    {
+        std::vector<std::pair<std::uint16_t, std::string>> accesses;
+        for (const auto& request : transport_.requests())
+        {
+            AccessSvc::Request access_request{&mr_};
+            EXPECT_THAT(request.tryDeserialize(access_request), IsTrue());
+            accesses.emplace_back(request.server_node_id,
+                                  std::string(access_request.name.name.begin(), access_request.name.name.end()));
+        }
+        return accesses;
+    }
+
+    /// Counts not yet answered requests to the node (given that requests are answered in the order of sending).
+    ///
+    std::size_t inFlightOf(const std::uint16_t node_id, const std::size_t answered)
+    {
+        const auto& requests  = transport_.requests();
+        std::size_t in_flight = 0;
+        for (std::size_t index = answered; index < requests.size(); ++index)
+        {
+            in_flight += (requests[index].server_node_id == node_id) ? 1 : 0;
+        }
+        return in_flight;
+    }
+
+    /// Responds to the `index`-th sent `List` request with the given name (empty one means the end of the list).
+    ///
+    bool respondList(const std::size_t index, const std::string& name)
+    {
+        const auto& requests = transport_.requests();
+        EXPECT_THAT(requests.size(), Gt(index));
+        if (requests.size() <= index)
+        {
+            return false;
+        }
+        // Copy the request b/c the response might cause new requests to be sent (and so `requests` reallocated).
+        const auto        request = requests[index];
+        ListSvc::Response response{&mr_};
+        response.name.name = {name.begin(), name.end(), &mr_};
+        return transport_.respond(request, response);
+    }
+
+    /// Responds to the `index`-th sent `Access` request (with an empty value).
+    ///
+    bool respondAccess(const std::size_t index)
+    {
+        const auto& requests = transport_.requests();
+        EXPECT_THAT(requests.size(), Gt(index));
+        if (requests.size() <= index)
+        {
+            return false;
+        }
+        const auto request = requests[index];
+        return transport_.respond(request, AccessSvc::Response{&mr_});
+    }
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    ocvsmd::TrackingMemoryResource        mr_;
+    libcyphal::VirtualTimeScheduler       scheduler_{};
+    TransportEmulator                     transport_{mr_, scheduler_};
+    libcyphal::presentation::Presentation presentation_{mr_, scheduler_, transport_.transport()};
+    NodeMonitor::Ptr                      monitor_;
+    RegisterClient::Ptr                   client_;
+    RegisterClient::Operation::Ptr        operation_;
+    bool                                  should_stop_{false};
+    std::size_t                           done_count_{0};
+    std::vector<Listed>                   listed_;
+    std::vector<Accessed>                 accessed_;
+    // NOLINTEND
+};
+
+// MARK: - Tests:
+
+TEST_F(TestRegisterClient, access_window)
+{
+    read({42, 43}, {"r0", "r1", "r2", "r3", "r4"}, 2);
+
+    // Nothing is sent until the next spin of the executor.
+    EXPECT_THAT(transport_.requests(), IsEmpty());
+    scheduler_.spinFor(1ms);
+    EXPECT_THAT(sentAccesses(),
+                UnorderedElementsAre(Pair(42, "r0"), Pair(42, "r1"), Pair(43, "r0"), Pair(43, "r1")));
+
+    // Each node has its own window - a completed call is followed by the next one to the same node.
+    const auto first_node_id = transport_.requests().front().server_node_id;
+    EXPECT_THAT(respondAccess(0), IsTrue());
+    ASSERT_THAT(sentAccesses(), SizeIs(5));
+    EXPECT_THAT(sentAccesses().back(), Pair(first_node_id, "r2"));
+
+    // Respond in the order of sending - nodes never get over their windows.
+    for (std::size_t answered = 1; answered < transport_.requests().size(); ++answered)
+    {
+        EXPECT_THAT(inFlightOf(42, answered), Le(2));
+        EXPECT_THAT(inFlightOf(43, answered), Le(2));
+        EXPECT_THAT(respondAccess(answered), IsTrue());
+    }
+    EXPECT_THAT(transport_.requests(), SizeIs(10));
+    EXPECT_THAT(accessed_, SizeIs(10));
+    EXPECT_THAT(done_count_, 1);
+    EXPECT_THAT(operation_, IsNull());
+}
+
+TEST_F(TestRegisterClient, list_end_out_of_order)
+{
+    list({42}, 4);
+    scheduler_.spinFor(1ms);
+    EXPECT_THAT(sentListIndices(), ElementsAre(0, 1, 2, 3));
+
+    // The end of the list (an empty name at the index 2) arrives before the preceding names -
+    // they are still reported, but names past the end are not (even if the node responds with them).
+    EXPECT_THAT(respondList(2, ""), IsTrue());
+    EXPECT_THAT(respondList(3, "ghost"), IsTrue());
+    EXPECT_THAT(respondList(1, "b"), IsTrue());
+    EXPECT_THAT(done_count_, 0);
+    EXPECT_THAT(respondList(0, "a"), IsTrue());
+    EXPECT_THAT(listed_, ElementsAre(Listed{42, 1, "b", 0}, Listed{42, 0, "a", 0}));
+
+    // Nothing is requested past the end.
+    EXPECT_THAT(sentListIndices(), ElementsAre(0, 1, 2, 3));
+    EXPECT_THAT(done_count_, 1);
+    EXPECT_THAT(operation_, IsNull());
+}
+
+TEST_F(TestRegisterClient, deadline)
+{
+    read({42}, {"r0", "r1", "r2", "r3", "r4"}, 2);
+    scheduler_.spinFor(1ms);
+    EXPECT_THAT(transport_.requests(), SizeIs(2));
+
+    // Calls in flight are expired at the deadline, and the remaining ones are failed right away (without sending).
+    scheduler_.spinFor(2s);
+    EXPECT_THAT(transport_.requests(), SizeIs(2));
+    EXPECT_THAT(accessed_,
+                UnorderedElementsAre(Accessed{42, "r0", ETIMEDOUT},
+                                     Accessed{42, "r1", ETIMEDOUT},
+                                     Accessed{42, "r2", ETIMEDOUT},
+                                     Accessed{42, "r3", ETIMEDOUT},
+                                     Accessed{42, "r4", ETIMEDOUT}));
+    EXPECT_THAT(done_count_, 1);
+    EXPECT_THAT(operation_, IsNull());
+}
+
+TEST_F(TestRegisterClient, stop_from_handler)
+{
+    read({42}, {"r0", "r1", "r2"}, 2);
+    scheduler_.spinFor(1ms);
+    EXPECT_THAT(transport_.requests(), SizeIs(2));
+
+    // The handler destroys the operation from within the response callback of one of its calls.
+    should_stop_ = true;
+    EXPECT_THAT(respondAccess(1), IsTrue());
+    EXPECT_THAT(accessed_, ElementsAre(Accessed{42, "r1", 0}));
+    EXPECT_THAT(operation_, IsNull());
+
+    // The rest of the calls are cancelled - neither responses, nor timeouts are reported.
+    (void) respondAccess(0);
+    scheduler_.spinFor(2s);
+    EXPECT_THAT(accessed_, SizeIs(1));
+    EXPECT_THAT(transport_.requests(), SizeIs(2));
+    EXPECT_THAT(done_count_, 0);
+}
+
+TEST_F(TestRegisterClient, stop_on_start)
+{
+    // The list handler stops (and destroys) the operation on the very first (failed) result.
+    transport_.setSendFailure(libcyphal::transport::AnyFailure{libcyphal::transport::CapacityError{}});
+    should_stop_ = true;
+    list({42, 43}, 4);
+    scheduler_.spinFor(1ms);
+    EXPECT_THAT(listed_, SizeIs(1));
+    EXPECT_THAT(std::get<3>(listed_.front()), ENOMEM);
+    EXPECT_THAT(operation_, IsNull());
+
+    scheduler_.spinFor(2s);
+    EXPECT_THAT(listed_, SizeIs(1));
+    EXPECT_THAT(done_count_, 0);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
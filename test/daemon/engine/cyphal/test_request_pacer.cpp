@@ -0,0 +1,229 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "cyphal/request_pacer.hpp"
+
+#include "virtual_time_scheduler.hpp"
+
+#include <libcyphal/types.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+using ocvsmd::daemon::engine::cyphal::RequestPacer;
+
+using testing::Pair;
+using testing::IsEmpty;
+using testing::ElementsAre;
+
+using std::literals::chrono_literals::operator""s;
+using std::literals::chrono_literals::operator""ms;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestRequestPacer : public testing::Test
+{
+protected:
+    using Sent = std::pair<std::string, libcyphal::Duration>;
+
+    /// Makes an action which records its name and the (virtual) time it was run at.
+    ///
+    RequestPacer::Action sender(std::string name)
+    {
+        return [this, name = std::move(name)] {
+            //
+            sent_.emplace_back(name, scheduler_.now() - libcyphal::TimePoint{});
+        };
+    }
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    libcyphal::VirtualTimeScheduler scheduler_{};
+    std::vector<Sent>               sent_;
+    // NOLINTEND
+};
+
+// MARK: - Tests:
+
+TEST_F(TestRequestPacer, unlimited)
+{
+    const auto pacer = RequestPacer::make(scheduler_, {0, 0, 0s});
+
+    pacer->submit(1, sender("1a"));
+    pacer->submit(1, sender("1b"));
+    pacer->submit(2, sender("2a"));
+    EXPECT_THAT(pacer->queued(), 3);
+    EXPECT_THAT(sent_, IsEmpty());  // Actions are never run from within `submit`.
+
+    scheduler_.spinFor(10ms);
+    EXPECT_THAT(sent_, ElementsAre(Pair("1a", 0s), Pair("1b", 0s), Pair("2a", 0s)));
+    EXPECT_THAT(pacer->queued(), 0);
+    EXPECT_THAT(pacer->inFlight(), 3);
+
+    pacer->release(1);
+    pacer->release(1);
+    pacer->release(1);  // An extra release is ignored.
+    pacer->release(3);  // Unknown owner is ignored.
+    EXPECT_THAT(pacer->inFlight(), 1);
+}
+
+TEST_F(TestRequestPacer, per_owner_limit)
+{
+    const auto pacer = RequestPacer::make(scheduler_, {1, 0, 0s});
+
+    pacer->submit(1, sender("1a"));
+    pacer->submit(1, sender("1b"));
+    pacer->submit(1, sender("1c"));
+    pacer->submit(2, sender("2a"));
+
+    // The 2nd owner is not blocked by the 1st one.
+    scheduler_.spinFor(10ms);
+    EXPECT_THAT(sent_, ElementsAre(Pair("1a", 0s), Pair("2a", 0s)));
+    EXPECT_THAT(pacer->queued(), 2);
+    EXPECT_THAT(pacer->inFlight(), 2);
+
+    scheduler_.spinFor(1s);
+    EXPECT_THAT(sent_, ElementsAre(Pair("1a", 0s), Pair("2a", 0s)));
+
+    pacer->release(2);
+    scheduler_.spinFor(10ms);
+    EXPECT_THAT(sent_, ElementsAre(Pair("1a", 0s), Pair("2a", 0s)));
+
+    pacer->release(1);
+    scheduler_.spinFor(10ms);
+    pacer->release(1);
+    scheduler_.spinFor(10ms);
+    EXPECT_THAT(sent_, ElementsAre(Pair("1a", 0s), Pair("2a", 0s), Pair("1b", 1020ms), Pair("1c", 1030ms)));
+    EXPECT_THAT(pacer->queued(), 0);
+    EXPECT_THAT(pacer->inFlight(), 1);
+}
+
+TEST_F(TestRequestPacer, global_limit)
+{
+    const auto pacer = RequestPacer::make(scheduler_, {0, 2, 0s});
+
+    pacer->submit(1, sender("1a"));
+    pacer->submit(2, sender("2a"));
+    pacer->submit(3, sender("3a"));
+    pacer->submit(4, sender("4a"));
+
+    scheduler_.spinFor(10ms);
+    EXPECT_THAT(sent_, ElementsAre(Pair("1a", 0s), Pair("2a", 0s)));
+    EXPECT_THAT(pacer->inFlight(), 2);
+
+    // Any owner's release lets the next queued action (in FIFO order) go.
+    pacer->release(2);
+    scheduler_.spinFor(10ms);
+    EXPECT_THAT(sent_, ElementsAre(Pair("1a", 0s), Pair("2a", 0s), Pair("3a", 10ms)));
+    EXPECT_THAT(pacer->queued(), 1);
+    EXPECT_THAT(pacer->inFlight(), 2);
+}
+
+TEST_F(TestRequestPacer, spacing)
+{
+    const auto pacer = RequestPacer::make(scheduler_, {0, 0, 100ms});
+
+    pacer->submit(1, sender("1a"));
+    pacer->submit(1, sender("1b"));
+    pacer->submit(2, sender("2a"));
+
+    scheduler_.spinFor(150ms);
+    EXPECT_THAT(sent_, ElementsAre(Pair("1a", 0s), Pair("1b", 100ms)));
+
+    scheduler_.spinFor(1s);
+    EXPECT_THAT(sent_, ElementsAre(Pair("1a", 0s), Pair("1b", 100ms), Pair("2a", 200ms)));
+
+    // Long after the last send there is nothing to wait for.
+    pacer->submit(3, sender("3a"));
+    scheduler_.spinFor(10ms);
+    EXPECT_THAT(sent_.back(), Pair("3a", 1150ms));
+}
+
+TEST_F(TestRequestPacer, submit_after)
+{
+    const auto pacer = RequestPacer::make(scheduler_, {0, 0, 0s});
+
+    // Delayed action doesn't block the ones which are due.
+    pacer->submitAfter(1, libcyphal::TimePoint{} + 500ms, sender("1a"));
+    pacer->submit(2, sender("2a"));
+    pacer->submitAfter(3, libcyphal::TimePoint{} + 200ms, sender("3a"));
+
+    scheduler_.spinFor(100ms);
+    EXPECT_THAT(sent_, ElementsAre(Pair("2a", 0s)));
+    EXPECT_THAT(pacer->queued(), 2);
+
+    scheduler_.spinFor(1s);
+    EXPECT_THAT(sent_, ElementsAre(Pair("2a", 0s), Pair("3a", 200ms), Pair("1a", 500ms)));
+    EXPECT_THAT(pacer->queued(), 0);
+}
+
+TEST_F(TestRequestPacer, cancel)
+{
+    const auto pacer = RequestPacer::make(scheduler_, {0, 1, 0s});
+
+    pacer->submit(1, sender("1a"));
+    pacer->submit(1, sender("1b"));
+    pacer->submit(2, sender("2a"));
+    pacer->submitAfter(1, libcyphal::TimePoint{} + 500ms, sender("1c"));
+
+    scheduler_.spinFor(10ms);
+    EXPECT_THAT(sent_, ElementsAre(Pair("1a", 0s)));
+    EXPECT_THAT(pacer->queued(), 3);
+
+    // Both queued and in-flight requests of the owner are gone, so the other owner could proceed.
+    pacer->cancel(1);
+    EXPECT_THAT(pacer->queued(), 1);
+    EXPECT_THAT(pacer->inFlight(), 0);
+
+    scheduler_.spinFor(1s);
+    EXPECT_THAT(sent_, ElementsAre(Pair("1a", 0s), Pair("2a", 10ms)));
+    EXPECT_THAT(pacer->queued(), 0);
+    EXPECT_THAT(pacer->inFlight(), 1);
+
+    pacer->cancel(2);
+    pacer->cancel(3);  // Unknown owner is ignored.
+    EXPECT_THAT(pacer->inFlight(), 0);
+}
+
+TEST_F(TestRequestPacer, reentrant_release_and_cancel)
+{
+    const auto pacer = RequestPacer::make(scheduler_, {1, 0, 0s});
+
+    // Failed sends release their slots right away (from within the action),
+    // so the next action of the same owner could go within the same pump.
+    for (const auto* const name : {"1a", "1b", "1c"})
+    {
+        pacer->submit(1, [this, &pacer, name] {
+            //
+            sent_.emplace_back(name, scheduler_.now() - libcyphal::TimePoint{});
+            pacer->release(1);
+        });
+    }
+    // The owner cancels itself on its very first action.
+    pacer->submit(2, [this, &pacer] {
+        //
+        sent_.emplace_back("2a", scheduler_.now() - libcyphal::TimePoint{});
+        pacer->cancel(2);
+    });
+    pacer->submit(2, sender("2b"));
+
+    scheduler_.spinFor(10ms);
+    EXPECT_THAT(sent_, ElementsAre(Pair("1a", 0s), Pair("1b", 0s), Pair("1c", 0s), Pair("2a", 0s)));
+    EXPECT_THAT(pacer->queued(), 0);
+    EXPECT_THAT(pacer->inFlight(), 0);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
@@ -0,0 +1,119 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "cyphal/transfer_id_map.hpp"
+
+#include <libcyphal/transport/types.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+namespace
+{
+
+using ocvsmd::daemon::engine::cyphal::TransferIdMap;
+
+using testing::IsTrue;
+using testing::IsFalse;
+using testing::NotNull;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestTransferIdMap : public testing::Test
+{
+protected:
+    using SessionSpec = TransferIdMap::SessionSpec;
+
+    void SetUp() override
+    {
+        file_path_ = testing::TempDir() + "ocvsmd_test_transfer_id_map_" + std::to_string(::getpid()) + ".bin";
+        (void) std::remove(file_path_.c_str());
+    }
+
+    void TearDown() override
+    {
+        (void) std::remove(file_path_.c_str());
+    }
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    std::string file_path_;
+    // NOLINTEND
+};
+
+// MARK: - Tests:
+
+TEST_F(TestTransferIdMap, in_memory)
+{
+    const auto map = TransferIdMap::make("");
+    ASSERT_THAT(map, NotNull());
+    EXPECT_THAT(map->isPersistent(), IsFalse());
+    EXPECT_THAT(map->size(), 0);
+
+    EXPECT_THAT(map->getIdFor(SessionSpec{123, 42}), 0);
+
+    map->setIdFor(SessionSpec{123, 42}, 7);
+    map->setIdFor(SessionSpec{123, 43}, 8);
+    map->setIdFor(SessionSpec{124, 42}, 9);
+    EXPECT_THAT(map->size(), 3);
+    EXPECT_THAT(map->getIdFor(SessionSpec{123, 42}), 7);
+    EXPECT_THAT(map->getIdFor(SessionSpec{123, 43}), 8);
+    EXPECT_THAT(map->getIdFor(SessionSpec{124, 42}), 9);
+    EXPECT_THAT(map->getIdFor(SessionSpec{124, 43}), 0);
+
+    // Update of an existing session.
+    map->setIdFor(SessionSpec{123, 42}, 10);
+    EXPECT_THAT(map->size(), 3);
+    EXPECT_THAT(map->getIdFor(SessionSpec{123, 42}), 10);
+}
+
+TEST_F(TestTransferIdMap, persistence)
+{
+    {
+        const auto map = TransferIdMap::make(file_path_);
+        ASSERT_THAT(map, NotNull());
+        EXPECT_THAT(map->isPersistent(), IsTrue());
+        EXPECT_THAT(map->size(), 0);
+
+        map->setIdFor(SessionSpec{430, 1}, 0x1234567890ULL);
+        map->setIdFor(SessionSpec{7509, 0xFFFF}, 42);
+    }
+    {
+        const auto map = TransferIdMap::make(file_path_);
+        ASSERT_THAT(map, NotNull());
+        EXPECT_THAT(map->size(), 2);
+        EXPECT_THAT(map->getIdFor(SessionSpec{430, 1}), 0x1234567890ULL);
+        EXPECT_THAT(map->getIdFor(SessionSpec{7509, 0xFFFF}), 42);
+        EXPECT_THAT(map->getIdFor(SessionSpec{430, 2}), 0);
+    }
+}
+
+TEST_F(TestTransferIdMap, capacity_overflow)
+{
+    const auto map = TransferIdMap::make("");
+    ASSERT_THAT(map, NotNull());
+
+    for (std::uint16_t node_id = 0; node_id < TransferIdMap::Capacity; ++node_id)
+    {
+        map->setIdFor(SessionSpec{1, node_id}, node_id + 1U);
+    }
+    EXPECT_THAT(map->size(), TransferIdMap::Capacity);
+
+    // The map is full - new sessions are not remembered, but existing ones are still available.
+    map->setIdFor(SessionSpec{2, 0}, 123);
+    EXPECT_THAT(map->size(), TransferIdMap::Capacity);
+    EXPECT_THAT(map->getIdFor(SessionSpec{2, 0}), 0);
+    EXPECT_THAT(map->getIdFor(SessionSpec{1, 13}), 14);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
@@ -0,0 +1,346 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#ifndef OCVSMD_DAEMON_ENGINE_CYPHAL_TRANSPORT_EMULATOR_HPP_INCLUDED
+#define OCVSMD_DAEMON_ENGINE_CYPHAL_TRANSPORT_EMULATOR_HPP_INCLUDED
+
+#include "dsdl_helpers.hpp"
+
+#include "transport/msg_sessions_mock.hpp"
+#include "transport/scattered_buffer_storage_mock.hpp"
+#include "transport/svc_sessions_mock.hpp"
+#include "transport/transport_mock.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/transport/errors.hpp>
+#include <libcyphal/transport/msg_sessions.hpp>
+#include <libcyphal/transport/scattered_buffer.hpp>
+#include <libcyphal/transport/svc_sessions.hpp>
+#include <libcyphal/transport/transport.hpp>
+#include <libcyphal/transport/types.hpp>
+#include <libcyphal/types.hpp>
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace ocvsmd
+{
+namespace daemon
+{
+namespace engine
+{
+namespace cyphal
+{
+
+/// Emulates the Cyphal transport layer (on top of the libcyphal transport mocks).
+///
+/// So that engine components could be tested together with the real presentation layer
+/// (subscribers, service clients, response promises etc.) - without any real network:
+/// - messages and service responses are "received" by the `publish` and `respond` methods;
+/// - service requests "sent" by the presentation layer are collected (see `requests`).
+///
+class TransportEmulator final
+{
+public:
+    using NodeId     = libcyphal::transport::NodeId;
+    using PortId     = libcyphal::transport::PortId;
+    using TransferId = libcyphal::transport::TransferId;
+    using AnyFailure = libcyphal::transport::AnyFailure;
+    using Bytes      = std::vector<std::uint8_t>;
+
+    /// Holds a service request sent by the presentation layer.
+    ///
+    struct Request
+    {
+        PortId               service_id;
+        NodeId               server_node_id;
+        TransferId           transfer_id;
+        libcyphal::TimePoint deadline;
+        Bytes                payload;
+
+        template <typename Message>
+        bool tryDeserialize(Message& message) const
+        {
+            return common::tryDeserializePayload({payload.data(), payload.size()}, message);
+        }
+    };
+
+    TransportEmulator(cetl::pmr::memory_resource& memory, libcyphal::IExecutor& executor)
+        : memory_{memory}
+        , executor_{executor}
+    {
+        using testing::_;
+        using testing::Invoke;
+        using testing::Return;
+        using libcyphal::transport::ProtocolParams;
+
+        ON_CALL(transport_mock_, getProtocolParams())
+            .WillByDefault(Return(ProtocolParams{std::numeric_limits<TransferId>::max(), 0, 0}));
+        ON_CALL(transport_mock_, makeMessageRxSession(_)).WillByDefault(Invoke([this](const auto& params) {
+            //
+            auto& session = addSession(msg_rx_sessions_, params);
+            return libcyphal::detail::makeUniquePtr<MsgRxSessionMock::RefWrapper>(memory_, session.mock);
+        }));
+        ON_CALL(transport_mock_, makeRequestTxSession(_)).WillByDefault(Invoke([this](const auto& params) {
+            //
+            auto& session = addSession(request_tx_sessions_, params);
+            return libcyphal::detail::makeUniquePtr<RequestTxSessionMock::RefWrapper>(memory_, session.mock);
+        }));
+        ON_CALL(transport_mock_, makeResponseRxSession(_)).WillByDefault(Invoke([this](const auto& params) {
+            //
+            auto& session = addSession(response_rx_sessions_, params);
+            return libcyphal::detail::makeUniquePtr<ResponseRxSessionMock::RefWrapper>(memory_, session.mock);
+        }));
+    }
+
+    TransportEmulator(const TransportEmulator&)                = delete;
+    TransportEmulator(TransportEmulator&&) noexcept            = delete;
+    TransportEmulator& operator=(const TransportEmulator&)     = delete;
+    TransportEmulator& operator=(TransportEmulator&&) noexcept = delete;
+
+    ~TransportEmulator() = default;
+
+    libcyphal::transport::ITransport& transport() noexcept
+    {
+        return transport_mock_;
+    }
+
+    /// Gets all service requests sent so far (in the order of their sending).
+    ///
+    std::vector<Request>& requests() noexcept
+    {
+        return requests_;
+    }
+
+    /// Makes all further request sendings fail with the given failure (or succeed again if `nullopt`).
+    ///
+    void setSendFailure(cetl::optional<AnyFailure> failure)
+    {
+        send_failure_ = std::move(failure);
+    }
+
+    /// Delivers the message (as if it was received from the network) to the subscriber of the subject.
+    ///
+    /// @return `false` if there is no subscriber of the subject.
+    ///
+    template <typename Message>
+    bool publish(const PortId                 subject_id,
+                 const Message&               message,
+                 const cetl::optional<NodeId> publisher_node_id,
+                 const TransferId             transfer_id = 0)
+    {
+        bool is_delivered = false;
+        (void) common::tryPerformOnSerialized(message, [&](const auto payload) {
+            //
+            is_delivered = publishRaw(subject_id, {payload.begin(), payload.end()}, publisher_node_id, transfer_id);
+            return 0;
+        });
+        return is_delivered;
+    }
+
+    bool publishRaw(const PortId                 subject_id,
+                    const Bytes&                 payload,
+                    const cetl::optional<NodeId> publisher_node_id,
+                    const TransferId             transfer_id = 0)
+    {
+        using libcyphal::transport::Priority;
+        using libcyphal::transport::ScatteredBuffer;
+        using libcyphal::transport::MessageRxTransfer;
+
+        // Index-based iteration - the receive callback might make new sessions (and so reallocate the vector).
+        for (std::size_t i = 0; i < msg_rx_sessions_.size(); ++i)
+        {
+            auto& session = *msg_rx_sessions_[i];
+            if (session.is_alive && session.callback && (session.params.subject_id == subject_id))
+            {
+                testing::NiceMock<StorageMock> storage_mock;
+                bindStorage(storage_mock, payload);
+                MessageRxTransfer transfer{{{{transfer_id, Priority::Nominal}, executor_.now()}, publisher_node_id},
+                                           ScatteredBuffer{StorageMock::Wrapper{&storage_mock}}};
+                session.callback({transfer});
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Delivers the response to the given request (as if it was received from the server node).
+    ///
+    /// @return `false` if the response session of the request is already gone (f.e. the client was destroyed).
+    ///
+    template <typename Response>
+    bool respond(const Request& request, const Response& response)
+    {
+        bool is_delivered = false;
+        (void) common::tryPerformOnSerialized(response, [&](const auto payload) {
+            //
+            is_delivered = respondRaw(request, {payload.begin(), payload.end()});
+            return 0;
+        });
+        return is_delivered;
+    }
+
+    bool respondRaw(const Request& request, const Bytes& payload)
+    {
+        using libcyphal::transport::Priority;
+        using libcyphal::transport::ScatteredBuffer;
+        using libcyphal::transport::ServiceRxTransfer;
+
+        // Index-based iteration - the receive callback might make new sessions (and so reallocate the vector).
+        for (std::size_t i = 0; i < response_rx_sessions_.size(); ++i)
+        {
+            auto& session = *response_rx_sessions_[i];
+            if (session.is_alive && session.callback && (session.params.service_id == request.service_id) &&
+                (session.params.server_node_id == request.server_node_id))
+            {
+                testing::NiceMock<StorageMock> storage_mock;
+                bindStorage(storage_mock, payload);
+                ServiceRxTransfer transfer{{{{request.transfer_id, Priority::Nominal}, executor_.now()},
+                                            request.server_node_id},
+                                           ScatteredBuffer{StorageMock::Wrapper{&storage_mock}}};
+                session.callback({transfer});
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    using StorageMock           = libcyphal::transport::ScatteredBufferStorageMock;
+    using MsgRxSessionMock      = libcyphal::transport::MessageRxSessionMock;
+    using RequestTxSessionMock  = libcyphal::transport::RequestTxSessionMock;
+    using ResponseRxSessionMock = libcyphal::transport::ResponseRxSessionMock;
+    using MsgRxCallback         = libcyphal::transport::IMessageRxSession::OnReceiveCallback::Function;
+    using ResponseRxCallback    = libcyphal::transport::IResponseRxSession::OnReceiveCallback::Function;
+
+    /// Holds state of a single transport session - it's kept (but not alive) even after the session is destroyed.
+    ///
+    template <typename Mock, typename Params, typename Callback>
+    struct Session
+    {
+        Params                  params;
+        testing::NiceMock<Mock> mock;
+        Callback                callback;
+        bool                    is_alive{true};
+    };
+    struct NoCallback
+    {};
+
+    using MsgRxParams       = libcyphal::transport::MessageRxParams;
+    using RequestTxParams   = libcyphal::transport::RequestTxParams;
+    using ResponseRxParams  = libcyphal::transport::ResponseRxParams;
+    using MsgRxSession      = Session<MsgRxSessionMock, MsgRxParams, MsgRxCallback>;
+    using RequestTxSession  = Session<RequestTxSessionMock, RequestTxParams, NoCallback>;
+    using ResponseRxSession = Session<ResponseRxSessionMock, ResponseRxParams, ResponseRxCallback>;
+
+    template <typename Mock, typename Params, typename Callback>
+    using Sessions = std::vector<std::unique_ptr<Session<Mock, Params, Callback>>>;
+
+    template <typename Mock, typename Params, typename Callback>
+    Session<Mock, Params, Callback>& addSession(Sessions<Mock, Params, Callback>& sessions, const Params& params)
+    {
+        using testing::_;
+        using testing::Invoke;
+        using testing::Return;
+
+        sessions.push_back(std::make_unique<Session<Mock, Params, Callback>>());
+        auto& session  = *sessions.back();
+        session.params = params;
+
+        ON_CALL(session.mock, getParams()).WillByDefault(Return(params));
+        ON_CALL(session.mock, deinit()).WillByDefault(Invoke([&session] {
+            //
+            // Note that the callback is not reset here - the session might be destroyed from within it.
+            session.is_alive = false;
+        }));
+        bindSession(session);
+        return session;
+    }
+
+    static void bindSession(MsgRxSession& session)
+    {
+        ON_CALL(session.mock, setOnReceiveCallback(testing::_)).WillByDefault(testing::Invoke([&session](auto&& fn) {
+            //
+            session.callback = std::move(fn);
+        }));
+    }
+
+    static void bindSession(ResponseRxSession& session)
+    {
+        ON_CALL(session.mock, setOnReceiveCallback(testing::_)).WillByDefault(testing::Invoke([&session](auto&& fn) {
+            //
+            session.callback = std::move(fn);
+        }));
+    }
+
+    void bindSession(RequestTxSession& session)
+    {
+        ON_CALL(session.mock, send(testing::_, testing::_))
+            .WillByDefault(testing::Invoke([this, &session](const auto& metadata, const auto fragments) {
+                //
+                if (send_failure_)
+                {
+                    return send_failure_;
+                }
+                Request request{session.params.service_id,
+                                session.params.server_node_id,
+                                metadata.base.transfer_id,
+                                metadata.deadline,
+                                {}};
+                for (const auto fragment : fragments)
+                {
+                    const auto* const bytes = reinterpret_cast<const std::uint8_t*>(fragment.data());  // NOLINT
+                    request.payload.insert(request.payload.end(), bytes, bytes + fragment.size());
+                }
+                requests_.push_back(std::move(request));
+                return cetl::optional<AnyFailure>{};
+            }));
+    }
+
+    static void bindStorage(StorageMock& storage_mock, const Bytes& payload)
+    {
+        using testing::_;
+        using testing::Invoke;
+        using testing::Return;
+
+        ON_CALL(storage_mock, size()).WillByDefault(Return(payload.size()));
+        ON_CALL(storage_mock, copy(_, _, _))
+            .WillByDefault(Invoke([&payload](const std::size_t offset, auto* const dst, const std::size_t length) {
+                //
+                if (offset >= payload.size())
+                {
+                    return std::size_t{0};
+                }
+                const auto size = std::min(length, payload.size() - offset);
+                std::memcpy(dst, payload.data() + offset, size);
+                return size;
+            }));
+    }
+
+    cetl::pmr::memory_resource&                                    memory_;
+    libcyphal::IExecutor&                                          executor_;
+    testing::NiceMock<libcyphal::transport::TransportMock>         transport_mock_;
+    std::vector<std::unique_ptr<MsgRxSession>>                     msg_rx_sessions_;
+    std::vector<std::unique_ptr<RequestTxSession>>                 request_tx_sessions_;
+    std::vector<std::unique_ptr<ResponseRxSession>>                response_rx_sessions_;
+    std::vector<Request>                                           requests_;
+    cetl::optional<AnyFailure>                                     send_failure_;
+
+};  // TransportEmulator
+
+}  // namespace cyphal
+}  // namespace engine
+}  // namespace daemon
+}  // namespace ocvsmd
+
+#endif  // OCVSMD_DAEMON_ENGINE_CYPHAL_TRANSPORT_EMULATOR_HPP_INCLUDED
@@ -0,0 +1,146 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "platform/can/can_filters.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+using ocvsmd::daemon::engine::platform::can::CanFilter;
+using ocvsmd::daemon::engine::platform::can::CanFilterMatcher;
+using ocvsmd::daemon::engine::platform::can::compactFilters;
+
+using testing::SizeIs;
+using testing::ElementsAre;
+using testing::UnorderedElementsAre;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestCanFilters : public testing::Test
+{
+protected:
+    /// Verifies that all CAN IDs accepted by the original filters are still accepted by the compacted ones.
+    ///
+    static void expectSuperset(const std::vector<CanFilter>& original, const std::vector<CanFilter>& compacted)
+    {
+        for (const auto& orig : original)
+        {
+            // Enough to check the filter's own ID and its ID with all "don't care" bits set.
+            const std::uint32_t ids[] = {orig.id, orig.id | (~orig.mask & 0x1FFFFFFFU)};  // NOLINT
+            for (const auto can_id : ids)
+            {
+                const bool is_accepted = std::any_of(compacted.begin(), compacted.end(), [can_id](const auto& flt) {
+                    //
+                    return flt.accepts(can_id);
+                });
+                EXPECT_TRUE(is_accepted) << "can_id=" << can_id;
+            }
+        }
+    }
+};
+
+// MARK: - Tests:
+
+TEST_F(TestCanFilters, merge)
+{
+    const CanFilter merged = CanFilter::merge({0x100, 0x1FF}, {0x101, 0x1FF});
+    EXPECT_THAT(merged, (CanFilter{0x100, 0x1FE}));
+    EXPECT_TRUE(merged.accepts(0x100));
+    EXPECT_TRUE(merged.accepts(0x101));
+    EXPECT_FALSE(merged.accepts(0x102));
+}
+
+TEST_F(TestCanFilters, covers)
+{
+    EXPECT_TRUE((CanFilter{0x100, 0x1F0}).covers({0x101, 0x1FF}));
+    EXPECT_FALSE((CanFilter{0x101, 0x1FF}).covers({0x100, 0x1F0}));
+    EXPECT_TRUE((CanFilter{0x0, 0x0}).covers({0x123, 0x1FF}));
+}
+
+TEST_F(TestCanFilters, compact_nothing_to_do)
+{
+    std::vector<CanFilter> filters{{0x100, 0x1FF}, {0x200, 0x3FF}};
+    compactFilters(filters, 2);
+    EXPECT_THAT(filters, UnorderedElementsAre(CanFilter{0x100, 0x1FF}, CanFilter{0x200, 0x3FF}));
+}
+
+TEST_F(TestCanFilters, compact_drops_covered)
+{
+    std::vector<CanFilter> filters{{0x101, 0x1FF}, {0x100, 0x1F0}, {0x100, 0x1F0}};
+    compactFilters(filters, 10);
+    EXPECT_THAT(filters, ElementsAre(CanFilter{0x100, 0x1F0}));
+}
+
+TEST_F(TestCanFilters, compact_merges_closest)
+{
+    const std::vector<CanFilter> original{{0x100, 0x1FFF}, {0x101, 0x1FFF}, {0x1000, 0x1FFF}};
+
+    auto filters = original;
+    compactFilters(filters, 2);
+    EXPECT_THAT(filters, UnorderedElementsAre(CanFilter{0x100, 0x1FFE}, CanFilter{0x1000, 0x1FFF}));
+    expectSuperset(original, filters);
+
+    filters = original;
+    compactFilters(filters, 1);
+    EXPECT_THAT(filters, SizeIs(1));
+    expectSuperset(original, filters);
+}
+
+TEST_F(TestCanFilters, compact_many)
+{
+    // Typical message subscription filters - same mask, different subject IDs.
+    std::vector<CanFilter> original;
+    for (std::uint32_t subject_id = 0; subject_id < 600; ++subject_id)
+    {
+        original.push_back({(subject_id * 7U) << 8U, 0x21FFF80U});
+    }
+
+    auto filters = original;
+    compactFilters(filters, 512);
+    EXPECT_THAT(filters, SizeIs(512));
+    expectSuperset(original, filters);
+
+    filters = original;
+    compactFilters(filters, 16);
+    EXPECT_THAT(filters, SizeIs(16));
+    expectSuperset(original, filters);
+}
+
+TEST_F(TestCanFilters, matcher)
+{
+    CanFilterMatcher matcher;
+    EXPECT_TRUE(matcher.empty());
+    EXPECT_FALSE(matcher.accepts(0x100));
+
+    matcher.assign({{0x100, 0x1FFF}, {0x300, 0x1FFF}, {0x10000, 0x30000}});
+    EXPECT_FALSE(matcher.empty());
+    EXPECT_TRUE(matcher.accepts(0x100));
+    EXPECT_TRUE(matcher.accepts(0x300));
+    EXPECT_FALSE(matcher.accepts(0x200));
+    EXPECT_TRUE(matcher.accepts(0x10123));
+    EXPECT_FALSE(matcher.accepts(0x20123));
+
+    // Compacted filters accept more than the original ones - the matcher tells the difference.
+    std::vector<CanFilter> filters{{0x100, 0x1FFF}, {0x300, 0x1FFF}, {0x500, 0x1FFF}};
+    matcher.assign(filters);
+    compactFilters(filters, 1);
+    ASSERT_THAT(filters, SizeIs(1));
+    EXPECT_TRUE(filters.front().accepts(0x700));
+    EXPECT_FALSE(matcher.accepts(0x700));
+    EXPECT_TRUE(matcher.accepts(0x500));
+
+    matcher.clear();
+    EXPECT_TRUE(matcher.empty());
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
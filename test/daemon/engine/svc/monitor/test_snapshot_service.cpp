@@ -0,0 +1,321 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "svc/monitor/snapshot_service.hpp"
+
+#include "common/ipc/gateway_mock.hpp"
+#include "common/ipc/server_router_mock.hpp"
+#include "cyphal/node_monitor.hpp"
+#include "cyphal/port_index.hpp"
+#include "cyphal/port_set.hpp"
+#include "daemon/engine/config_mock.hpp"
+#include "daemon/engine/cyphal/transport_emulator.hpp"
+#include "dsdl_helpers.hpp"
+#include "ipc/gateway.hpp"
+#include "ipc/ipc_types.hpp"
+#include "memory_accounting.hpp"
+#include "ocvsmd/common/svc/monitor/NodeDelta_0_1.hpp"
+#include "svc/monitor/snapshot_spec.hpp"
+#include "svc/svc_helpers.hpp"
+#include "tracking_memory_resource.hpp"
+#include "virtual_time_scheduler.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/presentation/presentation.hpp>
+#include <libcyphal/types.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+using ocvsmd::daemon::engine::cyphal::PortIndex;
+using ocvsmd::daemon::engine::cyphal::NodeMonitor;
+using ocvsmd::daemon::engine::svc::monitor::SnapshotService;
+
+using GatewayMock = ocvsmd::common::ipc::detail::GatewayMock;
+using Spec        = ocvsmd::common::svc::monitor::SnapshotSpec;
+using NodeDelta   = ocvsmd::common::svc::monitor::NodeDelta_0_1;
+
+using testing::_;
+using testing::Invoke;
+using testing::IsTrue;
+using testing::IsEmpty;
+using testing::IsFalse;
+using testing::SizeIs;
+using testing::StrictMock;
+using testing::ElementsAre;
+
+using std::literals::chrono_literals::operator""ms;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestSnapshotService : public testing::Test
+{
+protected:
+    /// Defines a fake monitor - the test fully controls its shadows and their change order.
+    ///
+    class NodeMonitorFake final : public NodeMonitor
+    {
+    public:
+        explicit NodeMonitorFake(cetl::pmr::memory_resource& memory)
+            : memory_{memory}
+        {
+        }
+
+        /// Gets (or makes a new one) shadow of the node, and stamps it as changed.
+        ///
+        Shadow& change(const std::uint16_t node_id)
+        {
+            auto found = id_to_shadow_.find(node_id);
+            if (found == id_to_shadow_.end())
+            {
+                Shadow new_shadow{node_id, true, {}, Heartbeat{&memory_}, cetl::nullopt, cetl::nullopt, 0, 0, 0, 0};
+                found = id_to_shadow_.emplace(node_id, std::move(new_shadow)).first;
+            }
+            auto& shadow = found->second;
+            seq_to_node_id_.erase(shadow.sequence);
+            shadow.sequence = ++sequence_;
+            seq_to_node_id_.emplace(shadow.sequence, node_id);
+
+            // Like the real monitor does on discovery.
+            if (0 == shadow.boot_sequence)
+            {
+                shadow.info_sequence      = shadow.sequence;
+                shadow.port_list_sequence = shadow.sequence;
+                shadow.boot_sequence      = shadow.sequence;
+            }
+            return shadow;
+        }
+
+        // NodeMonitor
+
+        std::uint64_t sequence() const noexcept override
+        {
+            return sequence_;
+        }
+
+        bool hasAnonymous() const noexcept override
+        {
+            return false;
+        }
+
+        const PortIndex& portIndex() const noexcept override
+        {
+            return port_index_;
+        }
+
+        const Shadow* findShadow(const std::uint16_t node_id) const override
+        {
+            const auto found = id_to_shadow_.find(node_id);
+            return (found != id_to_shadow_.end()) ? &found->second : nullptr;
+        }
+
+        void visitChangedSince(const std::uint64_t since_sequence, const ShadowVisitor& visitor) const override
+        {
+            for (auto it = seq_to_node_id_.upper_bound(since_sequence); it != seq_to_node_id_.end(); ++it)
+            {
+                visitor(id_to_shadow_.at(it->second));
+            }
+        }
+
+    private:
+        cetl::pmr::memory_resource&            memory_;
+        std::uint64_t                          sequence_{0};
+        std::map<std::uint16_t, Shadow>        id_to_shadow_;
+        std::map<std::uint64_t, std::uint16_t> seq_to_node_id_;
+        PortIndex                              port_index_;
+
+    };  // NodeMonitorFake
+
+    using Responses = std::vector<Spec::Response>;
+
+    void SetUp() override
+    {
+        SnapshotService::registerWithContext(context_, monitor_);
+    }
+
+    /// Opens a new snapshot stream - all messages sent by the service to the client are collected.
+    ///
+    std::shared_ptr<StrictMock<GatewayMock>> openStream(const std::uint32_t update_period_ms,
+                                                        const bool          with_port_lists)
+    {
+        auto gateway = std::make_shared<StrictMock<GatewayMock>>();
+        EXPECT_CALL(*gateway, subscribe(_)).Times(1);
+        EXPECT_CALL(*gateway, send(_, _)).WillRepeatedly(Invoke([this](auto, const auto payload) {
+            //
+            Spec::Response response{&mr_};
+            EXPECT_THAT(ocvsmd::common::tryDeserializePayload(payload, response), IsTrue());
+            responses_.push_back(std::move(response));
+            return 0;
+        }));
+
+        Spec::Request request{&mr_};
+        request.update_period_ms = update_period_ms;
+        request.with_port_lists  = with_port_lists;
+        EXPECT_THAT(ipc_router_.emulateNewChannel(Spec::svc_full_name(), gateway, request), IsTrue());
+        return gateway;
+    }
+
+    /// Gets node IDs of the collected responses (or 0xFFFF for the update end ones).
+    ///
+    std::vector<std::uint16_t> responseNodeIds() const
+    {
+        std::vector<std::uint16_t> node_ids;
+        for (const auto& response : responses_)
+        {
+            node_ids.push_back(response.node.empty() ? 0xFFFF : response.node.front().node_id);
+        }
+        return node_ids;
+    }
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    ocvsmd::TrackingMemoryResource                    mr_;
+    libcyphal::VirtualTimeScheduler                   scheduler_{};
+    ocvsmd::daemon::engine::cyphal::TransportEmulator transport_{mr_, scheduler_};
+    libcyphal::presentation::Presentation             presentation_{mr_, scheduler_, transport_.transport()};
+    ocvsmd::daemon::engine::MemoryAccounting          memory_accounting_{mr_};
+    StrictMock<ocvsmd::daemon::engine::ConfigMock>    config_;
+    NodeMonitorFake                                   monitor_{mr_};
+    ocvsmd::common::ipc::ServerRouterMock             ipc_router_{mr_};
+    ocvsmd::daemon::engine::svc::ScvContext           context_{mr_,
+                                                     scheduler_,
+                                                     ipc_router_,
+                                                     presentation_,
+                                                     memory_accounting_,
+                                                     config_,
+                                                     "udp",
+                                                     true};
+    Responses                                         responses_;
+    // NOLINTEND
+};
+
+// MARK: - Tests:
+
+TEST_F(TestSnapshotService, registered_per_network)
+{
+    EXPECT_THAT(ipc_router_.isRegistered<Spec::Request>(Spec::svc_full_name()), IsTrue());
+    EXPECT_THAT(ipc_router_.isRegistered<Spec::Request>("ocvsmd.svc.monitor.snapshot@udp"), IsTrue());
+}
+
+TEST_F(TestSnapshotService, snapshot_then_updates)
+{
+    monitor_.change(1).info.emplace(NodeMonitor::Shadow::Info{{}, NodeMonitor::NodeInfo{&mr_}});
+    monitor_.change(2);
+    monitor_.change(1).info_sequence = monitor_.sequence();
+
+    // The snapshot - all nodes (in their change order), followed by the end message.
+    const auto gateway = openStream(100, false);
+    ASSERT_THAT(responseNodeIds(), ElementsAre(2, 1, 0xFFFF));
+    for (const auto& response : responses_)
+    {
+        EXPECT_THAT(response.is_snapshot, IsTrue());
+        EXPECT_THAT(response.sequence, 3);
+    }
+    EXPECT_THAT(responses_[2].is_update_end, IsTrue());
+    EXPECT_THAT(responses_[0].node.front().is_info_changed, IsTrue());
+    EXPECT_THAT(responses_[0].node.front().info, IsEmpty());
+    EXPECT_THAT(responses_[1].node.front().is_info_changed, IsTrue());
+    EXPECT_THAT(responses_[1].node.front().info, SizeIs(1));
+    responses_.clear();
+
+    // Nothing has changed - nothing is sent.
+    scheduler_.spinFor(250ms);
+    EXPECT_THAT(responses_, IsEmpty());
+
+    // Only changed nodes are sent, and the info only if it has changed.
+    monitor_.change(1).last_heartbeat.health.value = 2;
+    scheduler_.spinFor(100ms);
+    ASSERT_THAT(responseNodeIds(), ElementsAre(1, 0xFFFF));
+    EXPECT_THAT(responses_[0].is_snapshot, IsFalse());
+    EXPECT_THAT(responses_[0].sequence, 4);
+    EXPECT_THAT(responses_[0].node.front().heartbeat.health.value, 2);
+    EXPECT_THAT(responses_[0].node.front().is_info_changed, IsFalse());
+    EXPECT_THAT(responses_[1].is_update_end, IsTrue());
+    responses_.clear();
+
+    // Changes within the update period are coalesced.
+    monitor_.change(2);
+    monitor_.change(1);
+    monitor_.change(2);
+    scheduler_.spinFor(100ms);
+    ASSERT_THAT(responseNodeIds(), ElementsAre(1, 2, 0xFFFF));
+    EXPECT_THAT(responses_[2].sequence, 7);
+    responses_.clear();
+
+    // The client has completed the stream - no more updates.
+    EXPECT_CALL(*gateway, complete(ECANCELED)).Times(1);
+    EXPECT_THAT(gateway->event_handler_(ocvsmd::common::ipc::detail::Gateway::Event::Completed{}), 0);
+    monitor_.change(1);
+    scheduler_.spinFor(500ms);
+    EXPECT_THAT(responses_, IsEmpty());
+}
+
+TEST_F(TestSnapshotService, port_list_split)
+{
+    constexpr std::size_t MaxRuns  = NodeDelta::MAX_PORT_RUNS;
+    constexpr std::size_t RunCount = (2 * MaxRuns) + 44;
+
+    // Every other subject ID - so that each one is a separate run.
+    auto port_list = NodeMonitor::Shadow::PortList::makeEmpty(mr_);
+    for (std::size_t i = 0; i < RunCount; ++i)
+    {
+        port_list.publishers.insert(static_cast<std::uint16_t>(i * 2));
+    }
+    auto& shadow = monitor_.change(42);
+    shadow.port_list.emplace(port_list);
+    shadow.port_list_sequence = shadow.sequence;
+
+    // The node delta is split into several messages - only the first one resets the port list.
+    const auto gateway = openStream(100, true);
+    ASSERT_THAT(responseNodeIds(), ElementsAre(42, 42, 42, 0xFFFF));
+    std::vector<std::size_t> run_counts;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        const auto& delta = responses_[i].node.front();
+        EXPECT_THAT(delta.is_port_list_reset, (i == 0));
+        EXPECT_THAT(delta.is_info_changed, (i == 0));
+        EXPECT_THAT(delta.removed_publishers, IsEmpty());
+        run_counts.push_back(delta.added_publishers.size());
+    }
+    EXPECT_THAT(run_counts, ElementsAre(MaxRuns, MaxRuns, 44));
+    EXPECT_THAT(responses_[1].node.front().added_publishers.front().first, MaxRuns * 2);
+    EXPECT_THAT(responses_[2].node.front().added_publishers.back().last, (RunCount - 1) * 2);
+    responses_.clear();
+
+    // Removal of all of them is split as well (but it's not a reset).
+    auto& changed = monitor_.change(42);
+    changed.port_list.emplace(NodeMonitor::Shadow::PortList::makeEmpty(mr_));
+    changed.port_list_sequence = changed.sequence;
+    scheduler_.spinFor(100ms);
+    ASSERT_THAT(responseNodeIds(), ElementsAre(42, 42, 42, 0xFFFF));
+    run_counts.clear();
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        const auto& delta = responses_[i].node.front();
+        EXPECT_THAT(delta.is_port_list_reset, IsFalse());
+        EXPECT_THAT(delta.added_publishers, IsEmpty());
+        run_counts.push_back(delta.removed_publishers.size());
+    }
+    EXPECT_THAT(run_counts, ElementsAre(MaxRuns, MaxRuns, 44));
+
+    EXPECT_CALL(*gateway, complete(ECANCELED)).Times(1);
+    EXPECT_THAT(gateway->event_handler_(ocvsmd::common::ipc::detail::Gateway::Event::Completed{}), 0);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
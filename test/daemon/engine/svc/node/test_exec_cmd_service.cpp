@@ -0,0 +1,202 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "svc/node/exec_cmd_service.hpp"
+
+#include "common/ipc/gateway_mock.hpp"
+#include "common/ipc/server_router_mock.hpp"
+#include "daemon/engine/config_mock.hpp"
+#include "daemon/engine/cyphal/transport_emulator.hpp"
+#include "dsdl_helpers.hpp"
+#include "memory_accounting.hpp"
+#include "svc/node/exec_cmd_spec.hpp"
+#include "svc/svc_helpers.hpp"
+#include "tracking_memory_resource.hpp"
+#include "virtual_time_scheduler.hpp"
+
+#include <uavcan/node/ExecuteCommand_1_3.hpp>
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/presentation/presentation.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+using ocvsmd::daemon::engine::svc::node::ExecCmdService;
+
+using GatewayMock = ocvsmd::common::ipc::detail::GatewayMock;
+using Spec        = ocvsmd::common::svc::node::ExecCmdSpec;
+
+using testing::_;
+using testing::Gt;
+using testing::Invoke;
+using testing::Return;
+using testing::IsTrue;
+using testing::SizeIs;
+using testing::IsEmpty;
+using testing::StrictMock;
+using testing::ElementsAre;
+
+using std::literals::chrono_literals::operator""s;
+using std::literals::chrono_literals::operator""ms;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestExecCmdService : public testing::Test
+{
+protected:
+    using CyphalExecCmdSvc = uavcan::node::ExecuteCommand_1_3;
+
+    void SetUp() override
+    {
+        EXPECT_CALL(config_, getSvcExecCmdMaxInFlightPerRequest()).WillOnce(Return(cetl::nullopt));
+        EXPECT_CALL(config_, getSvcExecCmdMaxInFlight()).WillOnce(Return(cetl::nullopt));
+        EXPECT_CALL(config_, getSvcExecCmdRequestSpacing()).WillOnce(Return(std::chrono::microseconds{0}));
+
+        ExecCmdService::registerWithContext(context_);
+    }
+
+    /// Makes a request with a retry policy: up to 3 attempts (1s each, with 500ms backoff) within 10s.
+    ///
+    Spec::Request makeRequest(const std::vector<std::uint16_t>& node_ids)
+    {
+        Spec::Request request{&mr_};
+        request.timeout_us         = 10'000'000;
+        request.max_attempts       = 3;
+        request.attempt_timeout_us = 1'000'000;
+        request.backoff_us         = 500'000;
+        request.payload.command    = 65535;
+        for (const auto node_id : node_ids)
+        {
+            request.node_ids.push_back(node_id);
+        }
+        return request;
+    }
+
+    /// Opens a new channel - all responses sent by the service to the client are collected.
+    ///
+    std::shared_ptr<StrictMock<GatewayMock>> open(const Spec::Request& request)
+    {
+        auto gateway = std::make_shared<StrictMock<GatewayMock>>();
+        EXPECT_CALL(*gateway, subscribe(_)).Times(1);
+        EXPECT_CALL(*gateway, send(_, _)).WillRepeatedly(Invoke([this](auto, const auto payload) {
+            //
+            Spec::Response response{&mr_};
+            EXPECT_THAT(ocvsmd::common::tryDeserializePayload(payload, response), IsTrue());
+            responded_node_ids_.push_back(response.node_id);
+            return 0;
+        }));
+
+        EXPECT_THAT(ipc_router_.emulateNewChannel(Spec::svc_full_name(), gateway, request), IsTrue());
+        return gateway;
+    }
+
+    /// Gets server node IDs of all sent Cyphal requests (in the order of their sending).
+    ///
+    std::vector<std::uint16_t> sentNodeIds()
+    {
+        std::vector<std::uint16_t> node_ids;
+        for (const auto& request : transport_.requests())
+        {
+            node_ids.push_back(request.server_node_id);
+        }
+        return node_ids;
+    }
+
+    /// Responds (with a successful status) to the `index`-th sent Cyphal request.
+    ///
+    bool respond(const std::size_t index)
+    {
+        const auto& requests = transport_.requests();
+        EXPECT_THAT(requests, SizeIs(Gt(index)));
+        if (requests.size() <= index)
+        {
+            return false;
+        }
+        // Copy the request b/c the response might cause new requests to be sent (and so `requests` reallocated).
+        const auto                 request = requests[index];
+        CyphalExecCmdSvc::Response response{&mr_};
+        response.status = CyphalExecCmdSvc::Response::STATUS_SUCCESS;
+        return transport_.respond(request, response);
+    }
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    ocvsmd::TrackingMemoryResource                    mr_;
+    libcyphal::VirtualTimeScheduler                   scheduler_{};
+    ocvsmd::daemon::engine::cyphal::TransportEmulator transport_{mr_, scheduler_};
+    libcyphal::presentation::Presentation             presentation_{mr_, scheduler_, transport_.transport()};
+    ocvsmd::daemon::engine::MemoryAccounting          memory_accounting_{mr_};
+    StrictMock<ocvsmd::daemon::engine::ConfigMock>    config_;
+    ocvsmd::common::ipc::ServerRouterMock             ipc_router_{mr_};
+    ocvsmd::daemon::engine::svc::ScvContext           context_{mr_,
+                                                     scheduler_,
+                                                     ipc_router_,
+                                                     presentation_,
+                                                     memory_accounting_,
+                                                     config_,
+                                                     "udp",
+                                                     true};
+    std::vector<std::uint16_t>                        responded_node_ids_;
+    // NOLINTEND
+};
+
+// MARK: - Tests:
+
+TEST_F(TestExecCmdService, retry_missing_node)
+{
+    const auto gateway = open(makeRequest({42}));
+    scheduler_.spinFor(10ms);
+    EXPECT_THAT(sentNodeIds(), ElementsAre(42));
+
+    // The first attempt times out (at 1s), and the node is retried after the backoff (at 1.5s).
+    scheduler_.spinFor(1s);
+    EXPECT_THAT(sentNodeIds(), ElementsAre(42));
+    EXPECT_THAT(responded_node_ids_, IsEmpty());
+    scheduler_.spinFor(1s);
+    EXPECT_THAT(sentNodeIds(), ElementsAre(42, 42));
+
+    // The retried node responds - its result is streamed back, and the request is completed.
+    EXPECT_CALL(*gateway, complete(0)).Times(1);
+    EXPECT_THAT(respond(1), IsTrue());
+    EXPECT_THAT(responded_node_ids_, ElementsAre(42));
+
+    // Late response to the first (already expired) attempt is ignored.
+    (void) respond(0);
+    scheduler_.spinFor(10s);
+    EXPECT_THAT(responded_node_ids_, ElementsAre(42));
+    EXPECT_THAT(sentNodeIds(), ElementsAre(42, 42));
+}
+
+TEST_F(TestExecCmdService, retry_only_missing_nodes)
+{
+    const auto gateway = open(makeRequest({42, 43}));
+    scheduler_.spinFor(10ms);
+    const auto first_node_ids = sentNodeIds();
+    ASSERT_THAT(first_node_ids, SizeIs(2));
+
+    // Only one of the nodes responds in time - so only the other one is retried (until its attempts are exhausted).
+    EXPECT_THAT(respond(0), IsTrue());
+    EXPECT_THAT(responded_node_ids_, ElementsAre(first_node_ids[0]));
+
+    EXPECT_CALL(*gateway, complete(0)).Times(1);
+    scheduler_.spinFor(10s);
+    EXPECT_THAT(sentNodeIds(), ElementsAre(first_node_ids[0], first_node_ids[1], first_node_ids[1], first_node_ids[1]));
+    EXPECT_THAT(responded_node_ids_, ElementsAre(first_node_ids[0]));
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
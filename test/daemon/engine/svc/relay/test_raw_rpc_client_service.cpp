@@ -0,0 +1,278 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "svc/relay/raw_rpc_client_service.hpp"
+
+#include "common/ipc/gateway_mock.hpp"
+#include "common/ipc/server_router_mock.hpp"
+#include "daemon/engine/config_mock.hpp"
+#include "daemon/engine/cyphal/transport_emulator.hpp"
+#include "dsdl_helpers.hpp"
+#include "ipc/gateway.hpp"
+#include "memory_accounting.hpp"
+#include "svc/relay/raw_rpc_client_spec.hpp"
+#include "svc/svc_helpers.hpp"
+#include "tracking_memory_resource.hpp"
+#include "virtual_time_scheduler.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/presentation/presentation.hpp>
+#include <libcyphal/transport/errors.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+using ocvsmd::daemon::engine::svc::relay::RawRpcClientService;
+
+using Gateway     = ocvsmd::common::ipc::detail::Gateway;
+using GatewayMock = ocvsmd::common::ipc::detail::GatewayMock;
+using Spec        = ocvsmd::common::svc::relay::RawRpcClientSpec;
+
+using testing::_;
+using testing::Gt;
+using testing::Pair;
+using testing::Invoke;
+using testing::Return;
+using testing::IsTrue;
+using testing::SizeIs;
+using testing::IsEmpty;
+using testing::StrictMock;
+using testing::ElementsAre;
+
+using std::literals::chrono_literals::operator""s;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestRawRpcClientService : public testing::Test
+{
+protected:
+    static constexpr std::uint16_t ServiceId = 123;
+
+    void SetUp() override
+    {
+        EXPECT_CALL(config_, getSvcRawRpcClientMaxClients()).WillOnce(Return(cetl::nullopt));
+        EXPECT_CALL(config_, getSvcRawRpcClientMaxClientsBytes()).WillOnce(Return(cetl::nullopt));
+
+        RawRpcClientService::registerWithContext(context_);
+    }
+
+    Spec::Request makeRequest(const std::uint64_t call_id, const std::uint16_t server_node_id)
+    {
+        Spec::Request request{&mr_};
+        request.call_id        = call_id;
+        request.service_id     = ServiceId;
+        request.server_node_id = server_node_id;
+        request.payload.push_back(static_cast<std::uint8_t>(call_id));
+        return request;
+    }
+
+    /// Opens a new channel (with the given initial call) - all responses sent by the service are collected.
+    ///
+    std::shared_ptr<StrictMock<GatewayMock>> open(const Spec::Request& request)
+    {
+        auto gateway = std::make_shared<StrictMock<GatewayMock>>();
+        EXPECT_CALL(*gateway, subscribe(_)).Times(1);
+        EXPECT_CALL(*gateway, send(_, _)).WillRepeatedly(Invoke([this](auto, const auto payload) {
+            //
+            Spec::Response response{&mr_};
+            EXPECT_THAT(ocvsmd::common::tryDeserializePayload(payload, response), IsTrue());
+            responses_.push_back(std::move(response));
+            return 0;
+        }));
+
+        EXPECT_THAT(ipc_router_.emulateNewChannel(Spec::svc_full_name(), gateway, request), IsTrue());
+        return gateway;
+    }
+
+    /// Emulates a subsequent call (an input message from the client) on the already opened channel.
+    ///
+    static bool call(GatewayMock& gateway, const Spec::Request& request)
+    {
+        const int result = ocvsmd::common::tryPerformOnSerialized(request, [&gateway](const auto payload) {
+            //
+            return gateway.event_handler_(Gateway::Event::Message{0, payload});
+        });
+        return 0 == result;
+    }
+
+    /// Responds to the `index`-th sent Cyphal request with a single byte payload.
+    ///
+    bool respond(const std::size_t index, const std::uint8_t byte)
+    {
+        const auto& requests = transport_.requests();
+        EXPECT_THAT(requests, SizeIs(Gt(index)));
+        return (requests.size() > index) && transport_.respondRaw(requests[index], {byte});
+    }
+
+    /// Gets call IDs and error codes of the received responses (in the order of their arrival).
+    ///
+    std::vector<std::pair<std::uint64_t, std::int32_t>> receivedCalls() const
+    {
+        std::vector<std::pair<std::uint64_t, std::int32_t>> calls;
+        for (const auto& response : responses_)
+        {
+            calls.emplace_back(response.call_id, response.error_code);
+        }
+        return calls;
+    }
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    ocvsmd::TrackingMemoryResource                    mr_;
+    libcyphal::VirtualTimeScheduler                   scheduler_{};
+    ocvsmd::daemon::engine::cyphal::TransportEmulator transport_{mr_, scheduler_};
+    libcyphal::presentation::Presentation             presentation_{mr_, scheduler_, transport_.transport()};
+    ocvsmd::daemon::engine::MemoryAccounting          memory_accounting_{mr_};
+    StrictMock<ocvsmd::daemon::engine::ConfigMock>    config_;
+    ocvsmd::common::ipc::ServerRouterMock             ipc_router_{mr_};
+    ocvsmd::daemon::engine::svc::ScvContext           context_{mr_,
+                                                     scheduler_,
+                                                     ipc_router_,
+                                                     presentation_,
+                                                     memory_accounting_,
+                                                     config_,
+                                                     "udp",
+                                                     true};
+    std::vector<Spec::Response>                       responses_;
+    // NOLINTEND
+};
+
+// MARK: - Tests:
+
+TEST_F(TestRawRpcClientService, multiplexing)
+{
+    const auto gateway = open(makeRequest(1, 42));
+    EXPECT_THAT(call(*gateway, makeRequest(2, 42)), IsTrue());
+    EXPECT_THAT(call(*gateway, makeRequest(3, 43)), IsTrue());
+
+    // All calls are in flight at the same time.
+    const auto& requests = transport_.requests();
+    ASSERT_THAT(requests, SizeIs(3));
+    EXPECT_THAT(requests[0].server_node_id, 42);
+    EXPECT_THAT(requests[0].payload, ElementsAre(1));
+    EXPECT_THAT(requests[1].server_node_id, 42);
+    EXPECT_THAT(requests[1].payload, ElementsAre(2));
+    EXPECT_THAT(requests[2].server_node_id, 43);
+    EXPECT_THAT(requests[2].payload, ElementsAre(3));
+    EXPECT_THAT(responses_, IsEmpty());
+
+    // Responses are sent back in the order of their arrival - each one with its own call ID.
+    EXPECT_THAT(respond(2, 0x33), IsTrue());
+    EXPECT_THAT(respond(0, 0x11), IsTrue());
+    EXPECT_THAT(receivedCalls(), ElementsAre(Pair(3, 0), Pair(1, 0)));
+    EXPECT_THAT(responses_[0].payload, ElementsAre(0x33));
+    EXPECT_THAT(responses_[1].payload, ElementsAre(0x11));
+
+    // The remaining one is timed out (by the default timeout of 1s).
+    scheduler_.spinFor(2s);
+    EXPECT_THAT(receivedCalls(), ElementsAre(Pair(3, 0), Pair(1, 0), Pair(2, ETIMEDOUT)));
+
+    // Late response of the timed out call is ignored.
+    EXPECT_THAT(respond(1, 0x22), IsTrue());
+    EXPECT_THAT(responses_, SizeIs(3));
+
+    EXPECT_CALL(*gateway, complete(ECANCELED)).Times(1);
+    EXPECT_THAT(gateway->event_handler_(Gateway::Event::Completed{}), 0);
+}
+
+TEST_F(TestRawRpcClientService, duplicate_call_id)
+{
+    const auto gateway = open(makeRequest(1, 42));
+
+    // The call ID is still in flight - so the duplicate is rejected (without sending anything).
+    EXPECT_THAT(call(*gateway, makeRequest(1, 43)), IsTrue());
+    EXPECT_THAT(transport_.requests(), SizeIs(1));
+    EXPECT_THAT(receivedCalls(), ElementsAre(Pair(1, EEXIST)));
+
+    // Once the call is done, its ID could be reused.
+    EXPECT_THAT(respond(0, 0x11), IsTrue());
+    EXPECT_THAT(receivedCalls(), ElementsAre(Pair(1, EEXIST), Pair(1, 0)));
+    EXPECT_THAT(call(*gateway, makeRequest(1, 43)), IsTrue());
+    EXPECT_THAT(transport_.requests(), SizeIs(2));
+    EXPECT_THAT(respond(1, 0x22), IsTrue());
+    EXPECT_THAT(receivedCalls(), ElementsAre(Pair(1, EEXIST), Pair(1, 0), Pair(1, 0)));
+
+    EXPECT_CALL(*gateway, complete(ECANCELED)).Times(1);
+    EXPECT_THAT(gateway->event_handler_(Gateway::Event::Completed{}), 0);
+}
+
+TEST_F(TestRawRpcClientService, in_flight_limit)
+{
+    constexpr std::uint64_t MaxInFlight = 256;
+
+    const auto gateway = open(makeRequest(0, 42));
+    for (std::uint64_t call_id = 1; call_id < MaxInFlight; ++call_id)
+    {
+        EXPECT_THAT(call(*gateway, makeRequest(call_id, 42)), IsTrue());
+    }
+    EXPECT_THAT(transport_.requests(), SizeIs(MaxInFlight));
+    EXPECT_THAT(responses_, IsEmpty());
+
+    // One more call is over the limit.
+    EXPECT_THAT(call(*gateway, makeRequest(MaxInFlight, 42)), IsTrue());
+    EXPECT_THAT(transport_.requests(), SizeIs(MaxInFlight));
+    EXPECT_THAT(receivedCalls(), ElementsAre(Pair(MaxInFlight, EBUSY)));
+
+    // A completed call frees a slot.
+    EXPECT_THAT(respond(7, 0x77), IsTrue());
+    EXPECT_THAT(call(*gateway, makeRequest(MaxInFlight, 42)), IsTrue());
+    EXPECT_THAT(transport_.requests(), SizeIs(MaxInFlight + 1));
+    EXPECT_THAT(receivedCalls(), ElementsAre(Pair(MaxInFlight, EBUSY), Pair(7, 0)));
+
+    EXPECT_CALL(*gateway, complete(ECANCELED)).Times(1);
+    EXPECT_THAT(gateway->event_handler_(Gateway::Event::Completed{}), 0);
+}
+
+TEST_F(TestRawRpcClientService, invalid_requests)
+{
+    auto request       = makeRequest(1, 42);
+    request.priority   = 8;
+    const auto gateway = open(request);
+    EXPECT_THAT(receivedCalls(), ElementsAre(Pair(1, EINVAL)));
+
+    // Failed sending is reported as the call failure, and the next call is sent as usual.
+    transport_.setSendFailure(libcyphal::transport::AnyFailure{libcyphal::transport::CapacityError{}});
+    EXPECT_THAT(call(*gateway, makeRequest(2, 42)), IsTrue());
+    EXPECT_THAT(receivedCalls(), ElementsAre(Pair(1, EINVAL), Pair(2, ENOMEM)));
+    transport_.setSendFailure(cetl::nullopt);
+    EXPECT_THAT(call(*gateway, makeRequest(3, 42)), IsTrue());
+    EXPECT_THAT(transport_.requests(), SizeIs(1));
+    EXPECT_THAT(respond(0, 0x33), IsTrue());
+    EXPECT_THAT(receivedCalls(), ElementsAre(Pair(1, EINVAL), Pair(2, ENOMEM), Pair(3, 0)));
+
+    EXPECT_CALL(*gateway, complete(ECANCELED)).Times(1);
+    EXPECT_THAT(gateway->event_handler_(Gateway::Event::Completed{}), 0);
+}
+
+TEST_F(TestRawRpcClientService, completion_cancels_calls)
+{
+    const auto gateway = open(makeRequest(1, 42));
+    EXPECT_THAT(call(*gateway, makeRequest(2, 43)), IsTrue());
+    EXPECT_THAT(transport_.requests(), SizeIs(2));
+
+    EXPECT_CALL(*gateway, complete(ECANCELED)).Times(1);
+    EXPECT_THAT(gateway->event_handler_(Gateway::Event::Completed{}), 0);
+
+    // Nothing is sent back for the cancelled calls - neither responses, nor timeouts.
+    (void) respond(0, 0x11);
+    scheduler_.spinFor(2s);
+    EXPECT_THAT(responses_, IsEmpty());
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
@@ -0,0 +1,264 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "svc/relay/raw_subscriber_service.hpp"
+
+#include "common/ipc/gateway_mock.hpp"
+#include "common/ipc/server_router_mock.hpp"
+#include "daemon/engine/config_mock.hpp"
+#include "daemon/engine/cyphal/transport_emulator.hpp"
+#include "dsdl_helpers.hpp"
+#include "memory_accounting.hpp"
+#include "svc/relay/raw_subscriber_spec.hpp"
+#include "svc/svc_helpers.hpp"
+#include "tracking_memory_resource.hpp"
+#include "virtual_time_scheduler.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <libcyphal/presentation/presentation.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+using ocvsmd::daemon::engine::svc::relay::RawSubscriberService;
+
+using GatewayMock = ocvsmd::common::ipc::detail::GatewayMock;
+using Spec        = ocvsmd::common::svc::relay::RawSubscriberSpec;
+
+using testing::_;
+using testing::Invoke;
+using testing::IsTrue;
+using testing::IsEmpty;
+using testing::StrictMock;
+using testing::ElementsAre;
+
+using std::literals::chrono_literals::operator""ms;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestRawSubscriberService : public testing::Test
+{
+protected:
+    static constexpr std::uint16_t SubjectId = 1234;
+
+    void SetUp() override
+    {
+        RawSubscriberService::registerWithContext(context_);
+    }
+
+    Spec::Request makeRequest()
+    {
+        Spec::Request request{&mr_};
+        request.subject_id = SubjectId;
+        return request;
+    }
+
+    /// Opens a new subscription - all messages sent by the service to the client are collected
+    /// (unless the client is "blocked" - then the service gets `EAGAIN` as if the IPC socket would block).
+    ///
+    std::shared_ptr<StrictMock<GatewayMock>> subscribe(const Spec::Request& request)
+    {
+        auto gateway = std::make_shared<StrictMock<GatewayMock>>();
+        EXPECT_CALL(*gateway, subscribe(_)).Times(1);
+        EXPECT_CALL(*gateway, enableBackPressure()).Times(1);
+        EXPECT_CALL(*gateway, send(_, _)).WillRepeatedly(Invoke([this](auto, const auto payload) {
+            //
+            if (is_client_blocked_)
+            {
+                return EAGAIN;
+            }
+            Spec::Response response{&mr_};
+            EXPECT_THAT(ocvsmd::common::tryDeserializePayload(payload, response), IsTrue());
+            responses_.push_back(std::move(response));
+            return 0;
+        }));
+
+        EXPECT_THAT(ipc_router_.emulateNewChannel(Spec::svc_full_name(), gateway, request), IsTrue());
+        return gateway;
+    }
+
+    bool publish(const cetl::optional<std::uint16_t> publisher_node_id, const std::uint64_t transfer_id)
+    {
+        return transport_.publishRaw(SubjectId, {0x2A}, publisher_node_id, transfer_id);
+    }
+
+    /// Gets transfer IDs of the received messages (or `~0` for the status ones).
+    ///
+    std::vector<std::uint64_t> receivedTransferIds() const
+    {
+        std::vector<std::uint64_t> transfer_ids;
+        for (const auto& response : responses_)
+        {
+            transfer_ids.push_back(response.message.empty() ? ~std::uint64_t{0} : response.message.front().transfer_id);
+        }
+        return transfer_ids;
+    }
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    ocvsmd::TrackingMemoryResource                    mr_;
+    libcyphal::VirtualTimeScheduler                   scheduler_{};
+    ocvsmd::daemon::engine::cyphal::TransportEmulator transport_{mr_, scheduler_};
+    libcyphal::presentation::Presentation             presentation_{mr_, scheduler_, transport_.transport()};
+    ocvsmd::daemon::engine::MemoryAccounting          memory_accounting_{mr_};
+    StrictMock<ocvsmd::daemon::engine::ConfigMock>    config_;
+    ocvsmd::common::ipc::ServerRouterMock             ipc_router_{mr_};
+    ocvsmd::daemon::engine::svc::ScvContext           context_{mr_,
+                                                     scheduler_,
+                                                     ipc_router_,
+                                                     presentation_,
+                                                     memory_accounting_,
+                                                     config_,
+                                                     "udp",
+                                                     true};
+    bool                                              is_client_blocked_{false};
+    std::vector<Spec::Response>                       responses_;
+    // NOLINTEND
+};
+
+// MARK: - Tests:
+
+TEST_F(TestRawSubscriberService, source_filter)
+{
+    auto request = makeRequest();
+    request.source_node_ids.push_back(42);
+    request.source_node_ids.push_back(13);
+    const auto gateway = subscribe(request);
+
+    EXPECT_THAT(publish(42, 0), IsTrue());
+    EXPECT_THAT(publish(7, 1), IsTrue());
+    EXPECT_THAT(publish(cetl::nullopt, 2), IsTrue());
+    EXPECT_THAT(publish(13, 3), IsTrue());
+    EXPECT_THAT(receivedTransferIds(), ElementsAre(0, 3));
+    EXPECT_THAT(responses_[0].message.front().publisher_node_id, ElementsAre(42));
+    EXPECT_THAT(responses_[1].message.front().publisher_node_id, ElementsAre(13));
+}
+
+TEST_F(TestRawSubscriberService, decimation)
+{
+    auto request = makeRequest();
+    request.source_node_ids.push_back(42);
+    request.decimation = 3;
+    const auto gateway = subscribe(request);
+
+    // Messages filtered out by the source are not counted by the decimation.
+    for (std::uint64_t transfer_id = 0; transfer_id < 7; ++transfer_id)
+    {
+        EXPECT_THAT(publish(42, transfer_id), IsTrue());
+        EXPECT_THAT(publish(7, 100 + transfer_id), IsTrue());
+    }
+    EXPECT_THAT(receivedTransferIds(), ElementsAre(0, 3, 6));
+}
+
+TEST_F(TestRawSubscriberService, rate_limit)
+{
+    auto request          = makeRequest();
+    request.min_period_us = 100'000;
+    const auto gateway    = subscribe(request);
+
+    EXPECT_THAT(publish(42, 0), IsTrue());
+    scheduler_.spinFor(50ms);
+    EXPECT_THAT(publish(42, 1), IsTrue());
+    scheduler_.spinFor(50ms);
+    EXPECT_THAT(publish(42, 2), IsTrue());
+    EXPECT_THAT(publish(42, 3), IsTrue());
+
+    // The period is counted from the previously accepted message - not from the previously received one.
+    scheduler_.spinFor(99ms);
+    EXPECT_THAT(publish(42, 4), IsTrue());
+    scheduler_.spinFor(1ms);
+    EXPECT_THAT(publish(42, 5), IsTrue());
+    EXPECT_THAT(receivedTransferIds(), ElementsAre(0, 2, 5));
+}
+
+TEST_F(TestRawSubscriberService, decimation_then_rate_limit)
+{
+    auto request          = makeRequest();
+    request.decimation    = 2;
+    request.min_period_us = 100'000;
+    const auto gateway    = subscribe(request);
+
+    // Every other message passes the decimation, and only then the rate limit is applied.
+    for (std::uint64_t transfer_id = 0; transfer_id < 8; ++transfer_id)
+    {
+        EXPECT_THAT(publish(42, transfer_id), IsTrue());
+        scheduler_.spinFor(30ms);
+    }
+    EXPECT_THAT(receivedTransferIds(), ElementsAre(0, 4));
+}
+
+TEST_F(TestRawSubscriberService, latest_only)
+{
+    auto request        = makeRequest();
+    request.latest_only = true;
+    const auto gateway  = subscribe(request);
+
+    // While the client is blocked, not yet sent messages are replaced by the latest one (without drops).
+    is_client_blocked_ = true;
+    EXPECT_THAT(publish(42, 0), IsTrue());
+    EXPECT_THAT(publish(42, 1), IsTrue());
+    EXPECT_THAT(publish(42, 2), IsTrue());
+    scheduler_.spinFor(50ms);
+    EXPECT_THAT(responses_, IsEmpty());
+
+    is_client_blocked_ = false;
+    scheduler_.spinFor(20ms);
+    EXPECT_THAT(receivedTransferIds(), ElementsAre(2));
+
+    EXPECT_THAT(publish(42, 3), IsTrue());
+    EXPECT_THAT(receivedTransferIds(), ElementsAre(2, 3));
+}
+
+TEST_F(TestRawSubscriberService, overflow_drop_oldest)
+{
+    auto request           = makeRequest();
+    request.queue_capacity = 2;
+    const auto gateway     = subscribe(request);
+
+    is_client_blocked_ = true;
+    for (std::uint64_t transfer_id = 0; transfer_id < 5; ++transfer_id)
+    {
+        EXPECT_THAT(publish(42, transfer_id), IsTrue());
+    }
+
+    // The drop status goes first - followed by the queued (the newest) messages.
+    is_client_blocked_ = false;
+    scheduler_.spinFor(20ms);
+    EXPECT_THAT(receivedTransferIds(), ElementsAre(~std::uint64_t{0}, 3, 4));
+    EXPECT_THAT(responses_.front().dropped_count, 3);
+}
+
+TEST_F(TestRawSubscriberService, overflow_drop_newest)
+{
+    auto request            = makeRequest();
+    request.queue_capacity  = 2;
+    request.overflow_policy = Spec::Request::OVERFLOW_DROP_NEWEST;
+    const auto gateway      = subscribe(request);
+
+    is_client_blocked_ = true;
+    for (std::uint64_t transfer_id = 0; transfer_id < 5; ++transfer_id)
+    {
+        EXPECT_THAT(publish(42, transfer_id), IsTrue());
+    }
+
+    is_client_blocked_ = false;
+    scheduler_.spinFor(20ms);
+    EXPECT_THAT(receivedTransferIds(), ElementsAre(~std::uint64_t{0}, 0, 1));
+    EXPECT_THAT(responses_.front().dropped_count, 3);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
@@ -0,0 +1,233 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include <ocvsmd/sdk/coroutine.hpp>
+
+#include "ocvsmd/platform/defines.hpp"
+#include "tracking_memory_resource.hpp"
+
+#include <ocvsmd/sdk/execution.hpp>
+
+#include <cetl/pf17/cetlpf.hpp>
+#include <cetl/pmr/interface_ptr.hpp>
+#include <libcyphal/executor.hpp>
+#include <libcyphal/types.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+using ocvsmd::sdk::Task;
+using ocvsmd::sdk::SenderOf;
+
+using testing::IsTrue;
+using testing::ElementsAre;
+
+using std::literals::chrono_literals::operator""ms;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestCoroutine : public testing::Test
+{
+protected:
+    /// Defines a sender which completes (with the given value) right on submission.
+    ///
+    template <typename Result>
+    class ImmediateSender final : public SenderOf<Result>
+    {
+    public:
+        explicit ImmediateSender(Result result)
+            : result_{std::move(result)}
+        {
+        }
+
+        void submitImpl(typename SenderOf<Result>::Receiver&& receiver) override
+        {
+            receiver(std::move(result_));
+        }
+
+    private:
+        Result result_;
+
+    };  // ImmediateSender
+
+    /// Defines a sender which completes (with the given value) after the given delay - from an executor callback.
+    ///
+    template <typename Result>
+    class DeferredSender final : public SenderOf<Result>
+    {
+    public:
+        DeferredSender(libcyphal::IExecutor& executor, Result result, const libcyphal::Duration delay, bool* destroyed)
+            : executor_{executor}
+            , result_{std::move(result)}
+            , delay_{delay}
+            , destroyed_{destroyed}
+        {
+        }
+
+        DeferredSender(const DeferredSender&)                = delete;
+        DeferredSender(DeferredSender&&) noexcept            = delete;
+        DeferredSender& operator=(const DeferredSender&)     = delete;
+        DeferredSender& operator=(DeferredSender&&) noexcept = delete;
+
+        ~DeferredSender() override
+        {
+            if (destroyed_ != nullptr)
+            {
+                *destroyed_ = true;
+            }
+        }
+
+        void submitImpl(typename SenderOf<Result>::Receiver&& receiver) override
+        {
+            receiver_.emplace(std::move(receiver));
+            callback_ = executor_.registerCallback([this](const auto&) {
+                //
+                (*receiver_)(std::move(result_));
+            });
+            callback_.schedule(libcyphal::IExecutor::Callback::Schedule::Once{executor_.now() + delay_});
+        }
+
+    private:
+        libcyphal::IExecutor&                               executor_;
+        Result                                              result_;
+        libcyphal::Duration                                 delay_;
+        bool*                                               destroyed_;
+        cetl::optional<typename SenderOf<Result>::Receiver> receiver_;
+        libcyphal::IExecutor::Callback::Any                 callback_;
+
+    };  // DeferredSender
+
+    template <typename Result>
+    typename SenderOf<Result>::Ptr immediate(Result result)
+    {
+        return cetl::pmr::InterfaceFactory::make_unique<SenderOf<Result>>(
+            cetl::pmr::polymorphic_allocator<ImmediateSender<Result>>{&mr_},
+            std::move(result));
+    }
+
+    template <typename Result>
+    typename SenderOf<Result>::Ptr deferred(Result                    result,
+                                            const libcyphal::Duration delay,
+                                            bool* const               destroyed = nullptr)
+    {
+        return cetl::pmr::InterfaceFactory::make_unique<SenderOf<Result>>(
+            cetl::pmr::polymorphic_allocator<DeferredSender<Result>>{&mr_},
+            executor_,
+            std::move(result),
+            delay,
+            destroyed);
+    }
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    ocvsmd::TrackingMemoryResource           mr_;
+    ocvsmd::platform::SingleThreadedExecutor executor_;
+    std::vector<std::string>                 trace_;
+    // NOLINTEND
+};
+
+// MARK: - Tests:
+
+TEST_F(TestCoroutine, await_immediate_sender)
+{
+    auto task = [this]() -> Task<int> {
+        //
+        trace_.emplace_back("started");
+        const int result = co_await immediate(42);
+        trace_.emplace_back("resumed");
+        co_return result + 1;
+    };
+
+    // Tasks are lazy - nothing happens until the task is started.
+    auto lazy_task = task();
+    EXPECT_THAT(trace_.empty(), IsTrue());
+
+    EXPECT_THAT(ocvsmd::sdk::sync_wait(executor_, std::move(lazy_task)), 43);
+    EXPECT_THAT(trace_, ElementsAre("started", "resumed"));
+}
+
+TEST_F(TestCoroutine, await_deferred_sender)
+{
+    auto task = [this]() -> Task<std::string> {
+        //
+        std::string result = co_await deferred<std::string>("a", 2ms);
+        result += co_await deferred<std::string>("b", 1ms);
+        result += co_await immediate<std::string>("c");
+        co_return result;
+    };
+
+    EXPECT_THAT(ocvsmd::sdk::sync_wait(executor_, task()), "abc");
+}
+
+TEST_F(TestCoroutine, nested_tasks)
+{
+    auto inner = [this](const int value) -> Task<int> {
+        //
+        trace_.emplace_back("inner " + std::to_string(value));
+        co_return 2 * co_await deferred(value, 1ms);
+    };
+    auto inner_void = [this]() -> Task<void> {
+        //
+        (void) co_await immediate(0);
+        trace_.emplace_back("inner void");
+    };
+    auto outer = [&]() -> Task<int> {
+        //
+        const int first = co_await inner(1);
+        co_await inner_void();
+        const int second = co_await inner(2);
+        co_return first + second;
+    };
+
+    EXPECT_THAT(ocvsmd::sdk::sync_wait(executor_, outer()), 6);
+    EXPECT_THAT(trace_, ElementsAre("inner 1", "inner void", "inner 2"));
+}
+
+TEST_F(TestCoroutine, when_all)
+{
+    auto task = [this]() -> Task<std::string> {
+        //
+        // Results are in the order of the senders (not of their completions).
+        auto [number, text] = co_await ocvsmd::sdk::when_all(deferred(7, 5ms), deferred<std::string>("x", 1ms));
+
+        // All senders might complete right away as well.
+        auto [first, second] = co_await ocvsmd::sdk::when_all(immediate(1), immediate(2));
+
+        co_return text + std::to_string(number) + std::to_string(first) + std::to_string(second);
+    };
+
+    EXPECT_THAT(ocvsmd::sdk::sync_wait(executor_, task()), "x712");
+}
+
+TEST_F(TestCoroutine, when_any)
+{
+    bool is_slow_destroyed = false;
+    auto task              = [this, &is_slow_destroyed]() -> Task<int> {
+        //
+        const auto result = co_await ocvsmd::sdk::when_any(deferred<std::string>("slow", 50ms, &is_slow_destroyed),
+                                                           deferred(13, 1ms));
+        EXPECT_THAT(result.index(), 1);
+        co_return cetl::get<1>(result);
+    };
+
+    EXPECT_THAT(ocvsmd::sdk::sync_wait(executor_, task()), 13);
+
+    // The rest of the senders are canceled (destroyed together with the awaiter) - they never complete.
+    EXPECT_THAT(is_slow_destroyed, IsTrue());
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
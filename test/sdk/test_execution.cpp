@@ -0,0 +1,502 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include <ocvsmd/sdk/execution.hpp>
+
+#include "common/ipc/ipc_gtest_helpers.hpp"
+#include "common/ipc/pipe/client_pipe_mock.hpp"
+#include "dsdl_helpers.hpp"
+#include "ipc/client_router.hpp"
+#include "ipc/ipc_types.hpp"
+#include "ipc/pipe/client_pipe.hpp"
+#include "ocvsmd/platform/defines.hpp"
+#include "sdk_factory.hpp"
+#include "svc/node/exec_cmd_spec.hpp"
+#include "tracking_memory_resource.hpp"
+
+#include "ocvsmd/common/ipc/Route_0_1.hpp"
+
+#include <ocvsmd/sdk/node_command_client.hpp>
+
+#include <cetl/pf17/cetlpf.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+/// Counts all heap allocations made via global `operator new` (see the replacement below).
+///
+std::atomic<std::size_t> g_heap_allocations{0};  // NOLINT(*-avoid-non-const-global-variables)
+
+}  // namespace
+
+// NOLINTBEGIN(*-no-malloc, *-owning-memory)
+void* operator new(const std::size_t size)
+{
+    ++g_heap_allocations;
+    if (void* const ptr = std::malloc(size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* const ptr) noexcept
+{
+    std::free(ptr);
+}
+// NOLINTEND(*-no-malloc, *-owning-memory)
+
+namespace
+{
+
+using ocvsmd::sdk::SenderOf;
+using Command = ocvsmd::sdk::NodeCommandClient::Command;
+
+using testing::_;
+using testing::Eq;
+using testing::Gt;
+using testing::Key;
+using testing::Return;
+using testing::IsEmpty;
+using testing::NotNull;
+using testing::StrictMock;
+using testing::UnorderedElementsAre;
+
+using std::literals::chrono_literals::operator""s;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+/// Defines a sender which completes (with the given value) right on submission.
+///
+template <typename Result>
+class ImmediateSender final : public SenderOf<Result>
+{
+public:
+    explicit ImmediateSender(Result result)
+        : result_{std::move(result)}
+    {
+    }
+
+    // Unlike real senders, this one could be re-submitted (to emulate steady-state calls).
+    void submitImpl(typename SenderOf<Result>::Receiver&& receiver) override
+    {
+        Result result{result_};
+        receiver(std::move(result));
+    }
+
+private:
+    Result result_;
+
+};  // ImmediateSender
+
+/// Defines a client pipe which just counts sent payloads, and lets a test to feed received ones.
+///
+/// Unlike the mock, it doesn't allocate on its own (gmock does on each call), so it's used to check
+/// heap allocations of the whole chain of a real command.
+///
+class CountingClientPipe final : public ocvsmd::common::ipc::pipe::ClientPipe
+{
+public:
+    CountingClientPipe() = default;
+
+    int start(EventHandler event_handler) override
+    {
+        event_handler_ = std::move(event_handler);
+        return 0;
+    }
+
+    int send(const ocvsmd::common::ipc::Payloads) override
+    {
+        ++sent_count_;
+        return 0;
+    }
+
+    int receive(const std::vector<std::uint8_t>& frame) const
+    {
+        return event_handler_(Event::Message{{frame.data(), frame.size()}});
+    }
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    EventHandler event_handler_;
+    std::size_t  sent_count_{0};
+    // NOLINTEND
+
+};  // CountingClientPipe
+
+/// Defines a memory resource which takes memory directly from `malloc` (bypassing the counted `operator new`).
+///
+/// Used as the upstream of the tracking memory resource - so that only "unexpected" heap allocations are counted.
+///
+class MallocMemoryResource final : public cetl::pmr::memory_resource
+{
+    // MARK: cetl::pmr::memory_resource
+
+    void* do_allocate(std::size_t size_bytes, std::size_t) override
+    {
+        return std::malloc(size_bytes);  // NOLINT(*-no-malloc, *-owning-memory)
+    }
+
+    void do_deallocate(void* ptr, std::size_t, std::size_t) override
+    {
+        std::free(ptr);  // NOLINT(*-no-malloc, *-owning-memory)
+    }
+
+    bool do_is_equal(const cetl::pmr::memory_resource& rhs) const noexcept override
+    {
+        return (&rhs == this);
+    }
+
+};  // MallocMemoryResource
+
+class TestExecution : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        cetl::pmr::set_default_resource(&mr_);
+    }
+
+    void TearDown() override
+    {
+        EXPECT_THAT(mr_.allocations, IsEmpty());
+        EXPECT_THAT(mr_.total_allocated_bytes, mr_.total_deallocated_bytes);
+    }
+
+    /// Makes a route frame (as if it was sent by the daemon side).
+    ///
+    static std::vector<std::uint8_t> makeRouteFrame(const ocvsmd::common::ipc::Route_0_1& route)
+    {
+        using ocvsmd::common::tryPerformOnSerialized;
+
+        std::vector<std::uint8_t> frame;
+        const int                 result = tryPerformOnSerialized(route, [&frame](const auto payload) {
+            //
+            frame.assign(payload.begin(), payload.end());
+            return 0;
+        });
+        EXPECT_THAT(result, 0);
+        return frame;
+    }
+
+    /// Makes the daemon side response of the route connection handshake.
+    ///
+    std::vector<std::uint8_t> makeRouteConnectFrame()
+    {
+        using ocvsmd::common::ipc::Route_0_1;
+        using ocvsmd::common::ipc::ErrorCode;
+
+        Route_0_1 route{&mr_};
+        auto&     rt_conn     = route.set_connect();
+        rt_conn.version.major = ocvsmd::common::ipc::VERSION_MAJOR;
+        rt_conn.version.minor = ocvsmd::common::ipc::VERSION_MINOR;
+        rt_conn.error_code    = static_cast<std::int32_t>(ErrorCode::Success);
+        return makeRouteFrame(route);
+    }
+
+    /// Makes a channel message frame from the daemon side.
+    ///
+    template <typename Msg>
+    std::vector<std::uint8_t> makeRouteChannelMsgFrame(const std::uint64_t     tag,
+                                                       const Msg&              msg,
+                                                       std::uint64_t&          seq,
+                                                       const cetl::string_view service_name)
+    {
+        using ocvsmd::common::tryPerformOnSerialized;
+        using ocvsmd::common::ipc::Route_0_1;
+        using ocvsmd::common::ipc::AnyChannel;
+
+        Route_0_1 route{&mr_};
+        auto&     channel_msg  = route.set_channel_msg();
+        channel_msg.tag        = tag;
+        channel_msg.sequence   = seq++;
+        channel_msg.service_id = AnyChannel::getServiceDesc<Msg>(service_name).id;
+
+        std::vector<std::uint8_t> frame;
+        const int                 result = tryPerformOnSerialized(route, [&](const auto prefix) {
+            //
+            return tryPerformOnSerialized(msg, [&](const auto suffix) {
+                //
+                std::copy(prefix.begin(), prefix.end(), std::back_inserter(frame));
+                std::copy(suffix.begin(), suffix.end(), std::back_inserter(frame));
+                return 0;
+            });
+        });
+        EXPECT_THAT(result, 0);
+        return frame;
+    }
+
+    /// Makes the channel end frame from the daemon side.
+    ///
+    std::vector<std::uint8_t> makeRouteChannelEndFrame(const std::uint64_t                  tag,
+                                                       const ocvsmd::common::ipc::ErrorCode error_code)
+    {
+        using ocvsmd::common::ipc::Route_0_1;
+
+        Route_0_1 route{&mr_};
+        auto&     channel_end  = route.set_channel_end();
+        channel_end.tag        = tag;
+        channel_end.error_code = static_cast<std::int32_t>(error_code);
+        return makeRouteFrame(route);
+    }
+
+    /// Emulates a frame received from the daemon side.
+    ///
+    static void emulateFrame(ocvsmd::common::ipc::pipe::ClientPipeMock& client_pipe_mock,
+                             const std::vector<std::uint8_t>&           frame)
+    {
+        using ocvsmd::common::ipc::pipe::ClientPipe;
+
+        EXPECT_THAT(client_pipe_mock.event_handler_(ClientPipe::Event::Message{{frame.data(), frame.size()}}), 0);
+    }
+
+    /// Emulates the daemon side of the route connection handshake.
+    ///
+    void emulateRouteConnect(ocvsmd::common::ipc::pipe::ClientPipeMock& client_pipe_mock)
+    {
+        using ocvsmd::common::ipc::pipe::ClientPipe;
+
+        EXPECT_CALL(client_pipe_mock, send(ocvsmd::common::ipc::PayloadOfRouteConnect(mr_)))  //
+            .WillOnce(Return(0));
+        client_pipe_mock.event_handler_(ClientPipe::Event::Connected{});
+
+        emulateFrame(client_pipe_mock, makeRouteConnectFrame());
+    }
+
+    /// Emulates a channel message from the daemon side.
+    ///
+    template <typename Msg>
+    void emulateRouteChannelMsg(ocvsmd::common::ipc::pipe::ClientPipeMock& client_pipe_mock,
+                                const std::uint64_t                        tag,
+                                const Msg&                                 msg,
+                                std::uint64_t&                             seq,
+                                const cetl::string_view                    service_name)
+    {
+        emulateFrame(client_pipe_mock, makeRouteChannelMsgFrame(tag, msg, seq, service_name));
+    }
+
+    /// Emulates the channel end from the daemon side.
+    ///
+    void emulateRouteChannelEnd(ocvsmd::common::ipc::pipe::ClientPipeMock& client_pipe_mock,
+                                const std::uint64_t                        tag,
+                                const ocvsmd::common::ipc::ErrorCode       error_code)
+    {
+        emulateFrame(client_pipe_mock, makeRouteChannelEndFrame(tag, error_code));
+    }
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    ocvsmd::TrackingMemoryResource mr_;
+    // NOLINTEND
+};
+
+// MARK: - Tests:
+
+TEST_F(TestExecution, submit_is_allocation_free)
+{
+    ImmediateSender<int> sender{42};
+
+    int         sum   = 0;
+    int         count = 0;
+    const void* tag   = &sender;
+
+    const std::size_t heap_allocations_before = g_heap_allocations;
+    for (int i = 0; i < 100; ++i)
+    {
+        // The receiver captures a few pointers - fits the in-place storage.
+        sender.submit([&sum, &count, tag](int&& result) {
+            //
+            (void) tag;
+            sum += result;
+            ++count;
+        });
+    }
+    EXPECT_THAT(g_heap_allocations - heap_allocations_before, Eq(0));
+    EXPECT_THAT(count, Eq(100));
+    EXPECT_THAT(sum, Eq(4200));
+}
+
+TEST_F(TestExecution, sync_wait_is_allocation_free)
+{
+    ocvsmd::platform::SingleThreadedExecutor executor;
+    ImmediateSender<cetl::variant<int, double>> sender{3.5};
+
+    // Warm up once (f.e. lazy initialization of logging).
+    (void) ocvsmd::sdk::sync_wait<cetl::variant<int, double>>(executor, sender);
+
+    const std::size_t heap_allocations_before = g_heap_allocations;
+    for (int i = 0; i < 100; ++i)
+    {
+        const auto result = ocvsmd::sdk::sync_wait<cetl::variant<int, double>>(executor, sender);
+        EXPECT_THAT(cetl::get<double>(result), Eq(3.5));
+    }
+    EXPECT_THAT(g_heap_allocations - heap_allocations_before, Eq(0));
+}
+
+TEST_F(TestExecution, command_sender_chain)
+{
+    using ocvsmd::common::ipc::ErrorCode;
+    using ocvsmd::common::ipc::ClientRouter;
+    using ocvsmd::common::ipc::pipe::ClientPipeMock;
+    using ExecCmdSpec = ocvsmd::common::svc::node::ExecCmdSpec;
+
+    // Unlike the immediate senders above, the real chain (client -> sender -> service client -> IPC channel)
+    // allocates its state from the memory resource - all of it should be returned once the sender is gone.
+    StrictMock<ClientPipeMock> client_pipe_mock;
+    EXPECT_CALL(client_pipe_mock, deinit()).Times(1);
+    {
+        const auto client_router = ClientRouter::make(  //
+            mr_,
+            std::make_unique<ClientPipeMock::RefWrapper>(client_pipe_mock));
+        ASSERT_THAT(client_router, NotNull());
+
+        EXPECT_CALL(client_pipe_mock, start(_)).Times(1);
+        EXPECT_THAT(client_router->start(), 0);
+        emulateRouteConnect(client_pipe_mock);
+
+        const auto client = ocvsmd::sdk::Factory::makeNodeCommandClient(mr_, client_router);
+        ASSERT_THAT(client, NotNull());
+
+        const std::vector<std::uint16_t> node_ids{13, 42};
+        const Command::NodeRequest       node_request{Command::NodeRequest::COMMAND_RESTART, {}, &mr_};
+        auto                             sender = client->sendCommand(node_ids, node_request, 1s);
+        ASSERT_THAT(sender, NotNull());
+
+        // The request goes to the daemon right on submission (the router is already connected).
+        const std::uint64_t  tag = 0;
+        ExecCmdSpec::Request request{&mr_};
+        request.node_ids          = {node_ids.begin(), node_ids.end(), &mr_};
+        request.payload.command   = node_request.command;
+        request.payload.parameter = node_request.parameter;
+        EXPECT_CALL(client_pipe_mock,
+                    send(ocvsmd::common::ipc::PayloadOfRouteChannelMsg(request,
+                                                                       mr_,
+                                                                       tag,
+                                                                       0,
+                                                                       ExecCmdSpec::svc_full_name())))
+            .WillOnce(Return(0));
+
+        cetl::optional<Command::Result> result;
+        sender->submit([&result](Command::Result&& cmd_result) { result = std::move(cmd_result); });
+        EXPECT_THAT(mr_.total_allocated_bytes, Gt(0U));
+
+        // Node responses are collected until the daemon completes the channel.
+        std::uint64_t         rx_seq = 0;
+        ExecCmdSpec::Response response{&mr_};
+        for (const auto node_id : node_ids)
+        {
+            response.node_id = node_id;
+            emulateRouteChannelMsg(client_pipe_mock, tag, response, rx_seq, ExecCmdSpec::svc_full_name());
+        }
+        EXPECT_FALSE(result.has_value());
+        emulateRouteChannelEnd(client_pipe_mock, tag, ErrorCode::Success);
+
+        ASSERT_TRUE(result.has_value());
+        const auto* const success = cetl::get_if<Command::Success>(&*result);
+        ASSERT_THAT(success, NotNull());
+        EXPECT_THAT(*success, UnorderedElementsAre(Key(13), Key(42)));
+    }
+}
+
+TEST_F(TestExecution, command_round_trip_is_allocation_free)
+{
+    using ocvsmd::common::ipc::ErrorCode;
+    using ocvsmd::common::ipc::ClientRouter;
+    using ocvsmd::common::ipc::pipe::ClientPipe;
+    using ExecCmdSpec = ocvsmd::common::svc::node::ExecCmdSpec;
+
+    constexpr std::uint64_t Rounds = 10;
+
+    // All memory of the chain is expected from `mr_` - which, in its turn, bypasses the counted heap.
+    MallocMemoryResource malloc_mr;
+    mr_.memory_ = &malloc_mr;
+    {
+        auto  client_pipe = std::make_unique<CountingClientPipe>();
+        auto& pipe        = *client_pipe;
+
+        const auto client_router = ClientRouter::make(mr_, std::move(client_pipe));
+        ASSERT_THAT(client_router, NotNull());
+        EXPECT_THAT(client_router->start(), 0);
+        EXPECT_THAT(pipe.event_handler_(ClientPipe::Event::Connected{}), 0);
+        EXPECT_THAT(pipe.receive(makeRouteConnectFrame()), 0);
+
+        const auto client = ocvsmd::sdk::Factory::makeNodeCommandClient(mr_, client_router);
+        ASSERT_THAT(client, NotNull());
+
+        const std::vector<std::uint16_t> node_ids{13, 42};
+        const Command::NodeRequest       node_request{Command::NodeRequest::COMMAND_RESTART, {}, &mr_};
+
+        // Frames of the daemon side (per each round) are prepared in advance - each round has its own channel tag.
+        std::vector<std::vector<std::uint8_t>> frames;
+        for (std::uint64_t tag = 0; tag < Rounds; ++tag)
+        {
+            std::uint64_t         rx_seq = 0;
+            ExecCmdSpec::Response response{&mr_};
+            for (const auto node_id : node_ids)
+            {
+                response.node_id = node_id;
+                frames.push_back(makeRouteChannelMsgFrame(tag, response, rx_seq, ExecCmdSpec::svc_full_name()));
+            }
+            frames.push_back(makeRouteChannelEndFrame(tag, ErrorCode::Success));
+        }
+        const std::size_t frames_per_round = frames.size() / Rounds;
+
+        int  responses = 0;
+        auto round     = [&](const std::uint64_t tag) {
+            //
+            auto sender = client->sendCommand(node_ids, node_request, 1s);
+            if (!sender)
+            {
+                return;
+            }
+            cetl::optional<Command::Result> result;
+            sender->submit([&result](Command::Result&& cmd_result) { result = std::move(cmd_result); });
+            for (std::size_t index = 0; index < frames_per_round; ++index)
+            {
+                (void) pipe.receive(frames[(tag * frames_per_round) + index]);
+            }
+            if (const auto* const success = result ? cetl::get_if<Command::Success>(&*result) : nullptr)
+            {
+                responses += static_cast<int>(success->size());
+            }
+        };
+
+        // Warm up once (f.e. lazy initialization of logging, and growth of the tracking resource's own bookkeeping).
+        round(0);
+
+        const std::size_t heap_allocations_before = g_heap_allocations;
+        for (std::uint64_t tag = 1; tag < Rounds; ++tag)
+        {
+            round(tag);
+        }
+        EXPECT_THAT(g_heap_allocations - heap_allocations_before, Eq(0));
+        EXPECT_THAT(responses, Eq(static_cast<int>(Rounds * node_ids.size())));
+
+        // The route connect, plus a request per each round.
+        EXPECT_THAT(pipe.sent_count_, Eq(1 + Rounds));
+    }
+    mr_.memory_ = cetl::pmr::new_delete_resource();
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
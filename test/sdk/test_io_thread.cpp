@@ -0,0 +1,305 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include <ocvsmd/sdk/io_thread.hpp>
+
+#include "io/io.hpp"
+#include "io/socket_address.hpp"
+
+#include <ocvsmd/sdk/daemon.hpp>
+#include <ocvsmd/sdk/execution.hpp>
+
+#include <cetl/pf17/cetlpf.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+using ocvsmd::sdk::Daemon;
+using ocvsmd::sdk::IoThread;
+using ocvsmd::sdk::SenderOf;
+
+using testing::Eq;
+using testing::Ne;
+using testing::IsTrue;
+using testing::IsFalse;
+using testing::NotNull;
+using testing::ElementsAre;
+
+using std::literals::chrono_literals::operator""s;
+using std::literals::chrono_literals::operator""ms;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestIoThread : public testing::Test
+{
+protected:
+    /// Defines a sender which completes (with the given value) right on submission.
+    ///
+    class ImmediateSender final : public SenderOf<int>
+    {
+    public:
+        explicit ImmediateSender(const int result)
+            : result_{result}
+        {
+        }
+
+        void submitImpl(Receiver&& receiver) override
+        {
+            receiver(int{result_});
+        }
+
+    private:
+        int result_;
+
+    };  // ImmediateSender
+
+    /// Defines a sender which never completes - like an operation which is still in progress.
+    ///
+    class NeverSender final : public SenderOf<int>
+    {
+    public:
+        explicit NeverSender(std::shared_ptr<int> token)
+            : token_{std::move(token)}
+        {
+        }
+
+        void submitImpl(Receiver&& receiver) override
+        {
+            receiver_.emplace(std::move(receiver));
+        }
+
+    private:
+        std::shared_ptr<int>     token_;
+        cetl::optional<Receiver> receiver_;
+
+    };  // NeverSender
+
+    void SetUp() override
+    {
+        using SocketAddress = ocvsmd::common::io::SocketAddress;
+        using ParseResult   = SocketAddress::ParseResult;
+        using SocketResult  = SocketAddress::SocketResult;
+
+        // The I/O thread connects to this (never accepting) server socket - that's enough for it to run.
+        connection_        = "unix-abstract:org.opencyphal.ocvsmd.test.io_thread." + std::to_string(::getpid());
+        auto maybe_address = SocketAddress::parse(connection_, 0);
+        ASSERT_THAT(cetl::get_if<ParseResult::Success>(&maybe_address), NotNull());
+        const auto address = cetl::get<ParseResult::Success>(maybe_address);
+
+        auto maybe_server_fd = address.socket(SOCK_STREAM);
+        ASSERT_THAT(cetl::get_if<SocketResult::Success>(&maybe_server_fd), NotNull());
+        server_fd_ = cetl::get<SocketResult::Success>(std::move(maybe_server_fd));
+        ASSERT_THAT(address.bind(server_fd_), 0);
+        ASSERT_THAT(::listen(server_fd_.get(), 8), 0);
+    }
+
+    /// Waits (but not forever) until the given predicate is satisfied.
+    ///
+    template <typename Predicate>
+    static bool waitFor(Predicate&& predicate)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (!predicate())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        return true;
+    }
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    cetl::pmr::memory_resource& memory_{*cetl::pmr::new_delete_resource()};
+    std::string                 connection_;
+    ocvsmd::common::io::OwnFd   server_fd_;
+    // NOLINTEND
+};
+
+// MARK: - Tests:
+
+TEST_F(TestIoThread, post_from_many_threads)
+{
+    constexpr std::size_t Producers        = 4;
+    constexpr std::size_t TasksPerProducer = 1000;
+
+    const auto io_thread = IoThread::make(memory_, connection_);
+    ASSERT_THAT(io_thread, NotNull());
+
+    // Tasks are executed on the I/O thread only, so their state needs no synchronization
+    // (except for the counter - it tells the main thread when all tasks are done).
+    const auto               main_thread_id = std::this_thread::get_id();
+    bool                     is_in_order    = true;
+    bool                     is_on_io       = true;
+    std::vector<std::size_t> next_sequences(Producers, 0);
+    std::atomic<std::size_t> executed{0};
+
+    std::vector<std::thread> producers;
+    for (std::size_t producer = 0; producer < Producers; ++producer)
+    {
+        producers.emplace_back([&, producer] {
+            //
+            for (std::size_t sequence = 0; sequence < TasksPerProducer; ++sequence)
+            {
+                io_thread->post([&, producer, sequence](Daemon&) {
+                    //
+                    is_in_order              = is_in_order && (sequence == next_sequences[producer]);
+                    is_on_io                 = is_on_io && (std::this_thread::get_id() != main_thread_id);
+                    next_sequences[producer] = sequence + 1;
+                    ++executed;
+                });
+            }
+        });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    ASSERT_THAT(waitFor([&executed] { return executed == Producers * TasksPerProducer; }), IsTrue());
+    EXPECT_THAT(is_in_order, IsTrue());
+    EXPECT_THAT(is_on_io, IsTrue());
+    EXPECT_THAT(next_sequences, ElementsAre(TasksPerProducer, TasksPerProducer, TasksPerProducer, TasksPerProducer));
+}
+
+TEST_F(TestIoThread, submit_delivers_result)
+{
+    const auto io_thread = IoThread::make(memory_, connection_);
+    ASSERT_THAT(io_thread, NotNull());
+
+    const auto main_thread_id = std::this_thread::get_id();
+
+    // Without a result executor, the receiver is called right on the I/O thread.
+    {
+        std::atomic<int>  result{0};
+        std::atomic<bool> is_on_io{false};
+        io_thread->submit<int>(  //
+            [](Daemon&) { return std::make_unique<ImmediateSender>(42); },
+            [&](int&& value) {
+                //
+                is_on_io = std::this_thread::get_id() != main_thread_id;
+                result   = value;
+            });
+
+        ASSERT_THAT(waitFor([&result] { return result == 42; }), IsTrue());
+        EXPECT_THAT(is_on_io.load(), IsTrue());
+    }
+
+    // With a result executor, the delivery is passed to it - here, to the main thread's own "event loop".
+    {
+        std::mutex                         mutex;
+        std::vector<std::function<void()>> actions;
+        int                                result = 0;
+        std::thread::id                    result_thread_id;
+        io_thread->submit<int>(  //
+            [](Daemon&) { return std::make_unique<ImmediateSender>(7); },
+            [&](int&& value) {
+                //
+                result_thread_id = std::this_thread::get_id();
+                result           = value;
+            },
+            [&](std::function<void()>&& action) {
+                //
+                const std::lock_guard<std::mutex> lock{mutex};
+                actions.push_back(std::move(action));
+            });
+
+        ASSERT_THAT(waitFor([&] {
+                        //
+                        const std::lock_guard<std::mutex> lock{mutex};
+                        return !actions.empty();
+                    }),
+                    IsTrue());
+        EXPECT_THAT(result, 0);
+
+        std::vector<std::function<void()>> ready_actions;
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            ready_actions.swap(actions);
+        }
+        for (auto& action : ready_actions)
+        {
+            action();
+        }
+        EXPECT_THAT(result, 7);
+        EXPECT_THAT(result_thread_id, Eq(main_thread_id));
+    }
+}
+
+TEST_F(TestIoThread, shutdown_with_pending_work)
+{
+    const auto               token = std::make_shared<int>(0);
+    std::atomic<bool>        is_received{false};
+    std::atomic<std::size_t> executed{0};
+    {
+        auto io_thread = IoThread::make(memory_, connection_);
+        ASSERT_THAT(io_thread, NotNull());
+
+        // An operation which is still in progress at the shutdown.
+        std::atomic<bool> is_submitted{false};
+        io_thread->submit<int>(
+            [token, &is_submitted](Daemon&) {
+                //
+                is_submitted = true;
+                return std::make_unique<NeverSender>(token);
+            },
+            [&is_received](int&&) { is_received = true; });
+        ASSERT_THAT(waitFor([&is_submitted] { return is_submitted.load(); }), IsTrue());
+
+        // Block the I/O thread, so that the next tasks stay queued.
+        std::atomic<bool>              is_blocked{false};
+        std::promise<void>             unblock;
+        const std::shared_future<void> unblocked = unblock.get_future().share();
+        io_thread->post([&is_blocked, unblocked](Daemon&) {
+            //
+            is_blocked = true;
+            unblocked.wait();
+        });
+        ASSERT_THAT(waitFor([&is_blocked] { return is_blocked.load(); }), IsTrue());
+        for (int i = 0; i < 100; ++i)
+        {
+            io_thread->post([token, &executed](Daemon&) { ++executed; });
+        }
+        EXPECT_THAT(token.use_count(), Ne(1));
+
+        // Request the shutdown while the I/O thread is still busy, and only then let it go.
+        std::thread destroyer{[&io_thread] { io_thread.reset(); }};
+        std::this_thread::sleep_for(100ms);
+        unblock.set_value();
+        destroyer.join();
+    }
+
+    // Neither queued tasks are executed, nor the operation in progress completes.
+    EXPECT_THAT(executed.load(), 0);
+    EXPECT_THAT(is_received.load(), IsFalse());
+
+    // Both the queued tasks and the operation's sender are released.
+    EXPECT_THAT(token.use_count(), 1);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
@@ -0,0 +1,165 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include "mpsc_queue.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+using ocvsmd::sdk::MpscQueue;
+
+using testing::Eq;
+using testing::IsTrue;
+using testing::IsFalse;
+using testing::IsEmpty;
+using testing::ElementsAre;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestMpscQueue : public testing::Test
+{
+protected:
+    struct Item
+    {
+        std::size_t producer;
+        std::size_t sequence;
+    };
+
+    template <typename Queue>
+    static std::vector<std::size_t> drainSequences(Queue& queue)
+    {
+        std::vector<std::size_t> sequences;
+        queue.drain([&sequences](Item&& item) { sequences.push_back(item.sequence); });
+        return sequences;
+    }
+};
+
+// MARK: - Tests:
+
+TEST_F(TestMpscQueue, push_signals_non_empty)
+{
+    MpscQueue<Item> queue;
+
+    EXPECT_THAT(queue.push({0, 1}), IsTrue());
+    EXPECT_THAT(queue.push({0, 2}), IsFalse());
+    EXPECT_THAT(queue.push({0, 3}), IsFalse());
+
+    EXPECT_THAT(drainSequences(queue), ElementsAre(1, 2, 3));
+    EXPECT_THAT(drainSequences(queue), IsEmpty());
+
+    // Drained queue is empty again - so the next push should wake up the consumer.
+    EXPECT_THAT(queue.push({0, 4}), IsTrue());
+    EXPECT_THAT(drainSequences(queue), ElementsAre(4));
+}
+
+TEST_F(TestMpscQueue, push_from_visitor)
+{
+    MpscQueue<Item> queue;
+    EXPECT_THAT(queue.push({0, 1}), IsTrue());
+    EXPECT_THAT(queue.push({0, 2}), IsFalse());
+
+    // Items pushed by the visitor are not visited by the same drain.
+    std::vector<std::size_t> sequences;
+    std::vector<bool>        signals;
+
+    const auto count = queue.drain([&](Item&& item) {
+        //
+        sequences.push_back(item.sequence);
+        signals.push_back(queue.push({0, item.sequence + 10}));
+    });
+    EXPECT_THAT(count, 2);
+    EXPECT_THAT(sequences, ElementsAre(1, 2));
+    EXPECT_THAT(signals, ElementsAre(true, false));
+
+    EXPECT_THAT(drainSequences(queue), ElementsAre(11, 12));
+}
+
+TEST_F(TestMpscQueue, destroy_with_pending_items)
+{
+    const auto token = std::make_shared<int>(0);
+    {
+        MpscQueue<std::shared_ptr<int>> queue;
+        for (int i = 0; i < 10; ++i)
+        {
+            auto item = token;
+            (void) queue.push(std::move(item));
+        }
+        EXPECT_THAT(token.use_count(), 11);
+    }
+    EXPECT_THAT(token.use_count(), 1);
+}
+
+TEST_F(TestMpscQueue, concurrent_producers)
+{
+    constexpr std::size_t    Producers        = 4;
+    constexpr std::size_t    ItemsPerProducer = 20000;
+    constexpr std::size_t    TotalItems       = Producers * ItemsPerProducer;
+    MpscQueue<Item>          queue;
+    std::atomic<bool>        go{false};
+    std::atomic<std::size_t> signals{0};
+
+    std::vector<std::thread> producers;
+    for (std::size_t producer = 0; producer < Producers; ++producer)
+    {
+        producers.emplace_back([&queue, &go, &signals, producer] {
+            //
+            while (!go.load())
+            {
+                std::this_thread::yield();
+            }
+            for (std::size_t sequence = 0; sequence < ItemsPerProducer; ++sequence)
+            {
+                if (queue.push({producer, sequence}))
+                {
+                    ++signals;
+                }
+            }
+        });
+    }
+
+    // The consumer drains concurrently with the producers.
+    std::size_t              total            = 0;
+    std::size_t              non_empty_drains = 0;
+    bool                     is_in_order      = true;
+    std::vector<std::size_t> next_sequences(Producers, 0);
+    go.store(true);
+    while (total < TotalItems)
+    {
+        const auto count = queue.drain([&](Item&& item) {
+            //
+            is_in_order                   = is_in_order && (item.sequence == next_sequences[item.producer]);
+            next_sequences[item.producer] = item.sequence + 1;
+        });
+        total += count;
+        non_empty_drains += (count > 0) ? 1 : 0;
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    // Items of each producer are drained in the order of their pushes, and none is lost or duplicated.
+    EXPECT_THAT(is_in_order, IsTrue());
+    EXPECT_THAT(total, Eq(TotalItems));
+    EXPECT_THAT(next_sequences, ElementsAre(ItemsPerProducer, ItemsPerProducer, ItemsPerProducer, ItemsPerProducer));
+    EXPECT_THAT(drainSequences(queue), IsEmpty());
+
+    // Each "empty -> non-empty" signal is followed by exactly one non-empty drain.
+    EXPECT_THAT(signals.load(), Eq(non_empty_drains));
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
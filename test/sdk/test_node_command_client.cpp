@@ -0,0 +1,102 @@
+//
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: MIT
+//
+
+#include <ocvsmd/sdk/node_command_client.hpp>
+
+#include "sdk_factory.hpp"
+#include "tracking_memory_resource.hpp"
+
+#include <cetl/pf17/cetlpf.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+using ocvsmd::sdk::Factory;
+using Command = ocvsmd::sdk::NodeCommandClient::Command;
+
+using testing::Eq;
+using testing::IsEmpty;
+using testing::NotNull;
+
+using std::literals::chrono_literals::operator""s;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+class TestNodeCommandClient : public testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        EXPECT_THAT(mr_.allocations, IsEmpty());
+        EXPECT_THAT(mr_.total_allocated_bytes, mr_.total_deallocated_bytes);
+    }
+
+    /// Submits the given batch, and expects it to fail right away (without any IPC).
+    ///
+    void expectBatchFailure(const cetl::span<const Command::BatchItem> items, const Command::Failure failure)
+    {
+        // No IPC router - any attempt to reach the daemon would crash the test.
+        const auto client = Factory::makeNodeCommandClient(mr_, nullptr);
+
+        std::size_t observed = 0;
+        const auto  sender   = client->sendCommandBatch(items, 1s, [&observed](auto, auto, auto&&) { ++observed; });
+        ASSERT_THAT(sender, NotNull());
+
+        cetl::optional<Command::StreamResult> result;
+        sender->submit([&result](Command::StreamResult&& stream_result) { result = std::move(stream_result); });
+        ASSERT_TRUE(result.has_value());
+        const auto* const result_failure = cetl::get_if<Command::Failure>(&*result);
+        ASSERT_THAT(result_failure, NotNull());
+        EXPECT_THAT(*result_failure, Eq(failure));
+        EXPECT_THAT(observed, 0);
+    }
+
+    // MARK: Data members:
+
+    // NOLINTBEGIN
+    ocvsmd::TrackingMemoryResource mr_;
+    // NOLINTEND
+};
+
+// MARK: - Tests:
+
+TEST_F(TestNodeCommandClient, sendCommandBatch_too_many_items)
+{
+    const Command::NodeRequest       node_request{&mr_};
+    const std::vector<std::uint16_t> node_ids{1, 2, 3};
+
+    // Up to 16 items are allowed.
+    const std::vector<Command::BatchItem> items(17, Command::BatchItem{node_ids, node_request});
+    expectBatchFailure(items, EINVAL);
+}
+
+TEST_F(TestNodeCommandClient, sendCommandBatch_too_many_node_ids)
+{
+    const Command::NodeRequest node_request{&mr_};
+    std::vector<std::uint16_t> few_node_ids{1, 2, 3};
+    std::vector<std::uint16_t> many_node_ids(129);
+    std::iota(many_node_ids.begin(), many_node_ids.end(), 0);
+
+    // Up to 128 node ids per item are allowed - even a single oversized item fails the whole batch.
+    const std::vector<Command::BatchItem> items{{few_node_ids, node_request},
+                                                {many_node_ids, node_request},
+                                                {few_node_ids, node_request}};
+    expectBatchFailure(items, EINVAL);
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace